@@ -27,6 +27,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <set>
 
 #ifdef _WIN32
 #include <io.h>
@@ -41,6 +42,7 @@
 #include "aidl_language.h"
 #include "aidl_typenames.h"
 #include "check_valid.h"
+#include "document_cache.h"
 #include "generate_aidl_mappings.h"
 #include "generate_cpp.h"
 #include "generate_cpp_analyzer.h"
@@ -402,6 +404,29 @@ bool ValidateHeaders(Options::Language language, const AidlDocument& doc) {
 
 namespace internals {
 
+namespace {
+// Returns false if |type| or one of its type parameters is an untyped List or Map.
+bool CheckNoUntypedContainer(const AidlTypeSpecifier& type, const AidlNode* node) {
+  if (type.IsGeneric()) {
+    bool success = true;
+    for (const auto& nested : type.GetTypeParameters()) {
+      if (!CheckNoUntypedContainer(*nested, node)) {
+        success = false;
+      }
+    }
+    return success;
+  }
+  if (type.GetName() == "List" || type.GetName() == "Map") {
+    AIDL_ERROR(node)
+        << "Encountered an untyped List or Map. The use of untyped List/Map is prohibited "
+        << "because it is not guaranteed that the objects in the list are recognizable in "
+        << "the receiving side. Consider switching to an array or a generic List/Map.";
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
 // WARNING: options are passed here and below, but only the file contents should determine
 // what is generated for portability.
 AidlError load_and_validate_aidl(const std::string& input_file_name, const Options& options,
@@ -414,7 +439,9 @@ AidlError load_and_validate_aidl(const std::string& input_file_name, const Optio
   //////////////////////////////////////////////////////////////////////////
 
   // Parse the main input file
-  const AidlDocument* document = Parser::Parse(input_file_name, io_delegate, *typenames);
+  const AidlDocument* document =
+      Parser::Parse(input_file_name, io_delegate, *typenames, /*is_preprocessed=*/false,
+                    /*cache=*/nullptr, options.GetParserKind());
   if (document == nullptr) {
     return AidlError::PARSE_ERROR;
   }
@@ -429,9 +456,24 @@ AidlError load_and_validate_aidl(const std::string& input_file_name, const Optio
     }
   }
 
+  // Imports and preprocessed files are shared by many compilations. Reuse their ASTs.
+  std::unique_ptr<DocumentCache> cache;
+  if (!options.CacheDir().empty()) {
+    cache = std::make_unique<DocumentCache>(options.CacheDir(), io_delegate);
+  }
+
   // Import the preprocessed file
   for (const string& filename : options.PreprocessedFiles()) {
-    auto preprocessed = Parser::Parse(filename, io_delegate, *typenames, /*is_preprocessed=*/true);
+    if (options.LazyPreprocessed()) {
+      if (!Parser::ParsePreprocessedLazily(filename, io_delegate, *typenames,
+                                           options.GetParserKind())) {
+        return AidlError::BAD_PRE_PROCESSED_FILE;
+      }
+      continue;
+    }
+    auto preprocessed =
+        Parser::Parse(filename, io_delegate, *typenames, /*is_preprocessed=*/true, cache.get(),
+                      options.GetParserKind());
     if (!preprocessed) {
       return AidlError::BAD_PRE_PROCESSED_FILE;
     }
@@ -441,6 +483,9 @@ AidlError load_and_validate_aidl(const std::string& input_file_name, const Optio
   vector<string> import_paths;
   ImportResolver import_resolver{io_delegate, input_file_name, options.ImportDirs()};
   for (const auto& import : document->Imports()) {
+    if (!typenames->LoadLazyType(import)) {
+      return AidlError::BAD_PRE_PROCESSED_FILE;
+    }
     if (typenames->IsIgnorableImport(import)) {
       // There are places in the Android tree where an import doesn't resolve,
       // but we'll pick the type up through the preprocessed types.
@@ -455,7 +500,9 @@ AidlError load_and_validate_aidl(const std::string& input_file_name, const Optio
 
     import_paths.emplace_back(import_path);
 
-    auto imported_doc = Parser::Parse(import_path, io_delegate, *typenames);
+    auto imported_doc = Parser::Parse(import_path, io_delegate, *typenames,
+                                      /*is_preprocessed=*/false, cache.get(),
+                                      options.GetParserKind());
     if (imported_doc == nullptr) {
       AIDL_ERROR(import_path) << "error while importing " << import_path << " for " << import;
       err = AidlError::BAD_IMPORT;
@@ -467,16 +514,23 @@ AidlError load_and_validate_aidl(const std::string& input_file_name, const Optio
   }
 
   TypeResolver resolver = [&](const AidlDefinedType* scope, AidlTypeSpecifier* type) {
+    // Lookups don't load the declarations of lazily parsed preprocessed files.
+    const string name = scope->ResolveName(type->GetName());
+    if (!typenames->LoadLazyType(name)) {
+      return false;
+    }
     // resolve with already loaded types
     if (type->Resolve(*typenames, scope)) {
       return true;
     }
-    const string import_path = import_resolver.FindImportFile(scope->ResolveName(type->GetName()));
+    const string import_path = import_resolver.FindImportFile(name);
     if (import_path.empty()) {
       return false;
     }
     import_paths.push_back(import_path);
-    auto imported_doc = Parser::Parse(import_path, io_delegate, *typenames);
+    auto imported_doc = Parser::Parse(import_path, io_delegate, *typenames,
+                                      /*is_preprocessed=*/false, cache.get(),
+                                      options.GetParserKind());
     if (imported_doc == nullptr) {
       AIDL_ERROR(import_path) << "error while importing " << import_path << " for " << import_path;
       return false;
@@ -604,8 +658,15 @@ AidlError load_and_validate_aidl(const std::string& input_file_name, const Optio
     return err;
   }
 
-  for (const auto& doc : typenames->AllDocuments()) {
-    VisitTopDown([](const AidlNode& n) { n.MarkVisited(); }, *doc);
+  // Preprocessed files declare far more types than a compilation uses. Only the types which the
+  // main document reaches are checked below, and only their documents are visited.
+  const auto reachable = typenames->ReachableTypes(*document);
+  set<const AidlDocument*> reachable_documents;
+  for (const auto& type : reachable) {
+    reachable_documents.insert(&type->GetDocument());
+  }
+  for (const auto& doc : reachable_documents) {
+    ForEachNodeTopDown(*doc, [](const AidlNode& n) { n.MarkVisited(); });
   }
 
   if (!CheckValid(*document, options)) {
@@ -625,6 +686,10 @@ AidlError load_and_validate_aidl(const std::string& input_file_name, const Optio
   }
 
   typenames->IterateTypes([&](const AidlDefinedType& type) {
+    if (reachable.count(&type) == 0) {
+      return;
+    }
+
     if (!type.LanguageSpecificCheckValid(options.TargetLanguage())) {
       err = AidlError::BAD_TYPE;
     }
@@ -647,24 +712,11 @@ AidlError load_and_validate_aidl(const std::string& input_file_name, const Optio
     }
 
     // Ensure that untyped List/Map is not used in a parcelable, a union and a stable interface.
-
-    std::function<void(const AidlTypeSpecifier&, const AidlNode*)> check_untyped_container =
-        [&err, &check_untyped_container](const AidlTypeSpecifier& type, const AidlNode* node) {
-          if (type.IsGeneric()) {
-            std::for_each(type.GetTypeParameters().begin(), type.GetTypeParameters().end(),
-                          [&node, &check_untyped_container](auto& nested) {
-                            check_untyped_container(*nested, node);
-                          });
-            return;
-          }
-          if (type.GetName() == "List" || type.GetName() == "Map") {
-            err = AidlError::BAD_TYPE;
-            AIDL_ERROR(node)
-                << "Encountered an untyped List or Map. The use of untyped List/Map is prohibited "
-                << "because it is not guaranteed that the objects in the list are recognizable in "
-                << "the receiving side. Consider switching to an array or a generic List/Map.";
-          }
-        };
+    auto check_untyped_container = [&err](const AidlTypeSpecifier& type, const AidlNode* node) {
+      if (!CheckNoUntypedContainer(type, node)) {
+        err = AidlError::BAD_TYPE;
+      }
+    };
 
     if (type.AsInterface() && options.IsStructured()) {
       for (const auto& method : type.GetMethods()) {
@@ -694,6 +746,8 @@ AidlError load_and_validate_aidl(const std::string& input_file_name, const Optio
 
 bool compile_aidl(const Options& options, const IoDelegate& io_delegate) {
   const Options::Language lang = options.TargetLanguage();
+  // Generated C++ sources by type name, for --unity_shards
+  std::map<string, string> cpp_sources;
   for (const string& input_file : options.InputFiles()) {
     AidlTypenames typenames;
 
@@ -704,6 +758,9 @@ bool compile_aidl(const Options& options, const IoDelegate& io_delegate) {
     if (aidl_err != AidlError::OK) {
       return false;
     }
+    if (!typenames.Freeze()) {
+      return false;
+    }
 
     for (const auto& defined_type : typenames.MainDocument().DefinedTypes()) {
       AIDL_FATAL_IF(defined_type == nullptr, input_file);
@@ -717,6 +774,12 @@ bool compile_aidl(const Options& options, const IoDelegate& io_delegate) {
         }
       }
 
+      // Only the unity sources are written. Other invocations generate the sources they include.
+      if (options.UnityShards() > 0) {
+        cpp_sources.emplace(defined_type->GetCanonicalName(), output_file_name);
+        continue;
+      }
+
       if (!write_dep_file(options, *defined_type, imported_files, io_delegate, input_file,
                           output_file_name)) {
         return false;
@@ -751,6 +814,14 @@ bool compile_aidl(const Options& options, const IoDelegate& io_delegate) {
       }
     }
   }
+  if (options.UnityShards() > 0 &&
+      !cpp::GenerateUnitySources(options, cpp_sources, io_delegate)) {
+    return false;
+  }
+  // Without input files, the invocation is only for the shared parcel helper.
+  if (!options.SharedParcelHelper().empty() && options.InputFiles().empty()) {
+    return java::GenerateSharedParcelHelper(options, io_delegate);
+  }
   return true;
 }
 
@@ -781,7 +852,7 @@ bool dump_mappings(const Options& options, const IoDelegate& io_delegate) {
 
 int aidl_entry(const Options& options, const IoDelegate& io_delegate) {
   AidlErrorLog::clearError();
-  AidlNode::ClearUnvisitedNodes();
+  AidlVisitTracker visit_tracker;
 
   bool success = false;
   if (options.Ok()) {
@@ -798,12 +869,18 @@ int aidl_entry(const Options& options, const IoDelegate& io_delegate) {
       case Options::Task::DUMP_API:
         success = android::aidl::dump_api(options, io_delegate);
         break;
+      case Options::Task::HASH_API:
+        success = android::aidl::hash_api(options, io_delegate);
+        break;
       case Options::Task::CHECK_API:
         success = android::aidl::check_api(options, io_delegate);
         break;
       case Options::Task::DUMP_MAPPINGS:
         success = android::aidl::dump_mappings(options, io_delegate);
         break;
+      case Options::Task::EXPLICIT_INSTANTIATIONS:
+        success = android::aidl::cpp::GenerateExplicitInstantiations(options, io_delegate);
+        break;
       default:
         AIDL_FATAL(AIDL_LOCATION_HERE)
             << "Unrecognized task: " << static_cast<size_t>(options.GetTask());
@@ -818,7 +895,7 @@ int aidl_entry(const Options& options, const IoDelegate& io_delegate) {
       << " emit error logs";
 
   if (success) {
-    auto locations = AidlNode::GetLocationsOfUnvisitedNodes();
+    const auto& locations = visit_tracker.GetLocationsOfUnvisitedNodes();
     if (!locations.empty()) {
       for (const auto& location : locations) {
         AIDL_ERROR(location) << "AidlNode at location was not visited!";
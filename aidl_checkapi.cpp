@@ -16,8 +16,15 @@
 
 #include "aidl.h"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <map>
+#include <memory>
+#include <optional>
+#include <ostream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <android-base/result.h>
@@ -29,6 +36,7 @@
 #include "import_resolver.h"
 #include "logging.h"
 #include "options.h"
+#include "parser.h"
 
 namespace android {
 namespace aidl {
@@ -93,6 +101,8 @@ static vector<string> get_strict_annotations(const AidlAnnotatable& node) {
       // @RustDerive doesn't affect read/write
       AidlAnnotation::Type::RUST_DERIVE,
       AidlAnnotation::Type::SUPPRESS_WARNINGS,
+      // @Compact changes only how the C++ code is generated
+      AidlAnnotation::Type::COMPACT,
   };
   vector<string> annotations;
   for (const auto& annotation : node.GetAnnotations()) {
@@ -399,6 +409,68 @@ static bool are_compatible_enums(const AidlEnumDeclaration& older,
   return compatible;
 }
 
+namespace {
+
+// A part of check_api which runs on a worker thread. Its diagnostics, and the nodes it didn't
+// visit, are handed to the calling thread by Finish(), so that the output doesn't depend on
+// scheduling.
+class Job {
+ public:
+  explicit Job(std::function<void()> fn)
+      : fn_(std::move(fn)), track_visits_(AidlVisitTracker::Current() != nullptr) {}
+
+  Job(const Job&) = delete;
+  Job& operator=(const Job&) = delete;
+
+  void Run() {
+    ScopedDiagnosticSink scope(sink_);
+    std::optional<AidlVisitTracker> tracker;
+    if (track_visits_) tracker.emplace();
+    fn_();
+    if (tracker) {
+      for (const auto& location : tracker->GetLocationsOfUnvisitedNodes()) {
+        unvisited_.push_back(location);
+      }
+    }
+  }
+
+  // Called on the thread which created the job, after Run().
+  void Finish() {
+    sink_.ForwardTo(DiagnosticSink::Current());
+    if (auto tracker = AidlVisitTracker::Current(); tracker) {
+      tracker->AddLocationsOfUnvisitedNodes(unvisited_);
+    }
+  }
+
+ private:
+  std::function<void()> fn_;
+  const bool track_visits_;
+  // Every message is buffered until Finish(), so nothing is written here.
+  std::ostream discarded_{nullptr};
+  DiagnosticSink sink_{discarded_};
+  std::vector<AidlLocation> unvisited_;
+};
+
+// Runs the jobs on up to one thread per core.
+void RunJobs(const std::vector<std::unique_ptr<Job>>& jobs) {
+  const size_t num_threads =
+      std::min<size_t>(jobs.size(), std::max(1u, std::thread::hardware_concurrency()));
+  std::atomic<size_t> next = 0;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; i++) {
+    threads.emplace_back([&]() {
+      for (size_t job = next++; job < jobs.size(); job = next++) {
+        jobs[job]->Run();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace
+
 static Result<AidlTypenames> LoadApiDump(const Options& options, const IoDelegate& io_delegate,
                                          const std::string& dir) {
   Result<std::vector<std::string>> dir_files = io_delegate.ListFiles(dir);
@@ -407,9 +479,34 @@ static Result<AidlTypenames> LoadApiDump(const Options& options, const IoDelegat
     return Error();
   }
 
-  AidlTypenames typenames;
+  std::vector<std::string> files;
   for (const auto& file : *dir_files) {
-    if (!android::base::EndsWith(file, ".aidl")) continue;
+    if (android::base::EndsWith(file, ".aidl")) files.push_back(file);
+  }
+
+  // Parsing doesn't depend on the other files, so all files are parsed at the same time. The
+  // files import each other, so they are then loaded one by one into the same typenames, which
+  // reuses the parsed documents.
+  std::vector<std::unique_ptr<AidlDocument>> documents(files.size());
+  std::vector<std::unique_ptr<Job>> parse_jobs;
+  for (size_t i = 0; i < files.size(); i++) {
+    parse_jobs.push_back(std::make_unique<Job>([&, i]() {
+      documents[i] = Parser::ParseFile(files[i], io_delegate, /*is_preprocessed=*/false,
+                                       options.GetParserKind());
+    }));
+  }
+  RunJobs(parse_jobs);
+
+  AidlTypenames typenames;
+  for (size_t i = 0; i < files.size(); i++) {
+    parse_jobs[i]->Finish();
+    if (documents[i] == nullptr ||
+        Parser::AddDocument(std::move(documents[i]), typenames) == nullptr) {
+      AIDL_ERROR(files[i]) << "Failed to read.";
+      return Error();
+    }
+  }
+  for (const auto& file : files) {
     // current "dir" is added to "imports" so that referenced.aidl files in the current
     // module are available when resolving references.
     if (internals::load_and_validate_aidl(file, options.PlusImportDir(dir), io_delegate, &typenames,
@@ -422,20 +519,78 @@ static Result<AidlTypenames> LoadApiDump(const Options& options, const IoDelegat
   return typenames;
 }
 
+static bool are_compatible_defined_types(const AidlDefinedType& older,
+                                         const AidlTypenames& old_tns,
+                                         const AidlDefinedType& newer,
+                                         const AidlTypenames& new_tns,
+                                         Options::CheckApiLevel level) {
+  if (level == Options::CheckApiLevel::EQUAL) {
+    return CheckEquality(older, newer);
+  }
+
+  bool compatible = have_compatible_annotations(older, newer);
+  if (older.AsInterface() != nullptr) {
+    if (newer.AsInterface() == nullptr) {
+      AIDL_ERROR(newer) << "Type mismatch: " << older.GetCanonicalName() << " is changed from "
+                        << older.GetPreprocessDeclarationName() << " to "
+                        << newer.GetPreprocessDeclarationName();
+      return false;
+    }
+    compatible &= are_compatible_interfaces(*(older.AsInterface()), *(newer.AsInterface()));
+  } else if (older.AsStructuredParcelable() != nullptr) {
+    if (newer.AsStructuredParcelable() == nullptr) {
+      AIDL_ERROR(newer) << "Parcelable" << newer.GetCanonicalName() << " is not structured. ";
+      return false;
+    }
+    compatible &= are_compatible_parcelables(*(older.AsStructuredParcelable()), old_tns,
+                                             *(newer.AsStructuredParcelable()), new_tns);
+  } else if (older.AsUnionDeclaration() != nullptr) {
+    if (newer.AsUnionDeclaration() == nullptr) {
+      AIDL_ERROR(newer) << "Type mismatch: " << older.GetCanonicalName() << " is changed from "
+                        << older.GetPreprocessDeclarationName() << " to "
+                        << newer.GetPreprocessDeclarationName();
+      return false;
+    }
+    compatible &= are_compatible_parcelables(*(older.AsUnionDeclaration()), old_tns,
+                                             *(newer.AsUnionDeclaration()), new_tns);
+  } else if (older.AsEnumDeclaration() != nullptr) {
+    if (newer.AsEnumDeclaration() == nullptr) {
+      AIDL_ERROR(newer) << "Type mismatch: " << older.GetCanonicalName() << " is changed from "
+                        << older.GetPreprocessDeclarationName() << " to "
+                        << newer.GetPreprocessDeclarationName();
+      return false;
+    }
+    compatible &= are_compatible_enums(*(older.AsEnumDeclaration()), *(newer.AsEnumDeclaration()));
+  } else {
+    AIDL_ERROR(older) << "Unsupported type " << older.GetPreprocessDeclarationName() << " for "
+                      << older.GetCanonicalName();
+    return false;
+  }
+  return compatible;
+}
+
 bool check_api(const Options& options, const IoDelegate& io_delegate) {
   AIDL_FATAL_IF(!options.IsStructured(), AIDL_LOCATION_HERE);
   AIDL_FATAL_IF(options.InputFiles().size() != 2, AIDL_LOCATION_HERE)
       << "--checkapi requires two inputs "
       << "but got " << options.InputFiles().size();
-  auto old_tns = LoadApiDump(options, io_delegate, options.InputFiles().at(0));
-  if (!old_tns.ok()) {
+
+  // The two dumps don't share anything, so they are loaded at the same time.
+  std::optional<Result<AidlTypenames>> old_tns, new_tns;
+  std::vector<std::unique_ptr<Job>> load_jobs;
+  load_jobs.push_back(std::make_unique<Job>(
+      [&]() { old_tns = LoadApiDump(options, io_delegate, options.InputFiles().at(0)); }));
+  load_jobs.push_back(std::make_unique<Job>(
+      [&]() { new_tns = LoadApiDump(options, io_delegate, options.InputFiles().at(1)); }));
+  RunJobs(load_jobs);
+  load_jobs[0]->Finish();
+  if (!old_tns->ok()) {
     return false;
   }
-  auto new_tns = LoadApiDump(options, io_delegate, options.InputFiles().at(1));
-  if (!new_tns.ok()) {
+  load_jobs[1]->Finish();
+  if (!new_tns->ok()) {
     return false;
   }
-
   const Options::CheckApiLevel level = options.GetCheckApiLevel();
 
   // We don't check impoted types.
@@ -449,9 +604,13 @@ bool check_api(const Options& options, const IoDelegate& io_delegate) {
     return types;
   };
   std::vector<const AidlDefinedType*> old_types =
-      get_types_in(*old_tns, options.InputFiles().at(0));
+      get_types_in(**old_tns, options.InputFiles().at(0));
   std::vector<const AidlDefinedType*> new_types =
-      get_types_in(*new_tns, options.InputFiles().at(1));
+      get_types_in(**new_tns, options.InputFiles().at(1));
+  // The types are compared on several threads.
+  if (!(*old_tns)->Freeze(old_types) || !(*new_tns)->Freeze(new_types)) {
+    return false;
+  }
 
   bool compatible = true;
 
@@ -475,69 +634,27 @@ bool check_api(const Options& options, const IoDelegate& io_delegate) {
     new_map.emplace(t->GetCanonicalName(), t);
   }
 
-  for (const auto old_type : old_types) {
+  // Diagnostics are reported in the order of the old types, as if they were checked one by one.
+  std::vector<std::unique_ptr<Job>> jobs;
+  std::vector<char> results(old_types.size(), false);
+  for (size_t i = 0; i < old_types.size(); i++) {
+    const auto old_type = old_types[i];
     const auto found = new_map.find(old_type->GetCanonicalName());
     if (found == new_map.end()) {
-      AIDL_ERROR(old_type) << "Removed type: " << old_type->GetCanonicalName();
-      compatible = false;
+      jobs.push_back(std::make_unique<Job>([old_type]() {
+        AIDL_ERROR(old_type) << "Removed type: " << old_type->GetCanonicalName();
+      }));
       continue;
     }
     const auto new_type = found->second;
-
-    if (level == Options::CheckApiLevel::EQUAL) {
-      if (!CheckEquality(*old_type, *new_type)) {
-        compatible = false;
-      }
-      continue;
-    }
-
-    if (!have_compatible_annotations(*old_type, *new_type)) {
-      compatible = false;
-    }
-    if (old_type->AsInterface() != nullptr) {
-      if (new_type->AsInterface() == nullptr) {
-        AIDL_ERROR(new_type) << "Type mismatch: " << old_type->GetCanonicalName()
-                             << " is changed from " << old_type->GetPreprocessDeclarationName()
-                             << " to " << new_type->GetPreprocessDeclarationName();
-        compatible = false;
-        continue;
-      }
-      compatible &=
-          are_compatible_interfaces(*(old_type->AsInterface()), *(new_type->AsInterface()));
-    } else if (old_type->AsStructuredParcelable() != nullptr) {
-      if (new_type->AsStructuredParcelable() == nullptr) {
-        AIDL_ERROR(new_type) << "Parcelable" << new_type->GetCanonicalName()
-                             << " is not structured. ";
-        compatible = false;
-        continue;
-      }
-      compatible &= are_compatible_parcelables(*(old_type->AsStructuredParcelable()), *old_tns,
-                                               *(new_type->AsStructuredParcelable()), *new_tns);
-    } else if (old_type->AsUnionDeclaration() != nullptr) {
-      if (new_type->AsUnionDeclaration() == nullptr) {
-        AIDL_ERROR(new_type) << "Type mismatch: " << old_type->GetCanonicalName()
-                             << " is changed from " << old_type->GetPreprocessDeclarationName()
-                             << " to " << new_type->GetPreprocessDeclarationName();
-        compatible = false;
-        continue;
-      }
-      compatible &= are_compatible_parcelables(*(old_type->AsUnionDeclaration()), *old_tns,
-                                               *(new_type->AsUnionDeclaration()), *new_tns);
-    } else if (old_type->AsEnumDeclaration() != nullptr) {
-      if (new_type->AsEnumDeclaration() == nullptr) {
-        AIDL_ERROR(new_type) << "Type mismatch: " << old_type->GetCanonicalName()
-                             << " is changed from " << old_type->GetPreprocessDeclarationName()
-                             << " to " << new_type->GetPreprocessDeclarationName();
-        compatible = false;
-        continue;
-      }
-      compatible &=
-          are_compatible_enums(*(old_type->AsEnumDeclaration()), *(new_type->AsEnumDeclaration()));
-    } else {
-      AIDL_ERROR(old_type) << "Unsupported type " << old_type->GetPreprocessDeclarationName()
-                           << " for " << old_type->GetCanonicalName();
-      compatible = false;
-    }
+    jobs.push_back(std::make_unique<Job>([&, old_type, new_type, i]() {
+      results[i] = are_compatible_defined_types(*old_type, **old_tns, *new_type, **new_tns, level);
+    }));
+  }
+  RunJobs(jobs);
+  for (size_t i = 0; i < jobs.size(); i++) {
+    jobs[i]->Finish();
+    compatible &= static_cast<bool>(results[i]);
   }
 
   return compatible;
@@ -23,6 +23,7 @@
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <sstream>
 
 #include <android-base/parsedouble.h>
 #include <android-base/parseint.h>
@@ -553,6 +554,7 @@ string AidlConstantValue::ValueString(const AidlTypeSpecifier& type,
     return "";
   }
   if (!is_evaluated_) {
+    AIDL_FATAL_IF(IsFrozen(), this) << "Constant value is not evaluated: " << value_;
     // TODO(b/142722772) CheckValid() should be called before ValueString()
     bool success = CheckValid();
     success &= evaluate();
@@ -850,6 +852,7 @@ AidlConstantReference::AidlConstantReference(const AidlLocation& location, const
 
 const AidlConstantValue* AidlConstantReference::Resolve(const AidlDefinedType* scope) const {
   if (resolved_) return resolved_;
+  AIDL_FATAL_IF(IsFrozen(), this) << "A frozen reference is not resolved: " << value_;
 
   const AidlDefinedType* defined_type;
   if (ref_type_) {
@@ -21,6 +21,7 @@
 #include "aidl.h"
 #include "logging.h"
 #include "os.h"
+#include "sha1.h"
 
 using android::base::EndsWith;
 using android::base::Join;
@@ -248,12 +249,10 @@ void DumpVisitor::Visit(const AidlUnaryConstExpression& u) {
   out << ")";
 }
 
-static string GetApiDumpPathFor(const AidlDefinedType& defined_type, const Options& options) {
+// Returns the path of the dump of |defined_type| relative to the output directory.
+static string GetApiDumpPathFor(const AidlDefinedType& defined_type) {
   string package_as_path = Join(Split(defined_type.GetPackage(), "."), OS_PATH_SEPARATOR);
-  AIDL_FATAL_IF(options.OutputDir().empty() || options.OutputDir().back() != OS_PATH_SEPARATOR,
-                defined_type);
-  return options.OutputDir() + package_as_path + OS_PATH_SEPARATOR + defined_type.GetName() +
-         ".aidl";
+  return package_as_path + OS_PATH_SEPARATOR + defined_type.GetName() + ".aidl";
 }
 
 static void DumpComments(CodeWriter& out, const Comments& comments) {
@@ -267,6 +266,20 @@ static void DumpComments(CodeWriter& out, const Comments& comments) {
   }
 }
 
+static void DumpApiFile(CodeWriter& writer, const AidlDocument& doc, const AidlDefinedType& type,
+                        const Options& options) {
+  if (!options.DumpNoLicense()) {
+    // dump doc comments (license) as well for each type
+    DumpComments(writer, doc.GetComments());
+  }
+  writer << kPreamble;
+  if (!type.GetPackage().empty()) {
+    writer << "package " << type.GetPackage() << ";\n";
+  }
+  DumpVisitor visitor(writer, /*inline_constants=*/false);
+  type.DispatchVisit(visitor);
+}
+
 bool dump_api(const Options& options, const IoDelegate& io_delegate) {
   for (const auto& file : options.InputFiles()) {
     AidlTypenames typenames;
@@ -275,18 +288,11 @@ bool dump_api(const Options& options, const IoDelegate& io_delegate) {
       const auto& doc = typenames.MainDocument();
 
       for (const auto& type : doc.DefinedTypes()) {
+        AIDL_FATAL_IF(
+            options.OutputDir().empty() || options.OutputDir().back() != OS_PATH_SEPARATOR, *type);
         unique_ptr<CodeWriter> writer =
-            io_delegate.GetCodeWriter(GetApiDumpPathFor(*type, options));
-        if (!options.DumpNoLicense()) {
-          // dump doc comments (license) as well for each type
-          DumpComments(*writer, doc.GetComments());
-        }
-        (*writer) << kPreamble;
-        if (!type->GetPackage().empty()) {
-          (*writer) << "package " << type->GetPackage() << ";\n";
-        }
-        DumpVisitor visitor(*writer, /*inline_constants=*/false);
-        type->DispatchVisit(visitor);
+            io_delegate.GetCodeWriter(options.OutputDir() + GetApiDumpPathFor(*type));
+        DumpApiFile(*writer, doc, *type, options);
       }
     } else {
       return false;
@@ -295,5 +301,61 @@ bool dump_api(const Options& options, const IoDelegate& io_delegate) {
   return true;
 }
 
+std::map<string, string> DumpApiFiles(const AidlTypenames& typenames, const Options& options) {
+  std::map<string, string> files;
+  const auto& doc = typenames.MainDocument();
+  for (const auto& type : doc.DefinedTypes()) {
+    string& contents = files[GetApiDumpPathFor(*type)];
+    unique_ptr<CodeWriter> writer = CodeWriter::ForString(&contents);
+    DumpApiFile(*writer, doc, *type, options);
+    writer->Close();
+  }
+  return files;
+}
+
+std::string HashApiFiles(const std::map<string, string>& files, const string& version) {
+  // (cd $DIR && find ./ -name "*.aidl" -print0 | LC_ALL=C sort -z | xargs -0 sha1sum &&
+  //  echo $VERSION) | sha1sum
+  // The map is ordered by bytes like LC_ALL=C. Without files, xargs runs sha1sum on empty stdin.
+  string sums;
+  for (const auto& [path, contents] : files) {
+    sums += Sha1Hex(contents) + "  ./" + path + "\n";
+  }
+  if (files.empty()) {
+    sums = Sha1Hex("") + "  -\n";
+  }
+  return Sha1Hex(sums + version + "\n");
+}
+
+bool hash_api(const Options& options, const IoDelegate& io_delegate) {
+  std::map<string, string> files;
+  for (const auto& file : options.InputFiles()) {
+    AidlTypenames typenames;
+    if (internals::load_and_validate_aidl(file, options, io_delegate, &typenames, nullptr) !=
+        AidlError::OK) {
+      return false;
+    }
+    const auto& doc = typenames.MainDocument();
+    if (options.HashFrozenApi()) {
+      // Dumping it again would add another preamble, and older versions were frozen with a
+      // different one. Its bytes are what build/hash_gen.sh hashed.
+      if (doc.DefinedTypes().size() != 1) {
+        AIDL_ERROR(doc) << "A file of a frozen API dump must declare exactly one type.";
+        return false;
+      }
+      unique_ptr<string> contents = io_delegate.GetFileContents(file);
+      if (contents == nullptr) {
+        return false;
+      }
+      files[GetApiDumpPathFor(*doc.DefinedTypes()[0])] = std::move(*contents);
+    } else {
+      files.merge(DumpApiFiles(typenames, options));
+    }
+  }
+  unique_ptr<CodeWriter> writer = io_delegate.GetCodeWriter(options.OutputFile());
+  *writer << HashApiFiles(files, options.HashApiVersion()) << "\n";
+  return writer->Close();
+}
+
 }  // namespace aidl
 }  // namespace android
@@ -17,6 +17,9 @@
 #include "aidl_language.h"
 #include "code_writer.h"
 
+#include <map>
+#include <string>
+
 namespace android {
 namespace aidl {
 
@@ -49,5 +52,20 @@ struct DumpVisitor : AidlVisitor {
 
 bool dump_api(const Options& options, const IoDelegate& io_delegate);
 
+// Returns the files which dump_api writes for the types of the main document of |typenames|,
+// which must be validated, keyed by their paths relative to the output directory.
+std::map<std::string, std::string> DumpApiFiles(const AidlTypenames& typenames,
+                                                const Options& options);
+
+// Returns the hash which build/hash_gen.sh computes for a directory holding |files|, keyed by their
+// relative paths, and |version|. It's the same for a frozen version as long as its dump is.
+std::string HashApiFiles(const std::map<std::string, std::string>& files,
+                         const std::string& version);
+
+// Writes the hash of the API dump of the input files to the output file, without writing the
+// dump itself. With --frozen, the input files are the dumps of a frozen version and are hashed as
+// they are, so the hash of a frozen version is the one in its .hash file.
+bool hash_api(const Options& options, const IoDelegate& io_delegate);
+
 }  // namespace aidl
 }  // namespace android
@@ -23,10 +23,12 @@
 #include <string.h>
 
 #include <algorithm>
+#include <array>
 #include <iostream>
 #include <set>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 #include <android-base/parsedouble.h>
@@ -75,22 +77,44 @@ bool IsJavaKeyword(const char* str) {
 }
 }  // namespace
 
-AidlNode::~AidlNode() {
-  if (!visited_) {
-    unvisited_locations_.push_back(location_);
-  }
+namespace {
+thread_local AidlVisitTracker* current_visit_tracker = nullptr;
+}  // namespace
+
+AidlVisitTracker::AidlVisitTracker() : previous_(current_visit_tracker) {
+  current_visit_tracker = this;
 }
 
-void AidlNode::ClearUnvisitedNodes() {
-  unvisited_locations_.clear();
+AidlVisitTracker::~AidlVisitTracker() {
+  current_visit_tracker = previous_;
 }
 
-const std::vector<AidlLocation>& AidlNode::GetLocationsOfUnvisitedNodes() {
-  return unvisited_locations_;
+AidlVisitTracker* AidlVisitTracker::Current() {
+  return current_visit_tracker;
+}
+
+AidlVisitTracker::Suspend::Suspend() : suspended_(current_visit_tracker) {
+  current_visit_tracker = nullptr;
+}
+
+AidlVisitTracker::Suspend::~Suspend() {
+  current_visit_tracker = suspended_;
+}
+
+AidlNode::~AidlNode() {
+  if (!visited_) {
+    if (auto tracker = AidlVisitTracker::Current(); tracker) {
+      tracker->unvisited_.push_back(location_);
+    }
+  }
 }
 
 void AidlNode::MarkVisited() const {
-  visited_ = true;
+  // Leaves the node untouched otherwise so that ASTs can be shared across threads.
+  if (AidlVisitTracker::Current() && !visited_) {
+    AIDL_FATAL_IF(frozen_, this) << "A frozen node is marked visited for the first time.";
+    visited_ = true;
+  }
 }
 
 AidlNode::AidlNode(const AidlLocation& location, const Comments& comments)
@@ -109,8 +133,6 @@ std::string AidlNode::PrintLocation() const {
   return ss.str();
 }
 
-std::vector<AidlLocation> AidlNode::unvisited_locations_;
-
 static const AidlTypeSpecifier kStringType{AIDL_LOCATION_HERE, "String", /*array=*/std::nullopt,
                                            nullptr, Comments{}};
 static const AidlTypeSpecifier kStringArrayType{AIDL_LOCATION_HERE, "String", DynamicArray{},
@@ -209,15 +231,39 @@ const std::vector<AidlAnnotation::Schema>& AidlAnnotation::AllSchemas() {
        "PropagateAllowBlocking",
        CONTEXT_METHOD,
        {}},
+      {AidlAnnotation::Type::COMPACT, "Compact", CONTEXT_TYPE_INTERFACE | CONTEXT_METHOD, {}},
   };
   return kSchemas;
 }
 
+const AidlAnnotation::Schema* AidlAnnotation::FindSchema(const std::string& name) {
+  static const auto kSchemasByName = [] {
+    std::unordered_map<std::string, const Schema*> schemas;
+    for (const Schema& schema : AllSchemas()) {
+      schemas.emplace(schema.name, &schema);
+    }
+    return schemas;
+  }();
+  auto it = kSchemasByName.find(name);
+  return it != kSchemasByName.end() ? it->second : nullptr;
+}
+
 std::string AidlAnnotation::TypeToString(Type type) {
-  for (const Schema& schema : AllSchemas()) {
-    if (type == schema.type) return schema.name;
+  static const auto kSchemasByType = [] {
+    std::array<const Schema*, kTypeCount> schemas{};
+    for (const Schema& schema : AllSchemas()) {
+      const size_t index = static_cast<size_t>(schema.type);
+      AIDL_FATAL_IF(index >= kTypeCount, AIDL_LOCATION_HERE)
+          << "kTypeCount is out of date for " << schema.name;
+      schemas[index] = &schema;
+    }
+    return schemas;
+  }();
+  const size_t index = static_cast<size_t>(type);
+  if (index < kTypeCount && kSchemasByType[index] != nullptr) {
+    return kSchemasByType[index]->name;
   }
-  AIDL_FATAL(AIDL_LOCATION_HERE) << "Unrecognized type: " << static_cast<size_t>(type);
+  AIDL_FATAL(AIDL_LOCATION_HERE) << "Unrecognized type: " << index;
   __builtin_unreachable();
 }
 
@@ -225,13 +271,7 @@ std::unique_ptr<AidlAnnotation> AidlAnnotation::Parse(
     const AidlLocation& location, const string& name,
     std::map<std::string, std::shared_ptr<AidlConstantValue>> parameter_list,
     const Comments& comments) {
-  const Schema* schema = nullptr;
-  for (const Schema& a_schema : AllSchemas()) {
-    if (a_schema.name == name) {
-      schema = &a_schema;
-    }
-  }
-
+  const Schema* schema = FindSchema(name);
   if (schema == nullptr) {
     std::ostringstream stream;
     stream << "'" << name << "' is not a recognized annotation. ";
@@ -253,6 +293,11 @@ AidlAnnotation::AidlAnnotation(const AidlLocation& location, const Schema& schem
                                const Comments& comments)
     : AidlNode(location, comments), schema_(schema), parameters_(std::move(parameters)) {}
 
+std::unique_ptr<AidlAnnotation> AidlAnnotation::Clone() const {
+  return std::unique_ptr<AidlAnnotation>(
+      new AidlAnnotation(GetLocation(), schema_, parameters_, GetComments()));
+}
+
 struct ConstReferenceFinder : AidlVisitor {
   const AidlConstantReference* found = nullptr;
   void Visit(const AidlConstantReference& ref) override {
@@ -399,16 +444,18 @@ std::string AidlAnnotation::ToString() const {
   }
 }
 
-void AidlAnnotation::TraverseChildren(std::function<void(const AidlNode&)> traverse) const {
+void AidlAnnotation::TraverseChildren(AidlNodeCallback traverse) const {
   for (const auto& [name, value] : parameters_) {
     (void)name;
     traverse(*value);
   }
 }
 
-static const AidlAnnotation* GetAnnotation(
-    const vector<std::unique_ptr<AidlAnnotation>>& annotations, AidlAnnotation::Type type) {
-  for (const auto& a : annotations) {
+const AidlAnnotation* AidlAnnotatable::GetAnnotation(AidlAnnotation::Type type) const {
+  if (!HasAnnotation(type)) {
+    return nullptr;
+  }
+  for (const auto& a : annotations_) {
     if (a->GetType() == type) {
       AIDL_FATAL_IF(a->Repeatable(), a)
           << "Trying to get a single annotation when it is repeatable.";
@@ -420,7 +467,7 @@ static const AidlAnnotation* GetAnnotation(
 
 static const AidlAnnotation* GetScopedAnnotation(const AidlDefinedType& defined_type,
                                                  AidlAnnotation::Type type) {
-  const AidlAnnotation* annotation = GetAnnotation(defined_type.GetAnnotations(), type);
+  const AidlAnnotation* annotation = defined_type.GetAnnotation(type);
   if (annotation) {
     return annotation;
   }
@@ -435,11 +482,11 @@ AidlAnnotatable::AidlAnnotatable(const AidlLocation& location, const Comments& c
     : AidlCommentable(location, comments) {}
 
 bool AidlAnnotatable::IsNullable() const {
-  return GetAnnotation(annotations_, AidlAnnotation::Type::NULLABLE);
+  return GetAnnotation(AidlAnnotation::Type::NULLABLE);
 }
 
 bool AidlAnnotatable::IsHeapNullable() const {
-  auto annot = GetAnnotation(annotations_, AidlAnnotation::Type::NULLABLE);
+  auto annot = GetAnnotation(AidlAnnotation::Type::NULLABLE);
   if (annot) {
     return annot->ParamValue<bool>("heap").value_or(false);
   }
@@ -447,11 +494,11 @@ bool AidlAnnotatable::IsHeapNullable() const {
 }
 
 bool AidlAnnotatable::IsUtf8InCpp() const {
-  return GetAnnotation(annotations_, AidlAnnotation::Type::UTF8_IN_CPP);
+  return GetAnnotation(AidlAnnotation::Type::UTF8_IN_CPP);
 }
 
 bool AidlAnnotatable::IsSensitiveData() const {
-  return GetAnnotation(annotations_, AidlAnnotation::Type::SENSITIVE_DATA);
+  return GetAnnotation(AidlAnnotation::Type::SENSITIVE_DATA);
 }
 
 bool AidlAnnotatable::IsVintfStability() const {
@@ -461,20 +508,20 @@ bool AidlAnnotatable::IsVintfStability() const {
 }
 
 bool AidlAnnotatable::IsJavaOnlyImmutable() const {
-  return GetAnnotation(annotations_, AidlAnnotation::Type::JAVA_ONLY_IMMUTABLE);
+  return GetAnnotation(AidlAnnotation::Type::JAVA_ONLY_IMMUTABLE);
 }
 
 bool AidlAnnotatable::IsFixedSize() const {
-  return GetAnnotation(annotations_, AidlAnnotation::Type::FIXED_SIZE);
+  return GetAnnotation(AidlAnnotation::Type::FIXED_SIZE);
 }
 
 const AidlAnnotation* AidlAnnotatable::UnsupportedAppUsage() const {
-  return GetAnnotation(annotations_, AidlAnnotation::Type::UNSUPPORTED_APP_USAGE);
+  return GetAnnotation(AidlAnnotation::Type::UNSUPPORTED_APP_USAGE);
 }
 
 std::vector<std::string> AidlAnnotatable::RustDerive() const {
   std::vector<std::string> ret;
-  if (const auto* ann = GetAnnotation(annotations_, AidlAnnotation::Type::RUST_DERIVE)) {
+  if (const auto* ann = GetAnnotation(AidlAnnotation::Type::RUST_DERIVE)) {
     for (const auto& name_and_param : ann->AnnotationParams(AidlConstantValueDecorator)) {
       if (name_and_param.second == "true") {
         ret.push_back(name_and_param.first);
@@ -485,11 +532,11 @@ std::vector<std::string> AidlAnnotatable::RustDerive() const {
 }
 
 const AidlAnnotation* AidlAnnotatable::BackingType() const {
-  return GetAnnotation(annotations_, AidlAnnotation::Type::BACKING);
+  return GetAnnotation(AidlAnnotation::Type::BACKING);
 }
 
 std::vector<std::string> AidlAnnotatable::SuppressWarnings() const {
-  auto annot = GetAnnotation(annotations_, AidlAnnotation::Type::SUPPRESS_WARNINGS);
+  auto annot = GetAnnotation(AidlAnnotation::Type::SUPPRESS_WARNINGS);
   if (annot) {
     auto names = annot->ParamValue<std::vector<std::string>>("value");
     AIDL_FATAL_IF(!names.has_value(), this);
@@ -500,7 +547,7 @@ std::vector<std::string> AidlAnnotatable::SuppressWarnings() const {
 
 // Parses the @Enforce annotation expression.
 std::unique_ptr<android::aidl::perm::Expression> AidlAnnotatable::EnforceExpression() const {
-  auto annot = GetAnnotation(annotations_, AidlAnnotation::Type::PERMISSION_ENFORCE);
+  auto annot = GetAnnotation(AidlAnnotation::Type::PERMISSION_ENFORCE);
   if (annot) {
     auto perm_expr = annot->EnforceExpression();
     if (!perm_expr.ok()) {
@@ -513,11 +560,11 @@ std::unique_ptr<android::aidl::perm::Expression> AidlAnnotatable::EnforceExpress
 }
 
 bool AidlAnnotatable::IsPermissionManual() const {
-  return GetAnnotation(annotations_, AidlAnnotation::Type::PERMISSION_MANUAL);
+  return GetAnnotation(AidlAnnotation::Type::PERMISSION_MANUAL);
 }
 
 bool AidlAnnotatable::IsPermissionNone() const {
-  return GetAnnotation(annotations_, AidlAnnotation::Type::PERMISSION_NONE);
+  return GetAnnotation(AidlAnnotation::Type::PERMISSION_NONE);
 }
 
 bool AidlAnnotatable::IsPermissionAnnotated() const {
@@ -525,19 +572,23 @@ bool AidlAnnotatable::IsPermissionAnnotated() const {
 }
 
 bool AidlAnnotatable::IsPropagateAllowBlocking() const {
-  return GetAnnotation(annotations_, AidlAnnotation::Type::PROPAGATE_ALLOW_BLOCKING);
+  return GetAnnotation(AidlAnnotation::Type::PROPAGATE_ALLOW_BLOCKING);
+}
+
+bool AidlAnnotatable::IsCompact() const {
+  return GetAnnotation(AidlAnnotation::Type::COMPACT);
 }
 
 bool AidlAnnotatable::IsStableApiParcelable(Options::Language lang) const {
   if (lang == Options::Language::JAVA)
-    return GetAnnotation(annotations_, AidlAnnotation::Type::JAVA_STABLE_PARCELABLE);
+    return GetAnnotation(AidlAnnotation::Type::JAVA_STABLE_PARCELABLE);
   if (lang == Options::Language::NDK)
-    return GetAnnotation(annotations_, AidlAnnotation::Type::NDK_STABLE_PARCELABLE);
+    return GetAnnotation(AidlAnnotation::Type::NDK_STABLE_PARCELABLE);
   return false;
 }
 
 bool AidlAnnotatable::JavaDerive(const std::string& method) const {
-  auto annotation = GetAnnotation(annotations_, AidlAnnotation::Type::JAVA_DERIVE);
+  auto annotation = GetAnnotation(AidlAnnotation::Type::JAVA_DERIVE);
   if (annotation != nullptr) {
     return annotation->ParamValue<bool>(method).value_or(false);
   }
@@ -545,15 +596,15 @@ bool AidlAnnotatable::JavaDerive(const std::string& method) const {
 }
 
 bool AidlAnnotatable::IsJavaDefault() const {
-  return GetAnnotation(annotations_, AidlAnnotation::Type::JAVA_DEFAULT);
+  return GetAnnotation(AidlAnnotation::Type::JAVA_DEFAULT);
 }
 
 bool AidlAnnotatable::IsJavaDelegator() const {
-  return GetAnnotation(annotations_, AidlAnnotation::Type::JAVA_DELEGATOR);
+  return GetAnnotation(AidlAnnotation::Type::JAVA_DELEGATOR);
 }
 
 std::string AidlAnnotatable::GetDescriptor() const {
-  auto annotation = GetAnnotation(annotations_, AidlAnnotation::Type::DESCRIPTOR);
+  auto annotation = GetAnnotation(AidlAnnotation::Type::DESCRIPTOR);
   if (annotation != nullptr) {
     return annotation->ParamValue<std::string>("value").value();
   }
@@ -605,6 +656,12 @@ void AidlTypeSpecifier::ViewAsArrayBase(std::function<void(const AidlTypeSpecifi
   // Declaring array of generic type cannot happen, it is grammar error.
   AIDL_FATAL_IF(IsGeneric(), this);
 
+  if (array_base_) {
+    func(*array_base_);
+    return;
+  }
+  AIDL_FATAL_IF(IsFrozen(), this) << "A frozen array type has no base type.";
+
   bool is_mutated = mutated_;
   mutated_ = true;
   // mutate the array type to its base by removing a single dimension
@@ -624,6 +681,40 @@ void AidlTypeSpecifier::ViewAsArrayBase(std::function<void(const AidlTypeSpecifi
   mutated_ = is_mutated;
 }
 
+// Returns a copy of this type with one-less dimension, as ViewAsArrayBase() does by mutation.
+std::unique_ptr<AidlTypeSpecifier> AidlTypeSpecifier::MakeArrayBase() const {
+  std::optional<ArrayType> array;
+  if (IsFixedSizeArray() && std::get<FixedSizeArray>(*array_).dimensions.size() > 1) {
+    const auto& dimensions = std::get<FixedSizeArray>(*array_).dimensions;
+    FixedSizeArray base_array(dimensions[1]);
+    base_array.dimensions.insert(base_array.dimensions.end(), dimensions.begin() + 2,
+                                 dimensions.end());
+    array = std::move(base_array);
+  }
+  auto base = std::make_unique<AidlTypeSpecifier>(GetLocation(), unresolved_name_,
+                                                  std::move(array), nullptr, GetComments());
+  vector<std::unique_ptr<AidlAnnotation>> annotations;
+  for (const auto& annotation : GetAnnotations()) {
+    annotations.push_back(annotation->Clone());
+  }
+  base->Annotate(std::move(annotations));
+  base->fully_qualified_name_ = fully_qualified_name_;
+  base->defined_type_ = defined_type_;
+  base->mutated_ = true;
+  return base;
+}
+
+void AidlTypeSpecifier::Freeze() const {
+  if (IsArray() && !IsGeneric() && !array_base_) {
+    array_base_ = MakeArrayBase();
+    ForEachNodeTopDown(*array_base_, [](const AidlNode& n) {
+      n.MarkVisited();
+      n.Freeze();
+    });
+  }
+  AidlNode::Freeze();
+}
+
 bool AidlTypeSpecifier::MakeArray(ArrayType array_type) {
   // T becomes T[] or T[N]
   if (!IsArray()) {
@@ -849,7 +940,7 @@ bool AidlTypeSpecifier::CheckValid(const AidlTypenames& typenames) const {
   return true;
 }
 
-void AidlTypeSpecifier::TraverseChildren(std::function<void(const AidlNode&)> traverse) const {
+void AidlTypeSpecifier::TraverseChildren(AidlNodeCallback traverse) const {
   AidlAnnotatable::TraverseChildren(traverse);
   if (IsGeneric()) {
     for (const auto& tp : GetTypeParameters()) {
@@ -950,8 +1041,7 @@ std::string AidlVariableDeclaration::ValueString(const ConstantValueDecorator& d
   }
 }
 
-void AidlVariableDeclaration::TraverseChildren(
-    std::function<void(const AidlNode&)> traverse) const {
+void AidlVariableDeclaration::TraverseChildren(AidlNodeCallback traverse) const {
   traverse(GetType());
   if (auto default_value = GetDefaultValue(); default_value) {
     traverse(*default_value);
@@ -1773,6 +1863,27 @@ bool AidlInterface::UsesPermissions() const {
   return false;
 }
 
+int AidlInterface::GetUserMethodIndex(const AidlMethod& method) const {
+  if (!method.IsUserDefined()) {
+    return -1;
+  }
+  int index = 0;
+  for (const auto& m : GetMethods()) {
+    if (m.get() == &method) {
+      return index;
+    }
+    if (m->IsUserDefined()) {
+      index++;
+    }
+  }
+  return -1;
+}
+
+int AidlInterface::CountUserMethods() const {
+  return std::count_if(GetMethods().begin(), GetMethods().end(),
+                       [](const auto& m) { return m->IsUserDefined(); });
+}
+
 std::string AidlInterface::GetDescriptor() const {
   std::string annotatedDescriptor = AidlAnnotatable::GetDescriptor();
   if (annotatedDescriptor != "") {
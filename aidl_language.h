@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include <bitset>
 #include <memory>
 #include <regex>
 #include <string>
+#include <type_traits>
 #include <unordered_set>
 #include <variant>
 #include <vector>
@@ -138,6 +140,28 @@ class AidlScope {
   const AidlScope* enclosing_ = nullptr;
 };
 
+class AidlNode;
+
+// Non-owning reference to a callable which takes an AidlNode, passed to TraverseChildren().
+// Unlike std::function, it never allocates and each call is a single indirect call, so that a
+// traversal doesn't pay for type erasure at every node. The callable must outlive it.
+class AidlNodeCallback {
+ public:
+  template <typename F,
+            typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, AidlNodeCallback>>>
+  AidlNodeCallback(F&& f)  // NOLINT(google-explicit-constructor)
+      : callable_(const_cast<void*>(static_cast<const void*>(&f))),
+        call_([](void* callable, const AidlNode& node) {
+          (*static_cast<std::remove_reference_t<F>*>(callable))(node);
+        }) {}
+
+  void operator()(const AidlNode& node) const { call_(callable_, node); }
+
+ private:
+  void* callable_;
+  void (*call_)(void*, const AidlNode&);
+};
+
 // Anything that is locatable in a .aidl file.
 class AidlNode {
  public:
@@ -156,26 +180,74 @@ class AidlNode {
   friend std::string android::aidl::java::dump_location(const AidlNode&);
 
   const AidlLocation& GetLocation() const { return location_; }
-  virtual void TraverseChildren(std::function<void(const AidlNode&)> traverse) const = 0;
+  virtual void TraverseChildren(AidlNodeCallback traverse) const = 0;
   virtual void DispatchVisit(AidlVisitor&) const = 0;
 
   const Comments& GetComments() const { return comments_; }
   void SetComments(const Comments& comments) { comments_ = comments; }
 
-  static void ClearUnvisitedNodes();
-  static const std::vector<AidlLocation>& GetLocationsOfUnvisitedNodes();
   void MarkVisited() const;
+  bool IsVisited() const { return visited_; }
   bool IsUserDefined() const { return !GetLocation().IsInternal(); }
 
+  // Computes lazily evaluated state and marks this node frozen. A frozen node is never modified
+  // again, so it can be read from multiple threads. See AidlTypenames::Freeze().
+  virtual void Freeze() const { frozen_ = true; }
+  bool IsFrozen() const { return frozen_; }
+
  private:
   std::string PrintLine() const;
   std::string PrintLocation() const;
   const AidlLocation location_;
   Comments comments_;
 
-  // make sure we are able to abort if types are not visited
+  // make sure we are able to abort if types are not visited. Only written while an
+  // AidlVisitTracker is active.
   mutable bool visited_ = false;
-  static std::vector<AidlLocation> unvisited_locations_;
+  mutable bool frozen_ = false;
+};
+
+// Collects the locations of nodes destroyed without being visited, so that a compilation can make
+// sure it processed the whole AST. Tracking is per thread: it is enabled for the current thread
+// while a tracker is alive, and nodes built or destroyed elsewhere cost nothing.
+class AidlVisitTracker {
+ public:
+  AidlVisitTracker();
+  ~AidlVisitTracker();
+
+  AidlVisitTracker(const AidlVisitTracker&) = delete;
+  AidlVisitTracker& operator=(const AidlVisitTracker&) = delete;
+
+  const std::vector<AidlLocation>& GetLocationsOfUnvisitedNodes() const { return unvisited_; }
+  // Adds locations collected by a tracker on another thread which worked for the same compilation.
+  void AddLocationsOfUnvisitedNodes(const std::vector<AidlLocation>& locations) {
+    for (const auto& location : locations) {
+      unvisited_.push_back(location);
+    }
+  }
+
+  // The tracker of the current thread, or nullptr.
+  static AidlVisitTracker* Current();
+
+  // Disables tracking on the current thread while alive, e.g. to release nodes which aren't
+  // expected to be visited.
+  class Suspend {
+   public:
+    Suspend();
+    ~Suspend();
+
+    Suspend(const Suspend&) = delete;
+    Suspend& operator=(const Suspend&) = delete;
+
+   private:
+    AidlVisitTracker* suspended_;
+  };
+
+ private:
+  friend class AidlNode;
+
+  AidlVisitTracker* previous_;
+  std::vector<AidlLocation> unvisited_;
 };
 
 // unique_ptr<AidlTypeSpecifier> for type arugment,
@@ -246,7 +318,10 @@ class AidlAnnotation : public AidlNode {
     PERMISSION_NONE,
     PERMISSION_MANUAL,
     PROPAGATE_ALLOW_BLOCKING,
+    COMPACT,
   };
+  // Upper bound of Type values. Update when adding a new Type.
+  static constexpr size_t kTypeCount = static_cast<size_t>(Type::COMPACT) + 1;
 
   using TargetContext = uint16_t;
   static constexpr TargetContext CONTEXT_TYPE_INTERFACE = 0x1 << 0;
@@ -289,11 +364,17 @@ class AidlAnnotation : public AidlNode {
 
   std::map<std::string, std::string> AnnotationParams(
       const ConstantValueDecorator& decorator) const;
-  void TraverseChildren(std::function<void(const AidlNode&)> traverse) const override;
+  const std::map<std::string, std::shared_ptr<AidlConstantValue>>& GetParameters() const {
+    return parameters_;
+  }
+  void TraverseChildren(AidlNodeCallback traverse) const override;
   void DispatchVisit(AidlVisitor& v) const override { v.Visit(*this); }
 
   Result<unique_ptr<android::aidl::perm::Expression>> EnforceExpression() const;
 
+  // Returns a copy sharing the parameter values with this.
+  std::unique_ptr<AidlAnnotation> Clone() const;
+
  private:
   struct ParamType {
     std::string name;
@@ -319,6 +400,8 @@ class AidlAnnotation : public AidlNode {
   };
 
   static const std::vector<Schema>& AllSchemas();
+  // Returns the schema of the annotation named `name`, or nullptr if there is none.
+  static const Schema* FindSchema(const std::string& name);
 
   AidlAnnotation(const AidlLocation& location, const Schema& schema,
                  std::map<std::string, std::shared_ptr<AidlConstantValue>> parameters,
@@ -343,9 +426,13 @@ class AidlAnnotatable : public AidlCommentable {
 
   void Annotate(vector<std::unique_ptr<AidlAnnotation>>&& annotations) {
     for (auto& annotation : annotations) {
+      annotation_types_.set(static_cast<size_t>(annotation->GetType()));
       annotations_.emplace_back(std::move(annotation));
     }
   }
+  bool HasAnnotation(AidlAnnotation::Type type) const {
+    return annotation_types_.test(static_cast<size_t>(type));
+  }
   bool IsNullable() const;
   bool IsHeapNullable() const;
   bool IsUtf8InCpp() const;
@@ -368,6 +455,7 @@ class AidlAnnotatable : public AidlCommentable {
   bool IsPermissionNone() const;
   bool IsPermissionAnnotated() const;
   bool IsPropagateAllowBlocking() const;
+  bool IsCompact() const;
 
   // ToString is for dumping AIDL.
   // Returns string representation of annotations.
@@ -375,8 +463,10 @@ class AidlAnnotatable : public AidlCommentable {
   std::string ToString() const;
 
   const vector<std::unique_ptr<AidlAnnotation>>& GetAnnotations() const { return annotations_; }
+  // Returns the annotation of the given type, or nullptr if it is not present.
+  const AidlAnnotation* GetAnnotation(AidlAnnotation::Type type) const;
   bool CheckValid(const AidlTypenames&) const;
-  void TraverseChildren(std::function<void(const AidlNode&)> traverse) const override {
+  void TraverseChildren(AidlNodeCallback traverse) const override {
     for (const auto& annot : GetAnnotations()) {
       traverse(*annot);
     }
@@ -384,14 +474,18 @@ class AidlAnnotatable : public AidlCommentable {
 
  private:
   vector<std::unique_ptr<AidlAnnotation>> annotations_;
+  // Types present in annotations_. Most queries are for absent annotations and are answered
+  // without looking at annotations_.
+  std::bitset<AidlAnnotation::kTypeCount> annotation_types_;
 };
 
 // Represents `[]`
 struct DynamicArray {};
 // Represents `[N][M]..`
 struct FixedSizeArray {
-  FixedSizeArray(std::unique_ptr<AidlConstantValue> dim) { dimensions.push_back(std::move(dim)); }
-  std::vector<std::unique_ptr<AidlConstantValue>> dimensions;
+  FixedSizeArray(std::shared_ptr<AidlConstantValue> dim) { dimensions.push_back(std::move(dim)); }
+  // Shared with the array base types of frozen type specifiers.
+  std::vector<std::shared_ptr<AidlConstantValue>> dimensions;
   std::vector<int32_t> GetDimensionInts() const;
 };
 // Represents `[]` or `[N]` part of type specifier
@@ -473,10 +567,13 @@ class AidlTypeSpecifier final : public AidlAnnotatable,
   const AidlNode& AsAidlNode() const override { return *this; }
 
   const AidlDefinedType* GetDefinedType() const;
-  void TraverseChildren(std::function<void(const AidlNode&)> traverse) const override;
+  void TraverseChildren(AidlNodeCallback traverse) const override;
   void DispatchVisit(AidlVisitor& v) const override { v.Visit(*this); }
+  void Freeze() const override;
 
  private:
+  std::unique_ptr<AidlTypeSpecifier> MakeArrayBase() const;
+
   const string unresolved_name_;
   string fully_qualified_name_;
   mutable std::optional<ArrayType> array_;
@@ -484,6 +581,8 @@ class AidlTypeSpecifier final : public AidlAnnotatable,
                                   // from the original type
   vector<string> split_name_;
   const AidlDefinedType* defined_type_ = nullptr;  // set when Resolve() for defined types
+  // Set by Freeze() for arrays. ViewAsArrayBase() passes this instead of mutating array_.
+  mutable std::unique_ptr<AidlTypeSpecifier> array_base_;
 };
 
 // Returns the universal value unaltered.
@@ -548,7 +647,7 @@ class AidlVariableDeclaration : public AidlMember {
 
   std::string ValueString(const ConstantValueDecorator& decorator) const;
 
-  void TraverseChildren(std::function<void(const AidlNode&)> traverse) const override;
+  void TraverseChildren(AidlNodeCallback traverse) const override;
   void DispatchVisit(AidlVisitor& v) const override { v.Visit(*this); }
 
  private:
@@ -624,6 +723,8 @@ class AidlConstantValue : public AidlNode {
   // Returns the evaluated value. T> should match to the actual type.
   template <typename T>
   T EvaluatedValue() const {
+    AIDL_FATAL_IF(IsFrozen() && !is_evaluated_, this)
+        << "Constant value is not evaluated: " << value_;
     is_evaluated_ || (CheckValid() && evaluate());
     AIDL_FATAL_IF(!is_valid_, this);
 
@@ -688,7 +789,7 @@ class AidlConstantValue : public AidlNode {
   // Raw value of type (currently valid in C++ and Java). Empty string on error.
   string ValueString(const AidlTypeSpecifier& type, const ConstantValueDecorator& decorator) const;
 
-  void TraverseChildren(std::function<void(const AidlNode&)> traverse) const override {
+  void TraverseChildren(AidlNodeCallback traverse) const override {
     if (type_ == Type::ARRAY) {
       for (const auto& v : values_) {
         traverse(*v);
@@ -740,13 +841,14 @@ class AidlConstantReference : public AidlConstantValue {
   const std::string& GetFieldName() const { return field_name_; }
 
   bool CheckValid() const override;
-  void TraverseChildren(std::function<void(const AidlNode&)> traverse) const override {
+  void TraverseChildren(AidlNodeCallback traverse) const override {
     if (ref_type_) {
       traverse(*ref_type_);
     }
   }
   void DispatchVisit(AidlVisitor& v) const override { v.Visit(*this); }
   const AidlConstantValue* Resolve(const AidlDefinedType* scope) const;
+  bool IsResolved() const { return resolved_ != nullptr; }
 
  private:
   bool evaluate() const override;
@@ -763,7 +865,7 @@ class AidlUnaryConstExpression : public AidlConstantValue {
 
   static bool IsCompatibleType(Type type, const string& op);
   bool CheckValid() const override;
-  void TraverseChildren(std::function<void(const AidlNode&)> traverse) const override {
+  void TraverseChildren(AidlNodeCallback traverse) const override {
     traverse(*unary_);
   }
   void DispatchVisit(AidlVisitor& v) const override { v.Visit(*this); }
@@ -789,7 +891,7 @@ class AidlBinaryConstExpression : public AidlConstantValue {
   static Type UsualArithmeticConversion(Type left, Type right);
   // Returns the promoted integral type where INT32 is the smallest type
   static Type IntegralPromotion(Type in);
-  void TraverseChildren(std::function<void(const AidlNode&)> traverse) const override {
+  void TraverseChildren(AidlNodeCallback traverse) const override {
     traverse(*left_val_);
     traverse(*right_val_);
   }
@@ -845,7 +947,7 @@ class AidlConstantDeclaration : public AidlMember {
     return value_->ValueString(GetType(), decorator);
   }
 
-  void TraverseChildren(std::function<void(const AidlNode&)> traverse) const override {
+  void TraverseChildren(AidlNodeCallback traverse) const override {
     traverse(GetType());
     traverse(GetValue());
   }
@@ -908,7 +1010,7 @@ class AidlMethod : public AidlMember {
   // e.g) "foo(int, String)"
   std::string Signature() const;
 
-  void TraverseChildren(std::function<void(const AidlNode&)> traverse) const override {
+  void TraverseChildren(AidlNodeCallback traverse) const override {
     traverse(GetType());
     for (const auto& a : GetArguments()) {
       traverse(*a);
@@ -1009,7 +1111,7 @@ class AidlDefinedType : public AidlMember, public AidlScope {
   }
   const std::vector<std::unique_ptr<AidlMethod>>& GetMethods() const { return methods_; }
   const std::vector<const AidlMember*>& GetMembers() const { return members_; }
-  void TraverseChildren(std::function<void(const AidlNode&)> traverse) const override {
+  void TraverseChildren(AidlNodeCallback traverse) const override {
     AidlAnnotatable::TraverseChildren(traverse);
     for (const auto c : GetMembers()) {
       traverse(*c);
@@ -1120,7 +1222,7 @@ class AidlEnumerator : public AidlCommentable {
   void SetValue(std::unique_ptr<AidlConstantValue> value) { value_ = std::move(value); }
   bool IsValueUserSpecified() const { return value_user_specified_; }
 
-  void TraverseChildren(std::function<void(const AidlNode&)> traverse) const override {
+  void TraverseChildren(AidlNodeCallback traverse) const override {
     traverse(*value_);
   }
   void DispatchVisit(AidlVisitor& v) const override { v.Visit(*this); }
@@ -1154,7 +1256,7 @@ class AidlEnumDeclaration : public AidlDefinedType {
 
   const AidlEnumDeclaration* AsEnumDeclaration() const override { return this; }
 
-  void TraverseChildren(std::function<void(const AidlNode&)> traverse) const override {
+  void TraverseChildren(AidlNodeCallback traverse) const override {
     AidlDefinedType::TraverseChildren(traverse);
     if (backing_type_) {
       traverse(*backing_type_);
@@ -1214,6 +1316,11 @@ class AidlInterface final : public AidlDefinedType {
   bool CheckValidPermissionAnnotations(const AidlMethod& m) const;
   bool UsesPermissions() const;
   std::string GetDescriptor() const;
+  // The position of |method| among the user-defined methods, or -1 for a meta method like
+  // getInterfaceVersion. Versioned proxies use it as the bit which records that the remote side
+  // doesn't implement the method.
+  int GetUserMethodIndex(const AidlMethod& method) const;
+  int CountUserMethods() const;
   void DispatchVisit(AidlVisitor& v) const override { v.Visit(*this); }
 };
 
@@ -1242,7 +1349,7 @@ class AidlDocument : public AidlCommentable, public AidlScope {
   }
   bool IsPreprocessed() const { return is_preprocessed_; }
 
-  void TraverseChildren(std::function<void(const AidlNode&)> traverse) const override {
+  void TraverseChildren(AidlNodeCallback traverse) const override {
     for (const auto& t : DefinedTypes()) {
       traverse(*t);
     }
@@ -1264,20 +1371,44 @@ std::optional<T> AidlAnnotation::ParamValue(const std::string& param_name) const
   return it->second->EvaluatedValue<T>();
 }
 
+// Calls f(child) for each child of |node|.
+template <typename F>
+void ForEachChild(const AidlNode& node, F&& f) {
+  node.TraverseChildren(f);
+}
+
+// Calls enter(n) for each node n of the tree rooted at |node|, then visits the children of n, and
+// calls leave(n). The callables are passed down as they are, so that the traversal is a template
+// which costs no std::function at any node.
+template <typename Enter, typename Leave>
+void ForEachNode(const AidlNode& node, Enter&& enter, Leave&& leave) {
+  enter(node);
+  ForEachChild(node, [&](const AidlNode& child) { ForEachNode(child, enter, leave); });
+  leave(node);
+}
+
+// Calls f for each node of the tree rooted at |node| in top-down order.
+template <typename F>
+void ForEachNodeTopDown(const AidlNode& node, F&& f) {
+  ForEachNode(node, f, [](const AidlNode&) {});
+}
+
+// Calls f for each node of the tree rooted at |node| in bottom-up order.
+template <typename F>
+void ForEachNodeBottomUp(const AidlNode& node, F&& f) {
+  ForEachNode(node, [](const AidlNode&) {}, f);
+}
+
 // Utilities to make a visitor to visit AST tree in top-down order
 // Given:       foo
 //              / \
 //            bar baz
 // VisitTopDown(v, foo) makes v visit foo -> bar -> baz.
 inline void VisitTopDown(std::function<void(const AidlNode&)> v, const AidlNode& node) {
-  std::function<void(const AidlNode&)> top_down = [&](const AidlNode& n) {
-    v(n);
-    n.TraverseChildren(top_down);
-  };
-  top_down(node);
+  ForEachNodeTopDown(node, v);
 }
 inline void VisitTopDown(AidlVisitor& v, const AidlNode& node) {
-  VisitTopDown([&](const AidlNode& n) { n.DispatchVisit(v); }, node);
+  ForEachNodeTopDown(node, [&](const AidlNode& n) { n.DispatchVisit(v); });
 }
 
 // Utility to make a visitor to visit AST tree in bottom-up order
@@ -1286,11 +1417,7 @@ inline void VisitTopDown(AidlVisitor& v, const AidlNode& node) {
 //            bar baz
 // VisitBottomUp(v, foo) makes v visit bar -> baz -> foo.
 inline void VisitBottomUp(AidlVisitor& v, const AidlNode& node) {
-  std::function<void(const AidlNode&)> bottom_up = [&](const AidlNode& n) {
-    n.TraverseChildren(bottom_up);
-    n.DispatchVisit(v);
-  };
-  bottom_up(node);
+  ForEachNodeBottomUp(node, [&](const AidlNode& n) { n.DispatchVisit(v); });
 }
 
 template <typename T>
@@ -1314,13 +1441,11 @@ T* AidlCast(AidlNode& node) {
 template <typename AidlNodeType>
 vector<const AidlNodeType*> Collect(const AidlNode& root) {
   vector<const AidlNodeType*> result;
-  std::function<void(const AidlNode&)> top_down = [&](const AidlNode& n) {
+  ForEachNodeTopDown(root, [&](const AidlNode& n) {
     if (auto cast = AidlCast<AidlNodeType>(n); cast) {
       result.push_back(cast);
     }
-    n.TraverseChildren(top_down);
-  };
-  top_down(root);
+  });
   return result;
 }
 
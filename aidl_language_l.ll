@@ -18,9 +18,12 @@
 #include <string.h>
 #include <stdlib.h>
 
+#include <string_view>
+
 #include "aidl_language.h"
 #include "parser.h"
 #include "aidl_language_y.h"
+#include "scan.h"
 
 #ifndef YYSTYPE
 #define YYSTYPE yy::parser::semantic_type
@@ -31,6 +34,65 @@
 #endif
 
 #define YY_USER_ACTION yylloc->columns(yyleng);
+
+// Extends the current match up to the position returned by scan(from, end), where from is the end
+// of what the rule matched and end is the end of the input. Rules for long runs of input match
+// their first bytes and find the rest with the block-wise functions of scan.h. This relies on the
+// whole input being in a single buffer, as Parser sets it up with yy_scan_buffer().
+#define YY_EXTEND_MATCH(scan)                                                      \
+  do {                                                                             \
+    *yyg->yy_c_buf_p = yyg->yy_hold_char;                                          \
+    const char* input_end = YY_CURRENT_BUFFER_LVALUE->yy_ch_buf + yyg->yy_n_chars; \
+    yyg->yy_c_buf_p = const_cast<char*>(scan(yyg->yy_c_buf_p, input_end));         \
+    yyleng = static_cast<int>(yyg->yy_c_buf_p - yytext);                           \
+    yyg->yy_hold_char = *yyg->yy_c_buf_p;                                          \
+    *yyg->yy_c_buf_p = '\0';                                                       \
+  } while (0)
+
+namespace {
+struct Keyword {
+  std::string_view text;
+  int token;
+  // Whether the parser takes the keyword as an AidlToken, e.g. for its comments.
+  bool has_token;
+};
+
+constexpr Keyword kKeywords[] = {
+    {"parcelable", yy::parser::token::PARCELABLE, true},
+    {"import", yy::parser::token::IMPORT, true},
+    {"package", yy::parser::token::PACKAGE, true},
+    {"in", yy::parser::token::IN, false},
+    {"out", yy::parser::token::OUT, false},
+    {"inout", yy::parser::token::INOUT, false},
+    {"cpp_header", yy::parser::token::CPP_HEADER, true},
+    {"ndk_header", yy::parser::token::NDK_HEADER, true},
+    {"const", yy::parser::token::CONST, true},
+    {"true", yy::parser::token::TRUE_LITERAL, false},
+    {"false", yy::parser::token::FALSE_LITERAL, false},
+    {"interface", yy::parser::token::INTERFACE, true},
+    {"oneway", yy::parser::token::ONEWAY, true},
+    {"enum", yy::parser::token::ENUM, true},
+    {"union", yy::parser::token::UNION, true},
+};
+
+// Returns the keyword spelled |text|, or nullptr if it's an identifier.
+const Keyword* FindKeyword(std::string_view text) {
+  for (const auto& keyword : kKeywords) {
+    if (keyword.text == text) return &keyword;
+  }
+  return nullptr;
+}
+
+// Advances |loc| over the text [begin, end), which may span lines.
+void AdvanceLocation(YYLTYPE* loc, const char* begin, const char* end) {
+  std::string_view text(begin, end - begin);
+  if (size_t lines = android::aidl::CountNewlines(begin, end); lines > 0) {
+    loc->lines(static_cast<int>(lines));
+    text.remove_prefix(text.rfind('\n') + 1);
+  }
+  loc->columns(static_cast<int>(text.size()));
+}
+}  // namespace
 %}
 
 %option noyywrap
@@ -40,10 +102,8 @@
 %option bison-bridge
 %option bison-locations
 
-%x LONG_COMMENT
-
 identifier  [_a-zA-Z][_a-zA-Z0-9]*
-whitespace  ([ \t\r]+)
+blank       [ \t\r]
 intvalue    [0-9]+[lL]?(u8)?
 hexvalue    0[x|X][0-9a-fA-F]+[lL]?(u8)?
 floatvalue  [0-9]*\.?[0-9]+([eE][-+]?[0-9]+)?f?
@@ -58,23 +118,27 @@ floatvalue  [0-9]*\.?[0-9]+([eE][-+]?[0-9]+)?f?
   yylloc->step();
 %}
 
-\/\*                  { extra_text += yytext; BEGIN(LONG_COMMENT); }
-<LONG_COMMENT>\*+\/   { extra_text += yytext; yylloc->step(); BEGIN(INITIAL);
-                        comments.push_back({extra_text});
-                        extra_text.clear(); }
-<LONG_COMMENT>\*+     { extra_text += yytext; }
-<LONG_COMMENT>\n+     { extra_text += yytext; yylloc->lines(yyleng); }
-<LONG_COMMENT>[^*\n]+ { extra_text += yytext; }
+\/\*                  { YY_EXTEND_MATCH(android::aidl::FindCommentEnd);
+                        AdvanceLocation(yylloc, yytext + 2, yytext + yyleng);
+                        /* An unterminated comment runs to the end of the input and is dropped */
+                        if (yyleng >= 4 && memcmp(yytext + yyleng - 2, "*/", 2) == 0) {
+                          yylloc->step();
+                          comments.push_back({std::string(yytext, yyleng)});
+                        }
+                      }
 
 \"([^\"]|\\.)*\"      { yylval->token = new AidlToken(yytext, comments);
                         return yy::parser::token::C_STR; }
 
-\/\/.*                { extra_text += yytext; extra_text += "\n";
+\/\/                  { YY_EXTEND_MATCH(android::aidl::FindLineEnd);
+                        yylloc->columns(yyleng - 2);
+                        extra_text += yytext; extra_text += "\n";
                         comments.push_back({extra_text});
                         extra_text.clear(); }
 
 \n+                   { yylloc->lines(yyleng); yylloc->step(); }
-{whitespace}          {}
+{blank}               { YY_EXTEND_MATCH(android::aidl::SkipBlanks);
+                        yylloc->columns(yyleng - 1); }
 <<EOF>>               { yyterminate(); }
 
     /* symbols */
@@ -115,43 +179,17 @@ floatvalue  [0-9]*\.?[0-9]+([eE][-+]?[0-9]+)?f?
                         return yy::parser::token::ANNOTATION;
                       }
 
-    /* keywords */
-parcelable            { yylval->token = new AidlToken("parcelable", comments);
-                        return yy::parser::token::PARCELABLE;
-                      }
-import                { yylval->token = new AidlToken("import", comments);
-                        return yy::parser::token::IMPORT; }
-package               { yylval->token = new AidlToken("package", comments);
-                        return yy::parser::token::PACKAGE; }
-in                    { return yy::parser::token::IN; }
-out                   { return yy::parser::token::OUT; }
-inout                 { return yy::parser::token::INOUT; }
-cpp_header            { yylval->token = new AidlToken("cpp_header", comments);
-                        return yy::parser::token::CPP_HEADER; }
-ndk_header            { yylval->token = new AidlToken("ndk_header", comments);
-                        return yy::parser::token::NDK_HEADER; }
-const                 { yylval->token = new AidlToken("const", comments);
-                        return yy::parser::token::CONST; }
-true                  { return yy::parser::token::TRUE_LITERAL; }
-false                 { return yy::parser::token::FALSE_LITERAL; }
-
-interface             { yylval->token = new AidlToken("interface", comments);
-                        return yy::parser::token::INTERFACE;
-                      }
-oneway                { yylval->token = new AidlToken("oneway", comments);
-                        return yy::parser::token::ONEWAY;
-                      }
-enum                  { yylval->token = new AidlToken("enum", comments);
-                        return yy::parser::token::ENUM;
-                      }
-union                 { yylval->token = new AidlToken("union", comments);
-                        return yy::parser::token::UNION;
+    /* keywords and identifiers */
+[_a-zA-Z]             { YY_EXTEND_MATCH(android::aidl::SkipIdentifier);
+                        yylloc->columns(yyleng - 1);
+                        const Keyword* keyword = FindKeyword(std::string_view(yytext, yyleng));
+                        if (keyword == nullptr || keyword->has_token) {
+                          yylval->token = new AidlToken(yytext, comments);
+                        }
+                        return keyword ? keyword->token : yy::parser::token::IDENTIFIER;
                       }
 
     /* scalars */
-{identifier}          { yylval->token = new AidlToken(yytext, comments);
-                        return yy::parser::token::IDENTIFIER;
-                      }
 '.'                   { yylval->token = new AidlToken(std::string(yytext, yyleng), comments);
                         return yy::parser::token::CHARVALUE; }
 {intvalue}            { yylval->token = new AidlToken(yytext, comments);
@@ -52,8 +52,8 @@ AidlLocation loc(const yy::parser::location_type& l) {
 %}
 
 %initial-action {
-    @$.begin.filename = @$.end.filename =
-        const_cast<std::string *>(&ps->FileName());
+    @$.initialize(const_cast<std::string *>(&ps->FileName()), ps->Start().line,
+                  ps->Start().column);
 }
 
 %parse-param { Parser* ps }
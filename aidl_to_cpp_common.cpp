@@ -22,10 +22,13 @@
 #include <limits>
 #include <set>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "comments.h"
 #include "logging.h"
 #include "os.h"
+#include "permission.h"
 
 using ::android::base::Join;
 using ::android::base::Split;
@@ -125,6 +128,45 @@ bool ValidateOutputFilePath(const string& output_file, const Options& options,
   return true;
 }
 
+std::string UnitySourceFile(const Options& options, size_t shard) {
+  return options.OutputDir() + "aidl_unity_" + std::to_string(shard) + ".cpp";
+}
+
+bool GenerateUnitySources(const Options& options, const std::map<std::string, std::string>& sources,
+                          const IoDelegate& io_delegate) {
+  const size_t num_shards = options.UnityShards();
+  std::vector<std::string> contents(num_shards);
+  for (size_t i = 0; i < num_shards; i++) {
+    contents[i] = "// Unity source " + std::to_string(i) + " of " + std::to_string(num_shards) +
+                  " generated by aidl.\n";
+  }
+  // Iterated in the order of the names, so the contents are deterministic.
+  for (const auto& [name, path] : sources) {
+    // FNV-1a, which is stable across hosts unlike std::hash
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char c : name) {
+      hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+    }
+    // The sources are under the output directory, as the unity sources are.
+    string relative_path = path;
+    if (android::base::StartsWith(relative_path, options.OutputDir())) {
+      relative_path = relative_path.substr(options.OutputDir().size());
+    }
+    std::replace(relative_path.begin(), relative_path.end(), OS_PATH_SEPARATOR, '/');
+    contents[hash % num_shards] += "#include \"" + relative_path + "\"\n";
+  }
+
+  std::vector<std::pair<std::string, std::string>> files;
+  for (size_t i = 0; i < num_shards; i++) {
+    files.emplace_back(UnitySourceFile(options, i), std::move(contents[i]));
+  }
+  if (!io_delegate.WriteFiles(files)) {
+    AIDL_ERROR(options.OutputDir()) << "Failed to write unity sources.";
+    return false;
+  }
+  return true;
+}
+
 void EnterNamespace(CodeWriter& out, const AidlDefinedType& defined_type) {
   const std::vector<std::string> packages = defined_type.GetSplitPackage();
   for (const std::string& package : packages) {
@@ -684,20 +726,53 @@ void UnionWriter::ReadFromParcel(CodeWriter& out, const ParcelWriterContext& ctx
     out << fmt::format("case {}: {{\n", variable->GetName());
     out.Indent();
     const auto& type = variable->GetType();
-    read_var(value, type);
-    out << fmt::format("if constexpr (std::is_trivially_copyable_v<{}>) {{\n",
-                       name_of(type, typenames));
-    out.Indent();
-    out << fmt::format("set<{}>({});\n", variable->GetName(), value);
-    out.Dedent();
-    out << "} else {\n";
-    out.Indent();
-    // Even when the `if constexpr` is false, the compiler runs the tidy check for the
-    // next line, which doesn't make sense. Silence the check for the unreachable code.
-    out << "// NOLINTNEXTLINE(performance-move-const-arg)\n";
-    out << fmt::format("set<{}>(std::move({}));\n", variable->GetName(), value);
-    out.Dedent();
-    out << "}\n";
+    if (decl.IsFixedSize()) {
+      read_var(value, type);
+      out << fmt::format("if constexpr (std::is_trivially_copyable_v<{}>) {{\n",
+                         name_of(type, typenames));
+      out.Indent();
+      out << fmt::format("set<{}>({});\n", variable->GetName(), value);
+      out.Dedent();
+      out << "} else {\n";
+      out.Indent();
+      // Even when the `if constexpr` is false, the compiler runs the tidy check for the
+      // next line, which doesn't make sense. Silence the check for the unreachable code.
+      out << "// NOLINTNEXTLINE(performance-move-const-arg)\n";
+      out << fmt::format("set<{}>(std::move({}));\n", variable->GetName(), value);
+      out.Dedent();
+      out << "}\n";
+    } else {
+      // Reads into the alternative in place. When the tag doesn't change, a vector or a string
+      // keeps its capacity for the reader to reuse. Others are reset first, because e.g. a
+      // parcelable from an older version wouldn't overwrite the fields it doesn't know. Reading a
+      // vector reads into the elements it keeps, so only those of plain values are reused.
+      auto is_plain = [&](const AidlTypeSpecifier& t) {
+        const string& name = t.GetName();
+        return AidlTypenames::IsPrimitiveTypename(name) || name == "String" ||
+               name == "IBinder" || name == "ParcelFileDescriptor" ||
+               typenames.GetEnumDeclaration(t) != nullptr;
+      };
+      bool reuse = false;
+      if (type.GetName() == "List") {
+        reuse = type.IsGeneric() && is_plain(*type.GetTypeParameters()[0]);
+      } else if (type.IsDynamicArray()) {
+        reuse = is_plain(type);
+      } else {
+        reuse = type.GetName() == "String";
+      }
+      if (reuse) {
+        out << fmt::format("if (getTag() != {}) {{\n", variable->GetName());
+        out.Indent();
+      }
+      out << fmt::format("set<{}>();\n", variable->GetName());
+      if (reuse) {
+        out.Dedent();
+        out << "}\n";
+      }
+      out << fmt::format("if (({} = ", status);
+      ctx.read_func(out, fmt::format("get<{}>()", variable->GetName()), type);
+      out << fmt::format(") != {}) return {};\n", ctx.status_ok, status);
+    }
     out << fmt::format("return {}; }}\n", ctx.status_ok);
     out.Dedent();
   }
@@ -860,6 +935,120 @@ void GenerateForwardDecls(CodeWriter& out, const AidlDefinedType& root_type, boo
     }
   }
 }
+
+// Must be a power of two.
+static constexpr size_t kPermissionCacheSize = 64;
+
+void GeneratePermissionCacheDecl(CodeWriter& out) {
+  out << "// Drops every permission decision cached by this object. Call this when permission grants "
+         "change.\n";
+  out << "void invalidatePermissionCache();\n";
+}
+
+void GeneratePermissionCachePrivateDecl(CodeWriter& out, const string& friend_name) {
+  if (!friend_name.empty()) {
+    out << "friend struct " << friend_name << ";\n";
+  }
+  out << "bool _aidl_lookupPermissionCache(uint32_t _aidl_expr, uid_t _aidl_uid, bool* "
+         "_aidl_granted);\n";
+  out << "void _aidl_storePermissionCache(uint32_t _aidl_expr, uid_t _aidl_uid, bool "
+         "_aidl_granted);\n";
+  out << "static constexpr size_t _aidl_permission_cache_size = "
+      << std::to_string(kPermissionCacheSize) << ";\n";
+  out << "std::atomic<uint64_t> _aidl_permission_cache[_aidl_permission_cache_size] = {};\n";
+}
+
+// Each cache entry packs a valid bit(63), the decision(62), the expression id(32..61) and the
+// calling uid(0..31) into one word, so a reader sees either a whole entry or a miss.
+void GeneratePermissionCacheDefinitions(CodeWriter& out, const string& q_name) {
+  constexpr auto tmpl = R"--(void {q_name}::invalidatePermissionCache() {{
+  for (auto& _aidl_entry : _aidl_permission_cache) {{
+    _aidl_entry.store(0, std::memory_order_release);
+  }}
+}}
+bool {q_name}::_aidl_lookupPermissionCache(uint32_t _aidl_expr, uid_t _aidl_uid, bool* _aidl_granted) {{
+  const uint32_t _aidl_raw_uid = static_cast<uint32_t>(_aidl_uid);
+  const uint64_t _aidl_key = (uint64_t{{1}} << 63) | (uint64_t{{_aidl_expr & 0x3fffffff}} << 32) | _aidl_raw_uid;
+  const size_t _aidl_slot = ((_aidl_raw_uid * 0x9e3779b1u) ^ _aidl_expr) & (_aidl_permission_cache_size - 1);
+  const uint64_t _aidl_entry = _aidl_permission_cache[_aidl_slot].load(std::memory_order_acquire);
+  if ((_aidl_entry & ~(uint64_t{{1}} << 62)) != _aidl_key) return false;
+  *_aidl_granted = (_aidl_entry & (uint64_t{{1}} << 62)) != 0;
+  return true;
+}}
+void {q_name}::_aidl_storePermissionCache(uint32_t _aidl_expr, uid_t _aidl_uid, bool _aidl_granted) {{
+  const uint32_t _aidl_raw_uid = static_cast<uint32_t>(_aidl_uid);
+  const uint64_t _aidl_key = (uint64_t{{1}} << 63) | (uint64_t{{_aidl_expr & 0x3fffffff}} << 32) | _aidl_raw_uid;
+  const size_t _aidl_slot = ((_aidl_raw_uid * 0x9e3779b1u) ^ _aidl_expr) & (_aidl_permission_cache_size - 1);
+  _aidl_permission_cache[_aidl_slot].store(_aidl_key | (_aidl_granted ? uint64_t{{1}} << 62 : 0), std::memory_order_release);
+}}
+)--";
+  out << fmt::format(tmpl, fmt::arg("q_name", q_name));
+}
+
+void GeneratePermissionCheck(CodeWriter& out, const AidlInterface& iface, const AidlMethod& method,
+                             const PermissionCheckContext& context) {
+  // The interface-wide expression shares one cache id for all methods.
+  uint32_t expr_id = 0;
+  auto expr = iface.EnforceExpression();
+  if (!expr) {
+    expr = method.GetType().EnforceExpression();
+    expr_id = method.GetId() + 1;
+  }
+  AIDL_FATAL_IF(!expr, method) << "No @EnforcePermission for " << method.GetName();
+
+  vector<string> checks;
+  for (const auto& permission : perm::Operands(*expr)) {
+    checks.push_back(fmt::format("{}checkPermission(\"{}\", _aidl_pid, _aidl_uid)", context.impl,
+                                 perm::NativeFullName(permission)));
+  }
+  const string op = std::holds_alternative<perm::AnyOf>(*expr) ? " || " : " && ";
+
+  out << "{\n";
+  out.Indent();
+  out << "const uid_t _aidl_uid = " << context.calling_uid << ";\n";
+  out << "const pid_t _aidl_pid = " << context.calling_pid << ";\n";
+  out << "bool _aidl_granted = false;\n";
+  out << "if (!" << context.cache_lookup << std::to_string(expr_id)
+      << ", _aidl_uid, &_aidl_granted)) {\n";
+  out << "  _aidl_granted = " << Join(checks, op) << ";\n";
+  out << "  " << context.cache_store << std::to_string(expr_id) << ", _aidl_uid, _aidl_granted);\n";
+  out << "}\n";
+  out << "if (!_aidl_granted) {\n";
+  out.Indent();
+  context.deny(out, method);
+  out << "break;\n";
+  out.Dedent();
+  out << "}\n";
+  out.Dedent();
+  out << "}\n";
+}
+
+bool CachesUnsupportedMethod(const AidlMethod& method, const Options& options) {
+  return options.Version() > 0 && method.IsUserDefined() && !method.IsOneway();
+}
+
+void GenerateUnsupportedMethodsDecl(CodeWriter& out, const AidlInterface& iface,
+                                    const string& var) {
+  if (const int count = iface.CountUserMethods(); count > 0) {
+    out << "std::atomic<uint64_t> " << var << "[" << std::to_string((count + 63) / 64)
+        << "] = {};\n";
+  }
+}
+
+string UnsupportedMethodTest(const AidlInterface& iface, const AidlMethod& method,
+                             const string& var) {
+  const int index = iface.GetUserMethodIndex(method);
+  return base::StringPrintf("(%s[%d].load(std::memory_order_relaxed) & (uint64_t{1} << %d))",
+                            var.c_str(), index / 64, index % 64);
+}
+
+string UnsupportedMethodSet(const AidlInterface& iface, const AidlMethod& method,
+                            const string& var) {
+  const int index = iface.GetUserMethodIndex(method);
+  return base::StringPrintf("%s[%d].fetch_or(uint64_t{1} << %d, std::memory_order_relaxed)",
+                            var.c_str(), index / 64, index % 64);
+}
+
 }  // namespace cpp
 }  // namespace aidl
 }  // namespace android
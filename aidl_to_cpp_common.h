@@ -17,10 +17,12 @@
 #pragma once
 
 #include <functional>
+#include <map>
 #include <string>
 #include <type_traits>
 
 #include "aidl_language.h"
+#include "io_delegate.h"
 
 // This is used to help generate code targetting C++ (the language) whether using the libbinder or
 // libbinder_ndk backend.
@@ -59,6 +61,14 @@ std::string HeaderFile(const AidlDefinedType& defined_type, ClassNames class_typ
 bool ValidateOutputFilePath(const string& output_file, const Options& options,
                             const AidlDefinedType& defined_type);
 
+// Path of the unity source for |shard| (--unity_shards).
+std::string UnitySourceFile(const Options& options, size_t shard);
+// Writes the unity sources, which include |sources|: the paths of the generated sources keyed by
+// the canonical names of their types. A type is assigned to a shard by a hash of its name, so it
+// stays in the same shard when other types are added or removed.
+bool GenerateUnitySources(const Options& options, const std::map<std::string, std::string>& sources,
+                          const IoDelegate& io_delegate);
+
 void EnterNamespace(CodeWriter& out, const AidlDefinedType& defined_type);
 void LeaveNamespace(CodeWriter& out, const AidlDefinedType& defined_type);
 
@@ -158,6 +168,48 @@ struct ClangDiagnosticIgnoreDeprecated {
 };
 
 bool HasDeprecatedField(const AidlParcelable& parcelable);
+
+// Describes how a backend's stub obtains the caller and reports a permission denial for
+// @EnforcePermission checks.
+struct PermissionCheckContext {
+  string impl;  // prefix to call checkPermission(), e.g. "_aidl_impl->"
+  // calls into the private decision cache up to the first argument (the expression id)
+  string cache_lookup;
+  string cache_store;
+  string calling_pid;
+  string calling_uid;
+  // writes the statements for a denied call (before the break out of the case)
+  std::function<void(CodeWriter& out, const AidlMethod& method)> deny;
+};
+
+// Declares the cache of (calling uid, permission expression) -> decision as a member of the stub, so
+// that each object caches the answers of its own checkPermission(). The cache is a fixed-size,
+// direct-mapped array of atomic words, so lookups never take a lock. Decisions are per uid: the
+// calling pid is passed to checkPermission() on a miss, but isn't part of the key.
+// Only invalidatePermissionCache() is public; the cache itself goes in the private section so
+// that code holding the object can't plant decisions. A stub which checks permissions outside of
+// the class (NDK) names a friend struct which forwards to the private lookup and store.
+void GeneratePermissionCacheDecl(CodeWriter& out);
+void GeneratePermissionCachePrivateDecl(CodeWriter& out, const string& friend_name = "");
+void GeneratePermissionCacheDefinitions(CodeWriter& out, const string& q_name);
+
+// Generates the check for the @EnforcePermission expression of the method (or the interface).
+// The check consults the decision cache first and only calls checkPermission() on a miss.
+void GeneratePermissionCheck(CodeWriter& out, const AidlInterface& iface, const AidlMethod& method,
+                             const PermissionCheckContext& context);
+
+// A versioned proxy keeps a bit per user-defined method which is set when the remote side answers
+// UNKNOWN_TRANSACTION, so that later calls go to the default implementation without a transaction.
+// Oneway calls never see the answer of the remote side and aren't cached.
+bool CachesUnsupportedMethod(const AidlMethod& method, const Options& options);
+// Declares the bits as |var|, if the interface has any methods.
+void GenerateUnsupportedMethodsDecl(CodeWriter& out, const AidlInterface& iface,
+                                    const string& var);
+// Expressions which test and set the bit of |method| in |var|.
+string UnsupportedMethodTest(const AidlInterface& iface, const AidlMethod& method,
+                             const string& var);
+string UnsupportedMethodSet(const AidlInterface& iface, const AidlMethod& method,
+                            const string& var);
 }  // namespace cpp
 }  // namespace aidl
 }  // namespace android
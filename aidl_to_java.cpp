@@ -218,13 +218,15 @@ string DefaultJavaValueOf(const AidlTypeSpecifier& aidl) {
   }
 }
 
-typedef void (*ParcelHelperGenerator)(CodeWriter&, const Options&);
+// |modifiers| of the helper methods are "static private" in a nested _Parcel class and
+// "public static" in the shared one.
+typedef void (*ParcelHelperGenerator)(CodeWriter&, const Options&, const string& modifiers);
 
-static void GenerateTypedObjectHelper(CodeWriter& out, const Options&) {
+static void GenerateTypedObjectHelper(CodeWriter& out, const Options&, const string& modifiers) {
   // Note that the name is inconsistent here because Parcel.java defines readTypedObject as if it
   // "creates" a new value from a parcel. "in-place" read function is not necessary because
   // user-defined parcelable defines its readFromParcel.
-  out << R"(static private <T> T readTypedObject(
+  out << modifiers << R"( <T> T readTypedObject(
     android.os.Parcel parcel,
     android.os.Parcelable.Creator<T> c) {
   if (parcel.readInt() != 0) {
@@ -233,7 +235,8 @@ static void GenerateTypedObjectHelper(CodeWriter& out, const Options&) {
       return null;
   }
 }
-static private <T extends android.os.Parcelable> void writeTypedObject(
+)" << modifiers
+      << R"( <T extends android.os.Parcelable> void writeTypedObject(
     android.os.Parcel parcel, T value, int parcelableFlags) {
   if (value != null) {
     parcel.writeInt(1);
@@ -245,8 +248,9 @@ static private <T extends android.os.Parcelable> void writeTypedObject(
 )";
 }
 
-static void GenerateTypedListHelper(CodeWriter& out, const Options& options) {
-  out << R"(static private <T extends android.os.Parcelable> void writeTypedList(
+static void GenerateTypedListHelper(CodeWriter& out, const Options& options,
+                                    const string& modifiers) {
+  out << modifiers << R"( <T extends android.os.Parcelable> void writeTypedList(
     android.os.Parcel parcel, java.util.List<T> value, int parcelableFlags) {
   if (value == null) {
     parcel.writeInt(-1);
@@ -271,12 +275,30 @@ static void GenerateTypedListHelper(CodeWriter& out, const Options& options) {
 )";
 }
 
+// The helpers which types might need for the minimum SDK version. The conditions are those of
+// GenerateParcelHelpers() for any type.
+static set<ParcelHelperGenerator> AllParcelHelpers(const Options& options) {
+  set<ParcelHelperGenerator> helpers;
+  // TypedObjects are supported since 23.
+  if (options.GetMinSdkVersion() < 23u) {
+    helpers.insert(&GenerateTypedObjectHelper);
+  }
+  if (options.GetMinSdkVersion() <= 33u) {
+    helpers.insert(&GenerateTypedListHelper);
+  }
+  return helpers;
+}
+
 void GenerateParcelHelpers(CodeWriter& out, const AidlDefinedType& defined_type,
                            const AidlTypenames& typenames, const Options& options) {
   // root-level type contains all necessary helpers
   if (defined_type.GetParentType()) {
     return;
   }
+  // The helpers are called in the shared class instead.
+  if (!options.SharedParcelHelper().empty()) {
+    return;
+  }
   // visits method parameters and parcelable fields to collect types which
   // requires read/write/create helpers.
   struct Visitor : AidlVisitor {
@@ -325,13 +347,34 @@ void GenerateParcelHelpers(CodeWriter& out, const AidlDefinedType& defined_type,
     out << "static class _Parcel {\n";
     out.Indent();
     for (const auto& helper : v.helpers) {
-      helper(out, options);
+      helper(out, options, "static private");
     }
     out.Dedent();
     out << "}\n";
   }
 }
 
+void GenerateSharedParcelHelper(CodeWriter& out, const Options& options) {
+  const string& name = options.SharedParcelHelper();
+  const size_t dot = name.rfind('.');
+  out << "/*\n";
+  out << " * This file is auto-generated.  DO NOT MODIFY.\n";
+  out << " */\n";
+  out << "package " << name.substr(0, dot) << ";\n";
+  out << "/** @hide */\n";
+  out << "public class " << name.substr(dot + 1) << " {\n";
+  out.Indent();
+  for (const auto& helper : AllParcelHelpers(options)) {
+    helper(out, options, "public static");
+  }
+  out.Dedent();
+  out << "}\n";
+}
+
+string ParcelHelperClass(const Options& options) {
+  return options.SharedParcelHelper().empty() ? "_Parcel" : options.SharedParcelHelper();
+}
+
 void WriteToParcelFor(const CodeGeneratorContext& c) {
   static map<string, function<void(const CodeGeneratorContext&)>> method_map{
       {"boolean",
@@ -417,8 +460,8 @@ void WriteToParcelFor(const CodeGeneratorContext& c) {
                c.writer << c.parcel << ".writeTypedList(" << c.var << ", " << c.write_to_parcel_flag
                         << ");\n";
              } else {
-               c.writer << "_Parcel.writeTypedList(" << c.parcel << ", " << c.var << ", "
-                        << c.write_to_parcel_flag << ");\n";
+               c.writer << c.parcel_helper << ".writeTypedList(" << c.parcel << ", " << c.var
+                        << ", " << c.write_to_parcel_flag << ");\n";
              }
            } else if (c.typenames.GetInterface(element_type)) {
              c.writer << c.parcel << ".writeInterfaceList(" << c.var << ");\n";
@@ -452,6 +495,7 @@ void WriteToParcelFor(const CodeGeneratorContext& c) {
                c.min_sdk_version,
                c.write_to_parcel_flag,
                c.is_classloader_created,
+               c.parcel_helper,
            };
            WriteToParcelFor(value_context);
            c.writer.Dedent();
@@ -485,8 +529,8 @@ void WriteToParcelFor(const CodeGeneratorContext& c) {
            c.writer << c.parcel << ".writeTypedObject(" << c.var << ", " << c.write_to_parcel_flag
                     << ");\n";
          } else {
-           c.writer << "_Parcel.writeTypedObject(" << c.parcel << ", " << c.var << ", "
-                    << c.write_to_parcel_flag << ");\n";
+           c.writer << c.parcel_helper << ".writeTypedObject(" << c.parcel << ", " << c.var
+                    << ", " << c.write_to_parcel_flag << ");\n";
          }
        }},
       {"ParcelFileDescriptor[]",
@@ -544,8 +588,8 @@ void WriteToParcelFor(const CodeGeneratorContext& c) {
           c.writer << c.parcel << ".writeTypedObject(" << c.var << ", " << c.write_to_parcel_flag
                    << ");\n";
         } else {
-          c.writer << "_Parcel.writeTypedObject(" << c.parcel << ", " << c.var << ", "
-                   << c.write_to_parcel_flag << ");\n";
+          c.writer << c.parcel_helper << ".writeTypedObject(" << c.parcel << ", " << c.var
+                   << ", " << c.write_to_parcel_flag << ");\n";
         }
       }
     }
@@ -681,6 +725,7 @@ bool CreateFromParcelFor(const CodeGeneratorContext& c) {
                c.min_sdk_version,
                c.write_to_parcel_flag,
                c.is_classloader_created,
+               c.parcel_helper,
            };
            CreateFromParcelFor(value_context);
            c.writer << c.var << ".put(k, v);\n";
@@ -717,7 +762,7 @@ bool CreateFromParcelFor(const CodeGeneratorContext& c) {
            c.writer << c.var << " = " << c.parcel
                     << ".readTypedObject(android.os.ParcelFileDescriptor.CREATOR);\n";
          } else {
-           c.writer << c.var << " = _Parcel.readTypedObject(" << c.parcel
+           c.writer << c.var << " = " << c.parcel_helper << ".readTypedObject(" << c.parcel
                     << ", android.os.ParcelFileDescriptor.CREATOR);\n";
          }
        }},
@@ -732,7 +777,7 @@ bool CreateFromParcelFor(const CodeGeneratorContext& c) {
            c.writer << c.var << " = " << c.parcel
                     << ".readTypedObject(android.text.TextUtils.CHAR_SEQUENCE_CREATOR);\n";
          } else {
-           c.writer << c.var << " = _Parcel.readTypedObject(" << c.parcel
+           c.writer << c.var << " = " << c.parcel_helper << ".readTypedObject(" << c.parcel
                     << ", android.text.TextUtils.CHAR_SEQUENCE_CREATOR);\n";
          }
        }},
@@ -782,8 +827,8 @@ bool CreateFromParcelFor(const CodeGeneratorContext& c) {
           c.writer << c.var << " = " << c.parcel << ".readTypedObject(" << c.type.GetName()
                    << ".CREATOR);\n";
         } else {
-          c.writer << c.var << " = _Parcel.readTypedObject(" << c.parcel << ", " << c.type.GetName()
-                   << ".CREATOR);\n";
+          c.writer << c.var << " = " << c.parcel_helper << ".readTypedObject(" << c.parcel << ", "
+                   << c.type.GetName() << ".CREATOR);\n";
         }
       }
     }
@@ -868,6 +913,7 @@ bool ReadFromParcelFor(const CodeGeneratorContext& c) {
                c.min_sdk_version,
                c.write_to_parcel_flag,
                c.is_classloader_created,
+               c.parcel_helper,
            };
            CreateFromParcelFor(value_context);
            c.writer << c.var << ".put(k, v);\n";
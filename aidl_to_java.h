@@ -89,6 +89,9 @@ struct CodeGeneratorContext {
   // We emit the code at most once per an AIDL method, otherwise we are wasting
   // time doing the same thing multiple time.
   bool* const is_classloader_created;
+
+  // See ParcelHelperClass()
+  const string parcel_helper = "_Parcel";
 };
 
 // Writes code fragment that writes a variable to the parcel.
@@ -110,6 +113,14 @@ void ToStringFor(const CodeGeneratorContext& c);
 void GenerateParcelHelpers(CodeWriter& out, const AidlDefinedType& defined_type,
                            const AidlTypenames& typenames, const Options& options);
 
+// Generates the class of --shared_parcel_helper. It has the helpers which any type might need for
+// the minimum SDK version.
+void GenerateSharedParcelHelper(CodeWriter& out, const Options& options);
+
+// Name of the class which has the parcel helpers: the one of --shared_parcel_helper or the
+// _Parcel class nested in each root class.
+string ParcelHelperClass(const Options& options);
+
 }  // namespace java
 }  // namespace aidl
 }  // namespace android
@@ -117,11 +117,23 @@ bool AidlTypenames::IsIgnorableImport(const string& import) const {
   return false;
 }
 
+AidlTypenames::~AidlTypenames() {
+  // A compilation visits only the documents which it uses. The others, like a preprocessed file
+  // none of whose types is referenced, are released without being tracked.
+  for (auto& doc : documents_) {
+    if (!doc->IsVisited()) {
+      AidlVisitTracker::Suspend suspend;
+      doc.reset();
+    }
+  }
+}
+
 // Add a parsed document and populate type names in it.
 // Name conflict is an error unless one of them is from preprocessed.
 // For legacy, we populate unqualified names from preprocessed unstructured parcelable types
 // so that they can be referenced via a simple name.
 bool AidlTypenames::AddDocument(std::unique_ptr<AidlDocument> doc) {
+  AIDL_FATAL_IF(frozen_, doc) << "Can't add a document after Freeze()";
   bool is_preprocessed = doc->IsPreprocessed();
   std::vector<AidlDefinedType*> types_to_add;
   // Add types in two steps to avoid adding a type while the doc is rejected.
@@ -187,6 +199,61 @@ bool AidlTypenames::AddDocument(std::unique_ptr<AidlDocument> doc) {
   return true;
 }
 
+bool AidlTypenames::AddLazyDocument(const AidlDocument& doc,
+                                    std::function<bool(AidlTypenames&)> load) {
+  AIDL_FATAL_IF(frozen_, doc) << "Can't add a document after Freeze()";
+  AIDL_FATAL_IF(!doc.IsPreprocessed(), doc) << "Only preprocessed documents are loaded lazily";
+  std::vector<string> names_to_add;
+
+  std::function<bool(const std::vector<std::unique_ptr<AidlDefinedType>>&)> collect_names_to_add;
+  collect_names_to_add = [&](auto& types) {
+    for (const auto& type : types) {
+      // Built-in types and duplicates are skipped in preprocessed documents, see AddDocument().
+      if (IsBuiltinTypename(type->GetName()) || IsKnownTypename(type->GetCanonicalName())) {
+        continue;
+      }
+      if (!HasValidNameComponents(*type)) {
+        return false;
+      }
+      names_to_add.push_back(type->GetCanonicalName());
+      if (type->AsUnstructuredParcelable() && !IsKnownTypename(type->GetName())) {
+        names_to_add.push_back(type->GetName());
+      }
+      if (!collect_names_to_add(type->GetNestedTypes())) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  if (!collect_names_to_add(doc.DefinedTypes())) {
+    return false;
+  }
+  if (names_to_add.empty()) {
+    return true;
+  }
+  for (const auto& name : names_to_add) {
+    lazy_names_.emplace(name, lazy_loads_.size());
+  }
+  lazy_loads_.push_back(std::move(load));
+  return true;
+}
+
+bool AidlTypenames::LoadLazyType(const string& type_name) {
+  auto found_lazy = lazy_names_.find(type_name);
+  if (found_lazy == lazy_names_.end() || !lazy_loads_[found_lazy->second]) {
+    return true;
+  }
+  AIDL_FATAL_IF(frozen_, AIDL_LOCATION_HERE) << "Can't load " << type_name << " after Freeze()";
+  auto load = std::move(lazy_loads_[found_lazy->second]);
+  lazy_loads_[found_lazy->second] = nullptr;
+  return load(*this);
+}
+
+bool AidlTypenames::IsKnownTypename(const string& type_name) const {
+  return defined_types_.count(type_name) > 0 || lazy_names_.count(type_name) > 0;
+}
+
 const AidlDocument& AidlTypenames::MainDocument() const {
   AIDL_FATAL_IF(documents_.size() == 0, AIDL_LOCATION_HERE) << "Main document doesn't exist";
   return *(documents_[0]);
@@ -222,13 +289,11 @@ const AidlDefinedType* AidlTypenames::TryGetDefinedType(const string& type_name)
 std::vector<const AidlDefinedType*> AidlTypenames::AllDefinedTypes() const {
   std::vector<const AidlDefinedType*> res;
   for (const auto& doc : AllDocuments()) {
-    VisitTopDown(
-        [&](const AidlNode& node) {
-          if (auto defined_type = AidlCast<AidlDefinedType>(node); defined_type) {
-            res.push_back(defined_type);
-          }
-        },
-        *doc);
+    ForEachNodeTopDown(*doc, [&](const AidlNode& node) {
+      if (auto defined_type = AidlCast<AidlDefinedType>(node); defined_type) {
+        res.push_back(defined_type);
+      }
+    });
   }
   return res;
 }
@@ -396,7 +461,53 @@ void AidlTypenames::IterateTypes(const std::function<void(const AidlDefinedType&
   }
 }
 
+set<const AidlDefinedType*> AidlTypenames::ReachableTypes(const AidlDocument& document) const {
+  vector<const AidlDefinedType*> roots;
+  for (const auto& type : document.DefinedTypes()) {
+    roots.push_back(type.get());
+  }
+  return ReachableTypes(roots);
+}
+
+set<const AidlDefinedType*> AidlTypenames::ReachableTypes(
+    const vector<const AidlDefinedType*>& roots) const {
+  struct Collector : AidlVisitor {
+    void Visit(const AidlTypeSpecifier& t) override { Reach(t.GetDefinedType()); }
+    void Visit(const AidlInterface& t) override { types.insert(&t); }
+    void Visit(const AidlParcelable& t) override { types.insert(&t); }
+    void Visit(const AidlStructuredParcelable& t) override { types.insert(&t); }
+    void Visit(const AidlUnionDecl& t) override { types.insert(&t); }
+    void Visit(const AidlEnumDeclaration& t) override { types.insert(&t); }
+
+    // Queues the top-level type of |type|, whose traversal covers the nested types.
+    void Reach(const AidlDefinedType* type) {
+      if (type == nullptr) return;
+      while (type->GetParentType() != nullptr) {
+        type = type->GetParentType();
+      }
+      if (roots.insert(type).second) {
+        queue.push_back(type);
+      }
+    }
+
+    set<const AidlDefinedType*> types;
+    set<const AidlDefinedType*> roots;
+    vector<const AidlDefinedType*> queue;
+  } collector;
+
+  for (const auto& type : roots) {
+    collector.Reach(type);
+  }
+  while (!collector.queue.empty()) {
+    const AidlDefinedType* type = collector.queue.back();
+    collector.queue.pop_back();
+    VisitTopDown(collector, *type);
+  }
+  return collector.types;
+}
+
 bool AidlTypenames::Autofill() const {
+  AIDL_FATAL_IF(frozen_, AIDL_LOCATION_HERE) << "Can't modify types after Freeze()";
   bool success = true;
   IterateTypes([&](const AidlDefinedType& type) {
     // BackingType is filled in for all known enums, including imported enums,
@@ -412,5 +523,132 @@ bool AidlTypenames::Autofill() const {
   return success;
 }
 
+namespace {
+const AidlConstantValue* AsConstantValue(const AidlNode& node) {
+  struct ConstantValueVisitor : AidlVisitor {
+    const AidlConstantValue* value = nullptr;
+    void Visit(const AidlConstantValue& v) override { value = &v; }
+    void Visit(const AidlConstantReference& v) override { value = &v; }
+    void Visit(const AidlUnaryConstExpression& v) override { value = &v; }
+    void Visit(const AidlBinaryConstExpression& v) override { value = &v; }
+  } visitor;
+  node.DispatchVisit(visitor);
+  return visitor.value;
+}
+
+// Only the references reachable from the main document are resolved while loading it. This
+// resolves the rest of |type| against the types which are loaded.
+bool ResolveConstantReferences(const AidlTypenames& typenames, const AidlDefinedType& type) {
+  bool success = true;
+  std::vector<const AidlDefinedType*> scopes;
+  ForEachNode(
+      type,
+      [&](const AidlNode& n) {
+        if (auto defined_type = AidlCast<AidlDefinedType>(n); defined_type) {
+          scopes.push_back(defined_type);
+          return;
+        }
+        auto ref = AidlCast<AidlConstantReference>(n);
+        if (!ref || ref->IsResolved() || scopes.empty()) return;
+        const auto& ref_type = ref->GetRefType();
+        if (ref_type && !ref_type->IsResolved() &&
+            !const_cast<AidlTypeSpecifier&>(*ref_type).Resolve(typenames, scopes.back())) {
+          // The type isn't loaded, so no generated code can use this value.
+          return;
+        }
+        if (!ref->Resolve(scopes.back())) {
+          success = false;
+        }
+      },
+      [&](const AidlNode& n) {
+        if (!scopes.empty() && static_cast<const AidlNode*>(scopes.back()) == &n) {
+          scopes.pop_back();
+        }
+      });
+  return success;
+}
+
+class ConstantEvaluator {
+ public:
+  // Evaluates all the constant values of |type| which can be evaluated.
+  bool Evaluate(const AidlDefinedType& type) {
+    const AidlConstantValue* root = nullptr;
+    ForEachNode(
+        type,
+        [&](const AidlNode& n) {
+          auto value = AsConstantValue(n);
+          if (!value || root) return;
+          root = value;
+          if (IsEvaluable(*value) && !value->Evaluate()) {
+            success_ = false;
+          }
+        },
+        [&](const AidlNode& n) {
+          if (root == &n) root = nullptr;
+        });
+    return success_;
+  }
+
+ private:
+  // A value is evaluable when all its references are resolved and none is circular.
+  bool IsEvaluable(const AidlConstantValue& value) {
+    if (auto it = evaluable_.find(&value); it != evaluable_.end()) return it->second;
+    if (!visiting_.insert(&value).second) {
+      AIDL_ERROR(value) << "Found a circular reference: " << value.Literal();
+      success_ = false;
+      return false;
+    }
+    bool evaluable = true;
+    ForEachNodeTopDown(value, [&](const AidlNode& n) {
+      auto ref = AidlCast<AidlConstantReference>(n);
+      if (evaluable && ref) {
+        evaluable = ref->IsResolved() && IsEvaluable(*ref->Resolve(nullptr));
+      }
+    });
+    visiting_.erase(&value);
+    return evaluable_[&value] = evaluable;
+  }
+
+  bool success_ = true;
+  std::map<const AidlConstantValue*, bool> evaluable_;
+  std::set<const AidlConstantValue*> visiting_;
+};
+}  // namespace
+
+bool AidlTypenames::Freeze() {
+  vector<const AidlDefinedType*> roots;
+  for (const auto& type : MainDocument().DefinedTypes()) {
+    roots.push_back(type.get());
+  }
+  return Freeze(roots);
+}
+
+bool AidlTypenames::Freeze(const vector<const AidlDefinedType*>& roots) {
+  if (frozen_) return true;
+  bool success = true;
+  // A resolved constant reference can reach another type, whose references need resolving too.
+  set<const AidlDefinedType*> seen;
+  vector<const AidlDefinedType*> top_level_types;
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (const auto& type : ReachableTypes(roots)) {
+      if (type->GetParentType() == nullptr && seen.insert(type).second) {
+        success &= ResolveConstantReferences(*this, *type);
+        top_level_types.push_back(type);
+        changed = true;
+      }
+    }
+  }
+  ConstantEvaluator evaluator;
+  for (const auto& type : top_level_types) {
+    success &= evaluator.Evaluate(*type);
+  }
+  for (const auto& type : top_level_types) {
+    ForEachNodeTopDown(*type, [](const AidlNode& n) { n.Freeze(); });
+  }
+  frozen_ = true;
+  return success;
+}
+
 }  // namespace aidl
 }  // namespace android
@@ -58,7 +58,20 @@ namespace aidl {
 class AidlTypenames final {
  public:
   AidlTypenames() = default;
+  ~AidlTypenames();
+  AidlTypenames(AidlTypenames&&) = default;
+  AidlTypenames& operator=(AidlTypenames&&) = default;
+
   bool AddDocument(std::unique_ptr<AidlDocument> doc);
+  // Registers the types of |doc|, a declaration of a preprocessed file, by name only. |doc| isn't
+  // kept. LoadLazyType() of one of these names calls |load|, which adds the declaration to the
+  // given typenames with AddDocument() and returns false on errors. Names are skipped like in
+  // AddDocument().
+  bool AddLazyDocument(const AidlDocument& doc, std::function<bool(AidlTypenames&)> load);
+  // Loads the declaration of |type_name| if it was registered by AddLazyDocument() and isn't
+  // loaded yet. Returns false only if loading it fails. Lookups never load declarations, so type
+  // resolution calls this before it looks a type up.
+  bool LoadLazyType(const string& type_name);
   const std::vector<std::unique_ptr<AidlDocument>>& AllDocuments() const { return documents_; }
   const AidlDocument& MainDocument() const;
   static bool IsBuiltinTypename(const string& type_name);
@@ -90,14 +103,36 @@ class AidlTypenames final {
   // Returns the AidlParcelable of the given type, or nullptr if the type
   // is not an AidlParcelable;
   const AidlParcelable* GetParcelable(const AidlTypeSpecifier& type) const;
-  // Iterates over all defined types
+  // Iterates over all defined types. Lazily registered types which were never loaded aren't
+  // included.
   void IterateTypes(const std::function<void(const AidlDefinedType&)>& body) const;
+  // Returns the types which |document| uses, directly or through other types, including its own.
+  // A type brings along the whole top-level type which declares it.
+  set<const AidlDefinedType*> ReachableTypes(const AidlDocument& document) const;
+  set<const AidlDefinedType*> ReachableTypes(const vector<const AidlDefinedType*>& roots) const;
   // Fixes AST after type/ref resolution before validation
   bool Autofill() const;
 
+  // Computes all lazily evaluated state (e.g. base types of arrays and constant values) of the
+  // types reachable from the main document, after which they are never modified. Generators can
+  // then share them across threads. Types which aren't reachable are left untouched, so they
+  // can't be used after this. No documents can be added after this. Returns false if a constant
+  // of a reachable type can't be evaluated.
+  bool Freeze();
+  // Same as above, but for the types reachable from |roots|.
+  bool Freeze(const vector<const AidlDefinedType*>& roots);
+  bool IsFrozen() const { return frozen_; }
+
  private:
+  bool IsKnownTypename(const string& type_name) const;
+
   map<string, AidlDefinedType*> defined_types_;
   std::vector<std::unique_ptr<AidlDocument>> documents_;
+  // Types registered by AddLazyDocument() and the loaders of their declarations. A loader is
+  // cleared once it has run.
+  map<string, size_t> lazy_names_;
+  std::vector<std::function<bool(AidlTypenames&)>> lazy_loads_;
+  bool frozen_ = false;
 };
 
 }  // namespace aidl
@@ -16,15 +16,20 @@
 
 #include "aidl.h"
 
+#include <android-base/file.h>
 #include <android-base/format.h>
 #include <android-base/stringprintf.h>
+#include <android-base/strings.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <variant>
 #include <vector>
 
@@ -37,10 +42,13 @@
 #include "aidl_to_ndk.h"
 #include "aidl_to_rust.h"
 #include "comments.h"
+#include "document_cache.h"
 #include "logging.h"
 #include "options.h"
 #include "parser.h"
 #include "preprocess.h"
+#include "session.h"
+#include "sha1.h"
 #include "tests/fake_io_delegate.h"
 
 using android::aidl::test::FakeIoDelegate;
@@ -52,6 +60,7 @@ using std::unique_ptr;
 using std::variant;
 using std::vector;
 using testing::HasSubstr;
+using testing::Not;
 using testing::TestParamInfo;
 using testing::internal::CaptureStderr;
 using testing::internal::GetCapturedStderr;
@@ -424,6 +433,24 @@ TEST_P(AidlTest, ParsesUtf8Annotations) {
   EXPECT_TRUE(interface->GetMethods()[0]->GetType().IsUtf8InCpp());
 }
 
+TEST_P(AidlTest, HasAnnotationTracksAnnotatedTypes) {
+  auto parse_result =
+      Parse("a/IFoo.aidl", "package a; interface IFoo { @nullable @utf8InCpp String f(); }",
+            typenames_, GetLanguage());
+  ASSERT_NE(nullptr, parse_result);
+  const AidlInterface* interface = parse_result->AsInterface();
+  ASSERT_NE(nullptr, interface);
+  ASSERT_FALSE(interface->GetMethods().empty());
+  const AidlTypeSpecifier& type = interface->GetMethods()[0]->GetType();
+  EXPECT_TRUE(type.HasAnnotation(AidlAnnotation::Type::NULLABLE));
+  EXPECT_TRUE(type.HasAnnotation(AidlAnnotation::Type::UTF8_IN_CPP));
+  EXPECT_FALSE(type.HasAnnotation(AidlAnnotation::Type::SENSITIVE_DATA));
+  EXPECT_EQ(nullptr, type.GetAnnotation(AidlAnnotation::Type::SENSITIVE_DATA));
+  ASSERT_NE(nullptr, type.GetAnnotation(AidlAnnotation::Type::NULLABLE));
+  EXPECT_EQ("nullable", type.GetAnnotation(AidlAnnotation::Type::NULLABLE)->GetName());
+  EXPECT_FALSE(interface->HasAnnotation(AidlAnnotation::Type::NULLABLE));
+}
+
 TEST_P(AidlTest, VintfRequiresStructuredAndStability) {
   AidlError error;
   const string expected_stderr =
@@ -678,6 +705,58 @@ TEST_F(AidlTest, UnionSupportJavaDeriveEquals) {
   EXPECT_THAT(java_out, testing::HasSubstr(expected));
 }
 
+TEST_F(AidlTest, CppUnionReadsAlternativeInPlace) {
+  io_delegate_.SetFileContents(
+      "a/Foo.aidl",
+      "package a; import a.Baz; union Foo { int a; int[] b; Baz c; List<Baz> d; String[] e; }");
+  io_delegate_.SetFileContents("a/Baz.aidl", "package a; parcelable Baz { int x; }");
+  io_delegate_.SetFileContents("a/Bar.aidl", "package a; @FixedSize union Bar { int a; long b; }");
+  EXPECT_TRUE(compile_aidl(
+      Options::From("aidl --lang=cpp -I . -o out -h out a/Foo.aidl a/Bar.aidl"), io_delegate_));
+
+  // The vector of the current alternative is read into when the tag doesn't change.
+  string code;
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/a/Foo.cpp", &code));
+  EXPECT_THAT(code, HasSubstr(R"--(
+  case b: {
+    if (getTag() != b) {
+      set<b>();
+    }
+    if ((_aidl_ret_status = _aidl_parcel->readInt32Vector(&get<b>())) != ::android::OK) return _aidl_ret_status;
+    return ::android::OK; }
+)--"));
+  EXPECT_THAT(code, Not(HasSubstr("_aidl_value")));
+
+  // A parcelable of an older version doesn't read the fields it doesn't know, which would keep
+  // those of the previous value. Alternatives other than vectors and strings are reset.
+  EXPECT_THAT(code, HasSubstr(R"--(
+  case c: {
+    set<c>();
+    if ((_aidl_ret_status = _aidl_parcel->readParcelable(&get<c>())) != ::android::OK) return _aidl_ret_status;
+    return ::android::OK; }
+)--"));
+  EXPECT_THAT(code, HasSubstr(R"--(
+  case a: {
+    set<a>();
+)--"));
+  // Reading a vector reads into the elements it keeps, so it's reused only for plain values.
+  EXPECT_THAT(code, HasSubstr(R"--(
+  case d: {
+    set<d>();
+)--"));
+  EXPECT_THAT(code, HasSubstr(R"--(
+  case e: {
+    if (getTag() != e) {
+      set<e>();
+    }
+)--"));
+
+  // A @FixedSize union only holds trivially copyable values.
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/a/Bar.cpp", &code));
+  EXPECT_THAT(code, HasSubstr("int64_t _aidl_value;"));
+  EXPECT_THAT(code, HasSubstr("set<b>(_aidl_value);"));
+}
+
 TEST_F(AidlTest, RejectsJavaDeriveAnnotation) {
   {
     io_delegate_.SetFileContents("a/Foo.aidl",
@@ -807,6 +886,36 @@ TEST_P(AidlTest, WritesComments) {
   EXPECT_EQ((Comments{{"// k1\n"}, {"/* k2 */"}}), interface->GetMethods()[2]->GetComments());
 }
 
+TEST_P(AidlTest, LocationsAfterLongCommentsAndBlanks) {
+  const string expected_stderr =
+      "ERROR: a/Foo.aidl:3.10-20: IBar should be declared in a file called a/IBar.aidl\n";
+  const string file_contents = "package a;\t" + string(100, ' ') + "/* " + string(100, '*') +
+                               "\n" + string(100, '/') + "\n  long */ interface IBar {}";
+  CaptureStderr();
+  EXPECT_EQ(nullptr, Parse("a/Foo.aidl", file_contents, typenames_, GetLanguage()));
+  EXPECT_EQ(expected_stderr, GetCapturedStderr());
+}
+
+TEST_P(AidlTest, KeywordsArePrefixesOfIdentifiers) {
+  const string contents = R"(package a;
+        parcelable Foo {
+          int in_;
+          int outer;
+          int interfaces;
+          boolean true_ = false;
+          String parcelable_that_has_a_very_long_name_to_span_multiple_blocks;
+        })";
+  CaptureStderr();
+  const AidlDefinedType* foo = Parse("a/Foo.aidl", contents, typenames_, GetLanguage());
+  ASSERT_NE(nullptr, foo);
+  EXPECT_EQ("", GetCapturedStderr());
+  std::vector<string> names;
+  for (const auto& field : foo->GetFields()) names.push_back(field->GetName());
+  EXPECT_EQ((std::vector<string>{"in_", "outer", "interfaces", "true_",
+                                 "parcelable_that_has_a_very_long_name_to_span_multiple_blocks"}),
+            names);
+}
+
 TEST_P(AidlTest, CppHeaderCanBeIdentifierAsWell) {
   io_delegate_.SetFileContents("p/cpp_header.aidl",
                                R"(package p;
@@ -862,6 +971,262 @@ TEST_F(AidlTest, ParsesPreprocessedFileWithWhitespace) {
   EXPECT_TRUE(typenames_.ResolveTypename("b.IBar").is_resolved);
 }
 
+TEST_F(AidlTest, ParsesPreprocessedFileLazily) {
+  // Enough declarations to span several chunks, with brackets and terminators in comments and
+  // literals, which don't end declarations.
+  string contents;
+  for (int i = 0; i < 2000; i++) {
+    contents += StringPrintf(
+        "/**\n * @hide\n * ; }\n */\n@JavaDerive(equals=true) parcelable p.Foo%d {\n"
+        "  const String S = \"};\"; // };\n  const char C = '}';\n  const int[] A = {1, 2};\n"
+        "}\n",
+        i);
+  }
+  contents += "interface p.IBar; parcelable p.Baz cpp_header \"baz;}.h\";";
+  io_delegate_.SetFileContents("path", contents);
+  CaptureStderr();
+  EXPECT_TRUE(Parser::ParsePreprocessedLazily("path", io_delegate_, typenames_));
+  EXPECT_EQ(GetCapturedStderr(), "");
+  EXPECT_EQ(typenames_.AllDocuments().size(), 0u);
+
+  // Lookups don't load declarations.
+  EXPECT_EQ(typenames_.TryGetDefinedType("p.Foo1999"), nullptr);
+  EXPECT_EQ(typenames_.AllDocuments().size(), 0u);
+
+  // Only the declaration of a type which is loaded is parsed again and kept.
+  EXPECT_TRUE(typenames_.LoadLazyType("p.Foo1999"));
+  const AidlDefinedType* last = typenames_.TryGetDefinedType("p.Foo1999");
+  ASSERT_NE(last, nullptr);
+  EXPECT_TRUE(last->IsHidden());
+  EXPECT_EQ(last->GetConstantDeclarations().size(), 3u);
+  EXPECT_EQ(typenames_.AllDocuments().size(), 1u);
+  // Loading a type again or an unknown type does nothing.
+  EXPECT_TRUE(typenames_.LoadLazyType("p.Foo1999"));
+  EXPECT_TRUE(typenames_.LoadLazyType("p.Foo2000"));
+  EXPECT_EQ(typenames_.AllDocuments().size(), 1u);
+  EXPECT_FALSE(typenames_.ResolveTypename("p.Foo2000").is_resolved);
+
+  EXPECT_TRUE(typenames_.LoadLazyType("p.IBar"));
+  EXPECT_TRUE(typenames_.ResolveTypename("p.IBar").is_resolved);
+  // Unstructured parcelables can still be referenced by their simple names.
+  EXPECT_TRUE(typenames_.LoadLazyType("Baz"));
+  EXPECT_TRUE(typenames_.ResolveTypename("Baz").is_resolved);
+  EXPECT_EQ(typenames_.AllDocuments().size(), 3u);
+
+  // Locations point into the whole file.
+  io_delegate_.SetFileContents("broken", "parcelable p.A;\ninterface p.IB {\n  const int X = ;\n}");
+  CaptureStderr();
+  EXPECT_FALSE(Parser::ParsePreprocessedLazily("broken", io_delegate_, typenames_));
+  EXPECT_THAT(GetCapturedStderr(), HasSubstr("broken:3.16-18:"));
+
+  io_delegate_.SetFileContents("empty", "// nothing\n");
+  CaptureStderr();
+  EXPECT_FALSE(Parser::ParsePreprocessedLazily("empty", io_delegate_, typenames_));
+  EXPECT_THAT(GetCapturedStderr(), HasSubstr("syntax error"));
+}
+
+TEST_F(AidlTest, CompilesWithLazyPreprocessedFile) {
+  io_delegate_.SetFileContents("preprocessed",
+                               "parcelable p.Unused { int x; }\n"
+                               "parcelable p.Bar { p.Baz baz; }\n"
+                               "enum p.Baz { A, B }\n");
+  io_delegate_.SetFileContents("p/IFoo.aidl", "package p; interface IFoo { void f(in Bar bar); }");
+  Options options =
+      Options::From("aidl --lang=java --lazy_preprocessed -p preprocessed -o out p/IFoo.aidl");
+  CaptureStderr();
+  EXPECT_TRUE(compile_aidl(options, io_delegate_));
+  EXPECT_EQ(GetCapturedStderr(), "");
+
+  // Other tasks take the option too. The loaders don't refer to the typenames, which check_api
+  // moves.
+  Options dump_options =
+      Options::From("aidl --dumpapi --lazy_preprocessed -p preprocessed -o dump p/IFoo.aidl");
+  CaptureStderr();
+  EXPECT_TRUE(dump_api(dump_options, io_delegate_));
+  EXPECT_EQ(GetCapturedStderr(), "");
+  string dumped;
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("dump/p/IFoo.aidl", &dumped));
+  EXPECT_THAT(dumped, HasSubstr("void f(in p.Bar bar);"));
+}
+
+namespace {
+// Describes every node of |doc| with its location and comments, in traversal order.
+string DescribeNodes(const AidlDocument& doc) {
+  struct Describer : AidlVisitor {
+    std::ostringstream out;
+    void Visit(const AidlDocument&) override { out << "document"; }
+    void Visit(const AidlInterface& n) override { out << "interface " << n.GetName(); }
+    void Visit(const AidlParcelable& n) override { out << "parcelable " << n.GetName(); }
+    void Visit(const AidlStructuredParcelable& n) override { out << "struct " << n.GetName(); }
+    void Visit(const AidlUnionDecl& n) override { out << "union " << n.GetName(); }
+    void Visit(const AidlEnumDeclaration& n) override { out << "enum " << n.GetName(); }
+    void Visit(const AidlEnumerator& n) override { out << "enumerator " << n.GetName(); }
+    void Visit(const AidlMethod& n) override { out << "method " << n.GetName(); }
+    void Visit(const AidlVariableDeclaration& n) override { out << "variable " << n.GetName(); }
+    void Visit(const AidlConstantDeclaration& n) override { out << "constant " << n.GetName(); }
+    void Visit(const AidlArgument& n) override { out << "argument " << n.GetName(); }
+    void Visit(const AidlTypeSpecifier& n) override {
+      out << "type " << n.GetName() << (n.IsArray() ? "[]" : "");
+    }
+    void Visit(const AidlConstantValue& n) override { out << "value " << n.Literal(); }
+    void Visit(const AidlConstantReference& n) override { out << "ref " << n.GetFieldName(); }
+    void Visit(const AidlUnaryConstExpression& n) override { out << "unary " << n.Op(); }
+    void Visit(const AidlBinaryConstExpression& n) override { out << "binary " << n.Op(); }
+    void Visit(const AidlAnnotation& n) override {
+      out << "annotation " << n.GetName();
+      for (const auto& [name, _] : n.GetParameters()) out << " " << name;
+    }
+  } describer;
+  ForEachNodeTopDown(doc, [&](const AidlNode& node) {
+    node.DispatchVisit(describer);
+    describer.out << " @" << node.GetLocation();
+    for (const auto& comment : node.GetComments()) describer.out << " " << comment.body;
+    describer.out << "\n";
+  });
+  return describer.out.str();
+}
+}  // namespace
+
+TEST_F(AidlTest, DescentParserBuildsTheSameAstAsBison) {
+  const vector<string> inputs = {
+      // Valid
+      "// leading\npackage p; /* a */ import q.Bar;\nimport q.IBaz;\n"
+      "/** doc */ @VintfStability @JavaDerive(equals=true, toString=true)\n"
+      "parcelable Foo<T, U> {\n"
+      "  // field\n  @nullable String s = \"x\";\n  int[] a = {1, 2, -3,};\n"
+      "  List<Map<String, List<T>>> nested;\n  byte[16] fixed;\n  @utf8InCpp String[][2] grid;\n"
+      "  const int C = (1 + 2) * 3 << 4 | ~5 & 0xFF ^ 07 % 2 - -1;\n"
+      "  /** c */ @Hide const boolean B = 1 < 2 && 3 >= 4 || !(C != 5) == true;\n"
+      "  const long L = 10L; const float F = 1.5f; const double D = .5e3;\n"
+      "  const char X = 'x'; const String S = \"a\" + \"b\";\n"
+      "  @Backing(type=\"int\") enum E { A = C, B, }\n"
+      "  union Inner { int i; String s = q.Bar.K; }\n"
+      "  interface INested { void f(); }\n"
+      "}\n",
+      "package p;\n/** doc */ oneway interface IFoo {\n"
+      "  /** m */ @UnsupportedAppUsage oneway void a(in int[] x, out List<String> y, inout Foo z);\n"
+      "  @nullable String b(@nullable IBinder c) = 3;\n"
+      "  void c(in @nullable ParcelFileDescriptor d);\n"
+      "  const int X = 1; const String Y = \"y\";\n"
+      "}\n",
+      "package p; @Backing(type=\"byte\") enum Foo { A = 1 << 2, B = A | 1, /** d */ C }",
+      "package p; parcelable Foo cpp_header \"foo.h\" ndk_header \"foo_ndk.h\";",
+      "package p; interface IFoo;",
+      "package p; @JavaOnlyStableParcelable parcelable Foo<T>;",
+      "package p; union Foo { @nullable String[] a; Map<String, Foo>[] b; }",
+      "parcelable Foo { int cpp_header; }",
+      // Semantic errors
+      "package p; parcelable Foo { @nullable @nullable String a; }",
+      "package p; @JavaDerive(equals=true, equals=false) parcelable Foo {}",
+      "package p; parcelable Foo { int a = 0x1FFFFFFFFFFFFFFFFF; int b = 99999999999999999999; }",
+      "package p; interface IFoo { void f() = 99999999999999999999; }",
+      "package p; parcelable Foo { List<@nullable String> a; int @nullable [] b; int[][] c; }",
+      // Syntax errors
+      "package p; parcelable Foo { int a }",
+      "package p; interface IFoo { void f(in int a,); }",
+      "package p; parcelable Foo { const int X = 1 +; }",
+      "package p; enum Foo { A B }",
+      "package p; parcelable Foo { List<String>> a; }",
+      "",
+  };
+  for (const auto& input : inputs) {
+    SCOPED_TRACE(input);
+    io_delegate_.SetFileContents("p/Foo.aidl", input);
+    map<Options::ParserKind, string> results;
+    for (auto kind : {Options::ParserKind::BISON, Options::ParserKind::DESCENT}) {
+      AidlTypenames typenames;
+      CaptureStderr();
+      const AidlDocument* doc = Parser::Parse("p/Foo.aidl", io_delegate_, typenames,
+                                              /*is_preprocessed=*/false, /*cache=*/nullptr, kind);
+      results[kind] = GetCapturedStderr() + (doc ? DescribeNodes(*doc) : "no document");
+    }
+    EXPECT_EQ(results[Options::ParserKind::BISON], results[Options::ParserKind::DESCENT]);
+  }
+}
+
+TEST_F(AidlTest, CacheDirReusesParsedImports) {
+  auto compile = [](FakeIoDelegate& io_delegate, AidlTypenames& typenames) {
+    io_delegate.SetFileContents("p/IFoo.aidl",
+                                "package p; import q.Bar; import q.IBaz;\n"
+                                "interface IFoo { void foo(in Bar bar, IBaz baz); }");
+    io_delegate.SetFileContents("q/Bar.aidl", R"(package q;
+/** @hide */
+@JavaDerive(toString=true)
+parcelable Bar {
+  const int X = (1 << 2) + 1;
+  /** @deprecated use ss */
+  @nullable String s = "s";
+  String[] ss = {"a", "b"};
+  List<String> l;
+  char c = 'c';
+  float f = -1.5f;
+  boolean b = !false;
+  long hex = 0x10;
+  E e = E.B;
+  union U { int a = X; long b; }
+  enum E { A, B = A + 2, C }
+})");
+    io_delegate.SetFileContents("q/IBaz.aidl", R"(package q;
+interface IBaz {
+  const String S = "s";
+  oneway void a(in int[] x) = 1;
+  @nullable String b(inout int[] y) = 2;
+})");
+    Options options =
+        Options::From("aidl --lang=java --include=. --cache_dir=cache p/IFoo.aidl");
+    vector<string> imported_files;
+    return ::android::aidl::internals::load_and_validate_aidl("p/IFoo.aidl", options, io_delegate,
+                                                              &typenames, &imported_files);
+  };
+  // Dumps the imported types like dump_api does, so that the cached documents are checked
+  // independently of the cache codec.
+  auto dump = [](const AidlTypenames& typenames) {
+    string dump;
+    auto writer = CodeWriter::ForString(&dump);
+    DumpVisitor visitor(*writer, /*inline_constants=*/false);
+    for (const char* name : {"q.Bar", "q.IBaz"}) {
+      typenames.TryGetDefinedType(name)->DispatchVisit(visitor);
+    }
+    writer->Close();
+    return dump;
+  };
+
+  // The first compilation stores the imports, but not the main input.
+  ASSERT_EQ(AidlError::OK, compile(io_delegate_, typenames_));
+  const auto& entries = io_delegate_.OutputFiles();
+  ASSERT_EQ(2u, entries.size());
+  for (const auto& [path, entry] : entries) {
+    EXPECT_TRUE(android::base::StartsWith(path, "cache/")) << path;
+  }
+
+  // Another compilation loads them instead of storing them again.
+  FakeIoDelegate io_delegate;
+  for (const auto& [path, entry] : entries) {
+    io_delegate.SetFileContents(path, entry);
+  }
+  AidlTypenames typenames;
+  ASSERT_EQ(AidlError::OK, compile(io_delegate, typenames));
+  EXPECT_TRUE(io_delegate.OutputFiles().empty());
+  const string uncached = dump(typenames_);
+  EXPECT_THAT(uncached, HasSubstr("/** @deprecated use ss */"));
+  EXPECT_THAT(uncached, HasSubstr("q.Bar.E e = q.Bar.E.B;"));
+  EXPECT_EQ(uncached, dump(typenames));
+  const auto& methods = typenames.TryGetDefinedType("q.IBaz")->GetMethods();
+  ASSERT_EQ(2u, methods.size());
+  EXPECT_EQ("oneway void a(in int[] x) = 1", methods[0]->ToString());
+  EXPECT_EQ("@nullable String b(inout int[] y) = 2", methods[1]->ToString());
+  EXPECT_EQ("q/Bar.aidl", typenames.TryGetDefinedType("q.Bar")->GetLocation().GetFile());
+
+  // Damaged entries are parsed again and replaced.
+  FakeIoDelegate damaged_io_delegate;
+  for (const auto& [path, entry] : entries) {
+    damaged_io_delegate.SetFileContents(path, entry.substr(0, entry.size() - 1));
+  }
+  AidlTypenames damaged_typenames;
+  ASSERT_EQ(AidlError::OK, compile(damaged_io_delegate, damaged_typenames));
+  EXPECT_EQ(entries, damaged_io_delegate.OutputFiles());
+}
+
 TEST_P(AidlTest, PreferImportToPreprocessed) {
   io_delegate_.SetFileContents("preprocessed", "interface another.IBar;");
   io_delegate_.SetFileContents("one/IBar.aidl", "package one; "
@@ -990,6 +1355,77 @@ TEST_F(AidlTest, PreprocessVariousThings) {
   EXPECT_THAT(code, testing::HasSubstr("public static final int y = 43;"));
 }
 
+TEST_F(AidlTest, PreprocessIncrementallyReprocessesOnlyChangedInputs) {
+  io_delegate_.SetFileContents("p/IFoo.aidl",
+                               "package p; import q.Bar; interface IFoo { const int A = Bar.B; }");
+  io_delegate_.SetFileContents("p/Gen.aidl", "package p; parcelable Gen<T> {}");
+  io_delegate_.SetFileContents("q/Bar.aidl", "package q; parcelable Bar { const int B = 1; }");
+  vector<string> args = {"aidl", "--preprocess", "--incremental", "out", "-I.", "p/IFoo.aidl",
+                         "p/Gen.aidl"};
+  // Makes the outputs of the last run the inputs of the next.
+  auto run = [&]() {
+    EXPECT_TRUE(Preprocess(Options::From(args), io_delegate_));
+    string output, index;
+    EXPECT_TRUE(io_delegate_.GetWrittenContents("out", &output));
+    EXPECT_TRUE(io_delegate_.GetWrittenContents("out.idx", &index));
+    io_delegate_.SetFileContents("out", output);
+    io_delegate_.SetFileContents("out.idx", index);
+    return output;
+  };
+
+  EXPECT_EQ(run(),
+            "interface p.IFoo {\n"
+            "  const int A = 1;\n"
+            "}\n"
+            "parcelable p.Gen<T> {\n"
+            "}\n");
+
+  // Edits the section of Gen in the previous output to tell whether it is reused.
+  auto edit_gen = [&](const string& from, const string& to) {
+    string output = io_delegate_.InputFiles().at("out");
+    string index = io_delegate_.InputFiles().at("out.idx");
+    output.replace(output.find(from), from.size(), to);
+    const size_t output_key = index.rfind('\t', index.find('\n')) + 1;
+    index.replace(output_key, index.find('\n') - output_key, DocumentCache::Key(output, false));
+    io_delegate_.SetFileContents("out", output);
+    io_delegate_.SetFileContents("out.idx", index);
+  };
+
+  // An import of IFoo changes, so only IFoo is reprocessed.
+  edit_gen("Gen<T>", "Gen<U>");
+  io_delegate_.SetFileContents("q/Bar.aidl", "package q; parcelable Bar { const int B = 2; }");
+  EXPECT_THAT(run(), HasSubstr("const int A = 2;"));
+  EXPECT_THAT(io_delegate_.InputFiles().at("out"), HasSubstr("Gen<U>"));
+
+  // Gen changes.
+  io_delegate_.SetFileContents("p/Gen.aidl", "package p; parcelable Gen<V> {}");
+  EXPECT_THAT(run(), HasSubstr("Gen<V>"));
+
+  // With other options, everything is reprocessed.
+  edit_gen("Gen<V>", "Gen<W>");
+  args.push_back("-Iother");
+  EXPECT_THAT(run(), HasSubstr("Gen<V>"));
+
+  // A file appears where an import was looked for, so IFoo is reprocessed. The import is now
+  // ambiguous.
+  io_delegate_.SetFileContents("other/q/Bar.aidl", "package q; parcelable Bar { const int B = 3; }");
+  CaptureStderr();
+  EXPECT_FALSE(Preprocess(Options::From(args), io_delegate_));
+  EXPECT_THAT(GetCapturedStderr(), HasSubstr("Duplicate files found for q.Bar"));
+  args.pop_back();
+
+  // Without a matching index, everything is reprocessed.
+  io_delegate_.SetFileContents("out", "garbage");
+  EXPECT_EQ(run(),
+            "interface p.IFoo {\n"
+            "  const int A = 2;\n"
+            "}\n"
+            "parcelable p.Gen<V> {\n"
+            "}\n");
+
+  EXPECT_FALSE(Options::From("aidl --lang=java --incremental -o out -I. p/IFoo.aidl").Ok());
+}
+
 TEST_F(AidlTest, AllowMultipleUnstructuredNestedParcelablesInASingleDocument) {
   io_delegate_.SetFileContents("p/IFoo.aidl",
                                "package p;\n"
@@ -1265,6 +1701,32 @@ TEST_F(AidlTest, ApiMappingAcceptsUnstructuredParcelables) {
   EXPECT_EQ("", GetCapturedStderr());
 }
 
+TEST_F(AidlTest, OnlyTypesReachableFromTheInputAreValidated) {
+  io_delegate_.SetFileContents("preprocessed",
+                               "parcelable p.Unused;\n"
+                               "parcelable p.Used;\n"
+                               "parcelable p.Holder { p.Used u; }\n");
+  io_delegate_.SetFileContents("p/IFoo.aidl", "package p; interface IFoo { void f(); }");
+  io_delegate_.SetFileContents("p/IBar.aidl",
+                               "package p; import p.Holder; interface IBar { void f(in Holder h); }");
+
+  // Unstructured parcelables are rejected in a structured interface unless nothing uses them.
+  Options foo = Options::From(
+      "aidl --lang=java --structured --preprocessed=preprocessed -o out p/IFoo.aidl");
+  CaptureStderr();
+  EXPECT_EQ(0, aidl_entry(foo, io_delegate_));
+  EXPECT_EQ("", GetCapturedStderr());
+
+  // p.Used is reached through p.Holder.
+  Options bar = Options::From(
+      "aidl --lang=java --structured --preprocessed=preprocessed -o out p/IBar.aidl");
+  CaptureStderr();
+  EXPECT_NE(0, aidl_entry(bar, io_delegate_));
+  const string err = GetCapturedStderr();
+  EXPECT_THAT(err, HasSubstr("p.Used is not structured"));
+  EXPECT_THAT(err, Not(HasSubstr("p.Unused")));
+}
+
 TEST_F(AidlTest, FailOnParcelable) {
   const string expected_foo_stderr =
       "ERROR: p/IFoo.aidl:1.22-27: Refusing to generate code with unstructured parcelables. "
@@ -2087,6 +2549,411 @@ TEST_F(AidlTest, ReorderNestedTypesForCppOutput) {
   EXPECT_LE(code.find("class F"), code.find("class E"));
 }
 
+TEST_F(AidlTest, HeaderForwardDeclsMovesSignatureOnlyIncludesToSource) {
+  io_delegate_.SetFileContents("p/IFoo.aidl", R"(
+    package p;
+    import q.Bar;
+    import q.Baz;
+    import q.IQux;
+    interface IFoo {
+      const int LIMIT = 1;
+      parcelable Holder { Baz baz; }
+      Bar get(in Bar bar, IQux qux);
+      @nullable Baz[] find(in Holder holder);
+    })");
+  io_delegate_.SetFileContents("q/Bar.aidl", "package q; parcelable Bar { int x; }");
+  io_delegate_.SetFileContents("q/Baz.aidl", "package q; parcelable Baz { int y; }");
+  io_delegate_.SetFileContents("q/IQux.aidl", "package q; interface IQux { void qux(); }");
+  Options options =
+      Options::From("aidl --lang=cpp --header_forward_decls -I . -o out -h out p/IFoo.aidl");
+  CaptureStderr();
+  EXPECT_TRUE(compile_aidl(options, io_delegate_));
+  EXPECT_EQ(GetCapturedStderr(), "");
+
+  string header, server_header, source;
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/IFoo.h", &header));
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/BnFoo.h", &server_header));
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/IFoo.cpp", &source));
+  // Used only in method signatures.
+  EXPECT_THAT(header, Not(HasSubstr("#include <q/Bar.h>")));
+  EXPECT_THAT(header, Not(HasSubstr("#include <q/IQux.h>")));
+  EXPECT_THAT(header, HasSubstr("class Bar;"));
+  EXPECT_THAT(header, HasSubstr("class IQux;"));
+  EXPECT_THAT(source, HasSubstr("#include <q/Bar.h>"));
+  EXPECT_THAT(source, HasSubstr("#include <q/IQux.h>"));
+  EXPECT_THAT(server_header, HasSubstr("#include <q/Bar.h>"));
+  // Also a field of a nested parcelable.
+  EXPECT_THAT(header, HasSubstr("#include <q/Baz.h>"));
+  EXPECT_THAT(source, Not(HasSubstr("#include <q/Baz.h>")));
+  EXPECT_THAT(header, HasSubstr("#include <optional>"));
+
+  // Without the flag, the header includes everything.
+  Options default_options = Options::From("aidl --lang=cpp -I . -o out -h out p/IFoo.aidl");
+  EXPECT_TRUE(compile_aidl(default_options, io_delegate_));
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/IFoo.h", &header));
+  EXPECT_THAT(header, HasSubstr("#include <q/Bar.h>"));
+  EXPECT_THAT(header, HasSubstr("#include <q/IQux.h>"));
+}
+
+TEST_F(AidlTest, UnityShardsIncludeEachSourceOnce) {
+  io_delegate_.SetFileContents("p/IFoo.aidl", "package p; interface IFoo { void foo(); }");
+  io_delegate_.SetFileContents("p/Bar.aidl", "package p; parcelable Bar { int x; }");
+  io_delegate_.SetFileContents("q/Baz.aidl", "package q; enum Baz { A }");
+  const string args =
+      " -I . -o out -h out/include --unity_shards=2 p/IFoo.aidl p/Bar.aidl q/Baz.aidl";
+  for (const string lang : {"cpp", "ndk"}) {
+    Options options = Options::From("aidl --lang=" + lang + args);
+    EXPECT_TRUE(compile_aidl(options, io_delegate_));
+
+    string shards;
+    for (const string shard : {"out/aidl_unity_0.cpp", "out/aidl_unity_1.cpp"}) {
+      string code;
+      EXPECT_TRUE(io_delegate_.GetWrittenContents(shard, &code)) << shard;
+      shards += code;
+    }
+    for (const string source : {"p/IFoo.cpp", "p/Bar.cpp", "q/Baz.cpp"}) {
+      const string include = "#include \"" + source + "\"\n";
+      EXPECT_NE(shards.find(include), string::npos) << lang << ": " << source;
+      EXPECT_EQ(shards.find(include), shards.rfind(include)) << lang << ": " << source;
+      // The sources are generated by other invocations, which don't touch the shards.
+      string code;
+      EXPECT_FALSE(io_delegate_.GetWrittenContents("out/" + source, &code))
+          << lang << ": " << source;
+    }
+  }
+
+  Options java = Options::From("aidl --lang=java -I . -o out --unity_shards=2 p/IFoo.aidl");
+  EXPECT_FALSE(java.Ok());
+  Options zero = Options::From("aidl --lang=cpp -I . -o out -h out --unity_shards=0 p/IFoo.aidl");
+  EXPECT_FALSE(zero.Ok());
+  // A module may have a single input file. Some shards are empty then.
+  Options single = Options::From("aidl --lang=cpp -I . -o out -h out --unity_shards=2 p/IFoo.aidl");
+  ASSERT_TRUE(single.Ok()) << single.GetErrorMessage();
+  EXPECT_TRUE(compile_aidl(single, io_delegate_));
+  string shards;
+  for (const string shard : {"out/aidl_unity_0.cpp", "out/aidl_unity_1.cpp"}) {
+    string code;
+    EXPECT_TRUE(io_delegate_.GetWrittenContents(shard, &code)) << shard;
+    shards += code;
+  }
+  EXPECT_THAT(shards, HasSubstr("#include \"p/IFoo.cpp\"\n"));
+  EXPECT_THAT(shards, Not(HasSubstr("p/Bar.cpp")));
+}
+
+TEST_F(AidlTest, ExplicitInstantiationsOfGenericParcelables) {
+  io_delegate_.SetFileContents("p/Foo.aidl", "package p; parcelable Foo<T> { int a; }");
+  io_delegate_.SetFileContents("p/Baz.aidl", "package p; parcelable Baz { int x; }");
+  io_delegate_.SetFileContents("p/Bar.aidl", R"(
+    package p;
+    import p.Baz;
+    import p.Foo;
+    parcelable Bar {
+      Foo<int> a;
+      Foo<String>[] b;
+      Foo<Baz> c;
+      Foo<Inner> d;
+      parcelable Inner { int y; }
+    })");
+  Options options = Options::From(
+      "aidl --lang=cpp -I . -o out -h out --explicit_instantiations p/Foo.aidl p/Bar.aidl "
+      "p/Baz.aidl");
+  EXPECT_TRUE(compile_aidl(options, io_delegate_));
+
+  string header;
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/Bar.h", &header));
+  const string instantiations =
+      "extern template class ::p::Foo<::android::String16>;\n"
+      "extern template class ::p::Foo<::p::Baz>;\n"
+      "extern template class ::p::Foo<int32_t>;\n";
+  EXPECT_THAT(header, HasSubstr(instantiations));
+  // Instantiations with types of the same file can't be declared before them.
+  EXPECT_THAT(header, Not(HasSubstr("Foo<::p::Bar::Inner>;")));
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/Foo.h", &header));
+  EXPECT_THAT(header, Not(HasSubstr("extern template")));
+
+  // Sources don't define them, since several sources may use an instantiation.
+  string source;
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/Bar.cpp", &source));
+  EXPECT_THAT(source, Not(HasSubstr("template class")));
+
+  // Invoking aidl once per input file gives the same declarations.
+  Options bar_only = Options::From(
+      "aidl --lang=cpp -I . -o out2 -h out2 --explicit_instantiations p/Bar.aidl");
+  EXPECT_TRUE(compile_aidl(bar_only, io_delegate_));
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out2/p/Bar.h", &header));
+  EXPECT_THAT(header, HasSubstr(instantiations));
+
+  // A single invocation for the module defines each of them once.
+  Options module = Options::From(
+      "aidl --lang=cpp -I . --instantiations out/instantiations.cpp p/Foo.aidl p/Bar.aidl "
+      "p/Baz.aidl");
+  ASSERT_TRUE(module.Ok()) << module.GetErrorMessage();
+  EXPECT_EQ(0, aidl_entry(module, io_delegate_));
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/instantiations.cpp", &source));
+  EXPECT_EQ(
+      "// Explicit instantiations of generic parcelables generated by aidl.\n"
+      "#include <p/Bar.h>\n"
+      "\n"
+      "template class ::p::Foo<::android::String16>;\n"
+      "template class ::p::Foo<::p::Baz>;\n"
+      "template class ::p::Foo<int32_t>;\n",
+      source);
+  EXPECT_FALSE(Options::From("aidl --lang=ndk -I . --instantiations out/i.cpp p/Bar.aidl").Ok());
+  EXPECT_FALSE(
+      Options::From("aidl --lang=ndk -I . -o out -h out --explicit_instantiations p/Bar.aidl")
+          .Ok());
+}
+
+TEST_F(AidlTest, SharedParcelHelperOfModule) {
+  io_delegate_.SetFileContents("p/Foo.aidl", "package p; parcelable Foo { int a; }");
+  io_delegate_.SetFileContents(
+      "p/IBar.aidl",
+      "package p; import p.Foo; interface IBar { void bar(in Foo foo, in List<Foo> foos); }");
+  io_delegate_.SetFileContents("q/Baz.aidl",
+                               "package q; import p.Foo; parcelable Baz { Foo foo; }");
+  const string args = "aidl --lang=java -I . -o out --min_sdk_version=21 ";
+
+  // Without the option, each root class nests its own copy.
+  EXPECT_TRUE(compile_aidl(Options::From(args + "p/IBar.aidl"), io_delegate_));
+  string code;
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/IBar.java", &code));
+  EXPECT_THAT(code, HasSubstr("static class _Parcel {"));
+  EXPECT_THAT(code, HasSubstr("static private <T> T readTypedObject("));
+  EXPECT_THAT(code, HasSubstr("_Parcel.writeTypedList(_data, foos, 0);"));
+
+  // Invoked once per input file, the classes all call the helpers of the same class.
+  const string helper_option = "--shared_parcel_helper=com.example.mymodule.AidlParcel";
+  for (const string input : {"p/IBar.aidl", "p/Foo.aidl", "q/Baz.aidl"}) {
+    EXPECT_TRUE(compile_aidl(Options::From(args + helper_option + " " + input), io_delegate_));
+  }
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/IBar.java", &code));
+  EXPECT_THAT(code, Not(HasSubstr("class _Parcel")));
+  EXPECT_THAT(code, HasSubstr("com.example.mymodule.AidlParcel.writeTypedList(_data, foos, 0);"));
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/q/Baz.java", &code));
+  EXPECT_THAT(code, Not(HasSubstr("class _Parcel")));
+  EXPECT_THAT(code, HasSubstr("com.example.mymodule.AidlParcel.readTypedObject(_aidl_parcel, "
+                              "p.Foo.CREATOR)"));
+  // Only an invocation without input files writes the class.
+  EXPECT_FALSE(
+      io_delegate_.GetWrittenContents("out/com/example/mymodule/AidlParcel.java", nullptr));
+  EXPECT_TRUE(compile_aidl(Options::From(args + helper_option), io_delegate_));
+  string helper;
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/com/example/mymodule/AidlParcel.java", &helper));
+  EXPECT_THAT(helper, HasSubstr("package com.example.mymodule;\n"
+                                "/** @hide */\n"
+                                "public class AidlParcel {\n"));
+  const string parcelable_helper = "  public static <T extends android.os.Parcelable> void ";
+  EXPECT_THAT(helper, HasSubstr("  public static <T> T readTypedObject("));
+  EXPECT_THAT(helper, HasSubstr(parcelable_helper + "writeTypedObject("));
+  EXPECT_THAT(helper, HasSubstr(parcelable_helper + "writeTypedList("));
+
+  EXPECT_FALSE(Options::From("aidl --lang=cpp -I . -o out -h out --shared_parcel_helper=a.B "
+                             "p/Foo.aidl")
+                   .Ok());
+  EXPECT_FALSE(Options::From("aidl --lang=java -I . --shared_parcel_helper=a.B").Ok());
+  EXPECT_FALSE(Options::From("aidl --lang=java -I . -o out --shared_parcel_helper=B").Ok());
+}
+
+TEST_F(AidlTest, CppInterfaceTokenUsesPreEncodedDescriptor) {
+  io_delegate_.SetFileContents("p/IFoo.aidl",
+                               "package p; @Descriptor(\"p.IBar\") interface IFoo { void f(); }");
+  Options options = Options::From("aidl --lang=cpp -I . -o out -h out p/IFoo.aidl");
+  EXPECT_TRUE(compile_aidl(options, io_delegate_));
+
+  string header;
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/IFoo.h", &header));
+  EXPECT_THAT(header, HasSubstr("static constexpr char16_t descriptor_utf16[] = u\"p.IBar\";\n"));
+  EXPECT_THAT(header, HasSubstr("static constexpr size_t descriptor_utf16_length = 6;\n"));
+
+  string source;
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/IFoo.cpp", &source));
+  EXPECT_THAT(source, HasSubstr("_aidl_data.writeInterfaceToken(descriptor_utf16, "
+                                "descriptor_utf16_length);\n"));
+  EXPECT_THAT(source, HasSubstr("if (!(_aidl_data.enforceInterface(descriptor_utf16, "
+                                "descriptor_utf16_length))) {\n"));
+  EXPECT_THAT(source, Not(HasSubstr("getInterfaceDescriptor()")));
+}
+
+TEST_F(AidlTest, CompactMethodsUseSharedMarshaller) {
+  io_delegate_.SetFileContents("p/IFoo.aidl", R"(
+    package p;
+    import p.Bar;
+    interface IFoo {
+      @Compact int add(int a, @utf8InCpp String s, in Bar bar, out Bar result);
+      @Compact void sum(in int[] values);
+      oneway void plain(int a);
+    })");
+  io_delegate_.SetFileContents("p/Bar.aidl", "package p; parcelable Bar { int x; }");
+  Options options = Options::From("aidl --lang=cpp -I . -o out -h out p/IFoo.aidl");
+  CaptureStderr();
+  EXPECT_TRUE(compile_aidl(options, io_delegate_));
+  EXPECT_EQ(GetCapturedStderr(), "");
+
+  string code;
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/IFoo.cpp", &code));
+  // The marshaller is part of the source, once, and needs no other output.
+  const string marshaller = "#ifndef AIDL_CPP_COMPACT_MARSHALLER";
+  EXPECT_NE(code.find(marshaller), string::npos);
+  EXPECT_EQ(code.find(marshaller), code.rfind(marshaller));
+  EXPECT_THAT(code, Not(HasSubstr("#include <aidl/cpp/")));
+  // Its functions are inline, so that a program keeps one copy of them.
+  EXPECT_THAT(code, HasSubstr("inline ::android::status_t Write("));
+  EXPECT_THAT(code, HasSubstr("inline ::android::status_t Read("));
+  // Client and server of add() use tables.
+  EXPECT_THAT(code, HasSubstr("static constexpr ::aidl_compact::Op _aidl_ops[] = "
+                              "{::aidl_compact::INT32, ::aidl_compact::UTF8_STRING, "
+                              "::aidl_compact::PARCELABLE};"));
+  EXPECT_THAT(code, HasSubstr("_aidl_ret_status = ::aidl_compact::Write(&_aidl_data, _aidl_ops, "
+                              "_aidl_values, 3);"));
+  EXPECT_THAT(code, HasSubstr("void* const _aidl_values[] = {_aidl_return, "
+                              "static_cast<::android::Parcelable*>(result)};"));
+  EXPECT_THAT(code, HasSubstr("_aidl_ret_status = ::aidl_compact::Write(_aidl_reply, _aidl_ops, "
+                              "_aidl_values, 2);"));
+  // Arrays aren't supported, so sum() falls back to the expanded code. So does plain().
+  EXPECT_THAT(code, HasSubstr("_aidl_ret_status = _aidl_data.readInt32Vector(&in_values);"));
+  EXPECT_THAT(code, HasSubstr("_aidl_ret_status = _aidl_data.writeInt32(a);"));
+
+  // Without @Compact, there is no marshaller.
+  io_delegate_.SetFileContents("p/IFoo.aidl", "package p; interface IFoo { void foo(int a); }");
+  EXPECT_TRUE(compile_aidl(options, io_delegate_));
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/IFoo.cpp", &code));
+  EXPECT_THAT(code, Not(HasSubstr(marshaller)));
+
+  io_delegate_.SetFileContents("p/Bar.aidl", "package p; @Compact parcelable Bar { int x; }");
+  Options bar_options = Options::From("aidl --lang=cpp -I . -o out -h out p/Bar.aidl");
+  CaptureStderr();
+  EXPECT_FALSE(compile_aidl(bar_options, io_delegate_));
+  EXPECT_THAT(GetCapturedStderr(), HasSubstr("@Compact is not available"));
+}
+
+TEST_F(AidlTest, SessionCompilesFilesInMemory) {
+  Session session;
+  session.SetFile("p/IFoo.aidl", "package p; import q.Bar; interface IFoo { Bar get(); }");
+  session.SetFile("q/Bar.aidl", "package q; parcelable Bar { int x; }");
+  const vector<string> args = {"aidl", "--lang=java", "-I", ".", "-o", "out", "p/IFoo.aidl"};
+
+  Session::Result result = session.Run(args);
+  EXPECT_EQ(result.exit_code, 0);
+  EXPECT_THAT(result.diagnostics, testing::IsEmpty());
+  ASSERT_EQ(result.outputs.count("out/p/IFoo.java"), 1u);
+  EXPECT_THAT(result.outputs["out/p/IFoo.java"], HasSubstr("public q.Bar get()"));
+  EXPECT_EQ(result.outputs.size(), 1u);
+  // Nothing is written through the real file system.
+  EXPECT_THAT(io_delegate_.OutputFiles(), testing::IsEmpty());
+
+  // Later runs see changed files, while unchanged imports come from the cache of the session.
+  session.SetFile("p/IFoo.aidl", "package p; import q.Bar; interface IFoo {\n  Bar get(;\n}");
+  result = session.Run(args);
+  EXPECT_NE(result.exit_code, 0);
+  EXPECT_THAT(result.outputs, testing::IsEmpty());
+  ASSERT_THAT(result.diagnostics, testing::Not(testing::IsEmpty()));
+  EXPECT_TRUE(result.diagnostics[0].is_error);
+  EXPECT_EQ(result.diagnostics[0].file, "p/IFoo.aidl");
+  EXPECT_EQ(result.diagnostics[0].line, 2);
+  EXPECT_THAT(result.diagnostics[0].message, HasSubstr("syntax error"));
+  EXPECT_THAT(result.diagnostics_text, HasSubstr("ERROR: p/IFoo.aidl:2."));
+
+  session.RemoveFile("q/Bar.aidl");
+  session.SetFile("p/IFoo.aidl", "package p; import q.Bar; interface IFoo { Bar get(); }");
+  result = session.Run(args);
+  EXPECT_NE(result.exit_code, 0);
+}
+
+TEST_F(AidlTest, SessionUsesCacheDirOfCaller) {
+  Session session;
+  session.SetFile("p/IFoo.aidl", "package p; import q.Bar; interface IFoo { Bar get(); }");
+  session.SetFile("q/Bar.aidl", "package q; parcelable Bar { int x; }");
+  const vector<string> args = {"aidl",        "--lang=java", "--cache_dir", "cache", "-I",
+                               ".",           "-o",          "out",         "p/IFoo.aidl"};
+
+  // The entries of the cache are written like other outputs, instead of to the session cache.
+  Session::Result result = session.Run(args);
+  EXPECT_EQ(result.exit_code, 0);
+  EXPECT_EQ(result.outputs.count("out/p/IFoo.java"), 1u);
+  vector<string> entries;
+  for (const auto& [path, contents] : result.outputs) {
+    if (android::base::StartsWith(path, "cache/")) entries.push_back(path);
+  }
+  EXPECT_THAT(entries, Not(testing::IsEmpty()));
+  EXPECT_EQ(result.outputs.size(), entries.size() + 1);
+}
+
+TEST_F(AidlTest, SessionCacheKeepsDocumentsOfCurrentFiles) {
+  Session session;
+  session.SetFile("p/IFoo.aidl", "package p; import q.Bar; interface IFoo { Bar get(); }");
+  session.SetFile("q/Bar.aidl", "package q; parcelable Bar { int x; }");
+  const vector<string> args = {"aidl", "--lang=java", "-I", ".", "-o", "out", "p/IFoo.aidl"};
+
+  EXPECT_EQ(session.Run(args).exit_code, 0);
+  const size_t count = session.CachedDocumentCount();
+  EXPECT_GT(count, 0u);
+
+  // Replaced contents don't pile up.
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(session.EditFile("q/Bar.aidl", {{1, 33, 1, 34, i % 2 ? "x" : "y"}}));
+    EXPECT_EQ(session.Run(args).exit_code, 0);
+    EXPECT_EQ(session.CachedDocumentCount(), count);
+    session.SetFile("p/IFoo.aidl",
+                    StringPrintf("package p; import q.Bar; interface IFoo { Bar get%d(); }", i));
+    EXPECT_EQ(session.Run(args).exit_code, 0);
+    EXPECT_EQ(session.CachedDocumentCount(), count);
+  }
+
+  session.RemoveFile("q/Bar.aidl");
+  EXPECT_EQ(session.CachedDocumentCount(), count - 1);
+  session.ClearFiles();
+  EXPECT_EQ(session.CachedDocumentCount(), 0u);
+}
+
+TEST_F(AidlTest, SessionChecksFilesAffectedByEdits) {
+  Session session;
+  session.SetFile("p/IFoo.aidl", "package p;\nimport q.Bar;\ninterface IFoo {\n  Bar get();\n}\n");
+  session.SetFile("p/IBaz.aidl", "package p;\ninterface IBaz {\n  void baz();\n}\n");
+  session.SetFile("q/Bar.aidl", "package q; parcelable Bar { int x; }");
+  const vector<string> args = {"aidl", "--lang=java", "-I", ".", "-o", "out",
+                               "p/IFoo.aidl", "p/IBaz.aidl"};
+
+  Session::Result result = session.Check(args);
+  EXPECT_EQ(result.exit_code, 0);
+  EXPECT_THAT(result.diagnostics, testing::IsEmpty());
+  EXPECT_THAT(result.outputs, testing::IsEmpty());
+
+  // An edit of an import is seen by the files which use it.
+  ASSERT_TRUE(session.EditFile("q/Bar.aidl", {{1, 29, 1, 32, "Unknown"}}));
+  result = session.Check(args);
+  EXPECT_NE(result.exit_code, 0);
+  EXPECT_THAT(result.diagnostics_text, HasSubstr("Couldn't find import for class Unknown"));
+  EXPECT_THAT(result.diagnostics_text, Not(HasSubstr("IBaz")));
+
+  // Edits span lines and apply in order.
+  ASSERT_TRUE(session.EditFile("q/Bar.aidl", {{1, 29, 1, 36, "int"}}));
+  ASSERT_TRUE(
+      session.EditFile("p/IBaz.aidl", {{2, 17, 3, 13, "\n\n  void baz("}, {1, 1, 1, 1, "\n"}}));
+  result = session.Check(args);
+  ASSERT_EQ(result.diagnostics.size(), 1u);
+  EXPECT_EQ(result.diagnostics[0].file, "p/IBaz.aidl");
+  EXPECT_EQ(result.diagnostics[0].line, 5);
+  EXPECT_THAT(result.diagnostics[0].message, HasSubstr("syntax error"));
+  EXPECT_THAT(result.diagnostics_text, HasSubstr("ERROR: p/IBaz.aidl:5."));
+
+  // Out of range edits change nothing.
+  EXPECT_FALSE(session.EditFile("p/IBaz.aidl", {{1, 1, 1, 1, "x"}, {9, 1, 9, 1, "y"}}));
+  EXPECT_FALSE(session.EditFile("p/IBaz.aidl", {{2, 12, 2, 12, "z"}}));
+  EXPECT_FALSE(session.EditFile("p/IQux.aidl", {}));
+  ASSERT_TRUE(session.EditFile("p/IBaz.aidl", {{1, 1, 2, 1, ""}, {4, 12, 4, 12, ")"}}));
+  result = session.Check(args);
+  EXPECT_EQ(result.exit_code, 0);
+  EXPECT_THAT(result.diagnostics, testing::IsEmpty());
+
+  // A file which was looked up but didn't exist is seen once it is added.
+  ASSERT_TRUE(session.EditFile("p/IFoo.aidl", {{2, 8, 2, 13, "q.Qux"}, {4, 3, 4, 6, "Qux"}}));
+  EXPECT_NE(session.Check(args).exit_code, 0);
+  session.SetFile("q/Qux.aidl", "package q; parcelable Qux { int y; }");
+  result = session.Check(args);
+  EXPECT_EQ(result.exit_code, 0);
+  EXPECT_THAT(result.diagnostics, testing::IsEmpty());
+}
+
 TEST_F(AidlTest, RejectsNestedTypesWithCyclicDeps) {
   const string input_path = "p/IFoo.aidl";
   const string input = R"(
@@ -2486,6 +3353,115 @@ parcelable Data {
             actual);
 }
 
+TEST_F(AidlTest, HashApiMatchesHashGen) {
+  EXPECT_EQ(Sha1Hex(""), "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+  EXPECT_EQ(Sha1Hex("abc"), "a9993e364706816aba3e25717850c26c9cd0d89d");
+  EXPECT_EQ(Sha1Hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+            "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+  EXPECT_EQ(Sha1Hex(string(1000000, 'a')), "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+
+  io_delegate_.SetFileContents("foo/bar/IFoo.aidl",
+                               "// comment\npackage foo.bar;\nimport foo.bar.Data;\n"
+                               "interface IFoo {\n    Data getData();\n"
+                               "    const String STR = \"Hello\";\n}\n");
+  io_delegate_.SetFileContents("foo/bar/Data.aidl",
+                               "// comment\npackage foo.bar;\n"
+                               "parcelable Data {\n   int x = 10;\n   @nullable String[] c;\n}\n");
+  // The hashes were taken from build/hash_gen.sh run over the output of --dumpapi.
+  const std::pair<string, string> cases[] = {
+      {"latest-version", "19d6a1991e2365a9d7753718d5afd682da05c2d9"},
+      {"3", "74368a3fb00108846e3f87a214c6566c3c36fa31"},
+  };
+  for (const auto& [version, hash] : cases) {
+    Options options = Options::From({"aidl", "--hashapi=" + version, "--structured", "-I", ".",
+                                     "hash", "foo/bar/IFoo.aidl", "foo/bar/Data.aidl"});
+    ASSERT_TRUE(hash_api(options, io_delegate_));
+    string actual;
+    EXPECT_TRUE(io_delegate_.GetWrittenContents("hash", &actual));
+    EXPECT_EQ(hash + "\n", actual);
+  }
+  // Nothing but the hash is written.
+  EXPECT_EQ(io_delegate_.OutputFiles().size(), 1u);
+
+  AidlTypenames typenames;
+  Options options = Options::From("aidl --dumpapi --structured -I . --out=dump foo/bar/IFoo.aidl");
+  ASSERT_EQ(internals::load_and_validate_aidl("foo/bar/IFoo.aidl", options, io_delegate_,
+                                              &typenames, nullptr),
+            AidlError::OK);
+  auto files = DumpApiFiles(typenames, options);
+  ASSERT_TRUE(dump_api(options, io_delegate_));
+  string dumped;
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("dump/foo/bar/IFoo.aidl", &dumped));
+  EXPECT_EQ((map<string, string>{{"foo/bar/IFoo.aidl", dumped}}), files);
+}
+
+TEST_F(AidlTest, HashApiHashesTheBytesOfDumpsOnlyWithFrozen) {
+  io_delegate_.SetFileContents("foo/bar/Data.aidl",
+                               "package foo.bar;\nparcelable Data {\n  int x = 10;\n}\n");
+  Options dump_options =
+      Options::From("aidl --dumpapi --structured -I . --out=dump foo/bar/Data.aidl");
+  ASSERT_TRUE(dump_api(dump_options, io_delegate_));
+  string dumped;
+  ASSERT_TRUE(io_delegate_.GetWrittenContents("dump/foo/bar/Data.aidl", &dumped));
+  io_delegate_.SetFileContents("dump/foo/bar/Data.aidl", dumped);
+
+  auto hash = [&](vector<string> args) {
+    Options options = Options::From(args);
+    EXPECT_TRUE(hash_api(options, io_delegate_));
+    string actual;
+    EXPECT_TRUE(io_delegate_.GetWrittenContents("hash", &actual));
+    return actual;
+  };
+  // The same declaration is dumped again without --frozen, which adds another preamble.
+  const string frozen = hash({"aidl", "--hashapi=1", "--frozen", "--structured", "-I", "dump",
+                              "hash", "dump/foo/bar/Data.aidl"});
+  EXPECT_EQ(HashApiFiles({{"foo/bar/Data.aidl", dumped}}, "1") + "\n", frozen);
+  const string dumped_again = hash({"aidl", "--hashapi=1", "--structured", "-I", "dump", "hash",
+                                    "dump/foo/bar/Data.aidl"});
+  EXPECT_NE(frozen, dumped_again);
+
+  AidlTypenames typenames;
+  Options options =
+      Options::From("aidl --hashapi=1 --structured -I dump hash dump/foo/bar/Data.aidl");
+  ASSERT_EQ(internals::load_and_validate_aidl("dump/foo/bar/Data.aidl", options, io_delegate_,
+                                              &typenames, nullptr),
+            AidlError::OK);
+  EXPECT_EQ(HashApiFiles(DumpApiFiles(typenames, options), "1") + "\n", dumped_again);
+
+  EXPECT_FALSE(Options::From("aidl --dumpapi --frozen --out=dump foo/bar/Data.aidl").Ok());
+}
+
+TEST_F(AidlTest, HashApiOfFrozenVersionsMatchesTheirHashFiles) {
+  // The frozen versions are test data next to the test binary.
+  const string api_dir = android::base::GetExecutableDirectory() +
+                         "/aidl_api/aidl-test-versioned-interface/";
+  const string package_dir = "android/aidl/versioned/tests/";
+  for (const string version : {"1", "2", "3"}) {
+    SCOPED_TRACE(version);
+    // Like build/aidl_api.go, a version is hashed along with the one before it.
+    const string previous = version == "1" ? "latest-version" : std::to_string(stoi(version) - 1);
+    vector<string> args = {"aidl", "--hashapi=" + previous, "--frozen", "--structured",
+                           "-I", version, "hash"};
+    for (const string type : {"BazUnion", "Foo", "IFooInterface"}) {
+      const string file = version + "/" + package_dir + type + ".aidl";
+      string contents;
+      ASSERT_TRUE(android::base::ReadFileToString(api_dir + file, &contents));
+      io_delegate_.SetFileContents(file, contents);
+      args.push_back(file);
+    }
+    string hash_file;
+    ASSERT_TRUE(android::base::ReadFileToString(api_dir + version + "/.hash", &hash_file));
+    // Only the last line is checked against, and earlier ones are superseded.
+    const string expected = android::base::Split(android::base::Trim(hash_file), "\n").back();
+
+    Options options = Options::From(args);
+    ASSERT_TRUE(hash_api(options, io_delegate_));
+    string actual;
+    EXPECT_TRUE(io_delegate_.GetWrittenContents("hash", &actual));
+    EXPECT_EQ(expected + "\n", actual);
+  }
+}
+
 TEST_F(AidlTest, ApiDumpWithManualIds) {
   io_delegate_.SetFileContents(
       "foo/bar/IFoo.aidl",
@@ -2940,6 +3916,29 @@ TEST_F(AidlTest, SuccessOnIdenticalApiDumps) {
   EXPECT_TRUE(::android::aidl::check_api(options, io_delegate_));
 }
 
+TEST_F(AidlTest, CheckApiReportsEachDiagnosticOfItsJobs) {
+  Options options = Options::From("aidl --checkapi old new");
+  io_delegate_.SetFileContents("old/p/IBar.aidl", "package p; interface IBar{ void bar();}");
+  io_delegate_.SetFileContents("old/p/IFoo.aidl", "package p; interface IFoo{ void foo();}");
+  io_delegate_.SetFileContents("new/p/IBar.aidl", "package p; interface IBar{}");
+  io_delegate_.SetFileContents("new/p/IFoo.aidl", "package p; interface IFoo{}");
+
+  std::ostringstream out;
+  DiagnosticSink sink(out);
+  sink.KeepRecords();
+  {
+    ScopedDiagnosticSink scope(sink);
+    EXPECT_FALSE(::android::aidl::check_api(options, io_delegate_));
+  }
+  // The types are compared on worker threads, but each message keeps its own record.
+  std::vector<string> files;
+  for (const auto& record : sink.TakeRecords()) {
+    EXPECT_TRUE(record.is_error);
+    files.push_back(record.file);
+  }
+  EXPECT_THAT(files, testing::UnorderedElementsAre("old/p/IBar.aidl", "old/p/IFoo.aidl"));
+}
+
 TEST_F(AidlTest, CheckApi_EnumFieldsWithDefaultValues) {
   Options options = Options::From("aidl --checkapi old new");
   const string foo_definition = "package p; parcelable Foo{ p.Enum e = p.Enum.FOO; }";
@@ -4012,6 +5011,68 @@ TEST_F(AidlTest, ManualIdsWithMetaTransactions) {
   EXPECT_TRUE(compile_aidl(options, io_delegate_));
 }
 
+TEST_F(AidlTest, VersionedProxiesCacheUnsupportedMethods) {
+  // 65 methods need a second word of bits. Oneway methods never learn that they're unsupported.
+  string methods;
+  for (int i = 0; i < 65; i++) {
+    methods += "void m" + std::to_string(i) + "();\n";
+  }
+  io_delegate_.SetFileContents("p/IFoo.aidl",
+                               "package p; interface IFoo {\n" + methods + "oneway void o(); }");
+  string code;
+
+  EXPECT_TRUE(compile_aidl(
+      Options::From("aidl --lang=cpp -I . --version 2 -o out -h out p/IFoo.aidl"), io_delegate_));
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/BpFoo.h", &code));
+  EXPECT_THAT(code, HasSubstr("std::atomic<uint64_t> unsupported_methods_[2] = {};"));
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/IFoo.cpp", &code));
+  EXPECT_THAT(code, HasSubstr(
+                        "if (UNLIKELY(unsupported_methods_[1].load(std::memory_order_relaxed) & "
+                        "(uint64_t{1} << 0))) {\n"
+                        "    if (IFoo::getDefaultImpl()) {\n"
+                        "      return IFoo::getDefaultImpl()->m64();\n"
+                        "    }\n"
+                        "    return ::android::binder::Status::fromStatusT("
+                        "::android::UNKNOWN_TRANSACTION);\n"
+                        "  }\n"));
+  EXPECT_THAT(code,
+              HasSubstr("_aidl_ret_status = remote()->transact(BnFoo::TRANSACTION_m64, "
+                        "_aidl_data, &_aidl_reply, 0);\n"
+                        "  if (UNLIKELY(_aidl_ret_status == ::android::UNKNOWN_TRANSACTION)) {\n"
+                        "    unsupported_methods_[1].fetch_or(uint64_t{1} << 0, "
+                        "std::memory_order_relaxed);\n"));
+  EXPECT_THAT(code, Not(HasSubstr("unsupported_methods_[1].fetch_or(uint64_t{1} << 1,")));
+
+  EXPECT_TRUE(compile_aidl(
+      Options::From("aidl --lang=ndk -I . --version 2 -o out -h out p/IFoo.aidl"), io_delegate_));
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/IFoo.cpp", &code));
+  EXPECT_THAT(code, HasSubstr("_aidl_unsupported_methods[0].fetch_or(uint64_t{1} << 63, "
+                              "std::memory_order_relaxed);"));
+
+  EXPECT_TRUE(compile_aidl(Options::From("aidl --lang=java -I . --version 2 -o out p/IFoo.aidl"),
+                           io_delegate_));
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/IFoo.java", &code));
+  EXPECT_THAT(code, HasSubstr("private final long[] mUnsupportedMethods = new long[2];"));
+  EXPECT_THAT(code, HasSubstr("if ((mUnsupportedMethods[1] & (1L << 0)) != 0) {\n"
+                              "          throw new android.os.RemoteException("
+                              "\"Method m64 is unimplemented.\");\n"));
+  EXPECT_THAT(code, HasSubstr("mUnsupportedMethods[1] |= (1L << 0);"));
+
+  EXPECT_TRUE(compile_aidl(Options::From("aidl --lang=rust -I . --version 2 -o out p/IFoo.aidl"),
+                           io_delegate_));
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/IFoo.rs", &code));
+  EXPECT_THAT(code, HasSubstr("unsupported_methods: [std::sync::atomic::AtomicU64; 2] = "
+                              "Default::default()"));
+  EXPECT_THAT(code, HasSubstr("return self.read_response_m64("
+                              "Err(binder::StatusCode::UNKNOWN_TRANSACTION));"));
+
+  // Unversioned proxies keep transacting, as the remote side may be replaced by a newer one.
+  EXPECT_TRUE(compile_aidl(Options::From("aidl --lang=cpp -I . -o out -h out p/IFoo.aidl"),
+                           io_delegate_));
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/p/IFoo.cpp", &code));
+  EXPECT_THAT(code, Not(HasSubstr("unsupported_methods_")));
+}
+
 TEST_F(AidlTest, FailOnDuplicatedIds) {
   const string expected_stderr =
       "ERROR: IFoo.aidl:3.7-11: Found duplicate method id (3) for method bar\n";
@@ -4317,6 +5378,57 @@ TEST_F(AidlTest, EnforceInterfaceManualPermissionMethod) {
                                              "the method Protected is also annotated"));
 }
 
+TEST_F(AidlTest, EnforcePermissionCpp) {
+  io_delegate_.SetFileContents("a/IFoo.aidl", R"(package a;
+    interface IFoo {
+        @EnforcePermission(anyOf={"INTERNET", "android.Manifest.permission.READ_PHONE_STATE"})
+        void Protected();
+    })");
+
+  Options options = Options::From("aidl --lang=cpp -I . -o out -h out a/IFoo.aidl");
+  CaptureStderr();
+  EXPECT_TRUE(compile_aidl(options, io_delegate_));
+  EXPECT_EQ(GetCapturedStderr(), "");
+  string code;
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/a/IFoo.cpp", &code));
+  EXPECT_THAT(code, HasSubstr("checkPermission(\"android.permission.INTERNET\", _aidl_pid, "
+                              "_aidl_uid) || "
+                              "checkPermission(\"android.permission.READ_PHONE_STATE\""));
+  EXPECT_THAT(code, HasSubstr("if (!_aidl_lookupPermissionCache(1, _aidl_uid, &_aidl_granted))"));
+  EXPECT_THAT(code, HasSubstr("void BnFoo::invalidatePermissionCache()"));
+  // Each object caches the answers of its own checkPermission().
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/a/BnFoo.h", &code));
+  EXPECT_THAT(code, HasSubstr("\n  void invalidatePermissionCache();"));
+  EXPECT_THAT(code, HasSubstr("\n  std::atomic<uint64_t> "
+                              "_aidl_permission_cache[_aidl_permission_cache_size] = {};"));
+  // Only the stub may read or plant decisions.
+  EXPECT_THAT(code, HasSubstr("private:\n  bool _aidl_lookupPermissionCache("));
+}
+
+TEST_F(AidlTest, EnforcePermissionNdk) {
+  io_delegate_.SetFileContents("a/IFoo.aidl", R"(package a;
+    @EnforcePermission(allOf={"INTERNET", "READ_PHONE_STATE"})
+    interface IFoo {
+        void Protected();
+    })");
+
+  Options options = Options::From("aidl --lang=ndk -I . -o out -h out a/IFoo.aidl");
+  CaptureStderr();
+  EXPECT_TRUE(compile_aidl(options, io_delegate_));
+  EXPECT_EQ(GetCapturedStderr(), "");
+  string code;
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/a/IFoo.cpp", &code));
+  EXPECT_THAT(code, HasSubstr("_aidl_impl->checkPermission(\"android.permission.INTERNET\", "
+                              "_aidl_pid, _aidl_uid) && _aidl_impl->checkPermission("));
+  EXPECT_THAT(code, HasSubstr("_aidl_a_IFoo_PermissionCache::lookup(*_aidl_impl, 0, _aidl_uid, "
+                              "&_aidl_granted)"));
+  EXPECT_TRUE(io_delegate_.GetWrittenContents("out/aidl/a/BnFoo.h", &code));
+  EXPECT_THAT(code, HasSubstr("private:\n  friend struct _aidl_a_IFoo_PermissionCache;\n  bool "
+                              "_aidl_lookupPermissionCache("));
+  EXPECT_THAT(code, HasSubstr("virtual bool checkPermission(const char* permission, pid_t pid, "
+                              "uid_t uid) = 0;"));
+}
+
 TEST_F(AidlTest, JavaSuppressLint) {
   io_delegate_.SetFileContents("a/IFoo.aidl", R"(package a;
     @JavaSuppressLint({"NewApi"})
@@ -4332,6 +5444,108 @@ TEST_F(AidlTest, JavaSuppressLint) {
   EXPECT_THAT(code, HasSubstr("@android.annotation.SuppressLint(value = {\"NewApi\"})"));
 }
 
+TEST_F(AidlTest, DiagnosticSinkCollectsMessagesOfItsThread) {
+  // Each thread gets its own files, so that only the diagnostics are shared state.
+  FakeIoDelegate good_io, bad_io;
+  good_io.SetFileContents("a/IGood.aidl", "package a; interface IGood { void f(); }");
+  bad_io.SetFileContents("a/IBad.aidl", "package a; interface IBad { Unknown f(); }");
+
+  // Earlier tests may have left an error in the sink of this thread.
+  AidlErrorLog::clearError();
+  std::ostringstream good_out, bad_out;
+  DiagnosticSink good_sink(good_out), bad_sink(bad_out);
+  // Both threads start compiling only once both have installed their sinks, so that the
+  // compilations interleave.
+  std::atomic<int> ready = 0;
+  auto compile = [&](DiagnosticSink& sink, FakeIoDelegate& io, const string& file) {
+    ScopedDiagnosticSink scope(sink);
+    ready++;
+    while (ready < 2) std::this_thread::yield();
+    Options options = Options::From("aidl --lang=java -I . -o out " + file);
+    return aidl_entry(options, io) == 0;
+  };
+  CaptureStderr();
+  bool good_ok = false, bad_ok = true;
+  std::thread good_thread([&] { good_ok = compile(good_sink, good_io, "a/IGood.aidl"); });
+  std::thread bad_thread([&] { bad_ok = compile(bad_sink, bad_io, "a/IBad.aidl"); });
+  good_thread.join();
+  bad_thread.join();
+
+  EXPECT_TRUE(good_ok);
+  EXPECT_FALSE(bad_ok);
+  EXPECT_FALSE(good_sink.HadError());
+  EXPECT_TRUE(bad_sink.HadError());
+  EXPECT_FALSE(AidlErrorLog::hadError());
+  // Nothing is written until the sinks are flushed.
+  EXPECT_EQ("", bad_out.str());
+  good_sink.Flush();
+  bad_sink.Flush();
+  EXPECT_EQ("", GetCapturedStderr());
+  EXPECT_EQ("", good_out.str());
+  EXPECT_THAT(bad_out.str(), HasSubstr("Failed to resolve 'Unknown'"));
+}
+
+TEST_F(AidlTest, VisitTrackerRecordsUnvisitedNodesOfItsThread) {
+  auto make_type = [](const string& file) {
+    return std::make_unique<AidlTypeSpecifier>(
+        AidlLocation(file, AidlLocation::Source::EXTERNAL), "int", std::nullopt, nullptr,
+        Comments{});
+  };
+  AidlVisitTracker tracker;
+  auto visited = make_type("visited.aidl");
+  visited->MarkVisited();
+  visited.reset();
+  make_type("unvisited.aidl").reset();
+  std::thread([&] { make_type("other_thread.aidl").reset(); }).join();
+
+  const auto& locations = tracker.GetLocationsOfUnvisitedNodes();
+  ASSERT_EQ(1u, locations.size());
+  EXPECT_EQ("unvisited.aidl", locations[0].GetFile());
+}
+
+TEST_F(AidlTest, VisitTrackerIgnoresNodesOfAbandonedDescentParse) {
+  // The descent parser gives up on the syntax error after building some nodes, and the input is
+  // parsed again with bison. Only the nodes bison builds may be reported.
+  io_delegate_.SetFileContents("p/Foo.aidl", "package p; parcelable Foo { int a; String b }");
+  map<Options::ParserKind, size_t> unvisited;
+  for (auto kind : {Options::ParserKind::BISON, Options::ParserKind::DESCENT}) {
+    AidlVisitTracker tracker;
+    {
+      AidlTypenames typenames;
+      CaptureStderr();
+      EXPECT_EQ(nullptr, Parser::Parse("p/Foo.aidl", io_delegate_, typenames,
+                                       /*is_preprocessed=*/false, /*cache=*/nullptr, kind));
+      GetCapturedStderr();
+    }
+    unvisited[kind] = tracker.GetLocationsOfUnvisitedNodes().size();
+  }
+  EXPECT_EQ(unvisited[Options::ParserKind::BISON], unvisited[Options::ParserKind::DESCENT]);
+}
+
+TEST_F(AidlTest, ForEachNodeCallsEnterAndLeaveAroundChildren) {
+  const AidlDefinedType* type =
+      Parse("p/Foo.aidl", "package p; parcelable Foo { String a; List<String> b; }", typenames_,
+            Options::Language::CPP);
+  ASSERT_NE(nullptr, type);
+
+  vector<string> events;
+  auto name = [](const AidlNode& n) {
+    if (auto t = AidlCast<AidlTypeSpecifier>(n); t) return t->GetName();
+    if (auto v = AidlCast<AidlVariableDeclaration>(n); v) return v->GetName();
+    if (auto d = AidlCast<AidlDefinedType>(n); d) return d->GetName();
+    return string("?");
+  };
+  ForEachNode(
+      *type, [&](const AidlNode& n) { events.push_back("+" + name(n)); },
+      [&](const AidlNode& n) { events.push_back("-" + name(n)); });
+  EXPECT_THAT(events, testing::ElementsAre("+Foo", "+a", "+String", "-String", "-a", "+b", "+List",
+                                           "+String", "-String", "-List", "-b", "-Foo"));
+
+  size_t children = 0;
+  ForEachChild(*type, [&](const AidlNode&) { children++; });
+  EXPECT_EQ(2u, children);
+}
+
 class AidlOutputPathTest : public AidlTest {
  protected:
   void SetUp() override {
@@ -4805,6 +6019,68 @@ TEST_F(AidlTest, DefaultShouldMatchWithFixedSizeArray) {
   EXPECT_EQ("", GetCapturedStderr());
 }
 
+TEST_F(AidlTest, FreezeBuildsArrayBaseTypes) {
+  const AidlDefinedType* bar =
+      Parse("a/Bar.aidl", "package a; parcelable Bar { @nullable String[2][3] a; }", typenames_,
+            Options::Language::NDK);
+  ASSERT_NE(nullptr, bar);
+  typenames_.Freeze();
+  EXPECT_TRUE(typenames_.IsFrozen());
+
+  const AidlTypeSpecifier& type = bar->GetFields()[0]->GetType();
+  EXPECT_TRUE(type.IsFrozen());
+  string base_signature, base_base_signature;
+  type.ViewAsArrayBase([&](const AidlTypeSpecifier& base) {
+    EXPECT_TRUE(base.IsMutated());
+    EXPECT_TRUE(base.IsNullable());
+    EXPECT_TRUE(base.IsFrozen());
+    base_signature = base.Signature();
+    base.ViewAsArrayBase(
+        [&](const AidlTypeSpecifier& base_base) { base_base_signature = base_base.Signature(); });
+  });
+  EXPECT_EQ("String[3]", base_signature);
+  EXPECT_EQ("String", base_base_signature);
+  EXPECT_EQ("String[2][3]", type.Signature());
+  EXPECT_FALSE(type.IsMutated());
+}
+
+TEST_F(AidlTest, FreezeEvaluatesConstantsOfImportedTypes) {
+  io_delegate_.SetFileContents("a/Foo.aidl",
+                               "package a; import a.Baz; parcelable Foo { const int X = 1 + 2; "
+                               "const int Y = X * Baz.B; }");
+  io_delegate_.SetFileContents("a/Baz.aidl", "package a; enum Baz { A = 1, B }");
+  const AidlDefinedType* bar =
+      Parse("a/Bar.aidl", "package a; import a.Foo; parcelable Bar { Foo foo; }", typenames_,
+            Options::Language::CPP);
+  ASSERT_NE(nullptr, bar);
+  CaptureStderr();
+  EXPECT_TRUE(typenames_.Freeze());
+  EXPECT_EQ("", GetCapturedStderr());
+
+  const AidlDefinedType* foo = typenames_.TryGetDefinedType("a.Foo");
+  ASSERT_NE(nullptr, foo);
+  EXPECT_EQ("3", foo->GetConstantDeclarations()[0]->ValueString(cpp::ConstantValueDecorator));
+  EXPECT_EQ("6", foo->GetConstantDeclarations()[1]->ValueString(cpp::ConstantValueDecorator));
+}
+
+TEST_F(AidlTest, FreezeLeavesUnreachableTypesUntouched) {
+  io_delegate_.SetFileContents("a/Foo.aidl",
+                               "package a; parcelable Foo { const int X = 2147483647 + 1; }");
+  const AidlDefinedType* bar =
+      Parse("a/Bar.aidl", "package a; import a.Foo; parcelable Bar { int a; }", typenames_,
+            Options::Language::CPP);
+  ASSERT_NE(nullptr, bar);
+  CaptureStderr();
+  EXPECT_TRUE(typenames_.Freeze());
+  EXPECT_EQ("", GetCapturedStderr());
+
+  EXPECT_TRUE(bar->IsFrozen());
+  const AidlDefinedType* foo = typenames_.TryGetDefinedType("a.Foo");
+  ASSERT_NE(nullptr, foo);
+  EXPECT_FALSE(foo->IsFrozen());
+  EXPECT_FALSE(foo->GetConstantDeclarations()[0]->GetValue().IsFrozen());
+}
+
 TEST_F(AidlTest, FixedSizeArrayWithWrongTypeDefaultValue) {
   io_delegate_.SetFileContents("a/Bar.aidl",
                                "package a;\n"
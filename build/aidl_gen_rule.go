@@ -18,7 +18,9 @@ import (
 	"android/soong/android"
 	"android/soong/genrule"
 
+	"fmt"
 	"path/filepath"
+	"strconv"
 	"strings"
 
 	"github.com/google/blueprint"
@@ -43,6 +45,20 @@ var (
 		Description: "AIDL ${lang} ${in}",
 	}, "imports", "lang", "headerDir", "outDir", "optionalFlags")
 
+	aidlUnityRule = pctx.StaticRule("aidlUnityRule", blueprint.RuleParams{
+		Command: `${aidlCmd} --lang=${lang} ${optionalFlags} --structured --unity_shards=${shards} ` +
+			`-h ${headerDir} -o ${outDir} ${imports} ${in}`,
+		CommandDeps: []string{"${aidlCmd}"},
+		Description: "AIDL ${lang} unity sources",
+	}, "imports", "lang", "headerDir", "outDir", "optionalFlags", "shards")
+
+	aidlInstantiationsRule = pctx.StaticRule("aidlInstantiationsRule", blueprint.RuleParams{
+		Command: `${aidlCmd} --lang=cpp ${optionalFlags} --structured --instantiations ${out} ` +
+			`${imports} ${in}`,
+		CommandDeps: []string{"${aidlCmd}"},
+		Description: "AIDL cpp explicit instantiations",
+	}, "imports", "optionalFlags")
+
 	aidlJavaRule = pctx.StaticRule("aidlJavaRule", blueprint.RuleParams{
 		Command: `${aidlCmd} --lang=java ${optionalFlags} --structured --ninja -d ${out}.d ` +
 			`-o ${outDir} ${imports} ${in}`,
@@ -52,6 +68,12 @@ var (
 		Description: "AIDL Java ${in}",
 	}, "imports", "outDir", "optionalFlags")
 
+	aidlJavaParcelHelperRule = pctx.StaticRule("aidlJavaParcelHelperRule", blueprint.RuleParams{
+		Command:     `${aidlCmd} --lang=java ${optionalFlags} --shared_parcel_helper=${class} -o ${outDir}`,
+		CommandDeps: []string{"${aidlCmd}"},
+		Description: "AIDL Java ${class}",
+	}, "class", "outDir", "optionalFlags")
+
 	aidlRustRule = pctx.StaticRule("aidlRustRule", blueprint.RuleParams{
 		Command: `${aidlCmd} --lang=rust ${optionalFlags} --structured --ninja -d ${out}.d ` +
 			`-o ${outDir} ${imports} ${in}`,
@@ -63,24 +85,27 @@ var (
 )
 
 type aidlGenProperties struct {
-	Srcs                []string `android:"path"`
-	AidlRoot            string   // base directory for the input aidl file
-	Imports             []string
-	Headers             []string
-	Stability           *string
-	Min_sdk_version     *string
-	Platform_apis       bool
-	Lang                string // target language [java|cpp|ndk|rust]
-	BaseName            string
-	GenLog              bool
-	Version             string
-	GenRpc              bool
-	GenTrace            bool
-	Unstable            *bool
-	NotFrozen           bool
-	RequireFrozenReason string
-	Visibility          []string
-	Flags               []string
+	Srcs                   []string `android:"path"`
+	AidlRoot               string   // base directory for the input aidl file
+	Imports                []string
+	Headers                []string
+	Stability              *string
+	Min_sdk_version        *string
+	Platform_apis          bool
+	Lang                   string // target language [java|cpp|ndk|rust]
+	BaseName               string
+	GenLog                 bool
+	Version                string
+	GenRpc                 bool
+	GenTrace               bool
+	UnityShards            int
+	ExplicitInstantiations bool   // only for cpp
+	SharedParcelHelper     string // only for java
+	Unstable               *bool
+	NotFrozen              bool
+	RequireFrozenReason    string
+	Visibility             []string
+	Flags                  []string
 }
 
 type aidlGenRule struct {
@@ -132,11 +157,26 @@ func (g *aidlGenRule) GenerateAndroidBuildActions(ctx android.ModuleContext) {
 
 	g.genOutDir = android.PathForModuleGen(ctx)
 	g.genHeaderDir = android.PathForModuleGen(ctx, "include")
+	var genSources android.WritablePaths
 	for _, src := range srcs {
 		outFile, headers := g.generateBuildActionsForSingleAidl(ctx, src)
-		g.genOutputs = append(g.genOutputs, outFile)
+		genSources = append(genSources, outFile)
 		g.genHeaderDeps = append(g.genHeaderDeps, headers...)
 	}
+	if g.properties.UnityShards > 0 {
+		// The unity sources include the sources of the types. Those are then only
+		// dependencies of the compilation rather than sources of their own.
+		g.genOutputs = g.generateBuildActionsForUnitySources(ctx, srcs)
+		g.genHeaderDeps = append(g.genHeaderDeps, genSources.Paths()...)
+	} else {
+		g.genOutputs = genSources
+	}
+	if g.properties.ExplicitInstantiations {
+		g.genOutputs = append(g.genOutputs, g.generateBuildActionsForInstantiations(ctx, srcs))
+	}
+	if g.properties.SharedParcelHelper != "" {
+		g.genOutputs = append(g.genOutputs, g.generateBuildActionsForSharedParcelHelper(ctx))
+	}
 
 	// This is to clean genOutDir before generating any file
 	ctx.Build(pctx, android.BuildParams{
@@ -152,8 +192,92 @@ func (g *aidlGenRule) GenerateAndroidBuildActions(ctx android.ModuleContext) {
 	ctx.Build(pctx, android.BuildParams{
 		Rule:   android.Phony,
 		Output: android.PathForModuleOut(ctx, "timestamp"), // $out/timestamp
-		Inputs: g.genOutputs.Paths(),
+		Inputs: android.FirstUniquePaths(append(genSources.Paths(), g.genOutputs.Paths()...)),
+	})
+}
+
+func (g *aidlGenRule) minSdkVersionFlag() string {
+	if g.properties.Platform_apis {
+		return "--min_sdk_version platform_apis"
+	}
+	return "--min_sdk_version " + proptools.StringDefault(g.properties.Min_sdk_version, "current")
+}
+
+// Flags of the invocations which take all the srcs at once. They load the types as the
+// invocations for single srcs do, but don't generate them.
+func (g *aidlGenRule) moduleFlags() []string {
+	optionalFlags := append([]string{}, g.properties.Flags...)
+	if g.properties.Stability != nil {
+		optionalFlags = append(optionalFlags, "--stability", *g.properties.Stability)
+	}
+	return append(optionalFlags, wrap("-p", g.deps.preprocessed.Strings(), "")...)
+}
+
+// The headers generated with --explicit_instantiations declare the instantiations which their
+// types use. A single invocation defines each of them once for the module.
+func (g *aidlGenRule) generateBuildActionsForInstantiations(ctx android.ModuleContext, srcs android.Paths) android.WritablePath {
+	output := android.PathForModuleGen(ctx, "aidl_instantiations.cpp")
+	ctx.Build(pctx, android.BuildParams{
+		Rule:      aidlInstantiationsRule,
+		Inputs:    srcs,
+		Implicits: g.implicitInputs,
+		Output:    output,
+		Args: map[string]string{
+			"imports":       g.importFlags,
+			"optionalFlags": strings.Join(g.moduleFlags(), " "),
+		},
 	})
+	return output
+}
+
+// The classes generated with --shared_parcel_helper call the helpers of this class.
+func (g *aidlGenRule) generateBuildActionsForSharedParcelHelper(ctx android.ModuleContext) android.WritablePath {
+	class := g.properties.SharedParcelHelper
+	output := android.PathForModuleGen(ctx, strings.ReplaceAll(class, ".", "/")+".java")
+	ctx.Build(pctx, android.BuildParams{
+		Rule:      aidlJavaParcelHelperRule,
+		Implicits: g.implicitInputs,
+		Output:    output,
+		Args: map[string]string{
+			"class":  class,
+			"outDir": g.genOutDir.String(),
+			// The helpers depend on the SDK versions which the classes support.
+			"optionalFlags": g.minSdkVersionFlag(),
+		},
+	})
+	return output
+}
+
+// A single invocation writes all the unity sources from all the srcs, so that their contents
+// don't depend on how the types are split into invocations. It generates nothing else.
+func (g *aidlGenRule) generateBuildActionsForUnitySources(ctx android.ModuleContext, srcs android.Paths) android.WritablePaths {
+	var shards android.WritablePaths
+	for i := 0; i < g.properties.UnityShards; i++ {
+		shards = append(shards, android.PathForModuleGen(ctx, fmt.Sprintf("aidl_unity_%d.cpp", i)))
+	}
+
+	optionalFlags := append(g.moduleFlags(), g.minSdkVersionFlag())
+
+	aidlLang := g.properties.Lang
+	if aidlLang == langNdkPlatform {
+		aidlLang = "ndk"
+	}
+
+	ctx.Build(pctx, android.BuildParams{
+		Rule:      aidlUnityRule,
+		Inputs:    srcs,
+		Implicits: g.implicitInputs,
+		Outputs:   shards,
+		Args: map[string]string{
+			"imports":       g.importFlags,
+			"lang":          aidlLang,
+			"headerDir":     g.genHeaderDir.String(),
+			"outDir":        g.genOutDir.String(),
+			"optionalFlags": strings.Join(optionalFlags, " "),
+			"shards":        strconv.Itoa(g.properties.UnityShards),
+		},
+	})
+	return shards
 }
 
 func (g *aidlGenRule) generateBuildActionsForSingleAidl(ctx android.ModuleContext, src android.Path) (android.WritablePath, android.Paths) {
@@ -201,16 +325,14 @@ func (g *aidlGenRule) generateBuildActionsForSingleAidl(ctx android.ModuleContex
 	if g.properties.Stability != nil {
 		optionalFlags = append(optionalFlags, "--stability", *g.properties.Stability)
 	}
-	if g.properties.Platform_apis {
-		optionalFlags = append(optionalFlags, "--min_sdk_version platform_apis")
-	} else {
-		minSdkVer := proptools.StringDefault(g.properties.Min_sdk_version, "current")
-		optionalFlags = append(optionalFlags, "--min_sdk_version "+minSdkVer)
-	}
+	optionalFlags = append(optionalFlags, g.minSdkVersionFlag())
 	optionalFlags = append(optionalFlags, wrap("-p", g.deps.preprocessed.Strings(), "")...)
 
 	var headers android.WritablePaths
 	if g.properties.Lang == langJava {
+		if g.properties.SharedParcelHelper != "" {
+			optionalFlags = append(optionalFlags, "--shared_parcel_helper="+g.properties.SharedParcelHelper)
+		}
 		ctx.Build(pctx, android.BuildParams{
 			Rule:      aidlJavaRule,
 			Input:     src,
@@ -260,6 +382,9 @@ func (g *aidlGenRule) generateBuildActionsForSingleAidl(ctx android.ModuleContex
 		if g.properties.GenLog {
 			optionalFlags = append(optionalFlags, "--log")
 		}
+		if g.properties.ExplicitInstantiations {
+			optionalFlags = append(optionalFlags, "--explicit_instantiations")
+		}
 
 		aidlLang := g.properties.Lang
 		if aidlLang == langNdkPlatform {
@@ -280,6 +280,12 @@ type CommonNativeBackendProperties struct {
 	// Default: false
 	Gen_log *bool
 
+	// Number of unity sources to compile instead of one source per type. Each of
+	// them includes the generated sources of some of the types, so that the
+	// headers they share are parsed fewer times. 0 turns it off.
+	// Default: 0
+	Unity_shards *int
+
 	// VNDK properties for correspdoning backend.
 	cc.VndkProperties
 }
@@ -387,6 +393,10 @@ type aidlInterfaceProperties struct {
 			// Whether RPC features are enabled (requires API level 32)
 			// TODO(b/175819535): enable this automatically?
 			Gen_rpc *bool
+			// Qualified name of a class, unique to this interface, which is generated
+			// into the library with the parcel helpers for older SDK versions. The
+			// generated classes call it instead of nesting a copy of the helpers.
+			Shared_parcel_helper *string
 			// Lint properties for generated java module
 			java.LintProperties
 		}
@@ -395,6 +405,12 @@ type aidlInterfaceProperties struct {
 		// When enabled, this creates a target called "<name>-cpp".
 		Cpp struct {
 			CommonNativeBackendProperties
+
+			// Declare the instantiations of generic parcelables which the types use
+			// as extern templates in their headers, and define each of them once in
+			// the library.
+			// Default: false
+			Explicit_instantiations *bool
 		}
 		// Backend of the compiler generating code for C++ clients using libbinder_ndk
 		// (stable C interface to system's libbinder) When enabled, this creates a target
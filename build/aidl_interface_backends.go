@@ -75,25 +75,29 @@ func addCppLibrary(mctx android.DefaultableHookContext, i *aidlInterface, versio
 
 	genLog := proptools.Bool(commonProperties.Gen_log)
 	genTrace := i.genTrace(lang)
+	explicitInstantiations := lang == langCpp &&
+		proptools.Bool(i.properties.Backend.Cpp.Explicit_instantiations)
 
 	mctx.CreateModule(aidlGenFactory, &nameProperties{
 		Name: proptools.StringPtr(cppSourceGen),
 	}, &aidlGenProperties{
-		Srcs:                srcs,
-		AidlRoot:            aidlRoot,
-		Imports:             i.getImportsForVersion(version),
-		Headers:             i.properties.Headers,
-		Stability:           i.properties.Stability,
-		Min_sdk_version:     i.minSdkVersion(lang),
-		Lang:                lang,
-		BaseName:            i.ModuleBase.Name(),
-		GenLog:              genLog,
-		Version:             i.versionForInitVersionCompat(version),
-		GenTrace:            genTrace,
-		Unstable:            i.properties.Unstable,
-		NotFrozen:           notFrozen,
-		RequireFrozenReason: requireFrozenReason,
-		Flags:               i.flagsForAidlGenRule(version),
+		Srcs:                   srcs,
+		AidlRoot:               aidlRoot,
+		Imports:                i.getImportsForVersion(version),
+		Headers:                i.properties.Headers,
+		Stability:              i.properties.Stability,
+		Min_sdk_version:        i.minSdkVersion(lang),
+		Lang:                   lang,
+		BaseName:               i.ModuleBase.Name(),
+		GenLog:                 genLog,
+		Version:                i.versionForInitVersionCompat(version),
+		GenTrace:               genTrace,
+		UnityShards:            proptools.Int(commonProperties.Unity_shards),
+		ExplicitInstantiations: explicitInstantiations,
+		Unstable:               i.properties.Unstable,
+		NotFrozen:              notFrozen,
+		RequireFrozenReason:    requireFrozenReason,
+		Flags:                  i.flagsForAidlGenRule(version),
 	})
 
 	importExportDependencies := []string{}
@@ -344,6 +348,7 @@ func addJavaLibrary(mctx android.DefaultableHookContext, i *aidlInterface, versi
 		Version:             version,
 		GenRpc:              proptools.Bool(i.properties.Backend.Java.Gen_rpc),
 		GenTrace:            i.genTrace(langJava),
+		SharedParcelHelper:  proptools.String(i.properties.Backend.Java.Shared_parcel_helper),
 		Unstable:            i.properties.Unstable,
 		NotFrozen:           notFrozen,
 		RequireFrozenReason: requireFrozenReason,
@@ -1831,6 +1831,85 @@ func TestAidlFlags(t *testing.T) {
 	}
 }
 
+func TestUnityShards(t *testing.T) {
+	ctx, _ := testAidl(t, `
+		aidl_interface {
+			name: "myiface",
+			srcs: ["a/Foo.aidl", "b/Bar.aidl"],
+			backend: { cpp: { unity_shards: 2 }}
+		}
+	`)
+	gen := ctx.ModuleForTests("myiface-V1-cpp-source", "")
+	rule := gen.Rule("aidlUnityRule")
+	android.AssertStringEquals(t, "shards", "2", rule.Args["shards"])
+	android.AssertPathsRelativeToTopEquals(t, "one invocation gets all the srcs",
+		[]string{"a/Foo.aidl", "b/Bar.aidl"}, rule.Inputs)
+	android.AssertPathsRelativeToTopEquals(t, "shards",
+		[]string{
+			"out/soong/.intermediates/myiface-V1-cpp-source/gen/aidl_unity_0.cpp",
+			"out/soong/.intermediates/myiface-V1-cpp-source/gen/aidl_unity_1.cpp",
+		}, rule.Outputs.Paths())
+
+	// Only the shards are compiled. The sources of the types are dependencies.
+	genRule := gen.Module().(*aidlGenRule)
+	android.AssertPathsRelativeToTopEquals(t, "sources", rule.Outputs.Paths(), genRule.Srcs())
+	for _, source := range []string{"a/Foo.cpp", "b/Bar.cpp"} {
+		android.AssertStringListContains(t, "deps", genRule.GeneratedDeps().Strings(),
+			gen.Output(source).Output.String())
+	}
+
+	ndk := ctx.ModuleForTests("myiface-V1-ndk-source", "").Module().(*aidlGenRule)
+	android.AssertIntEquals(t, "ndk sources", 2, len(ndk.Srcs()))
+}
+
+func TestExplicitInstantiations(t *testing.T) {
+	ctx, _ := testAidl(t, `
+		aidl_interface {
+			name: "myiface",
+			srcs: ["a/Foo.aidl", "b/Bar.aidl"],
+			backend: { cpp: { explicit_instantiations: true }}
+		}
+	`)
+	gen := ctx.ModuleForTests("myiface-V1-cpp-source", "")
+	for _, source := range []string{"a/Foo.cpp", "b/Bar.cpp"} {
+		assertContains(t, gen.Output(source).Args["optionalFlags"], "--explicit_instantiations")
+	}
+	rule := gen.Rule("aidlInstantiationsRule")
+	android.AssertPathsRelativeToTopEquals(t, "one invocation gets all the srcs",
+		[]string{"a/Foo.aidl", "b/Bar.aidl"}, rule.Inputs)
+	android.AssertPathsRelativeToTopEquals(t, "the instantiations are compiled",
+		[]string{
+			"out/soong/.intermediates/myiface-V1-cpp-source/gen/a/Foo.cpp",
+			"out/soong/.intermediates/myiface-V1-cpp-source/gen/b/Bar.cpp",
+			"out/soong/.intermediates/myiface-V1-cpp-source/gen/aidl_instantiations.cpp",
+		}, gen.Module().(*aidlGenRule).Srcs())
+
+	ndk := ctx.ModuleForTests("myiface-V1-ndk-source", "")
+	android.AssertStringDoesNotContain(t, "only for cpp",
+		ndk.Output("a/Foo.cpp").Args["optionalFlags"], "--explicit_instantiations")
+}
+
+func TestSharedParcelHelper(t *testing.T) {
+	ctx, _ := testAidl(t, `
+		aidl_interface {
+			name: "myiface",
+			srcs: ["a/Foo.aidl"],
+			backend: { java: { shared_parcel_helper: "com.example.myiface.AidlParcel" }}
+		}
+	`)
+	gen := ctx.ModuleForTests("myiface-V1-java-source", "")
+	assertContains(t, gen.Output("a/Foo.java").Args["optionalFlags"],
+		"--shared_parcel_helper=com.example.myiface.AidlParcel")
+	helper := gen.Output("com/example/myiface/AidlParcel.java")
+	android.AssertStringEquals(t, "class", "com.example.myiface.AidlParcel", helper.Args["class"])
+	assertContains(t, helper.Args["optionalFlags"], "--min_sdk_version")
+	android.AssertPathsRelativeToTopEquals(t, "the helper is compiled",
+		[]string{
+			"out/soong/.intermediates/myiface-V1-java-source/gen/a/Foo.java",
+			"out/soong/.intermediates/myiface-V1-java-source/gen/com/example/myiface/AidlParcel.java",
+		}, gen.Module().(*aidlGenRule).Srcs())
+}
+
 func TestAidlModuleJavaSdkVersionDeterminesMinSdkVersion(t *testing.T) {
 	ctx, _ := testAidl(t, `
 		aidl_interface {
@@ -17,37 +17,76 @@
 #include "check_valid.h"
 #include "aidl.h"
 
+#include <set>
 #include <vector>
 
 namespace android {
 namespace aidl {
 
-using TypePredicate = std::function<bool(const AidlTypeSpecifier&)>;
-using DefinedTypePredicate = std::function<bool(const AidlDefinedType&)>;
-
 namespace {
-bool IsListOf(const AidlTypeSpecifier& type, TypePredicate pred) {
+template <typename Predicate>
+bool IsListOf(const AidlTypeSpecifier& type, Predicate pred) {
   return type.GetName() == "List" && type.IsGeneric() && type.GetTypeParameters().size() == 1 &&
          pred(*type.GetTypeParameters().at(0));
 }
-bool IsArrayOf(const AidlTypeSpecifier& type, TypePredicate pred) {
+template <typename Predicate>
+bool IsArrayOf(const AidlTypeSpecifier& type, Predicate pred) {
   return type.IsArray() && pred(type);
 }
 bool IsInterface(const AidlTypeSpecifier& type) {
   return type.GetDefinedType() && type.GetDefinedType()->AsInterface();
 }
+
+// Depth-first search for a path from |type| back to |start_type|. See CheckNestedTypeCycles().
+bool HasPathTo(const AidlDefinedType& start_type, const AidlDefinedType* type,
+               std::set<const AidlDefinedType*>* visited) {
+  if (!visited->insert(type).second) {
+    // Already visited
+    return false;
+  }
+
+  for (const auto& t : Collect<AidlTypeSpecifier>(*type)) {
+    auto defined_type = t->GetDefinedType();
+    if (!defined_type) {
+      // Skip primitive/builtin types
+      continue;
+    }
+
+    auto top_type = defined_type->GetRootType();
+    if (top_type == type) {
+      // Skip type references within the same top-level type
+      continue;
+    }
+
+    if (defined_type == &start_type) {
+      // Found a cycle back to the starting nested type
+      return true;
+    }
+
+    if (HasPathTo(start_type, top_type, visited)) {
+      // Found a cycle while visiting the top type for the next node
+      return true;
+    }
+  }
+
+  return false;
+}
 }  // namespace
 
+// The checks are member functions rather than stored callbacks, so that visiting a node calls
+// them directly.
 struct CheckTypeVisitor : AidlVisitor {
+  explicit CheckTypeVisitor(const Options& options)
+      : lang(options.TargetLanguage()), min_sdk_version(options.GetMinSdkVersion()) {}
+
   bool success = true;
-  std::vector<TypePredicate> checkers;
-  std::vector<DefinedTypePredicate> defined_checkers;
 
   void Visit(const AidlTypeSpecifier& type) override {
-    for (auto& checker : checkers) {
-      if (!checker(type)) {
-        success = false;
-      }
+    if (!CheckCollectionOfInterfaces(type)) {
+      success = false;
+    }
+    if (!CheckParcelableHolder(type)) {
+      success = false;
     }
   }
   void Visit(const AidlInterface& t) override { CheckDefinedType(t); }
@@ -56,26 +95,14 @@ struct CheckTypeVisitor : AidlVisitor {
   void Visit(const AidlUnionDecl& t) override { CheckDefinedType(t); }
   void Visit(const AidlParcelable& t) override { CheckDefinedType(t); }
 
-  void Check(TypePredicate checker) { checkers.push_back(std::move(checker)); }
-  void Check(DefinedTypePredicate checker) { defined_checkers.push_back(std::move(checker)); }
-
  private:
   void CheckDefinedType(const AidlDefinedType& type) {
-    for (auto& checker : defined_checkers) {
-      if (!checker(type)) {
-        success = false;
-      }
+    if (!CheckNestedTypeCycles(type)) {
+      success = false;
     }
   }
-};
 
-bool CheckValid(const AidlDocument& doc, const Options& options) {
-  const auto lang = options.TargetLanguage();
-  const auto min_sdk_version = options.GetMinSdkVersion();
-
-  CheckTypeVisitor v;
-
-  v.Check([&](const AidlTypeSpecifier& type) {
+  bool CheckCollectionOfInterfaces(const AidlTypeSpecifier& type) const {
     const auto valid_version = MinSdkVersionFromString("Tiramisu").value();
     if ((IsListOf(type, IsInterface) || IsArrayOf(type, IsInterface)) &&
         lang == Options::Language::JAVA && min_sdk_version < valid_version) {
@@ -85,9 +112,9 @@ bool CheckValid(const AidlDocument& doc, const Options& options) {
       return false;
     }
     return true;
-  });
+  }
 
-  v.Check([&](const AidlTypeSpecifier& type) {
+  bool CheckParcelableHolder(const AidlTypeSpecifier& type) const {
     const auto valid_version = MinSdkVersionFromString("S").value();
     if (type.GetName() == "ParcelableHolder" && min_sdk_version < valid_version) {
       AIDL_ERROR(type) << " ParcelableHolder is available since SDK = " << valid_version
@@ -95,7 +122,7 @@ bool CheckValid(const AidlDocument& doc, const Options& options) {
       return false;
     }
     return true;
-  });
+  }
 
   // Check all nested types for potential #include cycles that would contain
   // them. The algorithm performs a depth-first search on a graph with the
@@ -117,54 +144,27 @@ bool CheckValid(const AidlDocument& doc, const Options& options) {
   //   * There exists a path from start_type to another top-level type T
   //     (different from start_type)
   //   * There is a back edge from T to start_type which closes the cycle
-  v.Check([&](const AidlDefinedType& start_type) {
+  bool CheckNestedTypeCycles(const AidlDefinedType& start_type) const {
     if (start_type.GetParentType() == nullptr) {
       return true;
     }
 
     std::set<const AidlDefinedType*> visited;
-    std::function<bool(const AidlDefinedType*)> dfs = [&](const AidlDefinedType* type) {
-      if (!visited.insert(type).second) {
-        // Already visited
-        return false;
-      }
-
-      for (const auto& t : Collect<AidlTypeSpecifier>(*type)) {
-        auto defined_type = t->GetDefinedType();
-        if (!defined_type) {
-          // Skip primitive/builtin types
-          continue;
-        }
-
-        auto top_type = defined_type->GetRootType();
-        if (top_type == type) {
-          // Skip type references within the same top-level type
-          continue;
-        }
-
-        if (defined_type == &start_type) {
-          // Found a cycle back to the starting nested type
-          return true;
-        }
-
-        if (dfs(top_type)) {
-          // Found a cycle while visiting the top type for the next node
-          return true;
-        }
-      }
-
-      return false;
-    };
-
-    bool has_cycle = dfs(start_type.GetRootType());
+    bool has_cycle = HasPathTo(start_type, start_type.GetRootType(), &visited);
     if (has_cycle) {
       AIDL_ERROR(start_type) << "has cyclic references to nested types.";
       return false;
     }
 
     return true;
-  });
+  }
+
+  const Options::Language lang;
+  const uint32_t min_sdk_version;
+};
 
+bool CheckValid(const AidlDocument& doc, const Options& options) {
+  CheckTypeVisitor v(options);
   VisitTopDown(v, doc);
   return v.success;
 }
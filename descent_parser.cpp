@@ -0,0 +1,826 @@
+/*
+ * Copyright (C) 2023, The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "descent_parser.h"
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <android-base/parseint.h>
+
+#include "aidl_language.h"
+#include "aidl_language_y.h"
+#include "logging.h"
+
+int yylex(yy::parser::semantic_type*, yy::parser::location_type*, void*);
+
+// Defined in aidl_language_y.yy.
+AidlLocation loc(const yy::parser::location_type& begin, const yy::parser::location_type& end);
+AidlLocation loc(const yy::parser::location_type& l);
+
+namespace {
+
+using Location = yy::parser::location_type;
+using T = yy::parser::token;
+
+bool IsIdentifier(int kind) {
+  // cpp_header and ndk_header are identifiers as well, see "identifier" in the grammar.
+  return kind == T::IDENTIFIER || kind == T::CPP_HEADER || kind == T::NDK_HEADER;
+}
+
+// Precedence of the binary operators of const_expr, the higher the tighter. 0 for other tokens.
+int BinaryPrecedence(int kind) {
+  switch (kind) {
+    case T::LOGICAL_OR:
+      return 1;
+    case T::LOGICAL_AND:
+      return 2;
+    case '|':
+      return 3;
+    case '^':
+      return 4;
+    case '&':
+      return 5;
+    case T::EQUALITY:
+    case T::NEQ:
+      return 6;
+    case '<':
+    case '>':
+    case T::LEQ:
+    case T::GEQ:
+      return 7;
+    case T::LSHIFT:
+    case T::RSHIFT:
+      return 8;
+    case '+':
+    case '-':
+      return 9;
+    case '*':
+    case '/':
+    case '%':
+      return 10;
+    default:
+      return 0;
+  }
+}
+
+std::string BinaryOperator(int kind) {
+  switch (kind) {
+    case T::LOGICAL_OR:
+      return "||";
+    case T::LOGICAL_AND:
+      return "&&";
+    case T::EQUALITY:
+      return "==";
+    case T::NEQ:
+      return "!=";
+    case T::LEQ:
+      return "<=";
+    case T::GEQ:
+      return ">=";
+    case T::LSHIFT:
+      return "<<";
+    case T::RSHIFT:
+      return ">>";
+    default:
+      return std::string(1, static_cast<char>(kind));
+  }
+}
+
+// The locations follow those of bison: a rule spans from the beginning of its first symbol to
+// the end of its last one, and an empty rule is at the end of the symbol before it. So the
+// (left-recursive) lists start at the end of the preceding token even when they aren't empty.
+class DescentParser {
+ public:
+  explicit DescentParser(Parser* ps) : ps_(ps) {
+    location_.initialize(const_cast<std::string*>(&ps->FileName()), ps->Start().line,
+                         ps->Start().column);
+    last_ = location_;
+  }
+
+  // document: optional_package imports decls
+  bool ParseDocument() {
+    Location package_location = Empty();
+    Comments comments;
+    Token package;
+    if (Expect(T::PACKAGE, &package)) {
+      Token name;
+      if (!ParseQualifiedName(&name) || !Expect(';')) return false;
+      ps_->SetPackage(name.token->GetText());
+      package_location = Span(package.location, last_);
+      comments = package.token->GetComments();
+    }
+
+    std::vector<std::string> imports;
+    while (PeekKind() == T::IMPORT) {
+      Token import = Take();
+      Token name;
+      if (!ParseQualifiedName(&name) || !Expect(';')) return false;
+      if (!package.token && imports.empty()) {
+        comments = import.token->GetComments();
+      }
+      imports.push_back(name.token->GetText());
+    }
+
+    std::vector<std::unique_ptr<AidlDefinedType>> decls;
+    do {
+      AnnotationList annotations;
+      if (!ParseAnnotationList(&annotations)) return false;
+      auto decl = ParseDecl(std::move(annotations));
+      if (!decl) return false;
+      decls.push_back(std::move(decl));
+    } while (PeekKind() != 0);
+
+    ps_->MakeDocument(loc(package_location), comments, std::move(imports), std::move(decls));
+    return true;
+  }
+
+  // Takes the remaining tokens so that the lexer restores the character it holds back from the
+  // buffer.
+  void SkipRest() {
+    while (PeekKind() != 0) {
+      Take();
+    }
+  }
+
+ private:
+  struct Token {
+    int kind = 0;
+    // Set for the kinds which carry text, e.g. identifiers and literals.
+    std::unique_ptr<AidlToken> token;
+    Location location;
+  };
+
+  struct AnnotationList {
+    std::vector<std::unique_ptr<AidlAnnotation>> annotations;
+    Location location;
+  };
+
+  using Members = std::vector<std::unique_ptr<AidlMember>>;
+
+  const Token& Peek(size_t n = 0) {
+    while (lookahead_.size() <= n) {
+      Token token;
+      if (!at_end_) {
+        yy::parser::semantic_type value;
+        value.token = nullptr;
+        token.kind = yylex(&value, &location_, ps_->Scanner());
+        token.token.reset(value.token);
+        at_end_ = token.kind == 0;
+      }
+      token.location = location_;
+      lookahead_.push_back(std::move(token));
+    }
+    return lookahead_[n];
+  }
+
+  int PeekKind(size_t n = 0) { return Peek(n).kind; }
+
+  Token Take() {
+    Peek();
+    Token token = std::move(lookahead_.front());
+    lookahead_.pop_front();
+    last_ = token.location;
+    return token;
+  }
+
+  bool Expect(int kind, Token* token = nullptr) {
+    if (PeekKind() != kind) return false;
+    Token taken = Take();
+    if (token != nullptr) *token = std::move(taken);
+    return true;
+  }
+
+  // The location of an empty rule here.
+  Location Empty() const {
+    Location empty = last_;
+    empty.step();
+    return empty;
+  }
+
+  static Location Span(const Location& first, const Location& last) {
+    Location span = first;
+    span.end = last.end;
+    return span;
+  }
+
+  // qualified_name: identifier ('.' identifier)*
+  // The text of the parts is joined into the first token, which spans all of them.
+  bool ParseQualifiedName(Token* name) {
+    if (!IsIdentifier(PeekKind())) return false;
+    *name = Take();
+    while (PeekKind() == '.') {
+      Take();
+      if (!IsIdentifier(PeekKind())) return false;
+      Token part = Take();
+      name->token->Append('.');
+      name->token->Append(part.token->GetText());
+      name->location.end = part.location.end;
+    }
+    return true;
+  }
+
+  // annotation_list: annotation*
+  bool ParseAnnotationList(AnnotationList* list) {
+    list->location = Empty();
+    while (PeekKind() == T::ANNOTATION) {
+      std::unique_ptr<AidlAnnotation> annotation;
+      if (!ParseAnnotation(&annotation)) return false;
+      // An invalid annotation is reported and left out.
+      if (annotation) list->annotations.push_back(std::move(annotation));
+      list->location.end = last_.end;
+    }
+    return true;
+  }
+
+  // annotation: ANNOTATION ('(' (const_expr | parameter_list) ')')?
+  // parameter_list: (identifier '=' const_expr (',' identifier '=' const_expr)*)?
+  bool ParseAnnotation(std::unique_ptr<AidlAnnotation>* annotation) {
+    Token name = Take();
+    std::map<std::string, std::shared_ptr<AidlConstantValue>> parameters;
+    Location location = name.location;
+    if (Expect('(')) {
+      if (IsIdentifier(PeekKind()) && PeekKind(1) == '=') {
+        do {
+          if (!IsIdentifier(PeekKind())) return false;
+          Token parameter = Take();
+          if (!Expect('=')) return false;
+          Location value_location;
+          std::unique_ptr<AidlConstantValue> value = ParseConstExpr(&value_location);
+          if (!value) return false;
+          const std::string& parameter_name = parameter.token->GetText();
+          if (parameters.find(parameter_name) != parameters.end()) {
+            AIDL_ERROR(loc(Span(parameter.location, value_location)))
+                << "Trying to redefine parameter " << parameter_name << ".";
+            ps_->AddError();
+          }
+          parameters.emplace(parameter_name, std::move(value));
+        } while (Expect(','));
+      } else if (PeekKind() != ')') {
+        Location value_location;
+        std::shared_ptr<AidlConstantValue> value = ParseConstExpr(&value_location);
+        if (!value) return false;
+        parameters.emplace("value", std::move(value));
+      }
+      if (!Expect(')')) return false;
+      location = Span(name.location, last_);
+    }
+    *annotation = AidlAnnotation::Parse(loc(location), name.token->GetText(),
+                                        std::move(parameters), name.token->GetComments());
+    if (!*annotation) ps_->AddError();
+    return true;
+  }
+
+  // decl: annotation_list (parcelable_decl | interface_decl | enum_decl | union_decl)
+  std::unique_ptr<AidlDefinedType> ParseDecl(AnnotationList annotations) {
+    std::unique_ptr<AidlDefinedType> decl;
+    switch (PeekKind()) {
+      case T::PARCELABLE:
+        decl = ParseParcelable();
+        break;
+      case T::INTERFACE:
+        decl = ParseInterface();
+        break;
+      case T::ONEWAY:
+        if (PeekKind(1) == T::INTERFACE) decl = ParseInterface();
+        break;
+      case T::ENUM:
+        decl = ParseEnum();
+        break;
+      case T::UNION:
+        decl = ParseUnion();
+        break;
+      default:
+        break;
+    }
+    if (decl && !annotations.annotations.empty()) {
+      decl->SetComments(annotations.annotations.front()->GetComments());
+      decl->Annotate(std::move(annotations.annotations));
+    }
+    return decl;
+  }
+
+  // optional_type_params: ('<' identifier (',' identifier)* '>')?
+  bool ParseOptionalTypeParams(std::unique_ptr<std::vector<std::string>>* type_params) {
+    if (PeekKind() != '<') return true;
+    Take();
+    *type_params = std::make_unique<std::vector<std::string>>();
+    do {
+      if (!IsIdentifier(PeekKind())) return false;
+      (*type_params)->push_back(Take().token->GetText());
+    } while (Expect(','));
+    return Expect('>');
+  }
+
+  // parcelable_decl: PARCELABLE qualified_name optional_type_params
+  //                  (optional_unstructured_headers ';' | '{' parcelable_members '}')
+  std::unique_ptr<AidlDefinedType> ParseParcelable() {
+    Token parcelable = Take();
+    Token name;
+    std::unique_ptr<std::vector<std::string>> type_params;
+    if (!ParseQualifiedName(&name) || !ParseOptionalTypeParams(&type_params)) return nullptr;
+
+    if (PeekKind() == '{') {
+      Take();
+      auto members = std::make_unique<Members>();
+      if (!ParseParcelableMembers(members.get()) || !Expect('}')) return nullptr;
+      ps_->CheckValidTypeName(*name.token, loc(name.location));
+      return std::make_unique<AidlStructuredParcelable>(
+          loc(name.location), name.token->GetText(), ps_->Package(),
+          parcelable.token->GetComments(), type_params.release(), members.release());
+    }
+
+    AidlUnstructuredHeaders headers;
+    while (PeekKind() == T::CPP_HEADER || PeekKind() == T::NDK_HEADER) {
+      const int kind = Take().kind;
+      Token header;
+      if (!Expect(T::C_STR, &header)) return nullptr;
+      (kind == T::CPP_HEADER ? headers.cpp : headers.ndk) = header.token->GetText();
+    }
+    if (!Expect(';')) return nullptr;
+    // No check for type name here. We allow nested types for unstructured parcelables.
+    return std::make_unique<AidlParcelable>(loc(name.location), name.token->GetText(),
+                                            ps_->Package(), parcelable.token->GetComments(),
+                                            headers, type_params.release());
+  }
+
+  // interface_decl: INTERFACE qualified_name ';'
+  //               | ONEWAY? INTERFACE qualified_name '{' interface_members '}'
+  std::unique_ptr<AidlDefinedType> ParseInterface() {
+    Token oneway;
+    const bool is_oneway = Expect(T::ONEWAY, &oneway);
+    Token interface = Take();
+    Token name;
+    if (!ParseQualifiedName(&name)) return nullptr;
+    const Comments& comments =
+        is_oneway ? oneway.token->GetComments() : interface.token->GetComments();
+
+    std::unique_ptr<Members> members;
+    if (is_oneway || !Expect(';')) {
+      members = std::make_unique<Members>();
+      if (!Expect('{') || !ParseInterfaceMembers(members.get()) || !Expect('}')) return nullptr;
+    }
+    ps_->CheckValidTypeName(*name.token, loc(name.location));
+    return std::make_unique<AidlInterface>(loc(interface.location), name.token->GetText(),
+                                           comments, is_oneway, ps_->Package(),
+                                           members.release());
+  }
+
+  // enum_decl: ENUM qualified_name '{' enumerator (',' enumerator)* ','? '}'
+  // enumerator: identifier ('=' const_expr)?
+  std::unique_ptr<AidlDefinedType> ParseEnum() {
+    Token enum_token = Take();
+    Token name;
+    if (!ParseQualifiedName(&name) || !Expect('{')) return nullptr;
+    std::vector<std::unique_ptr<AidlEnumerator>> enumerators;
+    do {
+      if (!IsIdentifier(PeekKind())) return nullptr;
+      Token enumerator = Take();
+      std::unique_ptr<AidlConstantValue> value;
+      if (Expect('=')) {
+        Location value_location;
+        value = ParseConstExpr(&value_location);
+        if (!value) return nullptr;
+      }
+      enumerators.push_back(std::make_unique<AidlEnumerator>(
+          loc(enumerator.location), enumerator.token->GetText(), value.release(),
+          enumerator.token->GetComments()));
+    } while (Expect(',') && PeekKind() != '}');
+    if (!Expect('}')) return nullptr;
+    ps_->CheckValidTypeName(*name.token, loc(name.location));
+    return std::make_unique<AidlEnumDeclaration>(loc(name.location), name.token->GetText(),
+                                                 &enumerators, ps_->Package(),
+                                                 enum_token.token->GetComments());
+  }
+
+  // union_decl: UNION qualified_name optional_type_params '{' parcelable_members '}'
+  std::unique_ptr<AidlDefinedType> ParseUnion() {
+    Token union_token = Take();
+    Token name;
+    std::unique_ptr<std::vector<std::string>> type_params;
+    if (!ParseQualifiedName(&name) || !ParseOptionalTypeParams(&type_params) || !Expect('{')) {
+      return nullptr;
+    }
+    auto members = std::make_unique<Members>();
+    if (!ParseParcelableMembers(members.get()) || !Expect('}')) return nullptr;
+    ps_->CheckValidTypeName(*name.token, loc(name.location));
+    return std::make_unique<AidlUnionDecl>(loc(name.location), name.token->GetText(),
+                                           ps_->Package(), union_token.token->GetComments(),
+                                           type_params.release(), members.release());
+  }
+
+  // Whether the next tokens start a decl after its annotations.
+  bool AtDecl() {
+    switch (PeekKind()) {
+      case T::PARCELABLE:
+      case T::INTERFACE:
+      case T::ENUM:
+      case T::UNION:
+        return true;
+      case T::ONEWAY:
+        return PeekKind(1) == T::INTERFACE;
+      default:
+        return false;
+    }
+  }
+
+  // parcelable_members: (variable_decl | constant_decl | decl)*
+  bool ParseParcelableMembers(Members* members) {
+    while (PeekKind() != '}') {
+      AnnotationList annotations;
+      if (!ParseAnnotationList(&annotations)) return false;
+      std::unique_ptr<AidlMember> member;
+      if (PeekKind() == T::CONST) {
+        member = ParseConstant(std::move(annotations));
+      } else if (AtDecl()) {
+        member = ParseDecl(std::move(annotations));
+      } else {
+        member = ParseVariable(std::move(annotations));
+      }
+      if (!member) return false;
+      members->push_back(std::move(member));
+    }
+    return true;
+  }
+
+  // interface_members: (method_decl | constant_decl | decl)*
+  bool ParseInterfaceMembers(Members* members) {
+    while (PeekKind() != '}') {
+      AnnotationList annotations;
+      if (!ParseAnnotationList(&annotations)) return false;
+      std::unique_ptr<AidlMember> member;
+      if (PeekKind() == T::CONST) {
+        member = ParseConstant(std::move(annotations));
+      } else if (AtDecl()) {
+        member = ParseDecl(std::move(annotations));
+      } else {
+        member = ParseMethod(std::move(annotations));
+      }
+      if (!member) return false;
+      members->push_back(std::move(member));
+    }
+    return true;
+  }
+
+  // variable_decl: type identifier ('=' const_expr)? ';'
+  // |annotations| are those of the type.
+  std::unique_ptr<AidlMember> ParseVariable(AnnotationList annotations) {
+    Location type_location;
+    auto type = ParseType(std::move(annotations), &type_location);
+    if (!type || !IsIdentifier(PeekKind())) return nullptr;
+    Token name = Take();
+    std::unique_ptr<AidlConstantValue> value;
+    if (Expect('=')) {
+      Location value_location;
+      value = ParseConstExpr(&value_location);
+      if (!value) return nullptr;
+    }
+    if (!Expect(';')) return nullptr;
+    if (value) {
+      return std::make_unique<AidlVariableDeclaration>(loc(name.location), type.release(),
+                                                       name.token->GetText(), value.release());
+    }
+    return std::make_unique<AidlVariableDeclaration>(loc(name.location), type.release(),
+                                                     name.token->GetText());
+  }
+
+  // constant_decl: annotation_list CONST type identifier '=' const_expr ';'
+  std::unique_ptr<AidlMember> ParseConstant(AnnotationList annotations) {
+    Token const_token = Take();
+    auto type = ParseTypeWithAnnotations();
+    if (!type || !IsIdentifier(PeekKind())) return nullptr;
+    Token name = Take();
+    if (!Expect('=')) return nullptr;
+    Location value_location;
+    auto value = ParseConstExpr(&value_location);
+    if (!value || !Expect(';')) return nullptr;
+    if (!annotations.annotations.empty()) {
+      type->SetComments(annotations.annotations.front()->GetComments());
+    } else {
+      type->SetComments(const_token.token->GetComments());
+    }
+    type->Annotate(std::move(annotations.annotations));
+    return std::make_unique<AidlConstantDeclaration>(loc(name.location), type.release(),
+                                                     name.token->GetText(), value.release());
+  }
+
+  // method_decl: type identifier '(' arg_list ')' ('=' INTVALUE)? ';'
+  //            | annotation_list ONEWAY type identifier '(' arg_list ')' ('=' INTVALUE)? ';'
+  // Without ONEWAY, |annotations| are those of the type.
+  std::unique_ptr<AidlMember> ParseMethod(AnnotationList annotations) {
+    Token oneway;
+    std::unique_ptr<AidlTypeSpecifier> type;
+    Comments comments;
+    if (Expect(T::ONEWAY, &oneway)) {
+      comments = !annotations.annotations.empty()
+                     ? annotations.annotations.front()->GetComments()
+                     : oneway.token->GetComments();
+      type = ParseTypeWithAnnotations();
+      if (type) type->Annotate(std::move(annotations.annotations));
+    } else {
+      Location type_location;
+      type = ParseType(std::move(annotations), &type_location);
+      if (type) comments = type->GetComments();
+    }
+    if (!type || !IsIdentifier(PeekKind())) return nullptr;
+    Token name = Take();
+
+    // arg_list: (arg (',' arg)*)?
+    // arg: direction? type identifier
+    auto args = std::make_unique<std::vector<std::unique_ptr<AidlArgument>>>();
+    if (!Expect('(')) return nullptr;
+    if (PeekKind() != ')') {
+      do {
+        std::optional<AidlArgument::Direction> direction;
+        switch (PeekKind()) {
+          case T::IN:
+            direction = AidlArgument::IN_DIR;
+            break;
+          case T::OUT:
+            direction = AidlArgument::OUT_DIR;
+            break;
+          case T::INOUT:
+            direction = AidlArgument::INOUT_DIR;
+            break;
+        }
+        if (direction) Take();
+        auto arg_type = ParseTypeWithAnnotations();
+        if (!arg_type || !IsIdentifier(PeekKind())) return nullptr;
+        Token arg_name = Take();
+        if (direction) {
+          args->push_back(std::make_unique<AidlArgument>(loc(arg_name.location), *direction,
+                                                         arg_type.release(),
+                                                         arg_name.token->GetText()));
+        } else {
+          args->push_back(std::make_unique<AidlArgument>(
+              loc(arg_name.location), arg_type.release(), arg_name.token->GetText()));
+        }
+      } while (Expect(','));
+    }
+    if (!Expect(')')) return nullptr;
+
+    Token id;
+    if (Expect('=') && !Expect(T::INTVALUE, &id)) return nullptr;
+    if (!Expect(';')) return nullptr;
+
+    std::unique_ptr<AidlMethod> method;
+    if (id.token) {
+      int32_t serial = 0;
+      if (!android::base::ParseInt(id.token->GetText(), &serial)) {
+        AIDL_ERROR(loc(id.location)) << "Could not parse int value: " << id.token->GetText();
+        ps_->AddError();
+      }
+      method = std::make_unique<AidlMethod>(loc(name.location), oneway.token != nullptr,
+                                            type.release(), name.token->GetText(),
+                                            args.release(), comments, serial);
+    } else {
+      method =
+          std::make_unique<AidlMethod>(loc(name.location), oneway.token != nullptr,
+                                       type.release(), name.token->GetText(), args.release(),
+                                       comments);
+    }
+    return method;
+  }
+
+  std::unique_ptr<AidlTypeSpecifier> ParseTypeWithAnnotations() {
+    AnnotationList annotations;
+    if (!ParseAnnotationList(&annotations)) return nullptr;
+    Location location;
+    return ParseType(std::move(annotations), &location);
+  }
+
+  // type: non_array_type (annotation_list '[' const_expr? ']')*
+  std::unique_ptr<AidlTypeSpecifier> ParseType(AnnotationList annotations, Location* location) {
+    bool closed_enclosing = false;
+    auto type = ParseNonArrayType(std::move(annotations), /*in_type_args=*/false, location,
+                                  &closed_enclosing);
+    if (!type) return nullptr;
+    return ParseArrays(std::move(type), location);
+  }
+
+  std::unique_ptr<AidlTypeSpecifier> ParseArrays(std::unique_ptr<AidlTypeSpecifier> type,
+                                                 Location* location) {
+    while (PeekKind() == '[' || PeekKind() == T::ANNOTATION) {
+      AnnotationList annotations;
+      if (!ParseAnnotationList(&annotations) || !Expect('[')) return nullptr;
+      std::unique_ptr<AidlConstantValue> size;
+      if (PeekKind() != ']') {
+        Location size_location;
+        size = ParseConstExpr(&size_location);
+        if (!size) return nullptr;
+      }
+      if (!Expect(']')) return nullptr;
+
+      if (!annotations.annotations.empty()) {
+        AIDL_ERROR(loc(annotations.location)) << "Annotations for arrays are not supported.";
+        ps_->AddError();
+      }
+      const bool made = size ? type->MakeArray(FixedSizeArray{std::move(size)})
+                             : type->MakeArray(DynamicArray{});
+      if (!made) {
+        AIDL_ERROR(loc(*location)) << "Multi-dimensional arrays must be fixed size.";
+        ps_->AddError();
+      }
+      location->end = last_.end;
+    }
+    return type;
+  }
+
+  // non_array_type: annotation_list qualified_name ('<' type_args '>')*
+  //
+  // The lexer takes ">>" as RSHIFT. The grammar accepts it as the end of type arguments of
+  // a type argument, e.g. List<List<T>>, when the inner type is the last argument and has no
+  // array. When |in_type_args|, RSHIFT ends the arguments of this type and of the enclosing one,
+  // and |closed_enclosing| is set.
+  std::unique_ptr<AidlTypeSpecifier> ParseNonArrayType(AnnotationList annotations,
+                                                       bool in_type_args, Location* location,
+                                                       bool* closed_enclosing) {
+    Token name;
+    if (!ParseQualifiedName(&name)) return nullptr;
+    auto type = std::make_unique<AidlTypeSpecifier>(loc(name.location), name.token->GetText(),
+                                                    /*array=*/std::nullopt, nullptr,
+                                                    name.token->GetComments());
+    if (!annotations.annotations.empty()) {
+      type->SetComments(annotations.annotations.front()->GetComments());
+      type->Annotate(std::move(annotations.annotations));
+    }
+    *location = Span(annotations.location, name.location);
+
+    while (Expect('<')) {
+      auto type_args = std::make_unique<std::vector<std::unique_ptr<AidlTypeSpecifier>>>();
+      bool closed_by_arg = false;
+      do {
+        AnnotationList arg_annotations;
+        if (!ParseAnnotationList(&arg_annotations)) return nullptr;
+        Location arg_location;
+        auto arg = ParseNonArrayType(std::move(arg_annotations), /*in_type_args=*/true,
+                                     &arg_location, &closed_by_arg);
+        if (!arg) return nullptr;
+        if (closed_by_arg) {
+          // Not a "type", so its annotations aren't checked.
+          type_args->push_back(std::move(arg));
+          break;
+        }
+        arg = ParseArrays(std::move(arg), &arg_location);
+        if (!arg) return nullptr;
+        if (!arg->GetAnnotations().empty()) {
+          AIDL_ERROR(loc(arg_location)) << "Annotations for type arguments are not supported.";
+          ps_->AddError();
+        }
+        type_args->push_back(std::move(arg));
+      } while (Expect(','));
+
+      if (!closed_by_arg) {
+        if (in_type_args && Expect(T::RSHIFT)) {
+          *closed_enclosing = true;
+        } else if (!Expect('>')) {
+          return nullptr;
+        }
+      }
+      ps_->SetTypeParameters(type.get(), type_args.release());
+      location->end = last_.end;
+      if (*closed_enclosing) break;
+    }
+    return type;
+  }
+
+  // const_expr with the binary operators of at least |min_precedence|. They are left
+  // associative. A binary expression is located at its left operand.
+  std::unique_ptr<AidlConstantValue> ParseConstExpr(Location* location, int min_precedence = 1) {
+    auto left = ParseUnaryExpr(location);
+    if (!left) return nullptr;
+    for (int precedence = BinaryPrecedence(PeekKind());
+         precedence != 0 && precedence >= min_precedence;
+         precedence = BinaryPrecedence(PeekKind())) {
+      const int op = Take().kind;
+      Location right_location;
+      auto right = ParseConstExpr(&right_location, precedence + 1);
+      if (!right) return nullptr;
+      left = std::make_unique<AidlBinaryConstExpression>(loc(*location), std::move(left),
+                                                         BinaryOperator(op), std::move(right));
+      location->end = right_location.end;
+    }
+    return left;
+  }
+
+  // The unary operators bind tighter than all the binary ones. A unary expression is located at
+  // its operator.
+  std::unique_ptr<AidlConstantValue> ParseUnaryExpr(Location* location) {
+    const int kind = PeekKind();
+    if (kind != '+' && kind != '-' && kind != '!' && kind != '~') {
+      return ParsePrimaryExpr(location);
+    }
+    Token op = Take();
+    Location operand_location;
+    auto operand = ParseUnaryExpr(&operand_location);
+    if (!operand) return nullptr;
+    *location = Span(op.location, operand_location);
+    return std::make_unique<AidlUnaryConstExpression>(loc(op.location), std::string(1, kind),
+                                                      std::move(operand));
+  }
+
+  std::unique_ptr<AidlConstantValue> ParsePrimaryExpr(Location* location) {
+    const int kind = PeekKind();
+    if (IsIdentifier(kind)) {
+      Token name;
+      if (!ParseQualifiedName(&name)) return nullptr;
+      *location = name.location;
+      return std::make_unique<AidlConstantReference>(loc(name.location), name.token->GetText());
+    }
+    if (kind == '(') {
+      Token open = Take();
+      Location inner_location;
+      auto inner = ParseConstExpr(&inner_location);
+      if (!inner || !Expect(')')) return nullptr;
+      *location = Span(open.location, last_);
+      return inner;
+    }
+    if (kind == '{') {
+      // constant_value_list: (const_expr (',' const_expr)* ','?)?
+      Token open = Take();
+      auto values = std::make_unique<std::vector<std::unique_ptr<AidlConstantValue>>>();
+      while (PeekKind() != '}') {
+        Location value_location;
+        auto value = ParseConstExpr(&value_location);
+        if (!value) return nullptr;
+        values->push_back(std::move(value));
+        if (!Expect(',')) break;
+      }
+      if (!Expect('}')) return nullptr;
+      *location = Span(open.location, last_);
+      return std::unique_ptr<AidlConstantValue>(
+          AidlConstantValue::Array(loc(open.location), std::move(values)));
+    }
+
+    Token literal = Take();
+    *location = literal.location;
+    const AidlLocation literal_location = loc(literal.location);
+    AidlConstantValue* value = nullptr;
+    switch (kind) {
+      case T::TRUE_LITERAL:
+        value = AidlConstantValue::Boolean(literal_location, true);
+        break;
+      case T::FALSE_LITERAL:
+        value = AidlConstantValue::Boolean(literal_location, false);
+        break;
+      case T::CHARVALUE:
+        value = AidlConstantValue::Character(literal_location, literal.token->GetText());
+        break;
+      case T::INTVALUE:
+      case T::HEXVALUE:
+        value = AidlConstantValue::Integral(literal_location, literal.token->GetText());
+        if (value == nullptr) {
+          AIDL_ERROR(literal_location)
+              << (kind == T::INTVALUE ? "Could not parse integer: " : "Could not parse hexvalue: ")
+              << literal.token->GetText();
+          ps_->AddError();
+          value = AidlConstantValue::Integral(literal_location, "0");
+        }
+        break;
+      case T::FLOATVALUE:
+        value = AidlConstantValue::Floating(literal_location, literal.token->GetText());
+        break;
+      case T::C_STR:
+        value = AidlConstantValue::String(literal_location, literal.token->GetText());
+        break;
+      default:
+        break;
+    }
+    return std::unique_ptr<AidlConstantValue>(value);
+  }
+
+  Parser* ps_;
+  // Passed to the lexer, which moves it over each token.
+  Location location_;
+  // The location of the last token taken.
+  Location last_;
+  std::deque<Token> lookahead_;
+  bool at_end_ = false;
+};
+
+}  // namespace
+
+bool ParseWithDescent(Parser* parser) {
+  DescentParser descent_parser(parser);
+  if (descent_parser.ParseDocument()) {
+    return true;
+  }
+  descent_parser.SkipRest();
+  return false;
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2023, The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "parser.h"
+
+// Parses the input of |parser| with a hand-written recursive descent parser for the grammar of
+// aidl_language_y.yy. It takes the same tokens from the lexer, builds the same AST with the same
+// locations and comments, and reports the same diagnostics as the actions of the grammar, in the
+// same order. It doesn't recover from syntax errors, though. On the first one it returns false
+// without reporting it, having consumed the rest of the input so that the buffer of the lexer is
+// intact, and the caller parses the input again with bison for its error messages.
+bool ParseWithDescent(Parser* parser);
@@ -15,14 +15,11 @@
  */
 #include "diagnostics.h"
 
-#include <functional>
 #include <stack>
 
 #include "aidl_language.h"
 #include "logging.h"
 
-using std::placeholders::_1;
-
 namespace android {
 namespace aidl {
 
@@ -97,28 +94,27 @@ class DiagnosticsVisitor : public AidlVisitor {
  public:
   DiagnosticsVisitor(DiagnosticsContext& diag) : diag(diag) {}
   void Check(const AidlDocument& doc) {
-    DiagnosticsVisitor* visitor = this;
-    using Fun = std::function<void(const AidlAnnotatable&)>;
     struct Hook : public AidlVisitor {
+      using Fun = void (DiagnosticsContext::*)(const AidlAnnotatable&);
+      DiagnosticsContext& diag;
       Fun fun;
-      Hook(Fun fun) : fun(fun) {}
-      void Visit(const AidlInterface& a) override { fun(a); }
-      void Visit(const AidlEnumDeclaration& a) override { fun(a); }
-      void Visit(const AidlStructuredParcelable& a) override { fun(a); }
-      void Visit(const AidlUnionDecl& a) override { fun(a); }
-      void Visit(const AidlParcelable& a) override { fun(a); }
-      void Visit(const AidlMethod& a) override { fun(a.GetType()); }
-    };
-    Hook suppress{std::bind(&DiagnosticsContext::Suppress, &diag, _1)};
-    Hook restore{std::bind(&DiagnosticsContext::Restore, &diag, _1)};
-    std::function<void(const AidlNode&)> top_down = [&top_down, &suppress, &restore,
-                                                     visitor](const AidlNode& a) {
-      a.DispatchVisit(suppress);
-      a.DispatchVisit(*visitor);
-      a.TraverseChildren(top_down);
-      a.DispatchVisit(restore);
+      Hook(DiagnosticsContext& diag, Fun fun) : diag(diag), fun(fun) {}
+      void Visit(const AidlInterface& a) override { (diag.*fun)(a); }
+      void Visit(const AidlEnumDeclaration& a) override { (diag.*fun)(a); }
+      void Visit(const AidlStructuredParcelable& a) override { (diag.*fun)(a); }
+      void Visit(const AidlUnionDecl& a) override { (diag.*fun)(a); }
+      void Visit(const AidlParcelable& a) override { (diag.*fun)(a); }
+      void Visit(const AidlMethod& a) override { (diag.*fun)(a.GetType()); }
     };
-    top_down(doc);
+    Hook suppress{diag, &DiagnosticsContext::Suppress};
+    Hook restore{diag, &DiagnosticsContext::Restore};
+    ForEachNode(
+        doc,
+        [&](const AidlNode& a) {
+          a.DispatchVisit(suppress);
+          a.DispatchVisit(*this);
+        },
+        [&](const AidlNode& a) { a.DispatchVisit(restore); });
   }
  protected:
   DiagnosticsContext& diag;
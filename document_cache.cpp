@@ -0,0 +1,781 @@
+/*
+ * Copyright (C) 2023, The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "document_cache.h"
+
+#include <sys/stat.h>
+
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <android-base/file.h>
+#include <android-base/stringprintf.h>
+
+using android::base::StringPrintf;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace android {
+namespace aidl {
+
+namespace {
+
+// Bump this whenever the encoding below or the AST built by the parser changes. Entries are also
+// keyed by CompilerId(), so a forgotten bump only costs cache misses between two builds.
+constexpr uint32_t kFormatVersion = 1;
+constexpr char kMagic[] = "AIDLDOC";
+
+uint64_t Fnv1a(const string& data, uint64_t basis) {
+  uint64_t hash = basis;
+  for (unsigned char c : data) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+uint64_t Checksum(const string& data) {
+  return Fnv1a(data, 14695981039346656037ULL);
+}
+
+// Identifies the running compiler binary by its path, size and modification time. A rebuilt
+// compiler never reads the entries of another build, whose parser may differ.
+uint64_t CompilerId() {
+  static const uint64_t id = [] {
+    const string path = android::base::GetExecutablePath();
+    string identity = path;
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0) {
+      identity += StringPrintf(":%lld:%lld", static_cast<long long>(st.st_size),
+                               static_cast<long long>(st.st_mtime));
+    }
+    return Checksum(identity);
+  }();
+  return id;
+}
+
+enum TypeKind : uint8_t { INTERFACE, PARCELABLE, STRUCTURED_PARCELABLE, UNION, ENUM };
+enum MemberKind : uint8_t { FIELD, CONSTANT, METHOD, TYPE };
+enum ValueKind : uint8_t { PLAIN, ARRAY, REFERENCE, UNARY, BINARY };
+enum ArrayKind : uint8_t { NOT_ARRAY, DYNAMIC_ARRAY, FIXED_SIZE_ARRAY };
+
+}  // namespace
+
+// Writes the AST in the order in which Decoder reads it back.
+class DocumentCache::Encoder {
+ public:
+  explicit Encoder(string* out) : out_(out) {}
+
+  bool Document(const AidlDocument& doc) {
+    WriteBool(doc.IsPreprocessed());
+    WriteLocation(doc.GetLocation());
+    WriteComments(doc.GetComments());
+    WriteUint(doc.Imports().size());
+    for (const auto& import : doc.Imports()) {
+      WriteString(import);
+    }
+    WriteUint(doc.DefinedTypes().size());
+    for (const auto& type : doc.DefinedTypes()) {
+      WriteDefinedType(*type);
+    }
+    return ok_;
+  }
+
+ private:
+  void WriteUint(uint64_t v) {
+    while (v >= 0x80) {
+      out_->push_back(static_cast<char>(v | 0x80));
+      v >>= 7;
+    }
+    out_->push_back(static_cast<char>(v));
+  }
+  void WriteInt(int64_t v) { WriteUint((static_cast<uint64_t>(v) << 1) ^ (v >> 63)); }
+  void WriteBool(bool v) { out_->push_back(v ? 1 : 0); }
+  void WriteString(const string& s) {
+    WriteUint(s.size());
+    out_->append(s);
+  }
+
+  void WriteLocation(const AidlLocation& loc) {
+    WriteBool(loc.IsInternal());
+    // External locations are all in the file being loaded.
+    if (loc.IsInternal()) {
+      WriteString(loc.file_);
+    }
+    WriteInt(loc.begin_.line);
+    WriteInt(loc.begin_.column);
+    WriteInt(loc.end_.line);
+    WriteInt(loc.end_.column);
+  }
+
+  void WriteComments(const Comments& comments) {
+    WriteUint(comments.size());
+    for (const auto& comment : comments) {
+      WriteString(comment.body);
+    }
+  }
+
+  void WriteAnnotations(const AidlAnnotatable& node) {
+    WriteUint(node.GetAnnotations().size());
+    for (const auto& annotation : node.GetAnnotations()) {
+      WriteLocation(annotation->GetLocation());
+      WriteString(annotation->GetName());
+      WriteComments(annotation->GetComments());
+      WriteUint(annotation->GetParameters().size());
+      for (const auto& [name, value] : annotation->GetParameters()) {
+        WriteString(name);
+        WriteValue(*value);
+      }
+    }
+  }
+
+  void WriteTypeSpecifier(const AidlTypeSpecifier& type) {
+    WriteLocation(type.GetLocation());
+    WriteString(type.GetUnresolvedName());
+    WriteComments(type.GetComments());
+    WriteAnnotations(type);
+    WriteBool(type.IsGeneric());
+    if (type.IsGeneric()) {
+      WriteUint(type.GetTypeParameters().size());
+      for (const auto& param : type.GetTypeParameters()) {
+        WriteTypeSpecifier(*param);
+      }
+    }
+    if (type.IsFixedSizeArray()) {
+      const auto& dimensions = std::get<FixedSizeArray>(type.GetArray()).dimensions;
+      out_->push_back(FIXED_SIZE_ARRAY);
+      WriteUint(dimensions.size());
+      for (const auto& dim : dimensions) {
+        WriteValue(*dim);
+      }
+    } else {
+      out_->push_back(type.IsDynamicArray() ? DYNAMIC_ARRAY : NOT_ARRAY);
+    }
+  }
+
+  void WriteValue(const AidlConstantValue& value) {
+    WriteLocation(value.GetLocation());
+    if (auto ref = AidlCast<AidlConstantReference>(value); ref) {
+      out_->push_back(REFERENCE);
+      WriteString(ref->Literal());
+    } else if (auto unary = AidlCast<AidlUnaryConstExpression>(value); unary) {
+      out_->push_back(UNARY);
+      WriteString(unary->Op());
+      WriteValue(*unary->Val());
+    } else if (auto binary = AidlCast<AidlBinaryConstExpression>(value); binary) {
+      out_->push_back(BINARY);
+      WriteValue(*binary->Left());
+      WriteString(binary->Op());
+      WriteValue(*binary->Right());
+    } else if (value.GetType() == AidlConstantValue::Type::ARRAY) {
+      out_->push_back(ARRAY);
+      WriteUint(value.Size());
+      for (size_t i = 0; i < value.Size(); i++) {
+        WriteValue(value.ValueAt(i));
+      }
+    } else {
+      // Invalid literals are reported while parsing, so they never reach here.
+      ok_ = ok_ && value.GetType() != AidlConstantValue::Type::ERROR;
+      out_->push_back(PLAIN);
+      out_->push_back(static_cast<char>(value.GetType()));
+      WriteString(value.Literal());
+    }
+  }
+
+  void WriteDefinedType(const AidlDefinedType& type) {
+    TypeKind kind;
+    if (type.AsInterface()) {
+      kind = INTERFACE;
+    } else if (type.AsStructuredParcelable()) {
+      kind = STRUCTURED_PARCELABLE;
+    } else if (type.AsUnionDeclaration()) {
+      kind = UNION;
+    } else if (type.AsEnumDeclaration()) {
+      kind = ENUM;
+    } else {
+      kind = PARCELABLE;
+    }
+    out_->push_back(kind);
+    WriteLocation(type.GetLocation());
+    WriteString(type.GetName());
+    WriteString(type.GetPackage());
+    WriteComments(type.GetComments());
+
+    if (auto parcelable = type.AsParcelable(); parcelable) {
+      WriteBool(parcelable->IsGeneric());
+      if (parcelable->IsGeneric()) {
+        WriteUint(parcelable->GetTypeParameters().size());
+        for (const auto& param : parcelable->GetTypeParameters()) {
+          WriteString(param);
+        }
+      }
+    }
+    if (kind == PARCELABLE) {
+      // The parser passes headers with their quotes.
+      const auto& parcelable = *type.AsParcelable();
+      WriteString(parcelable.GetCppHeader().empty() ? "" : "\"" + parcelable.GetCppHeader() + "\"");
+      WriteString(parcelable.GetNdkHeader().empty() ? "" : "\"" + parcelable.GetNdkHeader() + "\"");
+    } else if (kind == ENUM) {
+      const auto& enumerators = type.AsEnumDeclaration()->GetEnumerators();
+      WriteUint(enumerators.size());
+      for (const auto& enumerator : enumerators) {
+        WriteLocation(enumerator->GetLocation());
+        WriteString(enumerator->GetName());
+        WriteComments(enumerator->GetComments());
+        // The others are filled in again when the enum is constructed.
+        WriteBool(enumerator->IsValueUserSpecified());
+        if (enumerator->IsValueUserSpecified()) {
+          WriteValue(*enumerator->GetValue());
+        }
+      }
+    } else {
+      WriteUint(type.GetMembers().size());
+      for (const AidlMember* member : type.GetMembers()) {
+        WriteMember(*member);
+      }
+    }
+    // Annotations are attached after construction, so they come last.
+    WriteAnnotations(type);
+  }
+
+  void WriteMember(const AidlMember& member) {
+    if (auto nested = AidlCast<AidlDefinedType>(member); nested) {
+      out_->push_back(TYPE);
+      WriteDefinedType(*nested);
+      return;
+    }
+    if (auto constant = AidlCast<AidlConstantDeclaration>(member); constant) {
+      out_->push_back(CONSTANT);
+      WriteLocation(constant->GetLocation());
+      WriteTypeSpecifier(constant->GetType());
+      WriteString(constant->GetName());
+      WriteValue(constant->GetValue());
+    } else if (auto field = AidlCast<AidlVariableDeclaration>(member); field) {
+      out_->push_back(FIELD);
+      WriteVariable(*field);
+    } else if (auto method = AidlCast<AidlMethod>(member); method) {
+      out_->push_back(METHOD);
+      WriteLocation(method->GetLocation());
+      WriteBool(method->IsOneway());
+      WriteTypeSpecifier(method->GetType());
+      WriteString(method->GetName());
+      WriteUint(method->GetArguments().size());
+      for (const auto& arg : method->GetArguments()) {
+        WriteBool(arg->DirectionWasSpecified());
+        WriteUint(arg->GetDirection());
+        WriteVariable(*arg);
+        WriteComments(arg->GetComments());
+        WriteAnnotations(*arg);
+      }
+      WriteBool(method->HasId());
+      WriteInt(method->GetId());
+    } else {
+      ok_ = false;
+      return;
+    }
+    WriteComments(member.GetComments());
+    WriteAnnotations(member);
+  }
+
+  void WriteVariable(const AidlVariableDeclaration& var) {
+    WriteLocation(var.GetLocation());
+    WriteTypeSpecifier(var.GetType());
+    WriteString(var.GetName());
+    // Defaults which are not user-specified are derived from the type again.
+    WriteBool(var.IsDefaultUserSpecified());
+    if (var.IsDefaultUserSpecified()) {
+      WriteValue(*var.GetDefaultValue());
+    }
+  }
+
+  string* out_;
+  bool ok_ = true;
+};
+
+// Rebuilds the AST with the constructors the grammar uses. Any malformed input fails the whole
+// document instead of aborting, since the entry may have been damaged on disk.
+class DocumentCache::Decoder {
+ public:
+  Decoder(const string& data, const string& filename)
+      : data_(data), filename_(filename) {}
+
+  unique_ptr<AidlDocument> Document() {
+    bool is_preprocessed = ReadBool();
+    auto location = ReadLocation();
+    auto comments = ReadComments();
+    vector<string> imports(ReadSize());
+    for (auto& import : imports) {
+      import = ReadString();
+    }
+    vector<unique_ptr<AidlDefinedType>> types(ReadSize());
+    for (auto& type : types) {
+      type = ReadDefinedType();
+    }
+    if (!ok_ || pos_ != data_.size()) {
+      return nullptr;
+    }
+    return std::make_unique<AidlDocument>(*location, comments, std::move(imports),
+                                          std::move(types), is_preprocessed);
+  }
+
+ private:
+  uint8_t ReadByte() {
+    if (pos_ >= data_.size()) {
+      ok_ = false;
+      return 0;
+    }
+    return static_cast<uint8_t>(data_[pos_++]);
+  }
+  uint64_t ReadUint() {
+    uint64_t v = 0;
+    for (int shift = 0; ok_ && shift < 64; shift += 7) {
+      uint8_t b = ReadByte();
+      v |= static_cast<uint64_t>(b & 0x7f) << shift;
+      if ((b & 0x80) == 0) return v;
+    }
+    ok_ = false;
+    return 0;
+  }
+  int64_t ReadInt() {
+    uint64_t v = ReadUint();
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+  }
+  bool ReadBool() { return ReadByte() != 0; }
+  // Sizes are bounded by the remaining data, so a damaged entry can't make us allocate a lot.
+  size_t ReadSize() {
+    uint64_t size = ReadUint();
+    if (size > data_.size() - pos_) {
+      ok_ = false;
+      return 0;
+    }
+    return size;
+  }
+  string ReadString() {
+    size_t size = ReadSize();
+    string s = data_.substr(pos_, size);
+    pos_ += size;
+    return s;
+  }
+
+  std::optional<AidlLocation> ReadLocation() {
+    bool internal = ReadBool();
+    string file = internal ? ReadString() : filename_;
+    AidlLocation::Point begin, end;
+    begin.line = ReadInt();
+    begin.column = ReadInt();
+    end.line = ReadInt();
+    end.column = ReadInt();
+    if (!ok_) {
+      return std::nullopt;
+    }
+    return AidlLocation(file, begin, end,
+                        internal ? AidlLocation::Source::INTERNAL : AidlLocation::Source::EXTERNAL);
+  }
+
+  Comments ReadComments() {
+    Comments comments;
+    for (size_t n = ReadSize(); ok_ && n > 0; n--) {
+      comments.emplace_back(ReadString());
+    }
+    return comments;
+  }
+
+  bool ReadAnnotations(AidlAnnotatable* node) {
+    vector<unique_ptr<AidlAnnotation>> annotations;
+    for (size_t n = ReadSize(); ok_ && n > 0; n--) {
+      auto location = ReadLocation();
+      auto name = ReadString();
+      auto comments = ReadComments();
+      std::map<string, std::shared_ptr<AidlConstantValue>> parameters;
+      for (size_t m = ReadSize(); ok_ && m > 0; m--) {
+        auto param = ReadString();
+        parameters[param] = ReadValue();
+      }
+      if (!ok_) break;
+      auto annotation = AidlAnnotation::Parse(*location, name, std::move(parameters), comments);
+      if (!annotation) {
+        ok_ = false;
+        break;
+      }
+      annotations.push_back(std::move(annotation));
+    }
+    if (ok_) {
+      node->Annotate(std::move(annotations));
+    }
+    return ok_;
+  }
+
+  unique_ptr<AidlTypeSpecifier> ReadTypeSpecifier() {
+    auto location = ReadLocation();
+    auto name = ReadString();
+    auto comments = ReadComments();
+    if (!ok_) return nullptr;
+    auto type = std::make_unique<AidlTypeSpecifier>(*location, name, std::nullopt, nullptr,
+                                                    comments);
+    if (!ReadAnnotations(type.get())) return nullptr;
+    if (ReadBool()) {
+      auto params = std::make_unique<vector<unique_ptr<AidlTypeSpecifier>>>(ReadSize());
+      for (auto& param : *params) {
+        param = ReadTypeSpecifier();
+      }
+      if (!ok_ || !type->SetTypeParameters(params.release())) {
+        ok_ = false;
+        return nullptr;
+      }
+    }
+    switch (ReadByte()) {
+      case NOT_ARRAY:
+        break;
+      case DYNAMIC_ARRAY:
+        ok_ = ok_ && type->MakeArray(DynamicArray{});
+        break;
+      case FIXED_SIZE_ARRAY:
+        for (size_t n = ReadSize(); ok_ && n > 0; n--) {
+          std::shared_ptr<AidlConstantValue> dim = ReadValue();
+          ok_ = ok_ && type->MakeArray(FixedSizeArray{std::move(dim)});
+        }
+        break;
+      default:
+        ok_ = false;
+    }
+    return ok_ ? std::move(type) : nullptr;
+  }
+
+  unique_ptr<AidlConstantValue> ReadValue() {
+    using Type = AidlConstantValue::Type;
+    auto location = ReadLocation();
+    if (!ok_) return nullptr;
+    unique_ptr<AidlConstantValue> value;
+    switch (ReadByte()) {
+      case PLAIN: {
+        auto type = static_cast<Type>(ReadByte());
+        auto literal = ReadString();
+        if (!ok_) break;
+        switch (type) {
+          case Type::BOOLEAN:
+            value.reset(AidlConstantValue::Boolean(*location, literal == "true"));
+            break;
+          case Type::INT8:
+          case Type::INT32:
+          case Type::INT64:
+            value.reset(AidlConstantValue::Integral(*location, literal));
+            break;
+          case Type::CHARACTER:
+            // Character() and String() abort on malformed literals.
+            if ((literal.size() == 3 && literal.front() == '\'' && literal.back() == '\'') ||
+                literal == "'\\0'") {
+              value.reset(AidlConstantValue::Character(*location, literal));
+            }
+            break;
+          case Type::STRING:
+            if (!literal.empty() && literal.front() == '"') {
+              value.reset(AidlConstantValue::String(*location, literal));
+            }
+            break;
+          case Type::FLOATING:
+            if (!literal.empty()) {
+              value.reset(AidlConstantValue::Floating(*location, literal));
+            }
+            break;
+          default:
+            break;
+        }
+        break;
+      }
+      case ARRAY: {
+        auto values = std::make_unique<vector<unique_ptr<AidlConstantValue>>>(ReadSize());
+        for (auto& v : *values) {
+          v = ReadValue();
+        }
+        if (ok_) {
+          value.reset(AidlConstantValue::Array(*location, std::move(values)));
+        }
+        break;
+      }
+      case REFERENCE: {
+        auto literal = ReadString();
+        if (ok_ && !literal.empty()) {
+          value = std::make_unique<AidlConstantReference>(*location, literal);
+        }
+        break;
+      }
+      case UNARY: {
+        auto op = ReadString();
+        auto operand = ReadValue();
+        if (ok_) {
+          value = std::make_unique<AidlUnaryConstExpression>(*location, op, std::move(operand));
+        }
+        break;
+      }
+      case BINARY: {
+        auto left = ReadValue();
+        auto op = ReadString();
+        auto right = ReadValue();
+        if (ok_) {
+          value = std::make_unique<AidlBinaryConstExpression>(*location, std::move(left), op,
+                                                              std::move(right));
+        }
+        break;
+      }
+      default:
+        break;
+    }
+    if (!value) {
+      ok_ = false;
+    }
+    return value;
+  }
+
+  unique_ptr<AidlVariableDeclaration> ReadVariable() {
+    auto location = ReadLocation();
+    auto type = ReadTypeSpecifier();
+    auto name = ReadString();
+    if (!ok_) return nullptr;
+    if (ReadBool()) {
+      auto value = ReadValue();
+      if (!ok_) return nullptr;
+      return std::make_unique<AidlVariableDeclaration>(*location, type.release(), name,
+                                                       value.release());
+    }
+    return std::make_unique<AidlVariableDeclaration>(*location, type.release(), name);
+  }
+
+  unique_ptr<AidlArgument> ReadArgument() {
+    bool direction_specified = ReadBool();
+    auto direction = static_cast<AidlArgument::Direction>(ReadUint());
+    auto location = ReadLocation();
+    auto type = ReadTypeSpecifier();
+    auto name = ReadString();
+    // Arguments have no default values.
+    if (ReadBool() || !ok_) {
+      ok_ = false;
+      return nullptr;
+    }
+    if (direction < AidlArgument::IN_DIR || direction > AidlArgument::INOUT_DIR) {
+      ok_ = false;
+      return nullptr;
+    }
+    unique_ptr<AidlArgument> arg;
+    if (direction_specified) {
+      arg = std::make_unique<AidlArgument>(*location, direction, type.release(), name);
+    } else {
+      arg = std::make_unique<AidlArgument>(*location, type.release(), name);
+    }
+    arg->SetComments(ReadComments());
+    if (!ReadAnnotations(arg.get())) return nullptr;
+    return arg;
+  }
+
+  unique_ptr<AidlMethod> ReadMethod() {
+    auto location = ReadLocation();
+    bool oneway = ReadBool();
+    auto type = ReadTypeSpecifier();
+    auto name = ReadString();
+    auto args = std::make_unique<vector<unique_ptr<AidlArgument>>>(ReadSize());
+    for (auto& arg : *args) {
+      arg = ReadArgument();
+    }
+    bool has_id = ReadBool();
+    int64_t id = ReadInt();
+    if (!ok_) return nullptr;
+    // Comments are restored with the other members'.
+    if (has_id) {
+      return std::make_unique<AidlMethod>(*location, oneway, type.release(), name, args.release(),
+                                          Comments{}, static_cast<int>(id));
+    }
+    return std::make_unique<AidlMethod>(*location, oneway, type.release(), name, args.release(),
+                                        Comments{});
+  }
+
+  unique_ptr<AidlMember> ReadMember() {
+    unique_ptr<AidlMember> member;
+    switch (ReadByte()) {
+      case TYPE:
+        return ReadDefinedType();
+      case CONSTANT: {
+        auto location = ReadLocation();
+        auto type = ReadTypeSpecifier();
+        auto name = ReadString();
+        auto value = ReadValue();
+        if (ok_) {
+          member = std::make_unique<AidlConstantDeclaration>(*location, type.release(), name,
+                                                             value.release());
+        }
+        break;
+      }
+      case FIELD:
+        member = ReadVariable();
+        break;
+      case METHOD:
+        member = ReadMethod();
+        break;
+      default:
+        break;
+    }
+    if (!ok_ || !member) {
+      ok_ = false;
+      return nullptr;
+    }
+    member->SetComments(ReadComments());
+    if (!ReadAnnotations(member.get())) return nullptr;
+    return member;
+  }
+
+  unique_ptr<AidlDefinedType> ReadDefinedType() {
+    auto kind = ReadByte();
+    auto location = ReadLocation();
+    auto name = ReadString();
+    auto package = ReadString();
+    auto comments = ReadComments();
+    if (!ok_) return nullptr;
+
+    unique_ptr<vector<string>> type_params;
+    if (kind == PARCELABLE || kind == STRUCTURED_PARCELABLE || kind == UNION) {
+      if (ReadBool()) {
+        type_params = std::make_unique<vector<string>>(ReadSize());
+        for (auto& param : *type_params) {
+          param = ReadString();
+        }
+      }
+    }
+
+    unique_ptr<AidlDefinedType> type;
+    if (kind == PARCELABLE) {
+      AidlUnstructuredHeaders headers;
+      headers.cpp = ReadString();
+      headers.ndk = ReadString();
+      if (ok_) {
+        type = std::make_unique<AidlParcelable>(*location, name, package, comments, headers,
+                                                type_params.release());
+      }
+    } else if (kind == ENUM) {
+      vector<unique_ptr<AidlEnumerator>> enumerators(ReadSize());
+      for (auto& enumerator : enumerators) {
+        auto enumerator_location = ReadLocation();
+        auto enumerator_name = ReadString();
+        auto enumerator_comments = ReadComments();
+        unique_ptr<AidlConstantValue> value;
+        if (ReadBool()) {
+          value = ReadValue();
+        }
+        if (!ok_) return nullptr;
+        enumerator = std::make_unique<AidlEnumerator>(*enumerator_location, enumerator_name,
+                                                      value.release(), enumerator_comments);
+      }
+      if (ok_) {
+        type = std::make_unique<AidlEnumDeclaration>(*location, name, &enumerators, package,
+                                                     comments);
+      }
+    } else {
+      auto members = std::make_unique<vector<unique_ptr<AidlMember>>>(ReadSize());
+      for (auto& member : *members) {
+        member = ReadMember();
+      }
+      if (!ok_) return nullptr;
+      switch (kind) {
+        case INTERFACE:
+          // Methods keep the oneway flag of the interface.
+          type = std::make_unique<AidlInterface>(*location, name, comments, /*oneway=*/false,
+                                                 package, members.release());
+          break;
+        case STRUCTURED_PARCELABLE:
+          type = std::make_unique<AidlStructuredParcelable>(
+              *location, name, package, comments, type_params.release(), members.release());
+          break;
+        case UNION:
+          type = std::make_unique<AidlUnionDecl>(*location, name, package, comments,
+                                                 type_params.release(), members.release());
+          break;
+        default:
+          break;
+      }
+    }
+    if (!ok_ || !type) {
+      ok_ = false;
+      return nullptr;
+    }
+    if (!ReadAnnotations(type.get())) return nullptr;
+    return type;
+  }
+
+  const string& data_;
+  const string& filename_;
+  size_t pos_ = 0;
+  bool ok_ = true;
+};
+
+DocumentCache::DocumentCache(const string& dir, const IoDelegate& io_delegate)
+    : dir_(dir), io_delegate_(io_delegate) {}
+
+string DocumentCache::Key(const string& contents, bool is_preprocessed) {
+  // Two hashes with different offset bases make accidental collisions practically impossible.
+  return StringPrintf("v%u-%016llx-%016llx%016llx-%zu%s", kFormatVersion,
+                      static_cast<unsigned long long>(CompilerId()),
+                      static_cast<unsigned long long>(Checksum(contents)),
+                      static_cast<unsigned long long>(Fnv1a(contents, 0x84222325cbf29ce4ULL)),
+                      contents.size(), is_preprocessed ? "-p" : "");
+}
+
+string DocumentCache::EntryPath(const string& key) const {
+  return dir_ + key + ".ast";
+}
+
+unique_ptr<AidlDocument> DocumentCache::Load(const string& key, const string& filename) const {
+  auto entry = io_delegate_.GetFileContents(EntryPath(key));
+  if (!entry) {
+    return nullptr;
+  }
+  // <magic>\n<key>\n<checksum of payload>\n<payload>
+  const string header = string(kMagic) + "\n" + key + "\n";
+  const size_t checksum_size = 16;
+  if (entry->compare(0, header.size(), header) != 0 ||
+      entry->size() < header.size() + checksum_size + 1 ||
+      (*entry)[header.size() + checksum_size] != '\n') {
+    return nullptr;
+  }
+  const string payload = entry->substr(header.size() + checksum_size + 1);
+  const string checksum = entry->substr(header.size(), checksum_size);
+  if (checksum != StringPrintf("%016llx", static_cast<unsigned long long>(Checksum(payload)))) {
+    return nullptr;
+  }
+  return Decode(payload, filename);
+}
+
+void DocumentCache::Store(const string& key, const AidlDocument& document) const {
+  string payload;
+  if (!Encode(document, &payload)) {
+    return;
+  }
+  const string entry = string(kMagic) + "\n" + key + "\n" +
+                       StringPrintf("%016llx", static_cast<unsigned long long>(Checksum(payload))) +
+                       "\n" + payload;
+  io_delegate_.WriteFileAtomically(EntryPath(key), entry);
+}
+
+bool DocumentCache::Encode(const AidlDocument& document, string* data) {
+  data->clear();
+  return Encoder(data).Document(document);
+}
+
+unique_ptr<AidlDocument> DocumentCache::Decode(const string& data, const string& filename) {
+  return Decoder(data, filename).Document();
+}
+
+}  // namespace aidl
+}  // namespace android
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2023, The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "aidl_language.h"
+#include "io_delegate.h"
+
+namespace android {
+namespace aidl {
+
+// On-disk cache of parsed documents, shared by compiler invocations (--cache_dir).
+//
+// An entry holds the AST which the parser built for a file, keyed by the file contents, the
+// cache format version and the compiler binary, so the same import read from different paths or
+// by different actions maps to a single entry. Entries are written atomically and verified when
+// read, so concurrent invocations can share a directory; a missing or damaged entry is a cache
+// miss.
+//
+// Only parsing is skipped. Loaded documents are resolved and validated like parsed ones, since
+// that depends on the other files of a compilation.
+class DocumentCache {
+ public:
+  DocumentCache(const std::string& dir, const IoDelegate& io_delegate);
+
+  // non-copyable, non-movable
+  DocumentCache(const DocumentCache&) = delete;
+  DocumentCache(DocumentCache&&) = delete;
+  DocumentCache& operator=(const DocumentCache&) = delete;
+  DocumentCache& operator=(DocumentCache&&) = delete;
+
+  // Returns the key of the document parsed from |contents|.
+  static std::string Key(const std::string& contents, bool is_preprocessed);
+
+  // Returns the document stored for |key| with its locations in |filename|, or nullptr.
+  std::unique_ptr<AidlDocument> Load(const std::string& key, const std::string& filename) const;
+  // Stores |document| for |key|. Failures are ignored as the entry is recreated by a later run.
+  void Store(const std::string& key, const AidlDocument& document) const;
+
+  // Path of the entry for |key|.
+  std::string EntryPath(const std::string& key) const;
+
+  // Compact binary form of a parsed document. Returns false if it can't be encoded.
+  static bool Encode(const AidlDocument& document, std::string* data);
+  static std::unique_ptr<AidlDocument> Decode(const std::string& data,
+                                              const std::string& filename);
+
+ private:
+  class Encoder;
+  class Decoder;
+
+  const std::string dir_;
+  const IoDelegate& io_delegate_;
+};
+
+}  // namespace aidl
+}  // namespace android
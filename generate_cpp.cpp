@@ -20,10 +20,14 @@
 #include <algorithm>
 #include <cctype>
 #include <cstring>
+#include <map>
 #include <memory>
+#include <optional>
 #include <random>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <android-base/format.h>
 #include <android-base/stringprintf.h>
@@ -60,6 +64,7 @@ const char kReplyVarName[] = "_aidl_reply";
 const char kReturnVarName[] = "_aidl_return";
 const char kStatusVarName[] = "_aidl_status";
 const char kTraceVarName[] = "_aidl_trace";
+const char kInterfaceTokenArgs[] = "descriptor_utf16, descriptor_utf16_length";
 const char kAndroidParcelLiteral[] = "::android::Parcel";
 const char kAndroidStatusLiteral[] = "::android::status_t";
 const char kAndroidStatusOk[] = "::android::OK";
@@ -67,6 +72,8 @@ const char kAndroidStatusBadValue[] = "::android::BAD_VALUE";
 const char kBinderStatusLiteral[] = "::android::binder::Status";
 const char kIBinderHeader[] = "binder/IBinder.h";
 const char kIInterfaceHeader[] = "binder/IInterface.h";
+const char kIPCThreadStateHeader[] = "binder/IPCThreadState.h";
+const char kIServiceManagerHeader[] = "binder/IServiceManager.h";
 const char kBinderDelegateHeader[] = "binder/Delegate.h";
 const char kParcelHeader[] = "binder/Parcel.h";
 const char kStabilityHeader[] = "binder/Stability.h";
@@ -88,6 +95,232 @@ void GenerateGotoErrorOnBadStatus(CodeWriter& out) {
   out.Write("}\n");
 }
 
+// Shared marshaller of the methods generated in compact mode (@Compact). Instead of a Parcel call
+// and a status check per argument, such a method describes its arguments with a constexpr table
+// of ops and makes a single call to Write or Read. It is part of each source which uses it, so no
+// other output is needed. Its functions are inline, so that a program keeps one copy of them, and
+// the guard keeps it once per translation unit when sources are combined (--unity_shards).
+const char kCompactMarshaller[] = R"(#ifndef AIDL_CPP_COMPACT_MARSHALLER
+#define AIDL_CPP_COMPACT_MARSHALLER
+namespace aidl_compact {
+enum Op : uint8_t {
+  BOOL,
+  BYTE,
+  CHAR,
+  INT32,
+  INT64,
+  FLOAT,
+  DOUBLE,
+  STRING16,
+  UTF8_STRING,
+  STRONG_BINDER,
+  NULLABLE_STRONG_BINDER,
+  PARCELABLE,
+};
+// Values are copied, as an enum is passed as a value of its backing type.
+template <typename T>
+inline ::android::status_t WriteValue(::android::Parcel* parcel,
+                                      ::android::status_t (::android::Parcel::*write)(T),
+                                      const void* value) {
+  T t;
+  memcpy(&t, value, sizeof(t));
+  return (parcel->*write)(t);
+}
+template <typename T>
+inline ::android::status_t ReadValue(const ::android::Parcel& parcel,
+                                     ::android::status_t (::android::Parcel::*read)(T*) const,
+                                     void* value) {
+  T t{};
+  ::android::status_t status = (parcel.*read)(&t);
+  memcpy(value, &t, sizeof(t));
+  return status;
+}
+inline ::android::status_t Write(::android::Parcel* parcel, const Op* ops,
+                                 const void* const* values, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    const void* value = values[i];
+    ::android::status_t status = ::android::BAD_VALUE;
+    switch (ops[i]) {
+      case BOOL:
+        status = WriteValue<bool>(parcel, &::android::Parcel::writeBool, value);
+        break;
+      case BYTE:
+        status = WriteValue<int8_t>(parcel, &::android::Parcel::writeByte, value);
+        break;
+      case CHAR:
+        status = WriteValue<char16_t>(parcel, &::android::Parcel::writeChar, value);
+        break;
+      case INT32:
+        status = WriteValue<int32_t>(parcel, &::android::Parcel::writeInt32, value);
+        break;
+      case INT64:
+        status = WriteValue<int64_t>(parcel, &::android::Parcel::writeInt64, value);
+        break;
+      case FLOAT:
+        status = WriteValue<float>(parcel, &::android::Parcel::writeFloat, value);
+        break;
+      case DOUBLE:
+        status = WriteValue<double>(parcel, &::android::Parcel::writeDouble, value);
+        break;
+      case STRING16:
+        status = parcel->writeString16(*static_cast<const ::android::String16*>(value));
+        break;
+      case UTF8_STRING:
+        status = parcel->writeUtf8AsUtf16(*static_cast<const ::std::string*>(value));
+        break;
+      case STRONG_BINDER:
+      case NULLABLE_STRONG_BINDER:
+        status = parcel->writeStrongBinder(
+            *static_cast<const ::android::sp<::android::IBinder>*>(value));
+        break;
+      case PARCELABLE:
+        status = parcel->writeParcelable(*static_cast<const ::android::Parcelable*>(value));
+        break;
+    }
+    if (status != ::android::OK) return status;
+  }
+  return ::android::OK;
+}
+inline ::android::status_t Read(const ::android::Parcel& parcel, const Op* ops,
+                                void* const* values, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    void* value = values[i];
+    ::android::status_t status = ::android::BAD_VALUE;
+    switch (ops[i]) {
+      case BOOL:
+        status = ReadValue<bool>(parcel, &::android::Parcel::readBool, value);
+        break;
+      case BYTE:
+        status = ReadValue<int8_t>(parcel, &::android::Parcel::readByte, value);
+        break;
+      case CHAR:
+        status = ReadValue<char16_t>(parcel, &::android::Parcel::readChar, value);
+        break;
+      case INT32:
+        status = ReadValue<int32_t>(parcel, &::android::Parcel::readInt32, value);
+        break;
+      case INT64:
+        status = ReadValue<int64_t>(parcel, &::android::Parcel::readInt64, value);
+        break;
+      case FLOAT:
+        status = ReadValue<float>(parcel, &::android::Parcel::readFloat, value);
+        break;
+      case DOUBLE:
+        status = ReadValue<double>(parcel, &::android::Parcel::readDouble, value);
+        break;
+      case STRING16:
+        status = parcel.readString16(static_cast<::android::String16*>(value));
+        break;
+      case UTF8_STRING:
+        status = parcel.readUtf8FromUtf16(static_cast<::std::string*>(value));
+        break;
+      case STRONG_BINDER:
+        status = parcel.readStrongBinder(static_cast<::android::sp<::android::IBinder>*>(value));
+        break;
+      case NULLABLE_STRONG_BINDER:
+        status = parcel.readNullableStrongBinder(
+            static_cast<::android::sp<::android::IBinder>*>(value));
+        break;
+      case PARCELABLE:
+        status = parcel.readParcelable(static_cast<::android::Parcelable*>(value));
+        break;
+    }
+    if (status != ::android::OK) return status;
+  }
+  return ::android::OK;
+}
+}  // namespace aidl_compact
+#endif  // AIDL_CPP_COMPACT_MARSHALLER
+)";
+
+// Returns the op which the compact marshaller uses for |type|, or nullopt if it is not supported.
+// Arrays, lists, interfaces and nullable values other than IBinder are not supported.
+std::optional<string> CompactOpOf(const AidlTypeSpecifier& type, const AidlTypenames& typenames) {
+  if (type.IsArray() || typenames.IsList(type)) {
+    return std::nullopt;
+  }
+  if (auto enum_decl = typenames.GetEnumDeclaration(type); enum_decl) {
+    return CompactOpOf(enum_decl->GetBackingType(), typenames);
+  }
+  static const std::map<string, string> kPrimitiveOps = {
+      {"boolean", "BOOL"}, {"byte", "BYTE"},   {"char", "CHAR"},     {"int", "INT32"},
+      {"long", "INT64"},   {"float", "FLOAT"}, {"double", "DOUBLE"},
+  };
+  if (auto it = kPrimitiveOps.find(type.GetName()); it != kPrimitiveOps.end()) {
+    return it->second;
+  }
+  if (type.GetName() == "IBinder") {
+    return type.IsNullable() ? "NULLABLE_STRONG_BINDER" : "STRONG_BINDER";
+  }
+  if (type.IsNullable()) {
+    return std::nullopt;
+  }
+  if (type.GetName() == "String") {
+    return type.IsUtf8InCpp() ? "UTF8_STRING" : "STRING16";
+  }
+  const auto defined_type = type.GetDefinedType();
+  if (defined_type &&
+      (defined_type->AsStructuredParcelable() || defined_type->AsUnionDeclaration())) {
+    return "PARCELABLE";
+  }
+  return std::nullopt;
+}
+
+// A method is generated in compact mode if it or its interface is annotated with @Compact and the
+// compact marshaller supports all of its arguments. Otherwise it is expanded as usual.
+bool IsCompactMethod(const AidlInterface& interface, const AidlMethod& method,
+                     const AidlTypenames& typenames) {
+  if (!interface.IsCompact() && !method.GetType().IsCompact()) {
+    return false;
+  }
+  if (method.GetType().GetName() != "void" && !CompactOpOf(method.GetType(), typenames)) {
+    return false;
+  }
+  return std::all_of(method.GetArguments().begin(), method.GetArguments().end(),
+                     [&](const auto& a) { return CompactOpOf(a->GetType(), typenames); });
+}
+
+bool HasCompactMethods(const AidlInterface& interface, const AidlTypenames& typenames) {
+  return std::any_of(interface.GetMethods().begin(), interface.GetMethods().end(),
+                     [&](const auto& m) { return IsCompactMethod(interface, *m, typenames); });
+}
+
+// A value for the compact marshaller: the op and the address of the value.
+struct CompactValue {
+  string op;
+  string address;
+};
+
+CompactValue CompactValueOf(const AidlTypeSpecifier& type, const AidlTypenames& typenames,
+                            const string& address, bool is_const) {
+  string op = *CompactOpOf(type, typenames);
+  if (op == "PARCELABLE") {
+    return {op, StringPrintf("static_cast<%s::android::Parcelable*>(%s)", is_const ? "const " : "",
+                             address.c_str())};
+  }
+  return {op, address};
+}
+
+// Writes |values| to |parcel| (a pointer) or reads them from |parcel|, setting
+// _aidl_ret_status.
+void GenerateCompactMarshalling(CodeWriter& out, const string& parcel,
+                                const vector<CompactValue>& values, bool is_write) {
+  vector<string> ops, addresses;
+  for (const auto& value : values) {
+    ops.push_back("::aidl_compact::" + value.op);
+    addresses.push_back(value.address);
+  }
+  out << "{\n";
+  out.Indent();
+  out << "static constexpr ::aidl_compact::Op _aidl_ops[] = {" << Join(ops, ", ") << "};\n";
+  out << (is_write ? "const void* const" : "void* const") << " _aidl_values[] = {"
+      << Join(addresses, ", ") << "};\n";
+  out << kAndroidStatusVarName << " = ::aidl_compact::" << (is_write ? "Write" : "Read") << "("
+      << parcel << ", _aidl_ops, _aidl_values, " << std::to_string(values.size()) << ");\n";
+  out.Dedent();
+  out << "}\n";
+}
+
 // Format three types of arg list for method.
 //  for_declaration & !type_name_only: int a      // for method decl with type and arg
 //  for_declaration &  type_name_only: int /*a*/  // for method decl with type
@@ -171,6 +404,21 @@ void GenerateClientTransaction(CodeWriter& out, const AidlTypenames& typenames,
   const string bp_name = GetQualifiedName(interface, ClassNames::CLIENT);
   const string bn_name = GetQualifiedName(interface, ClassNames::SERVER);
 
+  // Arguments to forward to the default implementation when the remote side doesn't implement
+  // the method.
+  vector<string> arg_names;
+  for (const auto& a : method.GetArguments()) {
+    if (IsNonCopyableType(a->GetType(), typenames)) {
+      arg_names.emplace_back(StringPrintf("std::move(%s)", a->GetName().c_str()));
+    } else {
+      arg_names.emplace_back(a->GetName());
+    }
+  }
+  if (method.GetType().GetName() != "void") {
+    arg_names.emplace_back(kReturnVarName);
+  }
+  const bool cache_unsupported = CachesUnsupportedMethod(method, options);
+
   GenerateMethodDecl(out, typenames, method, bp_name);
   out << " {\n";
   out.Indent();
@@ -200,30 +448,57 @@ void GenerateClientTransaction(CodeWriter& out, const AidlTypenames& typenames,
     out << GenLogBeforeExecute(bp_name, method, false /* isServer */, false /* isNdk */);
   }
 
+  if (cache_unsupported) {
+    out.Write("if (UNLIKELY%s) {\n",
+              UnsupportedMethodTest(interface, method, "unsupported_methods_").c_str());
+    out.Write("  if (%s::getDefaultImpl()) {\n", i_name.c_str());
+    out.Write("    return %s::getDefaultImpl()->%s(%s);\n", i_name.c_str(),
+              method.GetName().c_str(), Join(arg_names, ", ").c_str());
+    out.Write("  }\n");
+    out.Write("  return %s::fromStatusT(::android::UNKNOWN_TRANSACTION);\n",
+              kBinderStatusLiteral);
+    out.Write("}\n");
+  }
+
   // Add the name of the interface we're hoping to call.
-  out.Write("%s = %s.writeInterfaceToken(getInterfaceDescriptor());\n", kAndroidStatusVarName,
-            kDataVarName);
+  out.Write("%s = %s.writeInterfaceToken(%s);\n", kAndroidStatusVarName, kDataVarName,
+            kInterfaceTokenArgs);
   GenerateGotoErrorOnBadStatus(out);
 
-  for (const auto& a : method.GetArguments()) {
-    const string var_name = ((a->IsOut()) ? "*" : "") + a->GetName();
-
-    if (a->IsIn()) {
-      // Serialization looks roughly like:
-      //     _aidl_ret_status = _aidl_data.WriteInt32(in_param_name);
-      //     if (_aidl_ret_status != ::android::OK) { goto error; }
-      out.Write("%s = %s.%s(%s);\n", kAndroidStatusVarName, kDataVarName,
-                ParcelWriteMethodOf(a->GetType(), typenames).c_str(),
-                ParcelWriteCastOf(a->GetType(), typenames, var_name).c_str());
-      GenerateGotoErrorOnBadStatus(out);
-    } else if (a->IsOut() && a->GetType().IsDynamicArray()) {
-      // Special case, the length of the out array is written into the parcel.
-      //     _aidl_ret_status = _aidl_data.writeVectorSize(&out_param_name);
-      //     if (_aidl_ret_status != ::android::OK) { goto error; }
-      out.Write("%s = %s.writeVectorSize(%s);\n", kAndroidStatusVarName, kDataVarName,
-                var_name.c_str());
+  const bool compact = IsCompactMethod(interface, method, typenames);
+  if (compact) {
+    vector<CompactValue> in_values;
+    for (const auto& a : method.GetArguments()) {
+      if (a->IsIn()) {
+        const string address = a->IsOut() ? a->GetName() : "&" + a->GetName();
+        in_values.push_back(CompactValueOf(a->GetType(), typenames, address, /*is_const=*/true));
+      }
+    }
+    if (!in_values.empty()) {
+      GenerateCompactMarshalling(out, string("&") + kDataVarName, in_values, /*is_write=*/true);
       GenerateGotoErrorOnBadStatus(out);
     }
+  } else {
+    for (const auto& a : method.GetArguments()) {
+      const string var_name = ((a->IsOut()) ? "*" : "") + a->GetName();
+
+      if (a->IsIn()) {
+        // Serialization looks roughly like:
+        //     _aidl_ret_status = _aidl_data.WriteInt32(in_param_name);
+        //     if (_aidl_ret_status != ::android::OK) { goto error; }
+        out.Write("%s = %s.%s(%s);\n", kAndroidStatusVarName, kDataVarName,
+                  ParcelWriteMethodOf(a->GetType(), typenames).c_str(),
+                  ParcelWriteCastOf(a->GetType(), typenames, var_name).c_str());
+        GenerateGotoErrorOnBadStatus(out);
+      } else if (a->IsOut() && a->GetType().IsDynamicArray()) {
+        // Special case, the length of the out array is written into the parcel.
+        //     _aidl_ret_status = _aidl_data.writeVectorSize(&out_param_name);
+        //     if (_aidl_ret_status != ::android::OK) { goto error; }
+        out.Write("%s = %s.writeVectorSize(%s);\n", kAndroidStatusVarName, kDataVarName,
+                  var_name.c_str());
+        GenerateGotoErrorOnBadStatus(out);
+      }
+    }
   }
 
   // Invoke the transaction on the remote binder and confirm status.
@@ -235,19 +510,14 @@ void GenerateClientTransaction(CodeWriter& out, const AidlTypenames& typenames,
             GetTransactionIdFor(bn_name, method).c_str(), kDataVarName, kReplyVarName,
             flags.empty() ? "0" : Join(flags, " | ").c_str());
 
+  if (cache_unsupported) {
+    out.Write("if (UNLIKELY(%s == ::android::UNKNOWN_TRANSACTION)) {\n", kAndroidStatusVarName);
+    out.Write("  %s;\n", UnsupportedMethodSet(interface, method, "unsupported_methods_").c_str());
+    out.Write("}\n");
+  }
+
   // If the method is not implemented in the remote side, try to call the
   // default implementation, if provided.
-  vector<string> arg_names;
-  for (const auto& a : method.GetArguments()) {
-    if (IsNonCopyableType(a->GetType(), typenames)) {
-      arg_names.emplace_back(StringPrintf("std::move(%s)", a->GetName().c_str()));
-    } else {
-      arg_names.emplace_back(a->GetName());
-    }
-  }
-  if (method.GetType().GetName() != "void") {
-    arg_names.emplace_back(kReturnVarName);
-  }
   out.Write("if (UNLIKELY(%s == ::android::UNKNOWN_TRANSACTION && %s::getDefaultImpl())) {\n",
             kAndroidStatusVarName, i_name.c_str());
   out.Write("   return %s::getDefaultImpl()->%s(%s);\n", i_name.c_str(), method.GetName().c_str(),
@@ -271,22 +541,38 @@ void GenerateClientTransaction(CodeWriter& out, const AidlTypenames& typenames,
   // Type checking should guarantee that nothing below emits code until "return
   // status" if we are a oneway method, so no more fear of accessing reply.
 
-  // If the method is expected to return something, read it first by convention.
-  if (method.GetType().GetName() != "void") {
-    out.Write("%s = %s.%s(%s);\n", kAndroidStatusVarName, kReplyVarName,
-              ParcelReadMethodOf(method.GetType(), typenames).c_str(),
-              ParcelReadCastOf(method.GetType(), typenames, kReturnVarName).c_str());
-    GenerateGotoErrorOnBadStatus(out);
-  }
+  if (compact) {
+    vector<CompactValue> out_values;
+    if (method.GetType().GetName() != "void") {
+      out_values.push_back(
+          CompactValueOf(method.GetType(), typenames, kReturnVarName, /*is_const=*/false));
+    }
+    for (const AidlArgument* a : method.GetOutArguments()) {
+      out_values.push_back(
+          CompactValueOf(a->GetType(), typenames, a->GetName(), /*is_const=*/false));
+    }
+    if (!out_values.empty()) {
+      GenerateCompactMarshalling(out, kReplyVarName, out_values, /*is_write=*/false);
+      GenerateGotoErrorOnBadStatus(out);
+    }
+  } else {
+    // If the method is expected to return something, read it first by convention.
+    if (method.GetType().GetName() != "void") {
+      out.Write("%s = %s.%s(%s);\n", kAndroidStatusVarName, kReplyVarName,
+                ParcelReadMethodOf(method.GetType(), typenames).c_str(),
+                ParcelReadCastOf(method.GetType(), typenames, kReturnVarName).c_str());
+      GenerateGotoErrorOnBadStatus(out);
+    }
 
-  for (const AidlArgument* a : method.GetOutArguments()) {
-    // Deserialization looks roughly like:
-    //     _aidl_ret_status = _aidl_reply.ReadInt32(out_param_name);
-    //     if (_aidl_status != ::android::OK) { goto _aidl_error; }
-    out.Write("%s = %s.%s(%s);\n", kAndroidStatusVarName, kReplyVarName,
-              ParcelReadMethodOf(a->GetType(), typenames).c_str(),
-              ParcelReadCastOf(a->GetType(), typenames, a->GetName()).c_str());
-    GenerateGotoErrorOnBadStatus(out);
+    for (const AidlArgument* a : method.GetOutArguments()) {
+      // Deserialization looks roughly like:
+      //     _aidl_ret_status = _aidl_reply.ReadInt32(out_param_name);
+      //     if (_aidl_status != ::android::OK) { goto _aidl_error; }
+      out.Write("%s = %s.%s(%s);\n", kAndroidStatusVarName, kReplyVarName,
+                ParcelReadMethodOf(a->GetType(), typenames).c_str(),
+                ParcelReadCastOf(a->GetType(), typenames, a->GetName()).c_str());
+      GenerateGotoErrorOnBadStatus(out);
+    }
   }
 
   // If we've gotten to here, one of two things is true:
@@ -321,7 +607,7 @@ void GenerateClientMetaTransaction(CodeWriter& out, const AidlInterface& interfa
         << "  if (cached_version_ == -1) {\n"
         << "    ::android::Parcel data;\n"
         << "    ::android::Parcel reply;\n"
-        << "    data.writeInterfaceToken(getInterfaceDescriptor());\n"
+        << "    data.writeInterfaceToken(" << kInterfaceTokenArgs << ");\n"
         << "    ::android::status_t err = remote()->transact("
         << GetTransactionIdFor(bn_name, method) << ", data, &reply);\n"
         << "    if (err == ::android::OK) {\n"
@@ -342,7 +628,7 @@ void GenerateClientMetaTransaction(CodeWriter& out, const AidlInterface& interfa
         << "  if (cached_hash_ == \"-1\") {\n"
         << "    ::android::Parcel data;\n"
         << "    ::android::Parcel reply;\n"
-        << "    data.writeInterfaceToken(getInterfaceDescriptor());\n"
+        << "    data.writeInterfaceToken(" << kInterfaceTokenArgs << ");\n"
         << "    ::android::status_t err = remote()->transact("
         << GetTransactionIdFor(bn_name, method) << ", data, &reply);\n"
         << "    if (err == ::android::OK) {\n"
@@ -370,10 +656,18 @@ void GenerateClientSource(CodeWriter& out, const AidlInterface& interface,
     include_list.emplace_back("chrono");
     include_list.emplace_back("functional");
   }
+  const bool has_compact_methods = HasCompactMethods(interface, typenames);
+  if (has_compact_methods) {
+    include_list.emplace_back("cstring");  // memcpy in the compact marshaller
+  }
   for (const auto& path : include_list) {
     out << "#include <" << path << ">\n";
   }
   out << "\n";
+  // Also used by the server, which is defined later in the same file.
+  if (has_compact_methods) {
+    out << kCompactMarshaller << "\n";
+  }
 
   const string i_name = ClassName(interface, ClassNames::INTERFACE);
   const string bp_name = ClassName(interface, ClassNames::CLIENT);
@@ -465,7 +759,7 @@ void GenerateServerTransaction(CodeWriter& out, const AidlInterface& interface,
   }
 
   // Check that the client is calling the correct interface.
-  out.Write("if (!(%s.checkInterface(this))) {\n", kDataVarName);
+  out.Write("if (!(%s.enforceInterface(%s))) {\n", kDataVarName, kInterfaceTokenArgs);
   out.Write("  %s = ::android::BAD_TYPE;\n", kAndroidStatusVarName);
   out.Write("  break;\n");
   out.Write("}\n");
@@ -477,27 +771,62 @@ void GenerateServerTransaction(CodeWriter& out, const AidlInterface& interface,
   }
 
   if (interface.EnforceExpression() || method.GetType().EnforceExpression()) {
-    out.Write("#error Permission checks not implemented for the cpp backend\n");
-  }
-
-  // Deserialize each "in" parameter to the transaction.
-  for (const auto& a: method.GetArguments()) {
-    // Deserialization looks roughly like:
-    //     _aidl_ret_status = _aidl_data.ReadInt32(&in_param_name);
-    //     if (_aidl_ret_status != ::android::OK) { break; }
-    const string& var_name = "&" + BuildVarName(*a);
-    if (a->IsIn()) {
-      out.Write("%s = %s.%s(%s);\n", kAndroidStatusVarName, kDataVarName,
-                ParcelReadMethodOf(a->GetType(), typenames).c_str(),
-                ParcelReadCastOf(a->GetType(), typenames, var_name).c_str());
+    GeneratePermissionCheck(
+        out, interface, method,
+        PermissionCheckContext{
+            .impl = "",
+            .cache_lookup = "_aidl_lookupPermissionCache(",
+            .cache_store = "_aidl_storePermissionCache(",
+            .calling_pid = "::android::IPCThreadState::self()->getCallingPid()",
+            .calling_uid = "::android::IPCThreadState::self()->getCallingUid()",
+            .deny =
+                [](CodeWriter& out, const AidlMethod& method) {
+                  if (method.IsOneway()) {
+                    out.Write("%s = ::android::PERMISSION_DENIED;\n", kAndroidStatusVarName);
+                  } else {
+                    out.Write(
+                        "%s = %s::fromExceptionCode(%s::EX_SECURITY, \"Permission denied for "
+                        "%s\").writeToParcel(%s);\n",
+                        kAndroidStatusVarName, kBinderStatusLiteral, kBinderStatusLiteral,
+                        method.GetName().c_str(), kReplyVarName);
+                  }
+                },
+        });
+  }
+
+  const bool compact = IsCompactMethod(interface, method, typenames);
+  if (compact) {
+    vector<CompactValue> in_values;
+    for (const auto& a : method.GetArguments()) {
+      if (a->IsIn()) {
+        in_values.push_back(CompactValueOf(a->GetType(), typenames, "&" + BuildVarName(*a),
+                                           /*is_const=*/false));
+      }
+    }
+    if (!in_values.empty()) {
+      GenerateCompactMarshalling(out, kDataVarName, in_values, /*is_write=*/false);
       GenerateBreakOnStatusNotOk(out);
-    } else if (a->IsOut() && a->GetType().IsDynamicArray()) {
-      // Special case, the length of the out array is written into the parcel.
-      //     _aidl_ret_status = _aidl_data.resizeOutVector(&out_param_name);
+    }
+  } else {
+    // Deserialize each "in" parameter to the transaction.
+    for (const auto& a: method.GetArguments()) {
+      // Deserialization looks roughly like:
+      //     _aidl_ret_status = _aidl_data.ReadInt32(&in_param_name);
       //     if (_aidl_ret_status != ::android::OK) { break; }
-      out.Write("%s = %s.resizeOutVector(%s);\n", kAndroidStatusVarName, kDataVarName,
-                var_name.c_str());
-      GenerateBreakOnStatusNotOk(out);
+      const string& var_name = "&" + BuildVarName(*a);
+      if (a->IsIn()) {
+        out.Write("%s = %s.%s(%s);\n", kAndroidStatusVarName, kDataVarName,
+                  ParcelReadMethodOf(a->GetType(), typenames).c_str(),
+                  ParcelReadCastOf(a->GetType(), typenames, var_name).c_str());
+        GenerateBreakOnStatusNotOk(out);
+      } else if (a->IsOut() && a->GetType().IsDynamicArray()) {
+        // Special case, the length of the out array is written into the parcel.
+        //     _aidl_ret_status = _aidl_data.resizeOutVector(&out_param_name);
+        //     if (_aidl_ret_status != ::android::OK) { break; }
+        out.Write("%s = %s.resizeOutVector(%s);\n", kAndroidStatusVarName, kDataVarName,
+                  var_name.c_str());
+        GenerateBreakOnStatusNotOk(out);
+      }
     }
   }
 
@@ -531,6 +860,23 @@ void GenerateServerTransaction(CodeWriter& out, const AidlInterface& interface,
     out.Write("}\n");
   }
 
+  if (compact) {
+    vector<CompactValue> out_values;
+    if (method.GetType().GetName() != "void") {
+      out_values.push_back(CompactValueOf(method.GetType(), typenames,
+                                          string("&") + kReturnVarName, /*is_const=*/true));
+    }
+    for (const AidlArgument* a : method.GetOutArguments()) {
+      out_values.push_back(
+          CompactValueOf(a->GetType(), typenames, "&" + BuildVarName(*a), /*is_const=*/true));
+    }
+    if (!out_values.empty()) {
+      GenerateCompactMarshalling(out, kReplyVarName, out_values, /*is_write=*/true);
+      GenerateBreakOnStatusNotOk(out);
+    }
+    return;
+  }
+
   // If we have a return value, write it first.
   if (method.GetType().GetName() != "void") {
     out.Write("%s = %s->%s(%s);\n", kAndroidStatusVarName, kReplyVarName,
@@ -556,12 +902,12 @@ void GenerateServerMetaTransaction(CodeWriter& out, const AidlInterface& interfa
 
   string iface = ClassName(interface, ClassNames::INTERFACE);
   if (method.GetName() == kGetInterfaceVersion && options.Version() > 0) {
-    out << "_aidl_data.checkInterface(this);\n"
+    out << "_aidl_data.enforceInterface(" << kInterfaceTokenArgs << ");\n"
         << "_aidl_reply->writeNoException();\n"
         << "_aidl_reply->writeInt32(" << iface << "::VERSION);\n";
   }
   if (method.GetName() == kGetInterfaceHash && !options.Hash().empty()) {
-    out << "_aidl_data.checkInterface(this);\n"
+    out << "_aidl_data.enforceInterface(" << kInterfaceTokenArgs << ");\n"
         << "_aidl_reply->writeNoException();\n"
         << "_aidl_reply->writeUtf8AsUtf16(" << iface << "::HASH);\n";
   }
@@ -648,6 +994,10 @@ void GenerateServerSource(CodeWriter& out, const AidlInterface& interface,
     include_list.emplace_back("chrono");
     include_list.emplace_back("functional");
   }
+  if (interface.UsesPermissions()) {
+    include_list.emplace_back(kIPCThreadStateHeader);
+    include_list.emplace_back(kIServiceManagerHeader);
+  }
   for (const auto& include : include_list) {
     out << "#include <" << include << ">\n";
   }
@@ -689,6 +1039,13 @@ void GenerateServerSource(CodeWriter& out, const AidlInterface& interface,
     out << "std::function<void(const " + q_name + "::TransactionLog&)> " << q_name
         << "::logFunc;\n";
   }
+  if (interface.UsesPermissions()) {
+    out << "bool " << q_name
+        << "::checkPermission(const char* permission, pid_t pid, uid_t uid) {\n"
+        << "  return ::android::checkPermission(::android::String16(permission), pid, uid);\n"
+        << "}\n";
+    GeneratePermissionCacheDefinitions(out, q_name);
+  }
 
   LeaveNamespace(out, interface);
 }
@@ -753,6 +1110,7 @@ void GenerateClientClassDecl(CodeWriter& out, const AidlInterface& interface,
     out.Indent();
     if (options.Version() > 0) {
       out << "int32_t cached_version_ = -1;\n";
+      GenerateUnsupportedMethodsDecl(out, interface, "unsupported_methods_");
     }
     if (!options.Hash().empty()) {
       out << "std::string cached_hash_ = \"-1\";\n";
@@ -775,6 +1133,9 @@ void GenerateClientHeader(CodeWriter& out, const AidlInterface& interface,
     out << "#include <functional>\n";  // for std::function
     out << "#include <android/binder_to_string.h>\n";
   }
+  if (options.Version() > 0 && interface.CountUserMethods() > 0) {
+    out << "#include <atomic>\n";  // for unsupported_methods_
+  }
   out << "\n";
   EnterNamespace(out, interface);
   GenerateClientClassDecl(out, interface, typenames, options);
@@ -847,7 +1208,20 @@ void GenerateServerClassDecl(CodeWriter& out, const AidlInterface& interface,
     out << kTransactionLogStruct;
     out << "static std::function<void(const TransactionLog&)> logFunc;\n";
   }
+  if (interface.UsesPermissions()) {
+    out << "// Checks @EnforcePermission permissions of the caller. Decisions are cached per "
+           "object and\n"
+           "// calling uid, so the answer must not depend on the pid.\n";
+    out << "virtual bool checkPermission(const char* permission, pid_t pid, uid_t uid);\n";
+    GeneratePermissionCacheDecl(out);
+  }
   out.Dedent();
+  if (interface.UsesPermissions()) {
+    out << "private:\n";
+    out.Indent();
+    GeneratePermissionCachePrivateDecl(out);
+    out.Dedent();
+  }
   out << "};  // class " << bn_name << "\n\n";
 
   std::string d_name = ClassName(interface, ClassNames::DELEGATOR_IMPL);
@@ -939,6 +1313,121 @@ void GenerateServerClassDecl(CodeWriter& out, const AidlInterface& interface,
   out << "};  // class " << d_name << "\n";
 }
 
+// With --header_forward_decls, returns the type references which the header of |defined_type|
+// can leave incomplete: interfaces and parcelables which GenerateForwardDecls declares, used in
+// the method signatures of a top-level interface. Nested interfaces are not handled as their
+// client/server classes are defined in the same header.
+std::set<const AidlTypeSpecifier*> ForwardDeclarableReferences(
+    const AidlDefinedType& defined_type, const Options& options) {
+  std::set<const AidlTypeSpecifier*> references;
+  const auto iface = AidlCast<AidlInterface>(defined_type);
+  if (!options.HeaderForwardDecls() || !iface) {
+    return references;
+  }
+  for (const auto& method : iface->GetMethods()) {
+    for (const auto type : Collect<AidlTypeSpecifier>(*method)) {
+      const auto referenced = type->GetDefinedType();
+      if (referenced && !referenced->GetParentType() &&
+          (referenced->AsInterface() || referenced->AsStructuredParcelable())) {
+        references.insert(type);
+      }
+    }
+  }
+  return references;
+}
+
+// Collect all includes for the type's header. Nested types are visited as well via VisitTopDown.
+// Headers which the header doesn't need because of forward declarations are collected in
+// |deferred| and included by the source instead.
+void CollectHeaderIncludes(const AidlDefinedType& defined_type, const AidlTypenames& typenames,
+                           const Options& options, std::set<std::string>* header_includes,
+                           std::set<std::string>* deferred) {
+  struct Visitor : AidlVisitor {
+    const AidlTypenames& typenames;
+    const Options& options;
+    const std::set<const AidlTypeSpecifier*> forward_declarable;
+    std::set<std::string> includes;
+    std::set<std::string> deferred;
+    Visitor(const AidlTypenames& typenames, const Options& options,
+            std::set<const AidlTypeSpecifier*> forward_declarable)
+        : typenames(typenames),
+          options(options),
+          forward_declarable(std::move(forward_declarable)) {}
+
+    // Collect includes for each type reference including built-in type
+    void Visit(const AidlTypeSpecifier& type) override {
+      if (forward_declarable.count(&type)) {
+        std::set<std::string> headers;
+        cpp::AddHeaders(type, typenames, &headers);
+        const std::string header = CppHeaderForType(*type.GetDefinedType());
+        headers.erase(header);
+        deferred.insert(header);
+        includes.insert(headers.begin(), headers.end());
+        return;
+      }
+      cpp::AddHeaders(type, typenames, &includes);
+    }
+
+    // Collect implementation-specific includes for each type definition
+    void Visit(const AidlInterface& iface) override {
+      includes.insert(kIBinderHeader);        // IBinder
+      includes.insert(kIInterfaceHeader);     // IInterface
+      includes.insert(kStatusHeader);         // Status
+      includes.insert(kStrongPointerHeader);  // sp<>
+
+      if (options.GenTraces()) {
+        includes.insert(kTraceHeader);
+      }
+
+      // For a nested interface, client/server classes are declared the same header as well.
+      if (iface.GetParentType()) {
+        includes.insert(kBinderDelegateHeader);  // Delegate.h
+        // client/server class provides logFunc when gen_log is on
+        if (options.GenLog()) {
+          includes.insert("functional");                  // std::function for logFunc
+          includes.insert("android/binder_to_string.h");  // Generic ToString helper
+        }
+        if (iface.UsesPermissions()) {
+          includes.insert("atomic");  // permission cache
+        }
+      }
+    }
+
+    void Visit(const AidlStructuredParcelable&) override {
+      AddParcelableCommonHeaders();
+      includes.insert("tuple");  // std::tie in comparison operators
+    }
+
+    void Visit(const AidlUnionDecl& union_decl) override {
+      AddParcelableCommonHeaders();
+      auto union_headers = cpp::UnionWriter::GetHeaders(union_decl);
+      includes.insert(std::begin(union_headers), std::end(union_headers));
+    }
+
+    void Visit(const AidlEnumDeclaration&) override {
+      includes.insert("array");           // used in enum_values
+      includes.insert("binder/Enums.h");  // provides enum_range
+      includes.insert("string");          // toString() returns std::string
+    }
+
+    void AddParcelableCommonHeaders() {
+      includes.insert(kParcelHeader);                 // Parcel in readFromParcel/writeToParcel
+      includes.insert(kStatusHeader);                 // Status
+      includes.insert(kString16Header);               // String16 in getParcelableDescriptor
+      includes.insert("android/binder_to_string.h");  // toString()
+    }
+  } v(typenames, options, ForwardDeclarableReferences(defined_type, options));
+  VisitTopDown(v, defined_type);
+
+  // A header used elsewhere in the header stays there.
+  for (const auto& path : v.deferred) {
+    if (!v.includes.count(path)) {
+      deferred->insert(path);
+    }
+  }
+  *header_includes = std::move(v.includes);
+}
+
 // Collect all includes for the type's server header. Nested types are visited as well via
 // VisitTopDown.
 void GenerateServerHeaderIncludes(CodeWriter& out, const AidlDefinedType& defined_type,
@@ -969,6 +1458,12 @@ void GenerateServerHeaderIncludes(CodeWriter& out, const AidlDefinedType& define
   } v(typenames, options);
   VisitTopDown(v, defined_type);
 
+  // Implementations need the definitions which the interface header only forward-declares.
+  if (options.HeaderForwardDecls()) {
+    std::set<std::string> header_includes;
+    CollectHeaderIncludes(defined_type, typenames, options, &header_includes, &v.includes);
+  }
+
   v.includes.insert(kBinderDelegateHeader);
   for (const auto& path : v.includes) {
     out << "#include <" << path << ">\n";
@@ -985,6 +1480,9 @@ void GenerateServerHeader(CodeWriter& out, const AidlInterface& interface,
     out << "#include <functional>\n";  // for std::function
     out << "#include <android/binder_to_string.h>\n";
   }
+  if (interface.UsesPermissions()) {
+    out << "#include <atomic>\n";  // for the permission cache
+  }
   GenerateServerHeaderIncludes(out, interface, typenames, options);
   out << "\n";
   EnterNamespace(out, interface);
@@ -1012,6 +1510,13 @@ void GenerateInterfaceClassDecl(CodeWriter& out, const AidlInterface& interface,
   out.Indent();
   out << "typedef " << ClassName(interface, ClassNames::DELEGATOR_IMPL) << " DefaultDelegator;\n";
   out << "DECLARE_META_INTERFACE(" << ClassName(interface, ClassNames::BASE) << ")\n";
+  // The descriptor as written to and checked against the interface token of transactions, so
+  // that they don't go through the String16 built by IMPLEMENT_META_INTERFACE. String constants
+  // are ASCII, so its length in UTF-16 is its size.
+  out << "static constexpr char16_t descriptor_utf16[] = u\"" << interface.GetDescriptor()
+      << "\";\n";
+  out << "static constexpr size_t descriptor_utf16_length = "
+      << std::to_string(interface.GetDescriptor().size()) << ";\n";
   if (options.Version() > 0) {
     out << "const int32_t VERSION = " << std::to_string(options.Version()) << ";\n";
   }
@@ -1306,74 +1811,16 @@ void GenerateClassDecl(CodeWriter& out, const AidlDefinedType& defined_type,
 
 using namespace internals;
 
-// Collect all includes for the type's header. Nested types are visited as well via VisitTopDown.
 void GenerateHeaderIncludes(CodeWriter& out, const AidlDefinedType& defined_type,
                             const AidlTypenames& typenames, const Options& options) {
-  struct Visitor : AidlVisitor {
-    const AidlTypenames& typenames;
-    const Options& options;
-    std::set<std::string> includes;
-    Visitor(const AidlTypenames& typenames, const Options& options)
-        : typenames(typenames), options(options) {}
-
-    // Collect includes for each type reference including built-in type
-    void Visit(const AidlTypeSpecifier& type) override {
-      cpp::AddHeaders(type, typenames, &includes);
-    }
-
-    // Collect implementation-specific includes for each type definition
-    void Visit(const AidlInterface& iface) override {
-      includes.insert(kIBinderHeader);        // IBinder
-      includes.insert(kIInterfaceHeader);     // IInterface
-      includes.insert(kStatusHeader);         // Status
-      includes.insert(kStrongPointerHeader);  // sp<>
-
-      if (options.GenTraces()) {
-        includes.insert(kTraceHeader);
-      }
-
-      // For a nested interface, client/server classes are declared the same header as well.
-      if (iface.GetParentType()) {
-        includes.insert(kBinderDelegateHeader);  // Delegate.h
-        // client/server class provides logFunc when gen_log is on
-        if (options.GenLog()) {
-          includes.insert("functional");                  // std::function for logFunc
-          includes.insert("android/binder_to_string.h");  // Generic ToString helper
-        }
-      }
-    }
+  std::set<std::string> includes, deferred;
+  CollectHeaderIncludes(defined_type, typenames, options, &includes, &deferred);
 
-    void Visit(const AidlStructuredParcelable&) override {
-      AddParcelableCommonHeaders();
-      includes.insert("tuple");  // std::tie in comparison operators
-    }
-
-    void Visit(const AidlUnionDecl& union_decl) override {
-      AddParcelableCommonHeaders();
-      auto union_headers = cpp::UnionWriter::GetHeaders(union_decl);
-      includes.insert(std::begin(union_headers), std::end(union_headers));
-    }
-
-    void Visit(const AidlEnumDeclaration&) override {
-      includes.insert("array");           // used in enum_values
-      includes.insert("binder/Enums.h");  // provides enum_range
-      includes.insert("string");          // toString() returns std::string
-    }
-
-    void AddParcelableCommonHeaders() {
-      includes.insert(kParcelHeader);                 // Parcel in readFromParcel/writeToParcel
-      includes.insert(kStatusHeader);                 // Status
-      includes.insert(kString16Header);               // String16 in getParcelableDescriptor
-      includes.insert("android/binder_to_string.h");  // toString()
-    }
-  } v(typenames, options);
-  VisitTopDown(v, defined_type);
-
-  for (const auto& path : v.includes) {
+  for (const auto& path : includes) {
     out << "#include <" << path << ">\n";
   }
   out << "\n";
-  if (v.includes.count("cassert")) {
+  if (includes.count("cassert")) {
     // TODO(b/31559095) bionic on host should define __assert2
     out << "#ifndef __BIONIC__\n#define __assert2(a,b,c,d) ((void)0)\n#endif\n\n";
   }
@@ -1418,6 +1865,84 @@ void GenerateHeaderDefinitions(CodeWriter& out, const AidlDefinedType& defined_t
   VisitTopDown(v, defined_type);
 }
 
+std::set<std::string> GenericInstantiations(const AidlDefinedType& defined_type,
+                                            const AidlTypenames& typenames,
+                                            const Options& options) {
+  // Headers declare the instantiations before their own types, so the arguments must come from
+  // other files. Type parameters of generic types are neither built-in nor defined types.
+  // Forward-declared types (--header_forward_decls) can't be used either.
+  const string file = defined_type.GetLocation().GetFile();
+  const auto forward_declared = internals::ForwardDeclarableReferences(defined_type, options);
+  std::function<bool(const AidlTypeSpecifier&)> is_concrete = [&](const AidlTypeSpecifier& type) {
+    if (forward_declared.count(&type)) {
+      return false;
+    }
+    if (!AidlTypenames::IsBuiltinTypename(type.GetName()) &&
+        (type.GetDefinedType() == nullptr ||
+         type.GetDefinedType()->GetLocation().GetFile() == file)) {
+      return false;
+    }
+    if (type.IsGeneric()) {
+      for (const auto& arg : type.GetTypeParameters()) {
+        if (!is_concrete(*arg)) return false;
+      }
+    }
+    return true;
+  };
+
+  std::set<std::string> instantiations;
+  VisitTopDown(
+      [&](const AidlNode& node) {
+        const auto* type = AidlCast<AidlTypeSpecifier>(node);
+        if (type == nullptr || !type->IsGeneric() || !is_concrete(*type)) return;
+        const AidlDefinedType* generic = type->GetDefinedType();
+        if (generic == nullptr ||
+            (!generic->AsStructuredParcelable() && !generic->AsUnionDeclaration())) {
+          return;
+        }
+        std::vector<std::string> name = generic->GetSplitPackage();
+        name.push_back(GetQualifiedName(*generic));
+        std::vector<std::string> args;
+        for (const auto& arg : type->GetTypeParameters()) {
+          args.push_back(CppNameOf(*arg, typenames));
+        }
+        instantiations.insert("::" + Join(name, "::") + "<" + Join(args, ", ") + ">");
+      },
+      defined_type);
+  return instantiations;
+}
+
+bool GenerateExplicitInstantiations(const Options& options, const IoDelegate& io_delegate) {
+  // Headers of the types using each instantiation
+  std::map<string, std::set<string>> instantiations;
+  for (const auto& input_file : options.InputFiles()) {
+    AidlTypenames typenames;
+    if (aidl::internals::load_and_validate_aidl(input_file, options, io_delegate, &typenames,
+                                                nullptr) != AidlError::OK) {
+      return false;
+    }
+    for (const auto& defined_type : typenames.MainDocument().DefinedTypes()) {
+      for (const auto& instantiation : GenericInstantiations(*defined_type, typenames, options)) {
+        instantiations[instantiation].insert(HeaderFile(*defined_type, ClassNames::RAW, false));
+      }
+    }
+  }
+  std::set<string> headers;
+  for (const auto& [instantiation, users] : instantiations) {
+    headers.insert(users.begin(), users.end());
+  }
+  unique_ptr<CodeWriter> out = io_delegate.GetCodeWriter(options.OutputFile());
+  *out << "// Explicit instantiations of generic parcelables generated by aidl.\n";
+  for (const auto& header : headers) {
+    *out << "#include <" << header << ">\n";
+  }
+  *out << "\n";
+  for (const auto& [instantiation, users] : instantiations) {
+    *out << "template class " << instantiation << ";\n";
+  }
+  return out->Close();
+}
+
 void GenerateHeader(CodeWriter& out, const AidlDefinedType& defined_type,
                     const AidlTypenames& typenames, const Options& options) {
   if (auto parcelable = AidlCast<AidlParcelable>(defined_type); parcelable) {
@@ -1427,6 +1952,12 @@ void GenerateHeader(CodeWriter& out, const AidlDefinedType& defined_type,
   out << "#pragma once\n\n";
   GenerateHeaderIncludes(out, defined_type, typenames, options);
   GenerateForwardDecls(out, defined_type, false);
+  if (options.ExplicitInstantiations()) {
+    // Instantiated by GenerateExplicitInstantiations()
+    for (const auto& instantiation : GenericInstantiations(defined_type, typenames, options)) {
+      out << "extern template class " << instantiation << ";\n";
+    }
+  }
   EnterNamespace(out, defined_type);
   // Each class decl contains its own nested types' class decls
   GenerateClassDecl(out, defined_type, typenames, options);
@@ -1470,6 +2001,14 @@ void GenerateServerHeader(CodeWriter& out, const AidlDefinedType& defined_type,
 
 void GenerateSource(CodeWriter& out, const AidlDefinedType& defined_type,
                     const AidlTypenames& typenames, const Options& options) {
+  // Definitions of the types which the header only forward-declares.
+  if (options.HeaderForwardDecls()) {
+    std::set<std::string> header_includes, deferred;
+    CollectHeaderIncludes(defined_type, typenames, options, &header_includes, &deferred);
+    for (const auto& path : deferred) {
+      out << "#include <" << path << ">\n";
+    }
+  }
   struct Visitor : AidlVisitor {
     CodeWriter& out;
     const AidlTypenames& typenames;
@@ -1522,21 +2061,24 @@ bool GenerateCpp(const string& output_file, const Options& options, const AidlTy
 
   using GenFn = void (*)(CodeWriter & out, const AidlDefinedType& defined_type,
                          const AidlTypenames& typenames, const Options& options);
-  // Wrap Generate* function to handle CodeWriter for a file.
+  // The outputs are generated in memory and then written together, headers first.
+  std::vector<std::pair<string, string>> files;
   auto gen = [&](auto file, GenFn fn) {
-    unique_ptr<CodeWriter> writer(io_delegate.GetCodeWriter(file));
+    string code;
+    unique_ptr<CodeWriter> writer = CodeWriter::ForString(&code);
     fn(*writer, defined_type, typenames, options);
-    AIDL_FATAL_IF(!writer->Close(), defined_type) << "I/O Error!";
-    return true;
+    writer->Close();
+    files.emplace_back(std::move(file), std::move(code));
   };
 
-  return gen(options.OutputHeaderDir() + HeaderFile(defined_type, ClassNames::RAW),
-             &GenerateHeader) &&
-         gen(options.OutputHeaderDir() + HeaderFile(defined_type, ClassNames::CLIENT),
-             &GenerateClientHeader) &&
-         gen(options.OutputHeaderDir() + HeaderFile(defined_type, ClassNames::SERVER),
-             &GenerateServerHeader) &&
-         gen(output_file, &GenerateSource);
+  gen(options.OutputHeaderDir() + HeaderFile(defined_type, ClassNames::RAW), &GenerateHeader);
+  gen(options.OutputHeaderDir() + HeaderFile(defined_type, ClassNames::CLIENT),
+      &GenerateClientHeader);
+  gen(options.OutputHeaderDir() + HeaderFile(defined_type, ClassNames::SERVER),
+      &GenerateServerHeader);
+  gen(output_file, &GenerateSource);
+  AIDL_FATAL_IF(!io_delegate.WriteFiles(files), defined_type) << "I/O Error!";
+  return true;
 }
 
 }  // namespace cpp
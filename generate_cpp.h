@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <set>
 #include <string>
 
 #include "aidl_language.h"
@@ -31,6 +32,17 @@ namespace cpp {
 bool GenerateCpp(const string& output_file, const Options& options, const AidlTypenames& typenames,
                  const AidlDefinedType& parsed_doc, const IoDelegate& io_delegate);
 
+// Instantiations of the generic structured parcelables and unions which |defined_type| uses, as
+// C++ class names. With --explicit_instantiations, the header of |defined_type| declares these as
+// extern templates.
+std::set<std::string> GenericInstantiations(const AidlDefinedType& defined_type,
+                                            const AidlTypenames& typenames,
+                                            const Options& options);
+
+// Writes the definitions of the instantiations which the types of the input files use to the
+// output file, for --instantiations. Each is defined once, however the inputs are compiled.
+bool GenerateExplicitInstantiations(const Options& options, const IoDelegate& io_delegate);
+
 }  // namespace cpp
 }  // namespace aidl
 }  // namespace android
@@ -32,9 +32,11 @@
 #include "aidl_to_java.h"
 #include "code_writer.h"
 #include "logging.h"
+#include "os.h"
 
 using ::android::base::EndsWith;
 using ::android::base::Join;
+using ::android::base::Split;
 using ::android::base::StartsWith;
 using std::string;
 using std::unique_ptr;
@@ -437,6 +439,7 @@ std::unique_ptr<android::aidl::java::Class> GenerateParcelableClass(
         .var = field->GetName(),
         .min_sdk_version = options.GetMinSdkVersion(),
         .write_to_parcel_flag = "_aidl_flag",
+        .parcel_helper = ParcelHelperClass(options),
     };
     WriteToParcelFor(context);
     writer->Close();
@@ -537,6 +540,7 @@ std::unique_ptr<android::aidl::java::Class> GenerateParcelableClass(
         .var = field_variable_name,
         .min_sdk_version = options.GetMinSdkVersion(),
         .is_classloader_created = &is_classloader_created,
+        .parcel_helper = ParcelHelperClass(options),
     };
     context.writer.Indent();
     if (parcel->IsJavaOnlyImmutable()) {
@@ -798,6 +802,7 @@ void GenerateUnionClass(CodeWriter& out, const AidlUnionDecl* decl, const AidlTy
         .var = name,
         .min_sdk_version = options.GetMinSdkVersion(),
         .write_to_parcel_flag = "_aidl_flag",
+        .parcel_helper = ParcelHelperClass(options),
     };
     WriteToParcelFor(context);
     writer->Close();
@@ -834,6 +839,7 @@ void GenerateUnionClass(CodeWriter& out, const AidlUnionDecl* decl, const AidlTy
         .var = name,
         .min_sdk_version = options.GetMinSdkVersion(),
         .is_classloader_created = &is_classloader_created,
+        .parcel_helper = ParcelHelperClass(options),
     };
     CreateFromParcelFor(context);
     writer->Close();
@@ -1055,6 +1061,19 @@ void GenerateJava(const std::string& filename, const Options& options, const Aid
   AIDL_FATAL_IF(!code_writer->Close(), defined_type) << "I/O Error!";
 }
 
+bool GenerateSharedParcelHelper(const Options& options, const IoDelegate& io_delegate) {
+  const std::string path = options.OutputDir() +
+                           Join(Split(options.SharedParcelHelper(), "."), OS_PATH_SEPARATOR) +
+                           ".java";
+  CodeWriterPtr code_writer = io_delegate.GetCodeWriter(path);
+  GenerateSharedParcelHelper(*code_writer, options);
+  if (!code_writer->Close()) {
+    AIDL_ERROR(path) << "Failed to write the shared parcel helper.";
+    return false;
+  }
+  return true;
+}
+
 }  // namespace java
 }  // namespace aidl
 }  // namespace android
@@ -32,6 +32,9 @@ void GenerateJava(const std::string& filename, const Options& options,
                   const AidlTypenames& typenames, const AidlDefinedType& defined_type,
                   const IoDelegate& io_delegate);
 
+// Writes the class of --shared_parcel_helper under the output directory.
+bool GenerateSharedParcelHelper(const Options& options, const IoDelegate& io_delegate);
+
 void GenerateClass(CodeWriter& out, const AidlDefinedType& defined_type, const AidlTypenames& types,
                    const Options& options);
 
@@ -387,6 +387,12 @@ ProxyClass::ProxyClass(const AidlInterface* interfaceType, const Options& option
   if (options.Version() > 0) {
     std::ostringstream code;
     code << "private int mCachedVersion = -1;\n";
+    // A bit per method which the remote side doesn't implement. Racing updates can only lose a
+    // bit, which costs another transaction.
+    if (const int count = interfaceType->CountUserMethods(); count > 0) {
+      code << "private final long[] mUnsupportedMethods = new long[" << (count + 63) / 64
+           << "];\n";
+    }
     this->elements.emplace_back(std::make_shared<LiteralClassElement>(code.str()));
   }
   if (!options.Hash().empty()) {
@@ -411,7 +417,7 @@ ProxyClass::~ProxyClass() {}
 
 static void GenerateWriteToParcel(CodeWriter& out, const AidlTypenames& typenames,
                                   const AidlTypeSpecifier& type, const std::string& parcel,
-                                  const std::string& var, uint32_t min_sdk_version,
+                                  const std::string& var, const Options& options,
                                   bool is_return_value) {
   WriteToParcelFor(CodeGeneratorContext{
       .writer = out,
@@ -419,19 +425,20 @@ static void GenerateWriteToParcel(CodeWriter& out, const AidlTypenames& typename
       .type = type,
       .parcel = parcel,
       .var = var,
-      .min_sdk_version = min_sdk_version,
+      .min_sdk_version = options.GetMinSdkVersion(),
       .write_to_parcel_flag =
           is_return_value ? "android.os.Parcelable.PARCELABLE_WRITE_RETURN_VALUE" : "0",
+      .parcel_helper = ParcelHelperClass(options),
   });
 }
 
 static void GenerateWriteToParcel(std::shared_ptr<StatementBlock> addTo,
                                   const AidlTypenames& typenames, const AidlTypeSpecifier& type,
                                   const std::string& parcel, const std::string& var,
-                                  uint32_t min_sdk_version, bool is_return_value) {
+                                  const Options& options, bool is_return_value) {
   string code;
-  GenerateWriteToParcel(*CodeWriter::ForString(&code), typenames, type, parcel, var,
-                        min_sdk_version, is_return_value);
+  GenerateWriteToParcel(*CodeWriter::ForString(&code), typenames, type, parcel, var, options,
+                        is_return_value);
   addTo->Add(std::make_shared<LiteralStatement>(code));
 }
 
@@ -574,7 +581,8 @@ static void GenerateStubCode(const AidlMethod& method, bool oneway,
                                      .parcel = transact_data->name,
                                      .var = v->name,
                                      .min_sdk_version = options.GetMinSdkVersion(),
-                                     .is_classloader_created = &is_classloader_created};
+                                     .is_classloader_created = &is_classloader_created,
+                                     .parcel_helper = ParcelHelperClass(options)};
         CreateFromParcelFor(context);
       } else {
         // "out" parameter should be instantiated before calling the real impl.
@@ -634,7 +642,7 @@ static void GenerateStubCode(const AidlMethod& method, bool oneway,
 
     // marshall the return value
     GenerateWriteToParcel(statements, typenames, method.GetType(), transact_reply->name,
-                          _result->name, options.GetMinSdkVersion(), /*is_return_value=*/true);
+                          _result->name, options, /*is_return_value=*/true);
   }
 
   // out parameters
@@ -643,7 +651,7 @@ static void GenerateStubCode(const AidlMethod& method, bool oneway,
     std::shared_ptr<Variable> v = stubArgs.Get(i++);
     if (arg->GetDirection() & AidlArgument::OUT_DIR) {
       GenerateWriteToParcel(statements, typenames, arg->GetType(), transact_reply->name, v->name,
-                            options.GetMinSdkVersion(), /*is_return_value=*/true);
+                            options, /*is_return_value=*/true);
     }
   }
 }
@@ -716,11 +724,50 @@ static void GenerateProxyMethod(CodeWriter& out, const AidlInterface& iface,
                                 const Options& options) {
   bool is_void = method.GetType().GetName() == "void";
 
+  // Calls the default impl for a method the remote side doesn't implement.
+  const auto generate_unimplemented = [&]() {
+    if (iface.IsJavaDefault()) {
+      out << "if (getDefaultImpl() != null) {\n";
+      out.Indent();
+      if (is_void) {
+        out << "getDefaultImpl()." << method.GetName() << "("
+            << ArgList(method, &AidlArgument::GetName) << ");\n";
+        out << "return;\n";
+      } else {
+        out << "return getDefaultImpl()." << method.GetName() << "("
+            << ArgList(method, &AidlArgument::GetName) << ");\n";
+      }
+      out.Dedent();
+      out << "}\n";
+    }
+
+    // TODO(b/274144762): we shouldn't have different behavior for versioned interfaces
+    // also this set to false for all exceptions, not just unimplemented methods.
+    if (options.Version() > 0) {
+      out << "throw new android.os.RemoteException(\"Method " << method.GetName()
+          << " is unimplemented.\");\n";
+    }
+  };
+
+  // A versioned proxy doesn't transact a method again once the remote side didn't know it.
+  const bool cache_unsupported = options.Version() > 0 && !oneway;
+  const int index = iface.GetUserMethodIndex(method);
+  const std::string unsupported_word = "mUnsupportedMethods[" + std::to_string(index / 64) + "]";
+  const std::string unsupported_mask = "(1L << " + std::to_string(index % 64) + ")";
+
   out << GenerateComments(method);
   out << "@Override public " << JavaSignatureOf(method.GetType()) << " " << method.GetName() << "("
       << ArgList(method, FormatArgForDecl) << ") throws android.os.RemoteException\n{\n";
   out.Indent();
 
+  if (cache_unsupported) {
+    out << "if ((" << unsupported_word << " & " << unsupported_mask << ") != 0) {\n";
+    out.Indent();
+    generate_unimplemented();
+    out.Dedent();
+    out << "}\n";
+  }
+
   // the parcels
   if (options.GenRpc()) {
     out << "android.os.Parcel _data = android.os.Parcel.obtain(asBinder());\n";
@@ -756,8 +803,8 @@ static void GenerateProxyMethod(CodeWriter& out, const AidlInterface& iface,
       // we pass the size of the array so that the remote can allocate the array with the same size.
       out << "_data.writeInt(" << arg->GetName() << ".length);\n";
     } else if (dir & AidlArgument::IN_DIR) {
-      GenerateWriteToParcel(out, typenames, arg->GetType(), "_data", arg->GetName(),
-                            options.GetMinSdkVersion(), /*is_return_value=*/false);
+      GenerateWriteToParcel(out, typenames, arg->GetType(), "_data", arg->GetName(), options,
+                            /*is_return_value=*/false);
     }
   }
 
@@ -787,29 +834,10 @@ static void GenerateProxyMethod(CodeWriter& out, const AidlInterface& iface,
   if (iface.IsJavaDefault() || options.Version() > 0) {
     out << "if (!_status) {\n";
     out.Indent();
-
-    if (iface.IsJavaDefault()) {
-      out << "if (getDefaultImpl() != null) {\n";
-      out.Indent();
-      if (is_void) {
-        out << "getDefaultImpl()." << method.GetName() << "("
-            << ArgList(method, &AidlArgument::GetName) << ");\n";
-        out << "return;\n";
-      } else {
-        out << "return getDefaultImpl()." << method.GetName() << "("
-            << ArgList(method, &AidlArgument::GetName) << ");\n";
-      }
-      out.Dedent();
-      out << "}\n";
+    if (cache_unsupported) {
+      out << unsupported_word << " |= " << unsupported_mask << ";\n";
     }
-
-    // TODO(b/274144762): we shouldn't have different behavior for versioned interfaces
-    // also this set to false for all exceptions, not just unimplemented methods.
-    if (options.Version() > 0) {
-      out << "throw new android.os.RemoteException(\"Method " << method.GetName()
-          << " is unimplemented.\");\n";
-    }
-
+    generate_unimplemented();
     out.Dedent();
     out << "}\n";
   }
@@ -829,7 +857,8 @@ static void GenerateProxyMethod(CodeWriter& out, const AidlInterface& iface,
                                                .parcel = "_reply",
                                                .var = "_result",
                                                .min_sdk_version = options.GetMinSdkVersion(),
-                                               .is_classloader_created = &is_classloader_created});
+                                               .is_classloader_created = &is_classloader_created,
+                                               .parcel_helper = ParcelHelperClass(options)});
     }
 
     // the out/inout parameters
@@ -841,7 +870,8 @@ static void GenerateProxyMethod(CodeWriter& out, const AidlInterface& iface,
                                                .parcel = "_reply",
                                                .var = arg->GetName(),
                                                .min_sdk_version = options.GetMinSdkVersion(),
-                                               .is_classloader_created = &is_classloader_created});
+                                               .is_classloader_created = &is_classloader_created,
+                                               .parcel_helper = ParcelHelperClass(options)});
       }
     }
   }
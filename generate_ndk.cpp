@@ -22,6 +22,7 @@
 #include "aidl_to_ndk.h"
 #include "logging.h"
 
+#include <android-base/format.h>
 #include <android-base/stringprintf.h>
 
 namespace android {
@@ -34,6 +35,7 @@ static constexpr const char* kHash = "hash";
 static constexpr const char* kCachedVersion = "_aidl_cached_version";
 static constexpr const char* kCachedHash = "_aidl_cached_hash";
 static constexpr const char* kCachedHashMutex = "_aidl_cached_hash_mutex";
+static constexpr const char* kUnsupportedMethods = "_aidl_unsupported_methods";
 
 namespace internals {
 // 4 outputs for NDK for each type: Header, BpHeader, BnHeader, Source
@@ -101,11 +103,14 @@ void GenerateNdk(const string& output_file, const Options& options, const AidlTy
                  const AidlDefinedType& defined_type, const IoDelegate& io_delegate) {
   using GenFn = void (*)(CodeWriter & out, const AidlTypenames& types,
                          const AidlDefinedType& defined_type, const Options& options);
-  // Wrap Generate* function to handle CodeWriter for a file.
+  // The outputs are generated in memory and then written together, headers first.
+  std::vector<std::pair<string, string>> files;
   auto gen = [&](auto file, GenFn fn) {
-    unique_ptr<CodeWriter> writer(io_delegate.GetCodeWriter(file));
+    string code;
+    unique_ptr<CodeWriter> writer = CodeWriter::ForString(&code);
     fn(*writer, types, defined_type, options);
-    AIDL_FATAL_IF(!writer->Close(), defined_type) << "I/O Error!";
+    writer->Close();
+    files.emplace_back(std::move(file), std::move(code));
   };
 
   gen(options.OutputHeaderDir() + NdkHeaderFile(defined_type, ClassNames::RAW), &GenerateHeader);
@@ -114,6 +119,7 @@ void GenerateNdk(const string& output_file, const Options& options, const AidlTy
   gen(options.OutputHeaderDir() + NdkHeaderFile(defined_type, ClassNames::SERVER),
       &GenerateServerHeader);
   gen(output_file, &GenerateSource);
+  AIDL_FATAL_IF(!io_delegate.WriteFiles(files), defined_type) << "I/O Error!";
 }
 
 namespace internals {
@@ -296,6 +302,9 @@ void GenerateHeaderIncludes(CodeWriter& out, const AidlTypenames& types,
         if (options.GenTraces()) {
           includes.insert("android/trace.h");
         }
+        if (interface.UsesPermissions()) {
+          includes.insert("atomic");  // permission cache
+        }
       }
     }
 
@@ -402,8 +411,11 @@ static void GenerateSourceIncludes(CodeWriter& out, const AidlTypenames& types,
   }
   out << "\n";
 
-  // Emit additional definition for gen_traces
+  // Emit additional definition for gen_traces. Guarded as unity sources (--unity_shards) put
+  // sources of several interfaces in a translation unit.
   if (v.has_interface && options.GenTraces()) {
+    out << "#ifndef AIDL_NDK_SCOPED_TRACE\n";
+    out << "#define AIDL_NDK_SCOPED_TRACE\n";
     out << "namespace {\n";
     out << "struct ScopedTrace {\n";
     out.Indent();
@@ -412,6 +424,7 @@ static void GenerateSourceIncludes(CodeWriter& out, const AidlTypenames& types,
     out.Dedent();
     out << "};\n";
     out << "}  // namespace\n";
+    out << "#endif  // AIDL_NDK_SCOPED_TRACE\n";
     out << "\n";
   }
 }
@@ -466,6 +479,14 @@ void GenerateSource(CodeWriter& out, const AidlTypenames& types, const AidlInter
   LeaveNdkNamespace(out, defined_type);
 }
 
+// The friend of the Bn class through which the file-local onTransact reaches its private
+// permission decision cache.
+static string PermissionCacheFriendName(const AidlInterface& interface) {
+  string name = interface.GetCanonicalName();
+  std::replace(name.begin(), name.end(), '.', '_');
+  return "_aidl_" + name + "_PermissionCache";
+}
+
 static std::string MethodId(const AidlMethod& m) {
   return "(FIRST_CALL_TRANSACTION + " + std::to_string(m.GetId()) + " /*" + m.GetName() + "*/)";
 }
@@ -499,6 +520,23 @@ static void GenerateClientMethodDefinition(CodeWriter& out, const AidlTypenames&
     out.Dedent();
     out << "}\n";
   }
+  const std::string iface = ClassName(defined_type, ClassNames::INTERFACE);
+  const bool cache_unsupported = cpp::CachesUnsupportedMethod(method, options);
+  if (cache_unsupported) {
+    out << "if " << cpp::UnsupportedMethodTest(defined_type, method, kUnsupportedMethods)
+        << " {\n";
+    out.Indent();
+    out << "if (" << iface << "::getDefaultImpl()) {\n";
+    out.Indent();
+    out << "return " << iface << "::getDefaultImpl()->" << method.GetName() << "(";
+    out << NdkArgList(types, method, FormatArgNameOnly) << ");\n";
+    out.Dedent();
+    out << "}\n";
+    out << "_aidl_status.set(AStatus_fromStatus(STATUS_UNKNOWN_TRANSACTION));\n"
+        << "return _aidl_status;\n";
+    out.Dedent();
+    out << "}\n";
+  }
   out << "::ndk::ScopedAParcel _aidl_in;\n";
   out << "::ndk::ScopedAParcel _aidl_out;\n";
   out << "\n";
@@ -551,9 +589,14 @@ static void GenerateClientMethodDefinition(CodeWriter& out, const AidlTypenames&
   out << ");\n";
   out.Dedent();
 
+  if (cache_unsupported) {
+    out << "if (_aidl_ret_status == STATUS_UNKNOWN_TRANSACTION) {\n";
+    out << "  " << cpp::UnsupportedMethodSet(defined_type, method, kUnsupportedMethods) << ";\n";
+    out << "}\n";
+  }
+
   // If the method is not implmented in the server side but the client has
   // provided the default implementation, call it instead of failing hard.
-  const std::string iface = ClassName(defined_type, ClassNames::INTERFACE);
   out << "if (_aidl_ret_status == STATUS_UNKNOWN_TRANSACTION && ";
   out << iface << "::getDefaultImpl()) {\n";
   out.Indent();
@@ -612,7 +655,28 @@ static void GenerateServerCaseDefinition(CodeWriter& out, const AidlTypenames& t
   out.Indent();
 
   if (defined_type.EnforceExpression() || method.GetType().EnforceExpression()) {
-    out.Write("#error Permission checks not implemented for the ndk backend\n");
+    cpp::GeneratePermissionCheck(
+        out, defined_type, method,
+        cpp::PermissionCheckContext{
+            .impl = "_aidl_impl->",
+            .cache_lookup = PermissionCacheFriendName(defined_type) + "::lookup(*_aidl_impl, ",
+            .cache_store = PermissionCacheFriendName(defined_type) + "::store(*_aidl_impl, ",
+            .calling_pid = "AIBinder_getCallingPid()",
+            .calling_uid = "AIBinder_getCallingUid()",
+            .deny =
+                [](CodeWriter& out, const AidlMethod& method) {
+                  if (method.IsOneway()) {
+                    out << "_aidl_ret_status = STATUS_PERMISSION_DENIED;\n";
+                  } else {
+                    out << "::ndk::ScopedAStatus _aidl_status = "
+                           "::ndk::ScopedAStatus::fromExceptionCodeWithMessage(EX_SECURITY, "
+                           "\"Permission denied for "
+                        << method.GetName() << "\");\n";
+                    out << "_aidl_ret_status = AParcel_writeStatusHeader(_aidl_out, "
+                           "_aidl_status.get());\n";
+                  }
+                },
+        });
   }
 
   for (const auto& arg : method.GetArguments()) {
@@ -698,6 +762,20 @@ void GenerateClassSource(CodeWriter& out, const AidlTypenames& types,
   const std::string q_name = GetQualifiedName(defined_type, ClassNames::SERVER);
 
   const string on_transact = OnTransactFuncName(defined_type);
+  if (defined_type.UsesPermissions()) {
+    constexpr auto tmpl = R"--(struct {name} {{
+  static bool lookup({q_name}& _aidl_impl, uint32_t _aidl_expr, uid_t _aidl_uid, bool* _aidl_granted) {{
+    return _aidl_impl._aidl_lookupPermissionCache(_aidl_expr, _aidl_uid, _aidl_granted);
+  }}
+  static void store({q_name}& _aidl_impl, uint32_t _aidl_expr, uid_t _aidl_uid, bool _aidl_granted) {{
+    _aidl_impl._aidl_storePermissionCache(_aidl_expr, _aidl_uid, _aidl_granted);
+  }}
+}};
+
+)--";
+    out << fmt::format(tmpl, fmt::arg("name", PermissionCacheFriendName(defined_type)),
+                       fmt::arg("q_name", q_name));
+  }
   bool deprecated = defined_type.IsDeprecated() ||
                     std::any_of(defined_type.GetMethods().begin(), defined_type.GetMethods().end(),
                                 [](const auto& m) { return m->IsDeprecated(); });
@@ -770,6 +848,9 @@ void GenerateServerSource(CodeWriter& out, const AidlTypenames& types,
     out << "std::function<void(const " << q_name << "::TransactionLog&)> " << q_name
         << "::logFunc;\n";
   }
+  if (defined_type.UsesPermissions()) {
+    cpp::GeneratePermissionCacheDefinitions(out, q_name);
+  }
   out << "::ndk::SpAIBinder " << q_name << "::createBinder() {\n";
   out.Indent();
   out << "AIBinder* binder = AIBinder_new(" << GlobalClassVarName(defined_type)
@@ -956,6 +1037,7 @@ void GenerateClientClassDecl(CodeWriter& out, const AidlTypenames& types,
 
   if (options.Version() > 0) {
     out << "int32_t " << kCachedVersion << " = -1;\n";
+    cpp::GenerateUnsupportedMethodsDecl(out, defined_type, kUnsupportedMethods);
   }
 
   if (!options.Hash().empty()) {
@@ -977,6 +1059,9 @@ void GenerateClientHeader(CodeWriter& out, const AidlTypenames& types,
       << "\"\n";
   out << "\n";
   out << "#include <android/binder_ibinder.h>\n";
+  if (options.Version() > 0 && defined_type.CountUserMethods() > 0) {
+    out << "#include <atomic>\n";
+  }
   if (options.GenLog()) {
     out << "#include <functional>\n";
     out << "#include <chrono>\n";
@@ -1074,6 +1159,13 @@ void GenerateServerClassDecl(CodeWriter& out, const AidlTypenames& types,
     out << cpp::kTransactionLogStruct;
     out << "static std::function<void(const TransactionLog&)> logFunc;\n";
   }
+  if (defined_type.UsesPermissions()) {
+    out << "// Checks @EnforcePermission permissions of the caller. Decisions are cached per "
+           "object and\n"
+           "// calling uid, so the answer must not depend on the pid.\n";
+    out << "virtual bool checkPermission(const char* permission, pid_t pid, uid_t uid) = 0;\n";
+    cpp::GeneratePermissionCacheDecl(out);
+  }
   out.Dedent();
   out << "protected:\n";
   out.Indent();
@@ -1081,6 +1173,9 @@ void GenerateServerClassDecl(CodeWriter& out, const AidlTypenames& types,
   out.Dedent();
   out << "private:\n";
   out.Indent();
+  if (defined_type.UsesPermissions()) {
+    cpp::GeneratePermissionCachePrivateDecl(out, PermissionCacheFriendName(defined_type));
+  }
   out.Dedent();
   out << "};\n";
 }
@@ -1092,6 +1187,9 @@ void GenerateServerHeader(CodeWriter& out, const AidlTypenames& types,
       << "\"\n";
   out << "\n";
   out << "#include <android/binder_ibinder.h>\n";
+  if (defined_type.UsesPermissions()) {
+    out << "#include <atomic>\n";  // for the permission cache
+  }
   // Needed for *Delegator classes while delegator version is required to be
   // the same as the implementation version
   // TODO(b/222347502) If we ever need to support mismatched versions of delegator and
@@ -233,6 +233,11 @@ void GenerateClientMethodHelpers(CodeWriter& out, const AidlInterface& iface,
       default_args += arg->GetName();
     }
     out << "if let Err(binder::StatusCode::UNKNOWN_TRANSACTION) = _aidl_reply {\n";
+    if (cpp::CachesUnsupportedMethod(method, options)) {
+      const int index = iface.GetUserMethodIndex(method);
+      out << "  self.unsupported_methods[" << std::to_string(index / 64) << "].fetch_or(1 << "
+          << std::to_string(index % 64) << ", std::sync::atomic::Ordering::Relaxed);\n";
+    }
     out << "  if let Some(_aidl_default_impl) = <Self as " << default_trait_name
         << ">::getDefaultImpl() {\n";
     out << "    return _aidl_default_impl.r#" << method.GetName() << "(" << default_args << ");\n";
@@ -338,6 +343,33 @@ void GenerateClientMethod(CodeWriter& out, const AidlInterface& iface, const Aid
   string read_response_args =
       build_parcel_args.empty() ? "_aidl_reply" : build_parcel_args + ", _aidl_reply";
 
+  // A method which the remote side doesn't implement is answered without a transaction, the same
+  // way as when it fails with UNKNOWN_TRANSACTION.
+  if (cpp::CachesUnsupportedMethod(method, options)) {
+    const int index = iface.GetUserMethodIndex(method);
+    const string unsupported_args =
+        (build_parcel_args.empty() ? "" : build_parcel_args + ", ") +
+        "Err(binder::StatusCode::UNKNOWN_TRANSACTION)";
+    const string unsupported_response =
+        "self.read_response_" + method.GetName() + "(" + unsupported_args + ")";
+    out << "if self.unsupported_methods[" << std::to_string(index / 64)
+        << "].load(std::sync::atomic::Ordering::Relaxed) & (1 << " << std::to_string(index % 64)
+        << ") != 0 {\n";
+    switch (kind) {
+      case MethodKind::NORMAL:
+      case MethodKind::ASYNC:
+        out << "  return " << unsupported_response << ";\n";
+        break;
+      case MethodKind::BOXED_FUTURE:
+        out << "  return Box::pin(std::future::ready(" << unsupported_response << "));\n";
+        break;
+      case MethodKind::READY_FUTURE:
+        out << "  return std::future::ready(" << unsupported_response << ");\n";
+        break;
+    }
+    out << "}\n";
+  }
+
   vector<string> flags;
   if (method.IsOneway()) flags.push_back("binder::binder_impl::FLAG_ONEWAY");
   if (iface.IsSensitiveData()) flags.push_back("binder::binder_impl::FLAG_CLEAR_BUF");
@@ -581,17 +613,25 @@ void GenerateRustInterface(CodeWriter* code_writer, const AidlInterface* iface,
   *code_writer << "native: " << server_name << "(on_transact),\n";
   *code_writer << "proxy: " << client_name << " {\n";
   code_writer->Indent();
+  vector<string> proxy_fields;
   if (options.Version() > 0) {
-    string comma = options.Hash().empty() ? "" : ",";
-    *code_writer << "cached_version: "
-                    "std::sync::atomic::AtomicI32 = "
-                    "std::sync::atomic::AtomicI32::new(-1)"
-                 << comma << "\n";
+    proxy_fields.push_back(
+        "cached_version: "
+        "std::sync::atomic::AtomicI32 = "
+        "std::sync::atomic::AtomicI32::new(-1)");
+    if (const int count = iface->CountUserMethods(); count > 0) {
+      proxy_fields.push_back("unsupported_methods: [std::sync::atomic::AtomicU64; " +
+                             std::to_string((count + 63) / 64) + "] = Default::default()");
+    }
   }
   if (!options.Hash().empty()) {
-    *code_writer << "cached_hash: "
-                    "std::sync::Mutex<Option<String>> = "
-                    "std::sync::Mutex::new(None)\n";
+    proxy_fields.push_back(
+        "cached_hash: "
+        "std::sync::Mutex<Option<String>> = "
+        "std::sync::Mutex::new(None)");
+  }
+  for (size_t i = 0; i < proxy_fields.size(); i++) {
+    *code_writer << proxy_fields[i] << (i + 1 < proxy_fields.size() ? "," : "") << "\n";
   }
   code_writer->Dedent();
   *code_writer << "},\n";
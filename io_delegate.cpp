@@ -16,8 +16,11 @@
 
 #include "io_delegate.h"
 
+#include <atomic>
+#include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <iostream>
 #include <type_traits>
 #include <vector>
 
@@ -32,6 +35,7 @@
 #include <unistd.h>
 #endif
 
+#include <android-base/file.h>
 #include <android-base/strings.h>
 
 #include "logging.h"
@@ -109,6 +113,14 @@ unique_ptr<string> IoDelegate::GetFileContents(
   return contents;
 }
 
+unique_ptr<std::istream> IoDelegate::GetFileStream(const string& filename) const {
+  auto in = std::make_unique<std::ifstream>(filename, std::ios::in | std::ios::binary);
+  if (!*in) {
+    return nullptr;
+  }
+  return in;
+}
+
 bool IoDelegate::FileIsReadable(const string& path) const {
 #ifdef _WIN32
   // check that the file exists and is not write-only
@@ -150,6 +162,15 @@ bool IoDelegate::CreateDirForPath(const string& path) const {
     return true;
   }
 
+  // Generators write many files to the same few directories.
+  const string dir = path.substr(0, path.find_last_of(OS_PATH_SEPARATOR) + 1);
+  {
+    std::lock_guard<std::mutex> lock(known_dirs_mutex_);
+    if (known_dirs_.count(dir) > 0) {
+      return true;
+    }
+  }
+
   string absolute_path;
   if (!GetAbsolutePath(path, &absolute_path)) {
     return false;
@@ -172,7 +193,12 @@ bool IoDelegate::CreateDirForPath(const string& path) const {
     directories.pop_back();
   }
 
-  return CreateNestedDirs(base, directories);
+  if (!CreateNestedDirs(base, directories)) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(known_dirs_mutex_);
+  known_dirs_.insert(dir);
+  return true;
 }
 
 unique_ptr<CodeWriter> IoDelegate::GetCodeWriter(
@@ -184,6 +210,54 @@ unique_ptr<CodeWriter> IoDelegate::GetCodeWriter(
   }
 }
 
+bool IoDelegate::WriteFileAtomically(const string& file_path, const string& contents) const {
+  if (!CreateDirForPath(file_path)) {
+    return false;
+  }
+  static std::atomic<unsigned> counter = 0;
+#ifdef _WIN32
+  const unsigned long pid = GetCurrentProcessId();
+#else
+  const unsigned long pid = getpid();
+#endif
+  const string temp_path =
+      file_path + ".tmp." + std::to_string(pid) + "." + std::to_string(counter++);
+  std::ofstream out(temp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  out.write(contents.data(), contents.size());
+  out.close();
+  if (out.fail()) {
+    remove(temp_path.c_str());
+    return false;
+  }
+#ifdef _WIN32
+  const bool success = MoveFileEx(temp_path.c_str(), file_path.c_str(), MOVEFILE_REPLACE_EXISTING);
+#else
+  const bool success = rename(temp_path.c_str(), file_path.c_str()) == 0;
+#endif
+  if (!success) {
+    remove(temp_path.c_str());
+  }
+  return success;
+}
+
+bool IoDelegate::WriteFiles(const vector<std::pair<string, string>>& files) const {
+  for (const auto& [file_path, contents] : files) {
+    // "-" is stdout, as in CodeWriter::ForFile().
+    if (file_path == "-") {
+      std::cout << contents;
+      if (!std::cout.flush()) {
+        return false;
+      }
+      continue;
+    }
+    if (!CreateDirForPath(file_path) ||
+        !android::base::WriteStringToFile(contents, file_path, /*follow_symlinks=*/true)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 #ifdef _WIN32
 
 static Result<void> add_list_files(const string& dirname, vector<string>* result) {
@@ -16,8 +16,12 @@
 
 #pragma once
 
+#include <istream>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <android-base/result.h>
@@ -52,6 +56,9 @@ class IoDelegate {
       const std::string& filename,
       const std::string& content_suffix = "") const;
 
+  // Returns a stream to read |filename| incrementally, or nullptr if it can't be opened.
+  virtual std::unique_ptr<std::istream> GetFileStream(const std::string& filename) const;
+
   virtual bool FileIsReadable(const std::string& path) const;
 
   virtual std::unique_ptr<CodeWriter> GetCodeWriter(
@@ -59,10 +66,22 @@ class IoDelegate {
 
   virtual android::base::Result<std::vector<std::string>> ListFiles(const std::string& dir) const;
 
+  // Replaces |file_path| with |contents| through a temporary file in the same directory, so that
+  // concurrent readers see either a previous file or the complete new one.
+  virtual bool WriteFileAtomically(const std::string& file_path, const std::string& contents) const;
+
+  // Writes the files of |files| (path and contents) in order, each with a single open and write.
+  // Stops at the first failure and returns false.
+  virtual bool WriteFiles(const std::vector<std::pair<std::string, std::string>>& files) const;
+
  private:
   // Create the directory when path is a dir or the parent directory when
   // path is a file. Path is a dir if it ends with the path separator.
   bool CreateDirForPath(const std::string& path) const;
+
+  // Directories which CreateDirForPath() has already created or found.
+  mutable std::mutex known_dirs_mutex_;
+  mutable std::set<std::string> known_dirs_;
 };  // class IoDelegate
 
 }  // namespace aidl
@@ -18,11 +18,15 @@
 
 #include <string>
 
+#include <android-base/file.h>
 #include <gtest/gtest.h>
 
+using android::base::ReadFileToString;
 using std::string;
 using testing::internal::CaptureStderr;
+using testing::internal::CaptureStdout;
 using testing::internal::GetCapturedStderr;
+using testing::internal::GetCapturedStdout;
 
 namespace android {
 namespace aidl {
@@ -48,5 +52,39 @@ TEST(IoDelegateTest, CurrentlyInfersLinuxAbsolutePath) {
   EXPECT_EQ(absolute_path[0], '/');
 }
 
+TEST(IoDelegateTest, WriteFilesCreatesDirectoriesAndStopsAtFailure) {
+  TemporaryDir dir;
+  const string base = string(dir.path) + "/";
+  IoDelegate io_delegate;
+  EXPECT_TRUE(io_delegate.WriteFiles(
+      {{base + "a/b/x.h", "x"}, {base + "a/b/y.h", "y"}, {base + "z.cpp", "z"}}));
+  string contents;
+  EXPECT_TRUE(ReadFileToString(base + "a/b/x.h", &contents));
+  EXPECT_EQ("x", contents);
+  EXPECT_TRUE(ReadFileToString(base + "a/b/y.h", &contents));
+  EXPECT_EQ("y", contents);
+  EXPECT_TRUE(ReadFileToString(base + "z.cpp", &contents));
+  EXPECT_EQ("z", contents);
+
+  // z.cpp is not a directory.
+  CaptureStderr();
+  EXPECT_FALSE(io_delegate.WriteFiles({{base + "z.cpp/w.h", "w"}, {base + "v.cpp", "v"}}));
+  GetCapturedStderr();
+  EXPECT_FALSE(ReadFileToString(base + "v.cpp", &contents));
+}
+
+TEST(IoDelegateTest, WriteFilesWritesDashToStdout) {
+  TemporaryDir dir;
+  const string base = string(dir.path) + "/";
+  IoDelegate io_delegate;
+  CaptureStdout();
+  EXPECT_TRUE(io_delegate.WriteFiles({{"-", "to stdout"}, {base + "x.h", "x"}}));
+  EXPECT_EQ("to stdout", GetCapturedStdout());
+  string contents;
+  EXPECT_TRUE(ReadFileToString(base + "x.h", &contents));
+  EXPECT_EQ("x", contents);
+  EXPECT_FALSE(ReadFileToString("-", &contents));
+}
+
 }  // namespace aidl
 }  // namespace android
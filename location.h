@@ -19,6 +19,14 @@
 #include <iostream>
 #include <string>
 
+namespace android {
+namespace aidl {
+class DocumentCache;
+}  // namespace aidl
+}  // namespace android
+
+class DiagnosticSink;
+
 class AidlLocation {
  public:
   struct Point {
@@ -46,6 +54,10 @@ class AidlLocation {
 
   friend std::ostream& operator<<(std::ostream& os, const AidlLocation& l);
   friend class AidlNode;
+  // To store locations of cached documents
+  friend class android::aidl::DocumentCache;
+  // To report locations in structured diagnostics
+  friend class DiagnosticSink;
 
  private:
   // INTENTIONALLY HIDDEN: only operator<< should access details here.
@@ -18,16 +18,114 @@
 
 #include "aidl_language.h"
 
-bool AidlErrorLog::sHadError = false;
+namespace {
+thread_local DiagnosticSink* current_sink = nullptr;
+
+// Serializes writes of sinks sharing an ostream (e.g. std::cerr).
+std::mutex& OutputMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+}  // namespace
+
+DiagnosticSink& DiagnosticSink::Default() {
+  static DiagnosticSink sink(std::cerr, /*buffered=*/false);
+  return sink;
+}
+
+DiagnosticSink& DiagnosticSink::Current() {
+  return current_sink ? *current_sink : Default();
+}
+
+void DiagnosticSink::Report(std::string message, bool is_error) {
+  Add({std::move(message), is_error, std::nullopt});
+}
+
+void DiagnosticSink::Report(std::string message, bool is_error, const AidlLocation& location,
+                            const std::string& body) {
+  Add({std::move(message), is_error,
+       DiagnosticRecord{is_error, location.file_, location.begin_.line, location.begin_.column,
+                        body}});
+}
+
+void DiagnosticSink::Add(Message message) {
+  if (message.is_error) had_error_ = true;
+  report_count_++;
+  if (keep_records_ && message.record) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    records_.push_back(*message.record);
+  }
+  if (!buffered_) {
+    Write(message.text);
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  messages_.push_back(std::move(message));
+}
+
+std::vector<DiagnosticRecord> DiagnosticSink::TakeRecords() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<DiagnosticRecord> records;
+  records.swap(records_);
+  return records;
+}
+
+void DiagnosticSink::Flush() {
+  std::vector<Message> messages;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    messages.swap(messages_);
+  }
+  if (messages.empty()) return;
+  std::string all;
+  for (const auto& message : messages) {
+    all += message.text;
+  }
+  Write(all);
+}
+
+void DiagnosticSink::ForwardTo(DiagnosticSink& sink) {
+  std::vector<Message> messages;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    messages.swap(messages_);
+  }
+  for (auto& message : messages) {
+    sink.Add(std::move(message));
+  }
+}
+
+void DiagnosticSink::Write(const std::string& message) {
+  std::lock_guard<std::mutex> lock(OutputMutex());
+  os_ << message << std::flush;
+}
+
+ScopedDiagnosticSink::ScopedDiagnosticSink(DiagnosticSink& sink) : previous_(current_sink) {
+  current_sink = &sink;
+}
+
+ScopedDiagnosticSink::~ScopedDiagnosticSink() {
+  current_sink = previous_;
+}
 
 AidlErrorLog::AidlErrorLog(Severity severity, const AidlLocation& location,
                            const std::string& suffix /* = "" */)
-    : os_(&std::cerr), severity_(severity), location_(location), suffix_(suffix) {
-  sHadError |= severity_ >= ERROR;
+    : sink_(&DiagnosticSink::Current()), severity_(severity), location_(location), suffix_(suffix) {
   if (severity_ != NO_OP) {
-    (*os_) << (severity_ == WARNING ? "WARNING: " : "ERROR: ");
-    (*os_) << location << ": ";
+    os_ << (severity_ == WARNING ? "WARNING: " : "ERROR: ");
+    os_ << location << ": ";
   }
+  body_begin_ = os_.str().size();
+}
+
+AidlErrorLog::AidlErrorLog(AidlErrorLog&& other)
+    : os_(std::move(other.os_)),
+      sink_(other.sink_),
+      severity_(other.severity_),
+      location_(other.location_),
+      suffix_(other.suffix_),
+      body_begin_(other.body_begin_) {
+  other.severity_ = NO_OP;
 }
 
 AidlErrorLog::AidlErrorLog(Severity severity, const AidlNode& node)
@@ -38,11 +136,22 @@ AidlErrorLog::AidlErrorLog(Severity severity, const std::string& filename)
 
 AidlErrorLog::~AidlErrorLog() {
   if (severity_ == NO_OP) return;
-  (*os_) << suffix_ << std::endl;
-  if (severity_ == FATAL) abort();
-  if (location_.IsInternal()) {
-    (*os_) << "Logging an internal location should not happen. Offending location: " << location_
-           << std::endl;
+  os_ << suffix_ << "\n";
+  const bool internal = location_.IsInternal();
+  if (internal) {
+    os_ << "Logging an internal location should not happen. Offending location: " << location_
+        << "\n";
+  }
+  const std::string message = os_.str();
+  std::string body = message.substr(body_begin_);
+  body.pop_back();  // the newline
+  sink_->Report(message, severity_ >= ERROR, location_, body);
+  if (severity_ == FATAL || internal) {
+    // Don't lose the diagnostics which led here, even when the sink doesn't print them.
+    sink_->Flush();
+    if (sink_ != &DiagnosticSink::Default()) {
+      DiagnosticSink::Default().Report(os_.str(), true);
+    }
     abort();
   }
 }
@@ -16,13 +16,106 @@
 
 #pragma once
 
+#include <atomic>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include "location.h"
 
 class AidlNode;
 
+// A diagnostic in structured form, for callers which consume them programmatically.
+struct DiagnosticRecord {
+  bool is_error;
+  std::string file;
+  // 0 when the location within the file is unknown. The first line and column are 1.
+  int line;
+  int column;
+  // The message without the severity and the location.
+  std::string message;
+};
+
+// Destination of the diagnostics of a compilation. Each AidlErrorLog message is delivered as a
+// whole, so messages from different threads never interleave.
+//
+// A sink is either unbuffered, writing each message as soon as it is complete, or buffered,
+// keeping messages in order until Flush(). Compilations running concurrently in a process
+// should each install their own buffered sink with ScopedDiagnosticSink and flush the sinks in a
+// fixed order, which keeps the output deterministic. Threads without a sink use Default(), which
+// writes to std::cerr unbuffered.
+class DiagnosticSink {
+ public:
+  explicit DiagnosticSink(std::ostream& os, bool buffered = true) : os_(os), buffered_(buffered) {}
+  ~DiagnosticSink() { Flush(); }
+
+  DiagnosticSink(const DiagnosticSink&) = delete;
+  DiagnosticSink& operator=(const DiagnosticSink&) = delete;
+
+  // Takes a complete message, including the trailing newline.
+  void Report(std::string message, bool is_error);
+  // Same as above, also keeping a record of the message when KeepRecords() was called.
+  void Report(std::string message, bool is_error, const AidlLocation& location,
+              const std::string& body);
+  // Writes out buffered messages. No-op for unbuffered sinks.
+  void Flush();
+  // Reports the messages buffered so far to |sink| instead, along with their records, and
+  // forgets them. This holds back the diagnostics of work which may still be thrown away.
+  void ForwardTo(DiagnosticSink& sink);
+
+  bool HadError() const { return had_error_; }
+  void ClearError() { had_error_ = false; }
+  // Number of messages reported so far, including warnings.
+  size_t ReportCount() const { return report_count_; }
+
+  // Starts keeping a DiagnosticRecord of each later message reported with its location.
+  void KeepRecords() { keep_records_ = true; }
+  // Returns the records kept so far, in order, and forgets them.
+  std::vector<DiagnosticRecord> TakeRecords();
+
+  // The sink of the current thread.
+  static DiagnosticSink& Current();
+  static DiagnosticSink& Default();
+
+ private:
+  friend class ScopedDiagnosticSink;
+
+  struct Message {
+    std::string text;
+    bool is_error;
+    std::optional<DiagnosticRecord> record;
+  };
+
+  void Add(Message message);
+  void Write(const std::string& message);
+
+  std::ostream& os_;
+  const bool buffered_;
+  std::mutex mutex_;
+  std::vector<Message> messages_;
+  std::atomic<bool> keep_records_ = false;
+  std::vector<DiagnosticRecord> records_;
+  std::atomic<bool> had_error_ = false;
+  std::atomic<size_t> report_count_ = 0;
+};
+
+// Routes the diagnostics of the current thread to `sink` during its lifetime.
+class ScopedDiagnosticSink {
+ public:
+  explicit ScopedDiagnosticSink(DiagnosticSink& sink);
+  ~ScopedDiagnosticSink();
+
+  ScopedDiagnosticSink(const ScopedDiagnosticSink&) = delete;
+  ScopedDiagnosticSink& operator=(const ScopedDiagnosticSink&) = delete;
+
+ private:
+  DiagnosticSink* previous_;
+};
+
 // Generic point for printing any error in the AIDL compiler.
 class AidlErrorLog {
  public:
@@ -42,26 +135,30 @@ class AidlErrorLog {
   AidlErrorLog& operator=(const AidlErrorLog&) = delete;
 
   // btw, making it movable so that functions can return it.
-  AidlErrorLog(AidlErrorLog&&) = default;
+  AidlErrorLog(AidlErrorLog&& other);
   AidlErrorLog& operator=(AidlErrorLog&&) = delete;
 
   template <typename T>
   AidlErrorLog& operator<<(T&& arg) {
     if (severity_ != NO_OP) {
-      (*os_) << std::forward<T>(arg);
+      os_ << std::forward<T>(arg);
     }
     return *this;
   }
 
-  static void clearError() { sHadError = false; }
-  static bool hadError() { return sHadError; }
+  // These refer to the sink of the current thread.
+  static void clearError() { DiagnosticSink::Current().ClearError(); }
+  static bool hadError() { return DiagnosticSink::Current().HadError(); }
 
  private:
-  std::ostream* os_;
+  // The message is sent to sink_ as a whole on destruction.
+  std::ostringstream os_;
+  DiagnosticSink* sink_;
   Severity severity_;
   const AidlLocation location_;
   const std::string suffix_;
-  static bool sHadError;
+  // Offset of the message after the severity and location prefix.
+  size_t body_begin_ = 0;
 };
 
 // A class used to make it obvious to clang that code is going to abort. This
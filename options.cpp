@@ -53,16 +53,30 @@ string Options::GetUsage() const {
        << myname_ << " --lang={java|cpp|ndk|rust} [OPTION]... INPUT..." << endl
        << "   Generate Java, C++ or Rust files for AIDL file(s)." << endl
        << endl
-       << myname_ << " --preprocess OUTPUT INPUT..." << endl
+       << myname_ << " --preprocess [--incremental] OUTPUT INPUT..." << endl
        << "   Create an AIDL file having declarations of AIDL file(s)." << endl
+       << "   With --incremental, keep an index in OUTPUT.idx and reprocess only" << endl
+       << "   the inputs which changed, or whose imports changed, since the last run." << endl
        << endl
        << myname_ << " --dumpapi --out=DIR INPUT..." << endl
        << "   Dump API signature of AIDL file(s) to DIR." << endl
        << endl
+       << myname_ << " --hashapi=VERSION [--frozen] OUTPUT INPUT..." << endl
+       << "   Write the hash of the API dump of AIDL file(s) and VERSION to OUTPUT," << endl
+       << "   without writing the dump. It's the hash build/hash_gen.sh computes." << endl
+       << "   With --frozen, the inputs are the files of a frozen aidl_api/<N>" << endl
+       << "   directory, which are hashed as they are instead of dumped again." << endl
+       << endl
        << myname_ << " --checkapi[={compatible|equal}] OLD_DIR NEW_DIR" << endl
        << "   Check whether NEW_DIR API dump is {compatible|equal} extension " << endl
        << "   of the API dump OLD_DIR. Default: compatible" << endl
        << endl
+       << myname_ << " --lang=cpp --instantiations OUTPUT INPUT..." << endl
+       << "   Write the explicit instantiations of generic parcelables which the" << endl
+       << "   types of all the AIDL files of a module use to OUTPUT, which the" << endl
+       << "   headers generated with --explicit_instantiations declare. Pass the" << endl
+       << "   options of those invocations, and compile OUTPUT with their sources." << endl
+       << endl
        << myname_ << " --apimapping OUTPUT INPUT..." << endl
        << "   Generate a mapping of declared aidl method signatures to" << endl
        << "   the original line number. e.g.: " << endl
@@ -93,6 +107,19 @@ string Options::GetUsage() const {
        << "          Use DIR as a search path for import statements." << endl
        << "  -p FILE, --preprocessed=FILE" << endl
        << "          Include FILE which is created by --preprocess." << endl
+       << "  --cache_dir=DIR" << endl
+       << "          Cache the parsed imports and preprocessed files under DIR and" << endl
+       << "          reuse them when their contents don't change. DIR can be shared" << endl
+       << "          by concurrent invocations." << endl
+       << "  --lazy_preprocessed" << endl
+       << "          Keep only the names of the types of preprocessed files and parse" << endl
+       << "          a declaration when a type of it is used. This bounds the memory" << endl
+       << "          for large preprocessed files. Preprocessed files aren't cached" << endl
+       << "          under --cache_dir then." << endl
+       << "  --parser=bison|descent" << endl
+       << "          Parse with the bison grammar (default) or with the hand-written" << endl
+       << "          recursive descent parser, which is faster. Both build the same" << endl
+       << "          AST and report the same errors." << endl
        << "  -d FILE, --dep=FILE" << endl
        << "          Generate dependency file as FILE. Don't use this when" << endl
        << "          there are multiple input files. Use -a then." << endl
@@ -134,6 +161,27 @@ string Options::GetUsage() const {
        << "  --log" << endl
        << "          Information about the transaction, e.g., method name, argument" << endl
        << "          values, execution time, etc., is provided via callback." << endl
+       << "  --header_forward_decls" << endl
+       << "          (for C++) Forward-declare the interfaces and parcelables which" << endl
+       << "          headers use only in method signatures, and include their" << endl
+       << "          headers from the generated source instead." << endl
+       << "  --unity_shards=N" << endl
+       << "          (for C++ and NDK) Write only N sources, aidl_unity_0.cpp to" << endl
+       << "          aidl_unity_<N-1>.cpp, under the output directory which together" << endl
+       << "          include the sources which other invocations generate for the" << endl
+       << "          input files. A type always goes to the same shard. Give all the" << endl
+       << "          input files of a module, and compile the shards instead of the" << endl
+       << "          sources of the types." << endl
+       << "  --explicit_instantiations" << endl
+       << "          (for C++) Declare the instantiations of generic parcelables which" << endl
+       << "          a type uses as extern templates in its header. They are defined" << endl
+       << "          once for the module by --instantiations." << endl
+       << "  --shared_parcel_helper=CLASS" << endl
+       << "          (for Java) Make the generated classes call the helpers which they" << endl
+       << "          need for older SDK versions in CLASS, a qualified class name" << endl
+       << "          unique to the module, instead of nesting a copy in each class." << endl
+       << "          Without input files, write CLASS under the output directory." << endl
+       << "          Compile it along with the classes." << endl
        << "  -Werror" << endl
        << "          Turn warnings into errors." << endl
        << "  -Wno-error=<warning>" << endl
@@ -266,12 +314,19 @@ Options::Options(int argc, const char* const raw_argv[], Options::Language defau
     static struct option long_options[] = {
         {"lang", required_argument, 0, 'l'},
         {"preprocess", no_argument, 0, 's'},
+        {"incremental", no_argument, 0, 'N'},
         {"dumpapi", no_argument, 0, 'u'},
         {"no_license", no_argument, 0, 'x'},
+        {"hashapi", required_argument, 0, 'k'},
+        {"frozen", no_argument, 0, 'z'},
         {"checkapi", optional_argument, 0, 'A'},
         {"apimapping", required_argument, 0, 'i'},
+        {"instantiations", required_argument, 0, 'g'},
         {"include", required_argument, 0, 'I'},
         {"preprocessed", required_argument, 0, 'p'},
+        {"cache_dir", required_argument, 0, 'C'},
+        {"lazy_preprocessed", no_argument, 0, 'M'},
+        {"parser", required_argument, 0, 'P'},
         {"dep", required_argument, 0, 'd'},
         {"out", required_argument, 0, 'o'},
         {"header_out", required_argument, 0, 'h'},
@@ -284,6 +339,10 @@ Options::Options(int argc, const char* const raw_argv[], Options::Language defau
         {"transaction_names", no_argument, 0, 'c'},
         {"version", required_argument, 0, 'v'},
         {"log", no_argument, 0, 'L'},
+        {"header_forward_decls", no_argument, 0, 'F'},
+        {"unity_shards", required_argument, 0, 'U'},
+        {"explicit_instantiations", no_argument, 0, 'G'},
+        {"shared_parcel_helper", required_argument, 0, 'Q'},
         {"hash", required_argument, 0, 'H'},
         {"help", no_argument, 0, 'e'},
         {0, 0, 0, 0},
@@ -328,12 +387,22 @@ Options::Options(int argc, const char* const raw_argv[], Options::Language defau
       case 's':
         task_ = Options::Task::PREPROCESS;
         break;
+      case 'N':
+        incremental_preprocess_ = true;
+        break;
       case 'u':
         task_ = Options::Task::DUMP_API;
         break;
       case 'x':
         dump_no_license_ = true;
         break;
+      case 'k':
+        task_ = Options::Task::HASH_API;
+        hash_api_version_ = Trim(optarg);
+        break;
+      case 'z':
+        hash_frozen_api_ = true;
+        break;
       case 'A':
         task_ = Options::Task::CHECK_API;
         // to ensure that all parcelables in the api dumpes are structured
@@ -356,6 +425,28 @@ Options::Options(int argc, const char* const raw_argv[], Options::Language defau
       case 'p':
         preprocessed_files_.emplace_back(Trim(optarg));
         break;
+      case 'C':
+        cache_dir_ = Trim(optarg);
+        if (!cache_dir_.empty() && cache_dir_.back() != OS_PATH_SEPARATOR) {
+          cache_dir_.push_back(OS_PATH_SEPARATOR);
+        }
+        break;
+      case 'M':
+        lazy_preprocessed_ = true;
+        break;
+      case 'P': {
+        const string parser = Trim(optarg);
+        if (parser == "bison") {
+          parser_kind_ = ParserKind::BISON;
+        } else if (parser == "descent") {
+          parser_kind_ = ParserKind::DESCENT;
+        } else {
+          error_message_ << "Unrecognized parser: '" << parser << "'. Must be bison or descent."
+                         << endl;
+          return;
+        }
+        break;
+      }
       case 'd':
         dependency_file_ = Trim(optarg);
         break;
@@ -427,6 +518,24 @@ Options::Options(int argc, const char* const raw_argv[], Options::Language defau
       case 'L':
         gen_log_ = true;
         break;
+      case 'F':
+        header_forward_decls_ = true;
+        break;
+      case 'G':
+        explicit_instantiations_ = true;
+        break;
+      case 'Q':
+        shared_parcel_helper_ = Trim(optarg);
+        break;
+      case 'U': {
+        const string shards_str = Trim(optarg);
+        if (!android::base::ParseUint(shards_str, &unity_shards_) || unity_shards_ == 0) {
+          error_message_ << "Invalid number of unity shards: '" << shards_str << "'. "
+                         << "It must be a positive number." << endl;
+          return;
+        }
+        break;
+      }
       case 'e':
         std::cerr << GetUsage();
         task_ = Task::HELP;
@@ -436,6 +545,10 @@ Options::Options(int argc, const char* const raw_argv[], Options::Language defau
         output_file_ = Trim(optarg);
         task_ = Task::DUMP_MAPPINGS;
         break;
+      case 'g':
+        output_file_ = Trim(optarg);
+        task_ = Task::EXPLICIT_INSTANTIATIONS;
+        break;
       default:
         error_message_ << GetUsage();
         CHECK(!Ok());
@@ -488,8 +601,11 @@ Options::Options(int argc, const char* const raw_argv[], Options::Language defau
   } else {
     // the new arguments format
     if (task_ == Options::Task::COMPILE || task_ == Options::Task::DUMP_API ||
-        task_ == Options::Task::DUMP_MAPPINGS) {
-      if (argc - optind < 1) {
+        task_ == Options::Task::DUMP_MAPPINGS ||
+        task_ == Options::Task::EXPLICIT_INSTANTIATIONS) {
+      // The shared parcel helper is written by an invocation of its own.
+      if (argc - optind < 1 &&
+          (task_ != Options::Task::COMPILE || shared_parcel_helper_.empty())) {
         error_message_ << "No input file." << endl;
         return;
       }
@@ -568,6 +684,43 @@ Options::Options(int argc, const char* const raw_argv[], Options::Language defau
       error_message_ << "--log is currently supported for either --lang=cpp or --lang=ndk" << endl;
       return;
     }
+    if (header_forward_decls_ && language_ != Options::Language::CPP) {
+      error_message_ << "--header_forward_decls is supported only for --lang=cpp" << endl;
+      return;
+    }
+    if (explicit_instantiations_) {
+      if (language_ != Options::Language::CPP) {
+        error_message_ << "--explicit_instantiations is supported only for --lang=cpp" << endl;
+        return;
+      }
+    }
+    if (!shared_parcel_helper_.empty()) {
+      if (language_ != Options::Language::JAVA) {
+        error_message_ << "--shared_parcel_helper is supported only for --lang=java" << endl;
+        return;
+      }
+      if (shared_parcel_helper_.find('.') == string::npos) {
+        error_message_ << "--shared_parcel_helper requires a qualified class name, but got '"
+                       << shared_parcel_helper_ << "'." << endl;
+        return;
+      }
+      if (input_files_.empty() && output_dir_.empty()) {
+        error_message_ << "--shared_parcel_helper requires output directory to write "
+                       << shared_parcel_helper_ << ". Use --out." << endl;
+        return;
+      }
+    }
+    if (unity_shards_ > 0) {
+      if (language_ != Options::Language::CPP && language_ != Options::Language::NDK) {
+        error_message_ << "--unity_shards is supported for either --lang=cpp or --lang=ndk"
+                       << endl;
+        return;
+      }
+      if (output_dir_.empty()) {
+        error_message_ << "--unity_shards requires output directory. Use --out." << endl;
+        return;
+      }
+    }
   }
   if (task_ == Options::Task::PREPROCESS) {
     if (version_ > 0) {
@@ -575,6 +728,10 @@ Options::Options(int argc, const char* const raw_argv[], Options::Language defau
       return;
     }
   }
+  if (incremental_preprocess_ && task_ != Options::Task::PREPROCESS) {
+    error_message_ << "--incremental is supported only with --preprocess." << endl;
+    return;
+  }
   if (task_ == Options::Task::CHECK_API) {
     if (input_files_.size() != 2) {
       error_message_ << "--checkapi requires two inputs for comparing, "
@@ -588,6 +745,19 @@ Options::Options(int argc, const char* const raw_argv[], Options::Language defau
       return;
     }
   }
+  if (task_ == Options::Task::EXPLICIT_INSTANTIATIONS &&
+      language_ != Options::Language::CPP) {
+    error_message_ << "--instantiations is supported only for --lang=cpp" << endl;
+    return;
+  }
+  if (hash_frozen_api_ && task_ != Options::Task::HASH_API) {
+    error_message_ << "--frozen is supported only with --hashapi." << endl;
+    return;
+  }
+  if (task_ == Options::Task::HASH_API && hash_api_version_.empty()) {
+    error_message_ << "--hashapi requires a version, e.g. --hashapi=latest-version." << endl;
+    return;
+  }
   if (task_ != Options::Task::COMPILE) {
     if (min_sdk_version_ != 0) {
       error_message_ << "--min_sdk_version is available only for compilation." << endl;
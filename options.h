@@ -99,11 +99,23 @@ class Options final {
  public:
   enum class Language { UNSPECIFIED, JAVA, CPP, NDK, RUST, CPP_ANALYZER };
 
-  enum class Task { HELP, COMPILE, PREPROCESS, DUMP_API, CHECK_API, DUMP_MAPPINGS };
+  enum class Task {
+    HELP,
+    COMPILE,
+    PREPROCESS,
+    DUMP_API,
+    HASH_API,
+    CHECK_API,
+    DUMP_MAPPINGS,
+    EXPLICIT_INSTANTIATIONS
+  };
 
   enum class CheckApiLevel { COMPATIBLE, EQUAL };
 
   enum class Stability { UNSPECIFIED, VINTF };
+
+  // Which implementation parses the AIDL files. They build the same ASTs.
+  enum class ParserKind { BISON, DESCENT };
   bool StabilityFromString(const std::string& stability, Stability* out_stability);
 
   Options(int argc, const char* const argv[], Language default_lang = Language::UNSPECIFIED);
@@ -141,6 +153,14 @@ class Options final {
 
   const vector<string>& PreprocessedFiles() const { return preprocessed_files_; }
 
+  // Directory where parsed imports and preprocessed files are cached. Empty if caching is off.
+  const string& CacheDir() const { return cache_dir_; }
+
+  // Whether preprocessed files are registered by name and parsed per declaration on use.
+  bool LazyPreprocessed() const { return lazy_preprocessed_; }
+
+  ParserKind GetParserKind() const { return parser_kind_; }
+
   string DependencyFile() const {
     return dependency_file_;
   }
@@ -178,8 +198,31 @@ class Options final {
 
   bool GenLog() const { return gen_log_; }
 
+  // Whether C++ headers include only the headers they need complete types from.
+  bool HeaderForwardDecls() const { return header_forward_decls_; }
+
+  // Number of unity sources which include the generated C++ sources. 0 if there is none.
+  size_t UnityShards() const { return unity_shards_; }
+
+  // Whether C++ headers declare the instantiations of generic parcelables their types use as
+  // extern templates. --instantiations defines them.
+  bool ExplicitInstantiations() const { return explicit_instantiations_; }
+
+  // Qualified name of the Java class which has the parcel helpers of all the generated classes.
+  // Empty if each class nests its own.
+  const string& SharedParcelHelper() const { return shared_parcel_helper_; }
+
+  // Whether --preprocess reuses the sections of unchanged inputs from the previous output.
+  bool IncrementalPreprocess() const { return incremental_preprocess_; }
+
   bool DumpNoLicense() const { return dump_no_license_; }
 
+  // The version which --hashapi appends to the API dump, like build/hash_gen.sh.
+  const std::string& HashApiVersion() const { return hash_api_version_; }
+
+  // Whether --hashapi hashes the bytes of the inputs, which are the dumps of a frozen version.
+  bool HashFrozenApi() const { return hash_frozen_api_; }
+
   bool Ok() const { return error_message_.stream_.str().empty(); }
 
   string GetErrorMessage() const { return error_message_.stream_.str(); }
@@ -205,6 +248,9 @@ class Options final {
   CheckApiLevel check_api_level_ = CheckApiLevel::COMPATIBLE;
   set<string> import_dirs_;
   vector<string> preprocessed_files_;
+  string cache_dir_;
+  bool lazy_preprocessed_ = false;
+  ParserKind parser_kind_ = ParserKind::BISON;
   string dependency_file_;
   bool gen_rpc_ = false;
   bool gen_traces_ = false;
@@ -222,7 +268,14 @@ class Options final {
   int version_ = 0;
   string hash_ = "";
   bool gen_log_ = false;
+  bool header_forward_decls_ = false;
+  size_t unity_shards_ = 0;
+  bool incremental_preprocess_ = false;
+  bool explicit_instantiations_ = false;
+  string shared_parcel_helper_;
   bool dump_no_license_ = false;
+  std::string hash_api_version_;
+  bool hash_frozen_api_ = false;
   ErrorMessage error_message_;
   WarningOptions warning_options_;
 };
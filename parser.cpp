@@ -17,8 +17,10 @@
 #include "parser.h"
 
 #include <queue>
+#include <string_view>
 
 #include "aidl_language_y.h"
+#include "descent_parser.h"
 #include "logging.h"
 
 void yylex_init(void**);
@@ -51,9 +53,171 @@ struct UnionTagGenerater : AidlVisitor {
   }
 };
 
+namespace {
+
+// Splits AIDL text, fed in chunks of any size, into top-level declarations. A declaration ends at
+// a ';' or '}' which is outside of comments, literals and brackets. Comments and whitespace after
+// a declaration go to the next one, which is where the lexer attaches them as well.
+class DeclarationSplitter {
+ public:
+  // Calls |on_declaration(text, offset, start)| for each declaration completed by |chunk|, where
+  // |offset| is the byte offset of |text| in the whole input. Stops and returns false when it
+  // returns false.
+  template <typename Callback>
+  bool Feed(std::string_view chunk, Callback on_declaration) {
+    size_t pos = buffer_.size();
+    buffer_.append(chunk);
+    for (; pos < buffer_.size(); pos++) {
+      if (Scan(buffer_[pos])) {
+        const size_t end = pos + 1;
+        if (!on_declaration(buffer_.substr(begin_, end - begin_), consumed_ + begin_, start_)) {
+          return false;
+        }
+        begin_ = end;
+        start_ = point_;
+        has_code_ = false;
+      }
+    }
+    // Keep only the declaration in progress.
+    buffer_.erase(0, begin_);
+    consumed_ += begin_;
+    begin_ = 0;
+    return true;
+  }
+
+  // The text after the last declaration and where it starts.
+  const std::string& Rest() const { return buffer_; }
+  size_t RestOffset() const { return consumed_; }
+  AidlLocation::Point RestStart() const { return start_; }
+  // Whether Rest() has more than whitespace and comments.
+  bool RestHasCode() const { return has_code_; }
+
+ private:
+  enum class State {
+    CODE,
+    SLASH,
+    LINE_COMMENT,
+    BLOCK_COMMENT,
+    BLOCK_COMMENT_STAR,
+    STRING,
+    STRING_ESCAPE,
+    CHAR,
+    CHAR_ESCAPE,
+  };
+
+  // Advances over |c|. Returns true if it ends a declaration.
+  bool Scan(char c) {
+    if (c == '\n') {
+      point_.line++;
+      point_.column = 1;
+    } else {
+      point_.column++;
+    }
+    switch (state_) {
+      case State::SLASH:
+        if (c == '/') {
+          state_ = State::LINE_COMMENT;
+          return false;
+        }
+        if (c == '*') {
+          state_ = State::BLOCK_COMMENT;
+          return false;
+        }
+        // It was a division.
+        has_code_ = true;
+        state_ = State::CODE;
+        return ScanCode(c);
+      case State::LINE_COMMENT:
+        if (c == '\n') state_ = State::CODE;
+        return false;
+      case State::BLOCK_COMMENT:
+        if (c == '*') state_ = State::BLOCK_COMMENT_STAR;
+        return false;
+      case State::BLOCK_COMMENT_STAR:
+        if (c == '/') {
+          state_ = State::CODE;
+        } else if (c != '*') {
+          state_ = State::BLOCK_COMMENT;
+        }
+        return false;
+      case State::STRING:
+        if (c == '\\') state_ = State::STRING_ESCAPE;
+        if (c == '"') state_ = State::CODE;
+        return false;
+      case State::STRING_ESCAPE:
+        state_ = State::STRING;
+        return false;
+      case State::CHAR:
+        if (c == '\\') state_ = State::CHAR_ESCAPE;
+        if (c == '\'') state_ = State::CODE;
+        return false;
+      case State::CHAR_ESCAPE:
+        state_ = State::CHAR;
+        return false;
+      case State::CODE:
+        return ScanCode(c);
+    }
+    return false;
+  }
+
+  bool ScanCode(char c) {
+    switch (c) {
+      case ' ':
+      case '\t':
+      case '\r':
+      case '\n':
+        return false;
+      case '/':
+        state_ = State::SLASH;
+        return false;
+      case '"':
+        state_ = State::STRING;
+        break;
+      case '\'':
+        state_ = State::CHAR;
+        break;
+      case '(':
+      case '[':
+      case '{':
+        depth_++;
+        break;
+      case ')':
+      case ']':
+        // Unbalanced brackets end the declaration so that the parser reports them.
+        if (depth_ == 0) return true;
+        depth_--;
+        break;
+      case '}':
+        if (depth_ == 0 || --depth_ == 0) return true;
+        break;
+      case ';':
+        if (depth_ == 0) return true;
+        break;
+      default:
+        break;
+    }
+    has_code_ = true;
+    return false;
+  }
+
+  std::string buffer_;
+  size_t begin_ = 0;
+  // Bytes erased from the front of buffer_.
+  size_t consumed_ = 0;
+  AidlLocation::Point start_ = {1, 1};
+  AidlLocation::Point point_ = {1, 1};
+  State state_ = State::CODE;
+  int depth_ = 0;
+  bool has_code_ = false;
+};
+
+}  // namespace
+
 const AidlDocument* Parser::Parse(const std::string& filename,
                                   const android::aidl::IoDelegate& io_delegate,
-                                  AidlTypenames& typenames, bool is_preprocessed) {
+                                  AidlTypenames& typenames, bool is_preprocessed,
+                                  const android::aidl::DocumentCache* cache,
+                                  android::aidl::Options::ParserKind parser_kind) {
   auto clean_path = android::aidl::IoDelegate::CleanPath(filename);
   // reuse pre-parsed document from typenames
   for (auto& doc : typenames.AllDocuments()) {
@@ -68,23 +232,173 @@ const AidlDocument* Parser::Parse(const std::string& filename,
     return nullptr;
   }
 
+  std::string cache_key;
+  if (cache != nullptr) {
+    cache_key = android::aidl::DocumentCache::Key(*raw_buffer, is_preprocessed);
+    if (auto document = cache->Load(cache_key, clean_path); document) {
+      return AddDocument(std::move(document), typenames);
+    }
+  }
+
   // We're going to scan this buffer in place, and yacc demands we put two
   // nulls at the end.
   raw_buffer->append(2u, '\0');
 
-  Parser parser(clean_path, *raw_buffer, is_preprocessed);
+  const size_t reports = DiagnosticSink::Current().ReportCount();
+  auto document = ParseBuffer(clean_path, *raw_buffer, is_preprocessed, {1, 1}, parser_kind);
+  if (document == nullptr) {
+    return nullptr;
+  }
+
+  // Documents with warnings aren't cached so that the warnings show up again.
+  if (cache != nullptr && DiagnosticSink::Current().ReportCount() == reports) {
+    cache->Store(cache_key, *document);
+  }
+
+  return AddDocument(std::move(document), typenames);
+}
+
+std::unique_ptr<AidlDocument> Parser::ParseFile(const std::string& filename,
+                                                const android::aidl::IoDelegate& io_delegate,
+                                                bool is_preprocessed,
+                                                android::aidl::Options::ParserKind parser_kind) {
+  auto clean_path = android::aidl::IoDelegate::CleanPath(filename);
+  unique_ptr<string> raw_buffer = io_delegate.GetFileContents(clean_path);
+  if (raw_buffer == nullptr) {
+    AIDL_ERROR(clean_path) << "Error while opening file for parsing";
+    return nullptr;
+  }
+  raw_buffer->append(2u, '\0');
+  return ParseBuffer(clean_path, *raw_buffer, is_preprocessed, {1, 1}, parser_kind);
+}
+
+std::unique_ptr<AidlDocument> Parser::ParseBuffer(const std::string& filename, std::string& buffer,
+                                                  bool is_preprocessed, AidlLocation::Point start,
+                                                  android::aidl::Options::ParserKind kind) {
+  if (kind == android::aidl::Options::ParserKind::DESCENT) {
+    // Diagnostics are held back until the input turns out to have no syntax errors. Otherwise
+    // it is parsed again with bison, which reports them along with the syntax errors. The nodes
+    // of an abandoned attempt are never visited, so they must not be reported as unvisited.
+    AidlVisitTracker::Suspend suspend;
+    std::ostream discarded(nullptr);
+    DiagnosticSink held(discarded);
+    Parser parser(filename, buffer, is_preprocessed, start);
+    bool parsed;
+    {
+      ScopedDiagnosticSink scoped_sink(held);
+      parsed = ParseWithDescent(&parser);
+    }
+    if (parsed) {
+      held.ForwardTo(DiagnosticSink::Current());
+      return parser.HasError() ? nullptr : std::move(parser.document_);
+    }
+  }
 
+  Parser parser(filename, buffer, is_preprocessed, start);
   if (yy::parser(&parser).parse() != 0 || parser.HasError()) {
     return nullptr;
   }
+  return std::move(parser.document_);
+}
+
+bool Parser::ParsePreprocessedLazily(const std::string& filename,
+                                     const android::aidl::IoDelegate& io_delegate,
+                                     AidlTypenames& typenames,
+                                     android::aidl::Options::ParserKind parser_kind) {
+  auto clean_path = android::aidl::IoDelegate::CleanPath(filename);
+  std::unique_ptr<std::istream> in = io_delegate.GetFileStream(clean_path);
+  if (in == nullptr) {
+    AIDL_ERROR(clean_path) << "Error while opening file for parsing";
+    return false;
+  }
+
+  bool has_declaration = false;
+  auto register_declaration = [&](std::string text, size_t offset, AidlLocation::Point start) {
+    const size_t length = text.size();
+    // yacc demands two nulls at the end.
+    text.append(2u, '\0');
+    auto document = ParseBuffer(clean_path, text, /*is_preprocessed=*/true, start, parser_kind);
+    if (document == nullptr) {
+      return false;
+    }
+    has_declaration = true;
+    // Registered names include the nested "Tag" enums of unions.
+    UnionTagGenerater v;
+    VisitTopDown(v, *document);
+    auto load = [&io_delegate, clean_path, offset, length, start,
+                 parser_kind](AidlTypenames& loading_typenames) {
+      return LoadDeclaration(clean_path, io_delegate, loading_typenames, offset, length, start,
+                             parser_kind) != nullptr;
+    };
+    bool registered = typenames.AddLazyDocument(*document, std::move(load));
+    // Only the names are kept. The AST is parsed again if it is used.
+    AidlVisitTracker::Suspend suspend;
+    document.reset();
+    return registered;
+  };
+
+  DeclarationSplitter splitter;
+  std::string chunk(64 * 1024, '\0');
+  while (*in) {
+    in->read(chunk.data(), chunk.size());
+    if (!splitter.Feed(std::string_view(chunk.data(), in->gcount()), register_declaration)) {
+      return false;
+    }
+  }
+  if (in->bad()) {
+    AIDL_ERROR(clean_path) << "Error while reading file for parsing";
+    return false;
+  }
+  // Trailing text is parsed to report the error. So is a file without declarations.
+  if (splitter.RestHasCode() || !has_declaration) {
+    return register_declaration(splitter.Rest(), splitter.RestOffset(), splitter.RestStart());
+  }
+  return true;
+}
+
+const AidlDocument* Parser::LoadDeclaration(const std::string& filename,
+                                            const android::aidl::IoDelegate& io_delegate,
+                                            AidlTypenames& typenames, size_t offset,
+                                            size_t length, AidlLocation::Point start,
+                                            android::aidl::Options::ParserKind parser_kind) {
+  std::unique_ptr<std::istream> in = io_delegate.GetFileStream(filename);
+  if (in == nullptr) {
+    AIDL_ERROR(filename) << "Error while opening file for parsing";
+    return nullptr;
+  }
+  std::string text(length, '\0');
+  in->seekg(static_cast<std::streamoff>(offset));
+  in->read(text.data(), length);
+  if (static_cast<size_t>(in->gcount()) != length) {
+    AIDL_ERROR(filename) << "Error while reading file for parsing";
+    return nullptr;
+  }
+  text.append(2u, '\0');
+
+  // The declaration was parsed before. Its warnings have been reported then.
+  std::unique_ptr<AidlDocument> document;
+  {
+    std::ostream discarded(nullptr);
+    DiagnosticSink held(discarded);
+    ScopedDiagnosticSink scoped_sink(held);
+    document = ParseBuffer(filename, text, /*is_preprocessed=*/true, start, parser_kind);
+  }
+  if (document == nullptr) {
+    AIDL_ERROR(filename) << "Can't parse a declaration again. The file has changed.";
+    return nullptr;
+  }
+  return AddDocument(std::move(document), typenames);
+}
 
+const AidlDocument* Parser::AddDocument(std::unique_ptr<AidlDocument> document,
+                                        AidlTypenames& typenames) {
   // Preprocess parsed document before adding to typenames.
   UnionTagGenerater v;
-  VisitTopDown(v, *parser.document_);
+  VisitTopDown(v, *document);
 
   // transfer ownership to AidlTypenames and return the raw pointer
-  const AidlDocument* result = parser.document_.get();
-  if (!typenames.AddDocument(std::move(parser.document_))) {
+  const AidlDocument* result = document.get();
+  if (!typenames.AddDocument(std::move(document))) {
     return nullptr;
   }
   return result;
@@ -183,14 +497,16 @@ class ScopedVisitor : public AidlVisitor {
   void PopScope() { scope_.pop_back(); }
   // Keep user defined type as a defining scope
   void VisitScopedTopDown(const AidlNode& node) {
-    std::function<void(const AidlNode&)> top_down = [&](const AidlNode& a) {
-      a.DispatchVisit(*this);
-      auto defined_type = AidlCast<AidlDefinedType>(a);
-      if (defined_type) PushScope(defined_type);
-      a.TraverseChildren(top_down);
-      if (defined_type) PopScope();
-    };
-    top_down(node);
+    ForEachNode(
+        node,
+        [&](const AidlNode& a) {
+          a.DispatchVisit(*this);
+          auto defined_type = AidlCast<AidlDefinedType>(a);
+          if (defined_type) PushScope(defined_type);
+        },
+        [&](const AidlNode& a) {
+          if (!scope_.empty() && static_cast<const AidlNode*>(scope_.back()) == &a) PopScope();
+        });
   }
 
  private:
@@ -325,8 +641,9 @@ bool ResolveReferences(const AidlDocument& document, TypeResolver& type_resolver
   return true;
 }
 
-Parser::Parser(const std::string& filename, std::string& raw_buffer, bool is_preprocessed)
-    : filename_(filename), is_preprocessed_(is_preprocessed) {
+Parser::Parser(const std::string& filename, std::string& raw_buffer, bool is_preprocessed,
+               AidlLocation::Point start)
+    : filename_(filename), is_preprocessed_(is_preprocessed), start_(start) {
   yylex_init(&scanner_);
   buffer_ = yy_scan_buffer(&raw_buffer[0], raw_buffer.length(), scanner_);
 }
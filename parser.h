@@ -19,6 +19,7 @@
 #include "aidl_language.h"
 #include "aidl_typenames.h"
 #include "comments.h"
+#include "document_cache.h"
 #include "io_delegate.h"
 #include "logging.h"
 #include "options.h"
@@ -66,14 +67,41 @@ class Parser {
   ~Parser();
 
   // Parse contents of file |filename|. Should only be called once.
-  static const AidlDocument* Parse(const std::string& filename,
-                                   const android::aidl::IoDelegate& io_delegate,
-                                   AidlTypenames& typenames, bool is_preprocessed = false);
+  // If |cache| is given, a document cached for the same contents is used instead of parsing, and
+  // a newly parsed document is stored in it.
+  // |parser_kind| selects the implementation, see Options::ParserKind.
+  static const AidlDocument* Parse(
+      const std::string& filename, const android::aidl::IoDelegate& io_delegate,
+      AidlTypenames& typenames, bool is_preprocessed = false,
+      const android::aidl::DocumentCache* cache = nullptr,
+      android::aidl::Options::ParserKind parser_kind = android::aidl::Options::ParserKind::BISON);
+
+  // Parses |filename| into a document which isn't added to any typenames yet, so that files can
+  // be parsed on several threads. Returns nullptr on errors. See AddDocument().
+  static std::unique_ptr<AidlDocument> ParseFile(
+      const std::string& filename, const android::aidl::IoDelegate& io_delegate,
+      bool is_preprocessed = false,
+      android::aidl::Options::ParserKind parser_kind = android::aidl::Options::ParserKind::BISON);
+  // Adds a document from ParseFile() to |typenames|. A later Parse() of the same file returns it.
+  static const AidlDocument* AddDocument(std::unique_ptr<AidlDocument> document,
+                                         AidlTypenames& typenames);
+
+  // Reads the preprocessed file |filename| in chunks and registers its top-level declarations in
+  // |typenames| by name only, see AidlTypenames::AddLazyDocument(). A declaration is read and
+  // parsed again when type resolution first loads one of its types, so the ASTs of the
+  // declarations which a run doesn't use aren't kept. |io_delegate| must outlive the loading.
+  // Returns false on errors.
+  static bool ParsePreprocessedLazily(
+      const std::string& filename, const android::aidl::IoDelegate& io_delegate,
+      AidlTypenames& typenames,
+      android::aidl::Options::ParserKind parser_kind = android::aidl::Options::ParserKind::BISON);
 
   void AddError() { error_++; }
   bool HasError() const { return error_ != 0; }
 
   const std::string& FileName() const { return filename_; }
+  // Where the parsed text starts in the file.
+  const AidlLocation::Point& Start() const { return start_; }
   void* Scanner() const { return scanner_; }
 
   // This restricts the grammar to something more reasonable. One alternative
@@ -96,10 +124,27 @@ class Parser {
                     std::vector<std::unique_ptr<AidlDefinedType>> defined_types);
 
  private:
-  explicit Parser(const std::string& filename, std::string& raw_buffer, bool is_preprocessed);
+  explicit Parser(const std::string& filename, std::string& raw_buffer, bool is_preprocessed,
+                  AidlLocation::Point start = {1, 1});
+
+  // Parses |buffer|, which ends with two NULs and starts at |start| in |filename|, into a
+  // document. Returns nullptr on errors.
+  static std::unique_ptr<AidlDocument> ParseBuffer(const std::string& filename,
+                                                   std::string& buffer, bool is_preprocessed,
+                                                   AidlLocation::Point start,
+                                                   android::aidl::Options::ParserKind kind);
+
+  // Parses the |length| bytes at |offset| of the preprocessed file |filename|, which start at
+  // |start|, and adds them to |typenames|. See ParsePreprocessedLazily().
+  static const AidlDocument* LoadDeclaration(const std::string& filename,
+                                             const android::aidl::IoDelegate& io_delegate,
+                                             AidlTypenames& typenames, size_t offset,
+                                             size_t length, AidlLocation::Point start,
+                                             android::aidl::Options::ParserKind parser_kind);
 
   std::string filename_;
   bool is_preprocessed_;
+  AidlLocation::Point start_;
   std::string package_;
   void* scanner_ = nullptr;
   YY_BUFFER_STATE buffer_;
@@ -46,6 +46,32 @@ std::string JavaFullName(const std::string& permission) {
   return permission;
 }
 
+// The native backends can't refer to android.Manifest.permission constants, so they check the
+// permission string itself. Other dotted names are used as they are.
+std::string NativeFullName(const std::string& permission) {
+  static const std::string kManifestPrefix = "android.Manifest.permission.";
+  if (permission.find('.') == std::string::npos) {
+    return "android.permission." + permission;
+  }
+  if (android::base::StartsWith(permission, kManifestPrefix)) {
+    return "android.permission." + permission.substr(kManifestPrefix.size());
+  }
+  return permission;
+}
+
+std::vector<std::string> Operands(const Expression& expr) {
+  if (const auto& s = std::get_if<std::string>(&expr); s) {
+    return {*s};
+  }
+  if (const auto& all = std::get_if<AllOf>(&expr); all) {
+    return all->operands;
+  }
+  if (const auto& any = std::get_if<AnyOf>(&expr); any) {
+    return any->operands;
+  }
+  return {};
+}
+
 }  // namespace perm
 }  // namespace aidl
 }  // namespace android
@@ -33,6 +33,9 @@ struct AllOf;
 typedef std::variant<std::string, AnyOf, AllOf> Expression;
 std::string AsJavaAnnotation(const Expression& expr);
 std::string JavaFullName(const std::string& permission);
+std::string NativeFullName(const std::string& permission);
+// Returns the permission names referenced by the expression, in declaration order.
+std::vector<std::string> Operands(const Expression& expr);
 
 struct AnyOf {
   std::vector<std::string> operands;
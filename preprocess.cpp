@@ -16,11 +16,24 @@
 
 #include "preprocess.h"
 
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <android-base/parseint.h>
 #include <android-base/strings.h>
 
 #include "aidl.h"
+#include "document_cache.h"
 
 using android::base::Join;
+using android::base::Split;
+using android::base::StartsWith;
+using std::map;
+using std::pair;
+using std::set;
+using std::vector;
 
 namespace android {
 namespace aidl {
@@ -127,22 +140,219 @@ struct PreprocessVisitor : AidlVisitor {
   void Visit(const AidlTypeSpecifier& t) override { out << t.ToString(); }
 };
 
+// Emits the types of |file| to |out|.
+bool PreprocessFile(const string& file, const Options& options, const IoDelegate& io_delegate,
+                    CodeWriter& out) {
+  AidlTypenames typenames;
+  auto result = internals::load_and_validate_aidl(file, options, io_delegate, &typenames, nullptr);
+  if (result != AidlError::OK) {
+    return false;
+  }
+  PreprocessVisitor visitor(out);
+  for (const auto& t : typenames.MainDocument().DefinedTypes()) {
+    t->DispatchVisit(visitor);
+  }
+  return true;
+}
+
+// --incremental keeps an index beside the output, in OUTPUT.idx. It starts with the key of the
+// options which affect the output and the key of the output it describes, followed by the section
+// of each input in output order: the size of the section and the keys of the files which it was
+// generated from. These are all the files which were read or probed while processing the input:
+// the input itself, its imports, the preprocessed files, and the paths where an import was looked
+// for but not found.
+//
+//   aidl-preprocess-index 2 <key of options> <key of output>
+//   input <path> <size of section>
+//   dep <path> <key of file, or "missing">
+//   ...
+//
+// Fields are separated by tabs. A section is reused while the keys of all of its files match.
+const char kIndexMagic[] = "aidl-preprocess-index 2";
+const char kMissing[] = "missing";
+
+struct Section {
+  string contents;
+  vector<pair<string, string>> deps;  // path and key
+};
+
+string IndexPath(const Options& options) {
+  return options.OutputFile() + ".idx";
+}
+
+// The options with which load_and_validate_aidl() may find other files or reach another result.
+string OptionsKey(const Options& options) {
+  string options_str = "lang=" + to_string(options.TargetLanguage()) + "\n";
+  options_str += "structured=" + std::to_string(options.IsStructured()) + "\n";
+  options_str += "stability=" + std::to_string(static_cast<int>(options.GetStability())) + "\n";
+  options_str += "min_sdk_version=" + std::to_string(options.GetMinSdkVersion()) + "\n";
+  for (const auto& dir : options.ImportDirs()) {
+    options_str += "I=" + dir + "\n";
+  }
+  for (const auto& file : options.PreprocessedFiles()) {
+    options_str += "p=" + file + "\n";
+  }
+  return DocumentCache::Key(options_str, false);
+}
+
+string IndexHeader(const Options& options, const string& output) {
+  return string(kIndexMagic) + "\t" + OptionsKey(options) + "\t" +
+         DocumentCache::Key(output, false);
+}
+
+// Forwards reads to |io_delegate| and records the paths of the files which are read or probed,
+// whether they exist or not, so that a new file which shadows an import invalidates a section.
+class RecordingIoDelegate : public IoDelegate {
+ public:
+  RecordingIoDelegate(const IoDelegate& io_delegate, const Options& options)
+      : io_delegate_(io_delegate), cache_dir_(options.CacheDir()) {}
+
+  unique_ptr<string> GetFileContents(const string& filename,
+                                     const string& content_suffix) const override {
+    Record(filename);
+    return io_delegate_.GetFileContents(filename, content_suffix);
+  }
+  unique_ptr<std::istream> GetFileStream(const string& filename) const override {
+    Record(filename);
+    return io_delegate_.GetFileStream(filename);
+  }
+  bool FileIsReadable(const string& path) const override {
+    Record(path);
+    return io_delegate_.FileIsReadable(path);
+  }
+  bool WriteFileAtomically(const string& file_path, const string& contents) const override {
+    return io_delegate_.WriteFileAtomically(file_path, contents);
+  }
+
+  // Recorded paths in the order in which they were first used
+  const vector<string>& Paths() const { return paths_; }
+
+ private:
+  void Record(const string& path) const {
+    // Entries of the document cache are keyed by their contents, which are recorded as well.
+    if (!cache_dir_.empty() && StartsWith(path, cache_dir_)) {
+      return;
+    }
+    if (recorded_.insert(path).second) {
+      paths_.push_back(path);
+    }
+  }
+
+  const IoDelegate& io_delegate_;
+  const string cache_dir_;
+  mutable set<string> recorded_;
+  mutable vector<string> paths_;
+};
+
+// Returns the sections of the previous output by input, or nothing if the output or the index is
+// missing, or they don't match each other or the options.
+map<string, Section> ReadSections(const Options& options, const IoDelegate& io_delegate) {
+  auto output = io_delegate.GetFileContents(options.OutputFile());
+  auto index = io_delegate.GetFileContents(IndexPath(options));
+  if (!output || !index) {
+    return {};
+  }
+  vector<string> lines = Split(*index, "\n");
+  if (lines.empty() || lines[0] != IndexHeader(options, *output)) {
+    return {};
+  }
+  map<string, Section> sections;
+  Section* section = nullptr;
+  size_t offset = 0;
+  for (size_t i = 1; i < lines.size(); i++) {
+    if (lines[i].empty()) continue;
+    vector<string> fields = Split(lines[i], "\t");
+    size_t size;
+    if (fields.size() == 3 && fields[0] == "input" && android::base::ParseUint(fields[2], &size) &&
+        size <= output->size() - offset) {
+      section = &sections[fields[1]];
+      section->contents = output->substr(offset, size);
+      offset += size;
+    } else if (fields.size() == 3 && fields[0] == "dep" && section != nullptr) {
+      section->deps.emplace_back(fields[1], fields[2]);
+    } else {
+      return {};
+    }
+  }
+  if (offset != output->size()) {
+    return {};
+  }
+  return sections;
+}
+
+bool PreprocessIncrementally(const Options& options, const IoDelegate& io_delegate) {
+  map<string, Section> previous = ReadSections(options, io_delegate);
+
+  // Keys of the files read so far
+  map<string, string> keys;
+  auto key_of = [&](const string& path) -> const string& {
+    auto it = keys.find(path);
+    if (it == keys.end()) {
+      auto contents = io_delegate.GetFileContents(path);
+      it = keys.emplace(path, contents ? DocumentCache::Key(*contents, false) : kMissing).first;
+    }
+    return it->second;
+  };
+
+  vector<pair<string, Section>> sections;
+  for (const auto& file : options.InputFiles()) {
+    if (auto it = previous.find(file); it != previous.end()) {
+      bool unchanged = true;
+      for (const auto& [path, key] : it->second.deps) {
+        if (key.empty() || key_of(path) != key) {
+          unchanged = false;
+          break;
+        }
+      }
+      if (unchanged) {
+        sections.emplace_back(file, std::move(it->second));
+        continue;
+      }
+    }
+    Section section;
+    RecordingIoDelegate recording_io_delegate(io_delegate, options);
+    auto writer = CodeWriter::ForString(&section.contents);
+    if (!PreprocessFile(file, options, recording_io_delegate, *writer)) {
+      return false;
+    }
+    writer->Close();
+    for (const auto& dep : recording_io_delegate.Paths()) {
+      section.deps.emplace_back(dep, key_of(dep));
+    }
+    sections.emplace_back(file, std::move(section));
+  }
+
+  string output;
+  for (const auto& [file, section] : sections) {
+    output += section.contents;
+  }
+  string index = IndexHeader(options, output) + "\n";
+  for (const auto& [file, section] : sections) {
+    index += "input\t" + file + "\t" + std::to_string(section.contents.size()) + "\n";
+    for (const auto& [path, key] : section.deps) {
+      index += "dep\t" + path + "\t" + key + "\n";
+    }
+  }
+  // The index names the output it describes, so a stale index is ignored if only the output is
+  // written.
+  if (!io_delegate.WriteFileAtomically(options.OutputFile(), output) ||
+      !io_delegate.WriteFileAtomically(IndexPath(options), index)) {
+    AIDL_ERROR(options.OutputFile()) << "Failed to write the preprocessed file or its index.";
+    return false;
+  }
+  return true;
+}
+
 }  // namespace
 
 bool Preprocess(const Options& options, const IoDelegate& io_delegate) {
-  unique_ptr<CodeWriter> writer = io_delegate.GetCodeWriter(options.OutputFile());
-  PreprocessVisitor visitor(*writer);
+  if (options.IncrementalPreprocess()) {
+    return PreprocessIncrementally(options, io_delegate);
+  }
 
+  unique_ptr<CodeWriter> writer = io_delegate.GetCodeWriter(options.OutputFile());
   for (const auto& file : options.InputFiles()) {
-    AidlTypenames typenames;
-    auto result =
-        internals::load_and_validate_aidl(file, options, io_delegate, &typenames, nullptr);
-    if (result == AidlError::OK) {
-      const auto& doc = typenames.MainDocument();
-      for (const auto& t : doc.DefinedTypes()) {
-        t->DispatchVisit(visitor);
-      }
-    } else {
+    if (!PreprocessFile(file, options, io_delegate, *writer)) {
       return false;
     }
   }
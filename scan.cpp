@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2023, The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scan.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define AIDL_SCAN_BLOCKS
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define AIDL_SCAN_BLOCKS
+#endif
+
+namespace android {
+namespace aidl {
+
+namespace {
+
+bool IsBlank(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+bool IsIdentifierChar(char c) {
+  return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+}
+
+#ifdef AIDL_SCAN_BLOCKS
+// One block of input, with a bit per byte in the masks.
+#if defined(__AVX2__)
+using Block = __m256i;
+using Mask = uint32_t;
+constexpr size_t kBlockSize = 32;
+Block Load(const char* p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+Block Splat(char c) {
+  return _mm256_set1_epi8(c);
+}
+Block Equal(Block a, Block b) {
+  return _mm256_cmpeq_epi8(a, b);
+}
+Block Greater(Block a, Block b) {
+  return _mm256_cmpgt_epi8(a, b);
+}
+Block Or(Block a, Block b) {
+  return _mm256_or_si256(a, b);
+}
+Block And(Block a, Block b) {
+  return _mm256_and_si256(a, b);
+}
+Mask ToMask(Block a) {
+  return static_cast<Mask>(_mm256_movemask_epi8(a));
+}
+#else
+using Block = __m128i;
+using Mask = uint32_t;
+constexpr size_t kBlockSize = 16;
+Block Load(const char* p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+Block Splat(char c) {
+  return _mm_set1_epi8(c);
+}
+Block Equal(Block a, Block b) {
+  return _mm_cmpeq_epi8(a, b);
+}
+Block Greater(Block a, Block b) {
+  return _mm_cmpgt_epi8(a, b);
+}
+Block Or(Block a, Block b) {
+  return _mm_or_si128(a, b);
+}
+Block And(Block a, Block b) {
+  return _mm_and_si128(a, b);
+}
+Mask ToMask(Block a) {
+  return static_cast<Mask>(_mm_movemask_epi8(a));
+}
+#endif
+
+constexpr Mask kAllBytes = static_cast<Mask>((uint64_t{1} << kBlockSize) - 1);
+
+// Bytes in [lo, hi]. Both are ASCII, so bytes >= 0x80, which are negative, never match.
+Block InRange(Block b, char lo, char hi) {
+  return And(Greater(b, Splat(lo - 1)), Greater(Splat(hi + 1), b));
+}
+
+int FirstSet(Mask mask) {
+  return __builtin_ctz(mask);
+}
+#endif  // AIDL_SCAN_BLOCKS
+
+}  // namespace
+
+const char* SkipBlanks(const char* p, const char* end) {
+#ifdef AIDL_SCAN_BLOCKS
+  for (; end - p >= static_cast<ptrdiff_t>(kBlockSize); p += kBlockSize) {
+    Block b = Load(p);
+    Block spaces_or_tabs = Or(Equal(b, Splat(' ')), Equal(b, Splat('\t')));
+    Mask blanks = ToMask(Or(spaces_or_tabs, Equal(b, Splat('\r'))));
+    if (blanks != kAllBytes) {
+      return p + FirstSet(~blanks & kAllBytes);
+    }
+  }
+#endif
+  while (p < end && IsBlank(*p)) p++;
+  return p;
+}
+
+const char* SkipIdentifier(const char* p, const char* end) {
+#ifdef AIDL_SCAN_BLOCKS
+  for (; end - p >= static_cast<ptrdiff_t>(kBlockSize); p += kBlockSize) {
+    Block b = Load(p);
+    // Letters are matched case-insensitively by setting the lowercase bit.
+    Block letters = InRange(Or(b, Splat(0x20)), 'a', 'z');
+    Block digits = InRange(b, '0', '9');
+    Mask chars = ToMask(Or(Or(letters, digits), Equal(b, Splat('_'))));
+    if (chars != kAllBytes) {
+      return p + FirstSet(~chars & kAllBytes);
+    }
+  }
+#endif
+  while (p < end && IsIdentifierChar(*p)) p++;
+  return p;
+}
+
+const char* FindCommentEnd(const char* p, const char* end) {
+#ifdef AIDL_SCAN_BLOCKS
+  // Each block is compared with the one starting a byte later, so that a "*/" across two blocks is
+  // found as well.
+  for (; end - p > static_cast<ptrdiff_t>(kBlockSize); p += kBlockSize) {
+    Mask ends = ToMask(And(Equal(Load(p), Splat('*')), Equal(Load(p + 1), Splat('/'))));
+    if (ends != 0) {
+      return p + FirstSet(ends) + 2;
+    }
+  }
+#endif
+  for (; end - p >= 2; p++) {
+    if (p[0] == '*' && p[1] == '/') return p + 2;
+  }
+  return end;
+}
+
+const char* FindLineEnd(const char* p, const char* end) {
+  // memchr is vectorized by the C library.
+  const void* newline = memchr(p, '\n', end - p);
+  return newline != nullptr ? static_cast<const char*>(newline) : end;
+}
+
+size_t CountNewlines(const char* p, const char* end) {
+  size_t count = 0;
+#ifdef AIDL_SCAN_BLOCKS
+  for (; end - p >= static_cast<ptrdiff_t>(kBlockSize); p += kBlockSize) {
+    count += __builtin_popcount(ToMask(Equal(Load(p), Splat('\n'))));
+  }
+#endif
+  for (; p < end; p++) {
+    if (*p == '\n') count++;
+  }
+  return count;
+}
+
+}  // namespace aidl
+}  // namespace android
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2023, The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+namespace android {
+namespace aidl {
+
+// Block-wise scanning of the input [p, end) for the lexer (aidl_language_l.ll).
+//
+// The flex tables consume the input one byte at a time. The rules for the longest runs of input,
+// i.e. comments, blanks and identifiers, only match their first bytes and find the rest with
+// these functions. They look at 32 bytes (AVX2) or 16 bytes (SSE2) at a time when the target
+// supports it, and fall back to a byte loop otherwise.
+
+// Returns the first position in [p, end) which isn't a space, a tab or a carriage return.
+const char* SkipBlanks(const char* p, const char* end);
+
+// Returns the first position in [p, end) which isn't one of [_a-zA-Z0-9].
+const char* SkipIdentifier(const char* p, const char* end);
+
+// Returns the position past the first "*/" in [p, end), or end if there is none.
+const char* FindCommentEnd(const char* p, const char* end);
+
+// Returns the position of the first newline in [p, end), or end if there is none.
+const char* FindLineEnd(const char* p, const char* end);
+
+// Returns the number of newlines in [p, end).
+size_t CountNewlines(const char* p, const char* end);
+
+}  // namespace aidl
+}  // namespace android
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2023, The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scan.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace android {
+namespace aidl {
+
+namespace {
+
+// Returns the offset of the position which |scan| returns for |input|.
+template <typename Fn>
+size_t Scan(Fn scan, const std::string& input) {
+  return scan(input.data(), input.data() + input.size()) - input.data();
+}
+
+}  // namespace
+
+TEST(ScanTest, SkipBlanksStopsAtTheFirstOtherByte) {
+  EXPECT_EQ(0u, Scan(SkipBlanks, ""));
+  EXPECT_EQ(3u, Scan(SkipBlanks, " \t\rfoo"));
+  EXPECT_EQ(100u, Scan(SkipBlanks, std::string(100, ' ')));
+  for (size_t i = 0; i < 70; i++) {
+    EXPECT_EQ(i, Scan(SkipBlanks, std::string(i, '\t') + "\n" + std::string(40, ' '))) << i;
+  }
+}
+
+TEST(ScanTest, SkipIdentifierStopsAtTheFirstOtherByte) {
+  const std::string chars = "_azAZ09";
+  EXPECT_EQ(chars.size(), Scan(SkipIdentifier, chars + "."));
+  // Neighbours of the ranges, and bytes which only match with the lowercase bit set.
+  for (char c : std::string("`{@[/:@[^\x7f\x80\xc1\xff ")) {
+    std::string input = std::string(40, 'x') + c + std::string(40, 'y');
+    EXPECT_EQ(40u, Scan(SkipIdentifier, input)) << static_cast<int>(c);
+  }
+  for (size_t i = 0; i < 70; i++) {
+    EXPECT_EQ(i, Scan(SkipIdentifier, std::string(i, 'a') + "<" + std::string(40, 'B'))) << i;
+  }
+}
+
+TEST(ScanTest, FindCommentEndFindsTheFirstTerminator) {
+  EXPECT_EQ(0u, Scan(FindCommentEnd, ""));
+  EXPECT_EQ(1u, Scan(FindCommentEnd, "*"));
+  EXPECT_EQ(2u, Scan(FindCommentEnd, "*/"));
+  EXPECT_EQ(5u, Scan(FindCommentEnd, "/ **/ */"));
+  EXPECT_EQ(50u, Scan(FindCommentEnd, std::string(50, '*')));
+  // The terminator at every offset, including across the boundaries of blocks.
+  for (size_t i = 0; i < 70; i++) {
+    std::string input = std::string(i, '*') + "*/" + std::string(40, '/') + "*/";
+    EXPECT_EQ(i + 2, Scan(FindCommentEnd, input)) << i;
+  }
+}
+
+TEST(ScanTest, FindLineEndFindsTheFirstNewline) {
+  EXPECT_EQ(3u, Scan(FindLineEnd, "foo"));
+  EXPECT_EQ(3u, Scan(FindLineEnd, "foo\nbar\n"));
+  EXPECT_EQ(0u, Scan(FindLineEnd, "\n"));
+}
+
+TEST(ScanTest, CountNewlinesCountsEveryNewline) {
+  EXPECT_EQ(0u, CountNewlines(nullptr, nullptr));
+  for (size_t i = 0; i < 70; i++) {
+    std::string input;
+    for (size_t j = 0; j < i; j++) input += (j % 3 == 0) ? "\n" : "x\xff";
+    const char* p = input.data();
+    EXPECT_EQ((i + 2) / 3, CountNewlines(p, p + input.size())) << i;
+  }
+}
+
+}  // namespace aidl
+}  // namespace android
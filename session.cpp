@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2024, The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "session.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include <android-base/strings.h>
+
+#include "aidl.h"
+#include "aidl_typenames.h"
+#include "document_cache.h"
+#include "io_delegate.h"
+#include "options.h"
+#include "os.h"
+
+using android::base::Join;
+using android::base::StartsWith;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace android {
+namespace aidl {
+
+namespace {
+// Directory of the session cache. It can't clash with the files of a session as it is relative
+// and starts with a character which no package or directory of an AIDL file can start with.
+const char kCacheDir[] = "<aidl-session-cache>/";
+
+// Parses |args|, making the run use the session cache unless the caller passes --cache_dir.
+Options WithSessionCache(const vector<string>& args) {
+  Options options = Options::From(args);
+  if (!options.CacheDir().empty()) {
+    return options;
+  }
+  vector<string> session_args = args;
+  auto end_of_options = std::find(session_args.begin(), session_args.end(), "--");
+  session_args.insert(end_of_options, string("--cache_dir=") + kCacheDir);
+  return Options::From(session_args);
+}
+
+// Returns the offset of |line|:|column| in |text|, or npos if it is out of the text. The end of a
+// line is in it.
+size_t ToOffset(const string& text, int line, int column) {
+  if (line < 1 || column < 1) {
+    return string::npos;
+  }
+  size_t offset = 0;
+  for (int i = 1; i < line; i++) {
+    offset = text.find('\n', offset);
+    if (offset == string::npos) {
+      return string::npos;
+    }
+    offset++;
+  }
+  const size_t line_end = std::min(text.find('\n', offset), text.size());
+  if (static_cast<size_t>(column - 1) > line_end - offset) {
+    return string::npos;
+  }
+  return offset + column - 1;
+}
+}  // namespace
+
+// Reads the files of a session and keeps the files written by a run. Cache entries are kept apart
+// from the outputs as they live as long as the session.
+class Session::MemoryIoDelegate : public IoDelegate {
+ public:
+  unique_ptr<string> GetFileContents(const string& filename,
+                                     const string& content_suffix = "") const override {
+    const string path = CleanPath(filename);
+    if (!IsCacheEntry(path)) Record(path);
+    const auto& files = IsCacheEntry(path) ? cache_ : inputs_;
+    auto it = files.find(path);
+    if (it == files.end()) {
+      return nullptr;
+    }
+    return std::make_unique<string>(it->second + content_suffix);
+  }
+
+  unique_ptr<std::istream> GetFileStream(const string& filename) const override {
+    Record(CleanPath(filename));
+    auto it = inputs_.find(CleanPath(filename));
+    if (it == inputs_.end()) {
+      return nullptr;
+    }
+    return std::make_unique<std::istringstream>(it->second);
+  }
+
+  bool FileIsReadable(const string& path) const override {
+    Record(CleanPath(path));
+    return inputs_.count(CleanPath(path)) > 0;
+  }
+
+  unique_ptr<CodeWriter> GetCodeWriter(const string& file_path) const override {
+    string* contents = &outputs_[file_path];
+    contents->clear();
+    return CodeWriter::ForString(contents);
+  }
+
+  android::base::Result<vector<string>> ListFiles(const string& dir) const override {
+    const string dir_name = dir.back() == OS_PATH_SEPARATOR ? dir : dir + OS_PATH_SEPARATOR;
+    Record(dir_name);
+    vector<string> files;
+    for (const auto& [path, contents] : inputs_) {
+      if (StartsWith(path, dir_name)) {
+        files.push_back(path);
+      }
+    }
+    return files;
+  }
+
+  bool WriteFileAtomically(const string& file_path, const string& contents) const override {
+    (IsCacheEntry(file_path) ? cache_ : outputs_)[file_path] = contents;
+    return true;
+  }
+
+  bool WriteFiles(const vector<std::pair<string, string>>& files) const override {
+    for (const auto& [file_path, contents] : files) {
+      WriteFileAtomically(file_path, contents);
+    }
+    return true;
+  }
+
+  // Drops the cache entries for |contents| once a file no longer has them, so that the cache
+  // holds the documents of the current files only. Another file with the same contents parses
+  // it again.
+  void Evict(const string& contents) {
+    const DocumentCache cache(kCacheDir, *this);
+    for (bool is_preprocessed : {false, true}) {
+      cache_.erase(cache.EntryPath(DocumentCache::Key(contents, is_preprocessed)));
+    }
+  }
+
+  std::map<string, string> inputs_;
+  mutable std::map<string, string> outputs_;
+  mutable std::map<string, string> cache_;
+  // While set, the paths looked up are added to it. Directories end with a separator.
+  std::set<string>* reads_ = nullptr;
+
+ private:
+  static bool IsCacheEntry(const string& path) { return StartsWith(path, kCacheDir); }
+
+  void Record(const string& path) const {
+    if (reads_ != nullptr) reads_->insert(path);
+  }
+};
+
+Session::Session() : io_delegate_(std::make_unique<MemoryIoDelegate>()) {}
+
+Session::~Session() = default;
+
+void Session::SetFile(const string& path, const string& contents) {
+  const string clean_path = IoDelegate::CleanPath(path);
+  auto [it, inserted] = io_delegate_->inputs_.emplace(clean_path, contents);
+  if (!inserted && it->second != contents) {
+    io_delegate_->Evict(it->second);
+    it->second = contents;
+  }
+  Invalidate(clean_path);
+}
+
+void Session::RemoveFile(const string& path) {
+  const string clean_path = IoDelegate::CleanPath(path);
+  if (auto it = io_delegate_->inputs_.find(clean_path); it != io_delegate_->inputs_.end()) {
+    io_delegate_->Evict(it->second);
+    io_delegate_->inputs_.erase(it);
+  }
+  Invalidate(clean_path);
+}
+
+void Session::ClearFiles() {
+  io_delegate_->inputs_.clear();
+  io_delegate_->cache_.clear();
+  checked_files_.clear();
+}
+
+bool Session::EditFile(const string& path, const vector<TextEdit>& edits) {
+  auto it = io_delegate_->inputs_.find(IoDelegate::CleanPath(path));
+  if (it == io_delegate_->inputs_.end()) {
+    return false;
+  }
+  string contents = it->second;
+  for (const auto& edit : edits) {
+    const size_t begin = ToOffset(contents, edit.begin_line, edit.begin_column);
+    const size_t end = ToOffset(contents, edit.end_line, edit.end_column);
+    if (begin == string::npos || end == string::npos || end < begin) {
+      return false;
+    }
+    contents.replace(begin, end - begin, edit.text);
+  }
+  io_delegate_->Evict(it->second);
+  it->second = std::move(contents);
+  Invalidate(it->first);
+  return true;
+}
+
+void Session::Invalidate(const string& path) {
+  for (auto it = checked_files_.begin(); it != checked_files_.end();) {
+    const auto& reads = it->second.reads;
+    bool depends = reads.count(path) > 0;
+    for (const auto& read : reads) {
+      depends = depends || (read.back() == OS_PATH_SEPARATOR && StartsWith(path, read));
+    }
+    it = depends ? checked_files_.erase(it) : std::next(it);
+  }
+}
+
+void Session::ClearCache() {
+  io_delegate_->cache_.clear();
+}
+
+size_t Session::CachedDocumentCount() const {
+  return io_delegate_->cache_.size();
+}
+
+Session::Result Session::Run(const vector<string>& args) {
+  const Options options = WithSessionCache(args);
+
+  Result result;
+  std::ostringstream diagnostics;
+  {
+    DiagnosticSink sink(diagnostics);
+    sink.KeepRecords();
+    ScopedDiagnosticSink scoped_sink(sink);
+    result.exit_code = aidl_entry(options, *io_delegate_);
+    result.diagnostics = sink.TakeRecords();
+  }
+  result.diagnostics_text = diagnostics.str();
+  result.outputs.swap(io_delegate_->outputs_);
+  return result;
+}
+
+Session::Result Session::Check(const vector<string>& args) {
+  const Options options = WithSessionCache(args);
+  if (!options.Ok()) {
+    // Reports the usage error.
+    return Run(args);
+  }
+
+  Result result;
+  const string command = Join(args, '\0');
+  for (const string& input : options.InputFiles()) {
+    auto it = checked_files_.find(command + '\0' + input);
+    if (it == checked_files_.end()) {
+      CheckedFile checked;
+      std::ostringstream diagnostics;
+      io_delegate_->reads_ = &checked.reads;
+      {
+        DiagnosticSink sink(diagnostics);
+        sink.KeepRecords();
+        ScopedDiagnosticSink scoped_sink(sink);
+        AidlTypenames typenames;
+        if (internals::load_and_validate_aidl(input, options, *io_delegate_, &typenames,
+                                              nullptr) != AidlError::OK) {
+          checked.result.exit_code = 1;
+        }
+        checked.result.diagnostics = sink.TakeRecords();
+      }
+      io_delegate_->reads_ = nullptr;
+      checked.result.diagnostics_text = diagnostics.str();
+      it = checked_files_.emplace(command + '\0' + input, std::move(checked)).first;
+    }
+
+    const Result& checked = it->second.result;
+    if (checked.exit_code != 0) {
+      result.exit_code = checked.exit_code;
+    }
+    result.diagnostics.insert(result.diagnostics.end(), checked.diagnostics.begin(),
+                              checked.diagnostics.end());
+    result.diagnostics_text += checked.diagnostics_text;
+  }
+  return result;
+}
+
+}  // namespace aidl
+}  // namespace android
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2024, The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "logging.h"
+
+namespace android {
+namespace aidl {
+
+// In-process entry point for build tools which run the compiler many times, e.g. a build daemon or
+// an IDE, without spawning a process or touching the file system for each run.
+//
+// The input files of a session are held in memory and compilations read them (and their imports)
+// from there. Documents parsed in a compilation are kept in an in-memory cache of the session, in
+// the format of --cache_dir, so later compilations skip parsing files whose contents didn't
+// change. Generated files and diagnostics are returned instead of written out.
+//
+// For editors, Check() validates files without generating code and keeps the diagnostics of each
+// file until the file or one of the files it looked up changes, e.g. through EditFile(). After an
+// edit, only the edited file and the files which depend on it are checked again.
+//
+// A session isn't thread-safe. Use a session per thread to compile concurrently.
+class Session {
+ public:
+  struct Result {
+    // As returned by aidl_entry; 0 on success.
+    int exit_code = 0;
+    std::vector<DiagnosticRecord> diagnostics;
+    // The messages of |diagnostics| as the command line compiler would print them.
+    std::string diagnostics_text;
+    // Generated files, keyed by path.
+    std::map<std::string, std::string> outputs;
+  };
+
+  // Replaces the text from |begin| up to |end| with |text|. Lines and columns are 1-based like in
+  // diagnostics, and columns count bytes.
+  struct TextEdit {
+    int begin_line = 1;
+    int begin_column = 1;
+    int end_line = 1;
+    int end_column = 1;
+    std::string text;
+  };
+
+  Session();
+  ~Session();
+
+  // non-copyable, non-movable
+  Session(const Session&) = delete;
+  Session(Session&&) = delete;
+  Session& operator=(const Session&) = delete;
+  Session& operator=(Session&&) = delete;
+
+  // Adds or replaces the input file at |path|.
+  void SetFile(const std::string& path, const std::string& contents);
+  void RemoveFile(const std::string& path);
+  void ClearFiles();
+  // Applies |edits| in order to the file at |path|. Returns false and leaves the file unchanged if
+  // there is no such file or a range of an edit is out of it.
+  bool EditFile(const std::string& path, const std::vector<TextEdit>& edits);
+
+  // Runs the compiler with the command line |args|, starting with the program name ("aidl" or
+  // "aidl-cpp"). Paths in |args| refer to the files of the session. Uses the session cache unless
+  // |args| has --cache_dir, whose entries are then files of the session as well: they are read
+  // from the input files and written to Result::outputs.
+  Result Run(const std::vector<std::string>& args);
+
+  // Like Run(), but only loads and validates each input file, and generates nothing. The
+  // diagnostics of an input are reused until a file which was looked up for it changes. Unlike
+  // Run(), all the inputs are checked even if one of them has errors.
+  Result Check(const std::vector<std::string>& args);
+
+  // Drops the parsed documents kept for later runs.
+  void ClearCache();
+  // Number of the parsed documents kept for later runs. Only those of the current contents of the
+  // files are kept.
+  size_t CachedDocumentCount() const;
+
+ private:
+  class MemoryIoDelegate;
+
+  struct CheckedFile {
+    Result result;
+    // Every path which was looked up while checking the file, whether it existed or not.
+    std::set<std::string> reads;
+  };
+
+  // Drops the checks which looked up |path|.
+  void Invalidate(const std::string& path);
+
+  std::unique_ptr<MemoryIoDelegate> io_delegate_;
+  // Keyed by the command line and the input file.
+  std::map<std::string, CheckedFile> checked_files_;
+};
+
+}  // namespace aidl
+}  // namespace android
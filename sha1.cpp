@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2023, The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sha1.h"
+
+#include <stdint.h>
+
+namespace android {
+namespace aidl {
+
+namespace {
+
+uint32_t RotateLeft(uint32_t x, int n) {
+  return (x << n) | (x >> (32 - n));
+}
+
+// Processes a 64-byte block (FIPS 180-4, 6.1.2).
+void Sha1Block(const unsigned char* block, uint32_t h[5]) {
+  uint32_t w[80];
+  for (int i = 0; i < 16; i++) {
+    w[i] = (uint32_t{block[4 * i]} << 24) | (uint32_t{block[4 * i + 1]} << 16) |
+           (uint32_t{block[4 * i + 2]} << 8) | uint32_t{block[4 * i + 3]};
+  }
+  for (int i = 16; i < 80; i++) {
+    w[i] = RotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+  }
+  uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+  for (int i = 0; i < 80; i++) {
+    uint32_t f, k;
+    if (i < 20) {
+      f = (b & c) | (~b & d);
+      k = 0x5A827999;
+    } else if (i < 40) {
+      f = b ^ c ^ d;
+      k = 0x6ED9EBA1;
+    } else if (i < 60) {
+      f = (b & c) | (b & d) | (c & d);
+      k = 0x8F1BBCDC;
+    } else {
+      f = b ^ c ^ d;
+      k = 0xCA62C1D6;
+    }
+    const uint32_t t = RotateLeft(a, 5) + f + e + k + w[i];
+    e = d;
+    d = c;
+    c = RotateLeft(b, 30);
+    b = a;
+    a = t;
+  }
+  h[0] += a;
+  h[1] += b;
+  h[2] += c;
+  h[3] += d;
+  h[4] += e;
+}
+
+}  // namespace
+
+std::string Sha1Hex(std::string_view data) {
+  uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+  size_t full = data.size() / 64 * 64;
+  for (size_t i = 0; i < full; i += 64) {
+    Sha1Block(bytes + i, h);
+  }
+
+  // The rest, then 0x80, zeros and the length in bits, padded to one or two blocks.
+  unsigned char tail[128] = {};
+  const size_t rest = data.size() - full;
+  for (size_t i = 0; i < rest; i++) {
+    tail[i] = bytes[full + i];
+  }
+  tail[rest] = 0x80;
+  const size_t tail_size = rest < 56 ? 64 : 128;
+  const uint64_t bits = uint64_t{data.size()} * 8;
+  for (int i = 0; i < 8; i++) {
+    tail[tail_size - 1 - i] = static_cast<unsigned char>(bits >> (8 * i));
+  }
+  for (size_t i = 0; i < tail_size; i += 64) {
+    Sha1Block(tail + i, h);
+  }
+
+  static constexpr char kHex[] = "0123456789abcdef";
+  std::string hex;
+  for (uint32_t word : h) {
+    for (int shift = 28; shift >= 0; shift -= 4) {
+      hex += kHex[(word >> shift) & 0xF];
+    }
+  }
+  return hex;
+}
+
+}  // namespace aidl
+}  // namespace android
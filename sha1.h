@@ -0,0 +1,30 @@
+/*
+ * Copyright (C) 2023, The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace android {
+namespace aidl {
+
+// Returns the SHA-1 digest of |data| in lowercase hex, as sha1sum prints it. This is what the API
+// hashes of frozen interfaces are made of (see build/hash_gen.sh), not a security measure.
+std::string Sha1Hex(std::string_view data);
+
+}  // namespace aidl
+}  // namespace android
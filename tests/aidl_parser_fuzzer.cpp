@@ -16,10 +16,12 @@
 
 #include "aidl.h"
 #include "fake_io_delegate.h"
+#include "logging.h"
 #include "options.h"
 
 #include <fuzzer/FuzzedDataProvider.h>
 #include <iostream>
+#include <sstream>
 
 #ifdef FUZZ_LOG
 constexpr bool kFuzzLog = true;
@@ -65,7 +67,39 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
     }
   }
 
-  int ret = android::aidl::aidl_entry(Options::From(args), io);
+  // The recursive descent parser builds the same ASTs as the bison one, so the result of the same
+  // compilation with it must be the same, including the diagnostics.
+  std::ostringstream diagnostics;
+  int ret;
+  {
+    DiagnosticSink sink(diagnostics);
+    ScopedDiagnosticSink scoped_sink(sink);
+    ret = android::aidl::aidl_entry(Options::From(args), io);
+  }
+  {
+    FakeIoDelegate descent_io;
+    for (const auto& [f, input] : io.InputFiles()) {
+      descent_io.SetFileContents(f, input);
+    }
+    // Right after argv[0], so that it isn't taken for an input file after "--".
+    std::vector<std::string> descent_args = args;
+    descent_args.insert(descent_args.begin() + (args.empty() ? 0 : 1), "--parser=descent");
+    std::ostringstream descent_diagnostics;
+    int descent_ret;
+    {
+      DiagnosticSink sink(descent_diagnostics);
+      ScopedDiagnosticSink scoped_sink(sink);
+      descent_ret = android::aidl::aidl_entry(Options::From(descent_args), descent_io);
+    }
+    if (descent_ret != ret || descent_io.OutputFiles() != io.OutputFiles() ||
+        descent_diagnostics.str() != diagnostics.str()) {
+      std::cerr << "The parsers disagree.\n"
+                << diagnostics.str() << "\n--- with --parser=descent:\n"
+                << descent_diagnostics.str();
+      abort();
+    }
+  }
+  std::cerr << diagnostics.str();
 
   if (kFuzzLog) {
     std::cout << "RET: " << ret << std::endl;
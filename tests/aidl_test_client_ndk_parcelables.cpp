@@ -27,6 +27,7 @@
 #include <aidl/android/aidl/tests/ITestService.h>
 #include <aidl/android/aidl/tests/RecursiveList.h>
 #include <aidl/android/aidl/tests/Union.h>
+#include <aidl/android/aidl/tests/unions/ParcelableListUnion.h>
 
 using aidl::android::aidl::fixedsizearray::FixedSizeArrayExample;
 using BnRepeatFixedSizeArray =
@@ -42,6 +43,7 @@ using aidl::android::aidl::tests::BackendType;
 using aidl::android::aidl::tests::ITestService;
 using aidl::android::aidl::tests::RecursiveList;
 using aidl::android::aidl::tests::Union;
+using aidl::android::aidl::tests::unions::ParcelableListUnion;
 using android::OK;
 using ndk::AParcel_readData;
 using ndk::AParcel_writeData;
@@ -99,6 +101,29 @@ TEST_F(AidlTest, GetUnionTags) {
   EXPECT_EQ(tags, (std::vector<Union::Tag>{Union::n, Union::ns}));
 }
 
+TEST_F(AidlTest, UnionReadsOlderParcelableListOverSameTag) {
+  auto parcel = AParcel_create();
+  ParcelableListUnion::OldItem old_item;
+  old_item.a = 3;
+  auto old = ParcelableListUnion::Old::make<ParcelableListUnion::Old::items>(
+      std::vector<ParcelableListUnion::OldItem>{old_item});
+  EXPECT_EQ(OK, old.writeToParcel(parcel));
+  AParcel_setDataPosition(parcel, 0);
+
+  // An item of the older version doesn't have b, which must not be left from the previous value.
+  ParcelableListUnion::Item item;
+  item.a = 1;
+  item.b = 2;
+  auto u = ParcelableListUnion::make<ParcelableListUnion::items>(
+      std::vector<ParcelableListUnion::Item>{item});
+  EXPECT_EQ(OK, u.readFromParcel(parcel));
+  ASSERT_EQ(1u, u.get<ParcelableListUnion::items>().size());
+  EXPECT_EQ(3, u.get<ParcelableListUnion::items>()[0].a);
+  EXPECT_EQ(0, u.get<ParcelableListUnion::items>()[0].b);
+
+  AParcel_delete(parcel);
+}
+
 TEST_F(AidlTest, FixedSizeArray) {
   auto parcel = AParcel_create();
 
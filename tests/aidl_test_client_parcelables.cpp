@@ -20,6 +20,7 @@
 #include <android/aidl/tests/extension/MyExt2.h>
 #include <android/aidl/tests/extension/MyExtLike.h>
 #include <android/aidl/tests/unions/EnumUnion.h>
+#include <android/aidl/tests/unions/ParcelableListUnion.h>
 #include <binder/Binder.h>
 #include "aidl_test_client.h"
 
@@ -48,6 +49,7 @@ using android::aidl::tests::extension::MyExt;
 using android::aidl::tests::extension::MyExt2;
 using android::aidl::tests::extension::MyExtLike;
 using android::aidl::tests::unions::EnumUnion;
+using android::aidl::tests::unions::ParcelableListUnion;
 using IntParcelable = android::aidl::fixedsizearray::FixedSizeArrayExample::IntParcelable;
 using IRepeatFixedSizeArray =
     android::aidl::fixedsizearray::FixedSizeArrayExample::IRepeatFixedSizeArray;
@@ -590,6 +592,27 @@ TEST_F(AidlTest, GetUnionTags) {
   EXPECT_EQ(tags, (std::vector<Union::Tag>{Union::n, Union::ns}));
 }
 
+TEST_F(AidlTest, UnionReadsOlderParcelableListOverSameTag) {
+  android::Parcel parcel;
+  ParcelableListUnion::OldItem old_item;
+  old_item.a = 3;
+  auto old = ParcelableListUnion::Old::make<ParcelableListUnion::Old::items>(
+      std::vector<ParcelableListUnion::OldItem>{old_item});
+  EXPECT_EQ(OK, old.writeToParcel(&parcel));
+  parcel.setDataPosition(0);
+
+  // An item of the older version doesn't have b, which must not be left from the previous value.
+  ParcelableListUnion::Item item;
+  item.a = 1;
+  item.b = 2;
+  auto u = ParcelableListUnion::make<ParcelableListUnion::items>(
+      std::vector<ParcelableListUnion::Item>{item});
+  EXPECT_EQ(OK, u.readFromParcel(&parcel));
+  ASSERT_EQ(1u, u.get<ParcelableListUnion::items>().size());
+  EXPECT_EQ(3, u.get<ParcelableListUnion::items>()[0].a);
+  EXPECT_EQ(0, u.get<ParcelableListUnion::items>()[0].b);
+}
+
 TEST_F(AidlTest, FixedSizeArray) {
   android::Parcel parcel;
 
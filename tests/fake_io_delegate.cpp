@@ -16,6 +16,8 @@
 
 #include "fake_io_delegate.h"
 
+#include <sstream>
+
 #include <android-base/stringprintf.h>
 #include <android-base/strings.h>
 
@@ -57,6 +59,14 @@ unique_ptr<string> FakeIoDelegate::GetFileContents(
   return contents;
 }
 
+unique_ptr<std::istream> FakeIoDelegate::GetFileStream(const string& filename) const {
+  auto it = file_contents_.find(CleanPath(filename));
+  if (it == file_contents_.end()) {
+    return nullptr;
+  }
+  return std::make_unique<std::istringstream>(it->second);
+}
+
 bool FakeIoDelegate::FileIsReadable(const string& path) const {
   return file_contents_.find(CleanPath(path)) != file_contents_.end();
 }
@@ -70,6 +80,25 @@ std::unique_ptr<CodeWriter> FakeIoDelegate::GetCodeWriter(
   return CodeWriter::ForString(&written_file_contents_[file_path]);
 }
 
+bool FakeIoDelegate::WriteFileAtomically(const std::string& file_path,
+                                         const std::string& contents) const {
+  if (broken_files_.count(file_path) > 0) {
+    return false;
+  }
+  written_file_contents_[file_path] = contents;
+  return true;
+}
+
+bool FakeIoDelegate::WriteFiles(const vector<std::pair<string, string>>& files) const {
+  for (const auto& [file_path, contents] : files) {
+    if (broken_files_.count(file_path) > 0) {
+      return false;
+    }
+    written_file_contents_[file_path] = contents;
+  }
+  return true;
+}
+
 void FakeIoDelegate::SetFileContents(const string& filename,
                                      const string& contents) {
   file_contents_[filename] = contents;
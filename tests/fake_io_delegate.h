@@ -42,10 +42,15 @@ class FakeIoDelegate : public IoDelegate {
   std::unique_ptr<std::string> GetFileContents(
       const std::string& filename,
       const std::string& append_content_suffix = "") const override;
+  std::unique_ptr<std::istream> GetFileStream(const std::string& filename) const override;
   bool FileIsReadable(const std::string& path) const override;
   std::unique_ptr<CodeWriter> GetCodeWriter(
       const std::string& file_path) const override;
   android::base::Result<std::vector<std::string>> ListFiles(const std::string& dir) const override;
+  bool WriteFileAtomically(const std::string& file_path,
+                           const std::string& contents) const override;
+  bool WriteFiles(
+      const std::vector<std::pair<std::string, std::string>>& files) const override;
 
   // Methods added to facilitate testing.
   void SetFileContents(const std::string& filename, const std::string& contents);
@@ -719,7 +719,7 @@ FixedSizeArrayExample::BpRepeatFixedSizeArray::BpRepeatFixedSizeArray(const ::an
   ::android::status_t _aidl_ret_status = ::android::OK;
   ::android::binder::Status _aidl_status;
   ::android::binder::ScopedTrace _aidl_trace(ATRACE_TAG_AIDL, "AIDL::cpp::IRepeatFixedSizeArray::RepeatBytes::cppClient");
-  _aidl_ret_status = _aidl_data.writeInterfaceToken(getInterfaceDescriptor());
+  _aidl_ret_status = _aidl_data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
   if (((_aidl_ret_status) != (::android::OK))) {
     goto _aidl_error;
   }
@@ -761,7 +761,7 @@ FixedSizeArrayExample::BpRepeatFixedSizeArray::BpRepeatFixedSizeArray(const ::an
   ::android::status_t _aidl_ret_status = ::android::OK;
   ::android::binder::Status _aidl_status;
   ::android::binder::ScopedTrace _aidl_trace(ATRACE_TAG_AIDL, "AIDL::cpp::IRepeatFixedSizeArray::RepeatInts::cppClient");
-  _aidl_ret_status = _aidl_data.writeInterfaceToken(getInterfaceDescriptor());
+  _aidl_ret_status = _aidl_data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
   if (((_aidl_ret_status) != (::android::OK))) {
     goto _aidl_error;
   }
@@ -803,7 +803,7 @@ FixedSizeArrayExample::BpRepeatFixedSizeArray::BpRepeatFixedSizeArray(const ::an
   ::android::status_t _aidl_ret_status = ::android::OK;
   ::android::binder::Status _aidl_status;
   ::android::binder::ScopedTrace _aidl_trace(ATRACE_TAG_AIDL, "AIDL::cpp::IRepeatFixedSizeArray::RepeatBinders::cppClient");
-  _aidl_ret_status = _aidl_data.writeInterfaceToken(getInterfaceDescriptor());
+  _aidl_ret_status = _aidl_data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
   if (((_aidl_ret_status) != (::android::OK))) {
     goto _aidl_error;
   }
@@ -845,7 +845,7 @@ FixedSizeArrayExample::BpRepeatFixedSizeArray::BpRepeatFixedSizeArray(const ::an
   ::android::status_t _aidl_ret_status = ::android::OK;
   ::android::binder::Status _aidl_status;
   ::android::binder::ScopedTrace _aidl_trace(ATRACE_TAG_AIDL, "AIDL::cpp::IRepeatFixedSizeArray::RepeatParcelables::cppClient");
-  _aidl_ret_status = _aidl_data.writeInterfaceToken(getInterfaceDescriptor());
+  _aidl_ret_status = _aidl_data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
   if (((_aidl_ret_status) != (::android::OK))) {
     goto _aidl_error;
   }
@@ -887,7 +887,7 @@ FixedSizeArrayExample::BpRepeatFixedSizeArray::BpRepeatFixedSizeArray(const ::an
   ::android::status_t _aidl_ret_status = ::android::OK;
   ::android::binder::Status _aidl_status;
   ::android::binder::ScopedTrace _aidl_trace(ATRACE_TAG_AIDL, "AIDL::cpp::IRepeatFixedSizeArray::Repeat2dBytes::cppClient");
-  _aidl_ret_status = _aidl_data.writeInterfaceToken(getInterfaceDescriptor());
+  _aidl_ret_status = _aidl_data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
   if (((_aidl_ret_status) != (::android::OK))) {
     goto _aidl_error;
   }
@@ -929,7 +929,7 @@ FixedSizeArrayExample::BpRepeatFixedSizeArray::BpRepeatFixedSizeArray(const ::an
   ::android::status_t _aidl_ret_status = ::android::OK;
   ::android::binder::Status _aidl_status;
   ::android::binder::ScopedTrace _aidl_trace(ATRACE_TAG_AIDL, "AIDL::cpp::IRepeatFixedSizeArray::Repeat2dInts::cppClient");
-  _aidl_ret_status = _aidl_data.writeInterfaceToken(getInterfaceDescriptor());
+  _aidl_ret_status = _aidl_data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
   if (((_aidl_ret_status) != (::android::OK))) {
     goto _aidl_error;
   }
@@ -971,7 +971,7 @@ FixedSizeArrayExample::BpRepeatFixedSizeArray::BpRepeatFixedSizeArray(const ::an
   ::android::status_t _aidl_ret_status = ::android::OK;
   ::android::binder::Status _aidl_status;
   ::android::binder::ScopedTrace _aidl_trace(ATRACE_TAG_AIDL, "AIDL::cpp::IRepeatFixedSizeArray::Repeat2dBinders::cppClient");
-  _aidl_ret_status = _aidl_data.writeInterfaceToken(getInterfaceDescriptor());
+  _aidl_ret_status = _aidl_data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
   if (((_aidl_ret_status) != (::android::OK))) {
     goto _aidl_error;
   }
@@ -1013,7 +1013,7 @@ FixedSizeArrayExample::BpRepeatFixedSizeArray::BpRepeatFixedSizeArray(const ::an
   ::android::status_t _aidl_ret_status = ::android::OK;
   ::android::binder::Status _aidl_status;
   ::android::binder::ScopedTrace _aidl_trace(ATRACE_TAG_AIDL, "AIDL::cpp::IRepeatFixedSizeArray::Repeat2dParcelables::cppClient");
-  _aidl_ret_status = _aidl_data.writeInterfaceToken(getInterfaceDescriptor());
+  _aidl_ret_status = _aidl_data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
   if (((_aidl_ret_status) != (::android::OK))) {
     goto _aidl_error;
   }
@@ -1072,7 +1072,7 @@ FixedSizeArrayExample::BnRepeatFixedSizeArray::BnRepeatFixedSizeArray()
     std::array<uint8_t, 3> in_input;
     std::array<uint8_t, 3> out_repeated;
     std::array<uint8_t, 3> _aidl_return;
-    if (!(_aidl_data.checkInterface(this))) {
+    if (!(_aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length))) {
       _aidl_ret_status = ::android::BAD_TYPE;
       break;
     }
@@ -1108,7 +1108,7 @@ FixedSizeArrayExample::BnRepeatFixedSizeArray::BnRepeatFixedSizeArray()
     std::array<int32_t, 3> in_input;
     std::array<int32_t, 3> out_repeated;
     std::array<int32_t, 3> _aidl_return;
-    if (!(_aidl_data.checkInterface(this))) {
+    if (!(_aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length))) {
       _aidl_ret_status = ::android::BAD_TYPE;
       break;
     }
@@ -1144,7 +1144,7 @@ FixedSizeArrayExample::BnRepeatFixedSizeArray::BnRepeatFixedSizeArray()
     std::array<::android::sp<::android::IBinder>, 3> in_input;
     std::array<::android::sp<::android::IBinder>, 3> out_repeated;
     std::array<::android::sp<::android::IBinder>, 3> _aidl_return;
-    if (!(_aidl_data.checkInterface(this))) {
+    if (!(_aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length))) {
       _aidl_ret_status = ::android::BAD_TYPE;
       break;
     }
@@ -1180,7 +1180,7 @@ FixedSizeArrayExample::BnRepeatFixedSizeArray::BnRepeatFixedSizeArray()
     std::array<::android::aidl::fixedsizearray::FixedSizeArrayExample::IntParcelable, 3> in_input;
     std::array<::android::aidl::fixedsizearray::FixedSizeArrayExample::IntParcelable, 3> out_repeated;
     std::array<::android::aidl::fixedsizearray::FixedSizeArrayExample::IntParcelable, 3> _aidl_return;
-    if (!(_aidl_data.checkInterface(this))) {
+    if (!(_aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length))) {
       _aidl_ret_status = ::android::BAD_TYPE;
       break;
     }
@@ -1216,7 +1216,7 @@ FixedSizeArrayExample::BnRepeatFixedSizeArray::BnRepeatFixedSizeArray()
     std::array<std::array<uint8_t, 3>, 2> in_input;
     std::array<std::array<uint8_t, 3>, 2> out_repeated;
     std::array<std::array<uint8_t, 3>, 2> _aidl_return;
-    if (!(_aidl_data.checkInterface(this))) {
+    if (!(_aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length))) {
       _aidl_ret_status = ::android::BAD_TYPE;
       break;
     }
@@ -1252,7 +1252,7 @@ FixedSizeArrayExample::BnRepeatFixedSizeArray::BnRepeatFixedSizeArray()
     std::array<std::array<int32_t, 3>, 2> in_input;
     std::array<std::array<int32_t, 3>, 2> out_repeated;
     std::array<std::array<int32_t, 3>, 2> _aidl_return;
-    if (!(_aidl_data.checkInterface(this))) {
+    if (!(_aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length))) {
       _aidl_ret_status = ::android::BAD_TYPE;
       break;
     }
@@ -1288,7 +1288,7 @@ FixedSizeArrayExample::BnRepeatFixedSizeArray::BnRepeatFixedSizeArray()
     std::array<std::array<::android::sp<::android::IBinder>, 3>, 2> in_input;
     std::array<std::array<::android::sp<::android::IBinder>, 3>, 2> out_repeated;
     std::array<std::array<::android::sp<::android::IBinder>, 3>, 2> _aidl_return;
-    if (!(_aidl_data.checkInterface(this))) {
+    if (!(_aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length))) {
       _aidl_ret_status = ::android::BAD_TYPE;
       break;
     }
@@ -1324,7 +1324,7 @@ FixedSizeArrayExample::BnRepeatFixedSizeArray::BnRepeatFixedSizeArray()
     std::array<std::array<::android::aidl::fixedsizearray::FixedSizeArrayExample::IntParcelable, 3>, 2> in_input;
     std::array<std::array<::android::aidl::fixedsizearray::FixedSizeArrayExample::IntParcelable, 3>, 2> out_repeated;
     std::array<std::array<::android::aidl::fixedsizearray::FixedSizeArrayExample::IntParcelable, 3>, 2> _aidl_return;
-    if (!(_aidl_data.checkInterface(this))) {
+    if (!(_aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length))) {
       _aidl_ret_status = ::android::BAD_TYPE;
       break;
     }
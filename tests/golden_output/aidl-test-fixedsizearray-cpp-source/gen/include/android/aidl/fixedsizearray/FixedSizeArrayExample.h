@@ -65,6 +65,8 @@ public:
   public:
     typedef IRepeatFixedSizeArrayDelegator DefaultDelegator;
     DECLARE_META_INTERFACE(RepeatFixedSizeArray)
+    static constexpr char16_t descriptor_utf16[] = u"android.aidl.fixedsizearray.FixedSizeArrayExample.IRepeatFixedSizeArray";
+    static constexpr size_t descriptor_utf16_length = 71;
     virtual ::android::binder::Status RepeatBytes(const std::array<uint8_t, 3>& input, std::array<uint8_t, 3>* repeated, std::array<uint8_t, 3>* _aidl_return) = 0;
     virtual ::android::binder::Status RepeatInts(const std::array<int32_t, 3>& input, std::array<int32_t, 3>* repeated, std::array<int32_t, 3>* _aidl_return) = 0;
     virtual ::android::binder::Status RepeatBinders(const std::array<::android::sp<::android::IBinder>, 3>& input, std::array<::android::sp<::android::IBinder>, 3>* repeated, std::array<::android::sp<::android::IBinder>, 3>* _aidl_return) = 0;
@@ -179,6 +181,8 @@ public:
   public:
     typedef IEmptyInterfaceDelegator DefaultDelegator;
     DECLARE_META_INTERFACE(EmptyInterface)
+    static constexpr char16_t descriptor_utf16[] = u"android.aidl.fixedsizearray.FixedSizeArrayExample.IEmptyInterface";
+    static constexpr size_t descriptor_utf16_length = 65;
   };  // class IEmptyInterface
 
   class IEmptyInterfaceDefault : public IEmptyInterface {
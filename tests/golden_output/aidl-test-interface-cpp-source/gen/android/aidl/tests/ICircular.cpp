@@ -27,7 +27,7 @@ BpCircular::BpCircular(const ::android::sp<::android::IBinder>& _aidl_impl)
   ::android::status_t _aidl_ret_status = ::android::OK;
   ::android::binder::Status _aidl_status;
   ::android::binder::ScopedTrace _aidl_trace(ATRACE_TAG_AIDL, "AIDL::cpp::ICircular::GetTestService::cppClient");
-  _aidl_ret_status = _aidl_data.writeInterfaceToken(getInterfaceDescriptor());
+  _aidl_ret_status = _aidl_data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
   if (((_aidl_ret_status) != (::android::OK))) {
     goto _aidl_error;
   }
@@ -76,7 +76,7 @@ BnCircular::BnCircular()
   case BnCircular::TRANSACTION_GetTestService:
   {
     ::android::sp<::android::aidl::tests::ITestService> _aidl_return;
-    if (!(_aidl_data.checkInterface(this))) {
+    if (!(_aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length))) {
       _aidl_ret_status = ::android::BAD_TYPE;
       break;
     }
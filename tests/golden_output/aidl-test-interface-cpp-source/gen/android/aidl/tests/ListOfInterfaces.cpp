@@ -115,7 +115,7 @@ ListOfInterfaces::BpMyInterface::BpMyInterface(const ::android::sp<::android::IB
   ::android::status_t _aidl_ret_status = ::android::OK;
   ::android::binder::Status _aidl_status;
   ::android::binder::ScopedTrace _aidl_trace(ATRACE_TAG_AIDL, "AIDL::cpp::IMyInterface::methodWithInterfaces::cppClient");
-  _aidl_ret_status = _aidl_data.writeInterfaceToken(getInterfaceDescriptor());
+  _aidl_ret_status = _aidl_data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
   if (((_aidl_ret_status) != (::android::OK))) {
     goto _aidl_error;
   }
@@ -212,7 +212,7 @@ ListOfInterfaces::BnMyInterface::BnMyInterface()
     ::std::optional<::std::vector<::android::sp<::android::aidl::tests::ListOfInterfaces::IEmptyInterface>>> out_nullable_iface_list_out;
     ::std::optional<::std::vector<::android::sp<::android::aidl::tests::ListOfInterfaces::IEmptyInterface>>> in_nullable_iface_list_inout;
     ::std::optional<::std::vector<::android::sp<::android::aidl::tests::ListOfInterfaces::IEmptyInterface>>> _aidl_return;
-    if (!(_aidl_data.checkInterface(this))) {
+    if (!(_aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length))) {
       _aidl_ret_status = ::android::BAD_TYPE;
       break;
     }
@@ -381,44 +381,20 @@ namespace tests {
   if ((_aidl_ret_status = _aidl_parcel->readInt32(&_aidl_tag)) != ::android::OK) return _aidl_ret_status;
   switch (static_cast<Tag>(_aidl_tag)) {
   case iface: {
-    ::android::sp<::android::aidl::tests::ListOfInterfaces::IEmptyInterface> _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readStrongBinder(&_aidl_value)) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::android::sp<::android::aidl::tests::ListOfInterfaces::IEmptyInterface>>) {
-      set<iface>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<iface>(std::move(_aidl_value));
-    }
+    set<iface>();
+    if ((_aidl_ret_status = _aidl_parcel->readStrongBinder(&get<iface>())) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   case nullable_iface: {
-    ::android::sp<::android::aidl::tests::ListOfInterfaces::IEmptyInterface> _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readNullableStrongBinder(&_aidl_value)) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::android::sp<::android::aidl::tests::ListOfInterfaces::IEmptyInterface>>) {
-      set<nullable_iface>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<nullable_iface>(std::move(_aidl_value));
-    }
+    set<nullable_iface>();
+    if ((_aidl_ret_status = _aidl_parcel->readNullableStrongBinder(&get<nullable_iface>())) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   case iface_list: {
-    ::std::vector<::android::sp<::android::aidl::tests::ListOfInterfaces::IEmptyInterface>> _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readStrongBinderVector(&_aidl_value)) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::std::vector<::android::sp<::android::aidl::tests::ListOfInterfaces::IEmptyInterface>>>) {
-      set<iface_list>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<iface_list>(std::move(_aidl_value));
-    }
+    set<iface_list>();
+    if ((_aidl_ret_status = _aidl_parcel->readStrongBinderVector(&get<iface_list>())) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   case nullable_iface_list: {
-    ::std::optional<::std::vector<::android::sp<::android::aidl::tests::ListOfInterfaces::IEmptyInterface>>> _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readStrongBinderVector(&_aidl_value)) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::std::optional<::std::vector<::android::sp<::android::aidl::tests::ListOfInterfaces::IEmptyInterface>>>>) {
-      set<nullable_iface_list>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<nullable_iface_list>(std::move(_aidl_value));
-    }
+    set<nullable_iface_list>();
+    if ((_aidl_ret_status = _aidl_parcel->readStrongBinderVector(&get<nullable_iface_list>())) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   }
   return ::android::BAD_VALUE;
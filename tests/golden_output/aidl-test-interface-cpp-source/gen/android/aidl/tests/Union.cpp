@@ -13,74 +13,38 @@ const ::std::string& Union::S1() {
   if ((_aidl_ret_status = _aidl_parcel->readInt32(&_aidl_tag)) != ::android::OK) return _aidl_ret_status;
   switch (static_cast<Tag>(_aidl_tag)) {
   case ns: {
-    ::std::vector<int32_t> _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readInt32Vector(&_aidl_value)) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::std::vector<int32_t>>) {
-      set<ns>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<ns>(std::move(_aidl_value));
+    if (getTag() != ns) {
+      set<ns>();
     }
+    if ((_aidl_ret_status = _aidl_parcel->readInt32Vector(&get<ns>())) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   case n: {
-    int32_t _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readInt32(&_aidl_value)) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<int32_t>) {
-      set<n>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<n>(std::move(_aidl_value));
-    }
+    set<n>();
+    if ((_aidl_ret_status = _aidl_parcel->readInt32(&get<n>())) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   case m: {
-    int32_t _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readInt32(&_aidl_value)) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<int32_t>) {
-      set<m>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<m>(std::move(_aidl_value));
-    }
+    set<m>();
+    if ((_aidl_ret_status = _aidl_parcel->readInt32(&get<m>())) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   case s: {
-    ::std::string _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readUtf8FromUtf16(&_aidl_value)) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::std::string>) {
-      set<s>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<s>(std::move(_aidl_value));
+    if (getTag() != s) {
+      set<s>();
     }
+    if ((_aidl_ret_status = _aidl_parcel->readUtf8FromUtf16(&get<s>())) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   case ibinder: {
-    ::android::sp<::android::IBinder> _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readNullableStrongBinder(&_aidl_value)) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::android::sp<::android::IBinder>>) {
-      set<ibinder>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<ibinder>(std::move(_aidl_value));
-    }
+    set<ibinder>();
+    if ((_aidl_ret_status = _aidl_parcel->readNullableStrongBinder(&get<ibinder>())) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   case ss: {
-    ::std::vector<::std::string> _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readUtf8VectorFromUtf16Vector(&_aidl_value)) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::std::vector<::std::string>>) {
-      set<ss>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<ss>(std::move(_aidl_value));
+    if (getTag() != ss) {
+      set<ss>();
     }
+    if ((_aidl_ret_status = _aidl_parcel->readUtf8VectorFromUtf16Vector(&get<ss>())) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   case be: {
-    ::android::aidl::tests::ByteEnum _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readByte(reinterpret_cast<int8_t *>(&_aidl_value))) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::android::aidl::tests::ByteEnum>) {
-      set<be>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<be>(std::move(_aidl_value));
-    }
+    set<be>();
+    if ((_aidl_ret_status = _aidl_parcel->readByte(reinterpret_cast<int8_t *>(&get<be>()))) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   }
   return ::android::BAD_VALUE;
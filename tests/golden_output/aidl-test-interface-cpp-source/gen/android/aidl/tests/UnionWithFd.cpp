@@ -9,24 +9,12 @@ namespace tests {
   if ((_aidl_ret_status = _aidl_parcel->readInt32(&_aidl_tag)) != ::android::OK) return _aidl_ret_status;
   switch (static_cast<Tag>(_aidl_tag)) {
   case num: {
-    int32_t _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readInt32(&_aidl_value)) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<int32_t>) {
-      set<num>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<num>(std::move(_aidl_value));
-    }
+    set<num>();
+    if ((_aidl_ret_status = _aidl_parcel->readInt32(&get<num>())) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   case pfd: {
-    ::android::os::ParcelFileDescriptor _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readParcelable(&_aidl_value)) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::android::os::ParcelFileDescriptor>) {
-      set<pfd>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<pfd>(std::move(_aidl_value));
-    }
+    set<pfd>();
+    if ((_aidl_ret_status = _aidl_parcel->readParcelable(&get<pfd>())) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   }
   return ::android::BAD_VALUE;
@@ -12,34 +12,16 @@ namespace unions {
   if ((_aidl_ret_status = _aidl_parcel->readInt32(&_aidl_tag)) != ::android::OK) return _aidl_ret_status;
   switch (static_cast<Tag>(_aidl_tag)) {
   case intEnum: {
-    ::android::aidl::tests::IntEnum _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readInt32(reinterpret_cast<int32_t *>(&_aidl_value))) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::android::aidl::tests::IntEnum>) {
-      set<intEnum>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<intEnum>(std::move(_aidl_value));
-    }
+    set<intEnum>();
+    if ((_aidl_ret_status = _aidl_parcel->readInt32(reinterpret_cast<int32_t *>(&get<intEnum>()))) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   case longEnum: {
-    ::android::aidl::tests::LongEnum _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readInt64(reinterpret_cast<int64_t *>(&_aidl_value))) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::android::aidl::tests::LongEnum>) {
-      set<longEnum>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<longEnum>(std::move(_aidl_value));
-    }
+    set<longEnum>();
+    if ((_aidl_ret_status = _aidl_parcel->readInt64(reinterpret_cast<int64_t *>(&get<longEnum>()))) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   case deprecatedField: {
-    int32_t _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readInt32(&_aidl_value)) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<int32_t>) {
-      set<deprecatedField>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<deprecatedField>(std::move(_aidl_value));
-    }
+    set<deprecatedField>();
+    if ((_aidl_ret_status = _aidl_parcel->readInt32(&get<deprecatedField>())) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   }
   return ::android::BAD_VALUE;
@@ -10,24 +10,12 @@ namespace unions {
   if ((_aidl_ret_status = _aidl_parcel->readInt32(&_aidl_tag)) != ::android::OK) return _aidl_ret_status;
   switch (static_cast<Tag>(_aidl_tag)) {
   case first: {
-    ::android::aidl::tests::unions::EnumUnion _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readParcelable(&_aidl_value)) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::android::aidl::tests::unions::EnumUnion>) {
-      set<first>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<first>(std::move(_aidl_value));
-    }
+    set<first>();
+    if ((_aidl_ret_status = _aidl_parcel->readParcelable(&get<first>())) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   case second: {
-    int32_t _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readInt32(&_aidl_value)) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<int32_t>) {
-      set<second>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<second>(std::move(_aidl_value));
-    }
+    set<second>();
+    if ((_aidl_ret_status = _aidl_parcel->readInt32(&get<second>())) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   }
   return ::android::BAD_VALUE;
@@ -20,6 +20,8 @@ class ICircular : public ::android::IInterface {
 public:
   typedef ICircularDelegator DefaultDelegator;
   DECLARE_META_INTERFACE(Circular)
+  static constexpr char16_t descriptor_utf16[] = u"android.aidl.tests.ICircular";
+  static constexpr size_t descriptor_utf16_length = 28;
   virtual ::android::binder::Status GetTestService(::android::sp<::android::aidl::tests::ITestService>* _aidl_return) = 0;
 };  // class ICircular
 
@@ -15,6 +15,8 @@ class __attribute__((deprecated("test"))) IDeprecated : public ::android::IInter
 public:
   typedef IDeprecatedDelegator DefaultDelegator;
   DECLARE_META_INTERFACE(Deprecated)
+  static constexpr char16_t descriptor_utf16[] = u"android.aidl.tests.IDeprecated";
+  static constexpr size_t descriptor_utf16_length = 30;
 };  // class IDeprecated
 
 class __attribute__((deprecated("test"))) IDeprecatedDefault : public IDeprecated {
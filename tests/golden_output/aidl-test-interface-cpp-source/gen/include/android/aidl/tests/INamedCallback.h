@@ -16,6 +16,8 @@ class INamedCallback : public ::android::IInterface {
 public:
   typedef INamedCallbackDelegator DefaultDelegator;
   DECLARE_META_INTERFACE(NamedCallback)
+  static constexpr char16_t descriptor_utf16[] = u"android.aidl.tests.INamedCallback";
+  static constexpr size_t descriptor_utf16_length = 33;
   virtual ::android::binder::Status GetName(::android::String16* _aidl_return) = 0;
 };  // class INamedCallback
 
@@ -16,6 +16,8 @@ class INewName : public ::android::IInterface {
 public:
   typedef INewNameDelegator DefaultDelegator;
   DECLARE_META_INTERFACE(NewName)
+  static constexpr char16_t descriptor_utf16[] = u"android.aidl.tests.IOldName";
+  static constexpr size_t descriptor_utf16_length = 27;
   virtual ::android::binder::Status RealName(::android::String16* _aidl_return) = 0;
 };  // class INewName
 
@@ -61,6 +61,8 @@ class ITestService : public ::android::IInterface {
 public:
   typedef ITestServiceDelegator DefaultDelegator;
   DECLARE_META_INTERFACE(TestService)
+  static constexpr char16_t descriptor_utf16[] = u"android.aidl.tests.ITestService";
+  static constexpr size_t descriptor_utf16_length = 31;
   class Empty : public ::android::Parcelable {
   public:
     inline bool operator!=(const Empty&) const {
@@ -103,6 +105,8 @@ public:
     public:
       typedef IFooDelegator DefaultDelegator;
       DECLARE_META_INTERFACE(Foo)
+      static constexpr char16_t descriptor_utf16[] = u"android.aidl.tests.ITestService.CompilerChecks.Foo";
+      static constexpr size_t descriptor_utf16_length = 50;
     };  // class IFoo
 
     class IFooDefault : public IFoo {
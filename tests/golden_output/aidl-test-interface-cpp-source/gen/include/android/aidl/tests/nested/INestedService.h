@@ -26,6 +26,8 @@ class INestedService : public ::android::IInterface {
 public:
   typedef INestedServiceDelegator DefaultDelegator;
   DECLARE_META_INTERFACE(NestedService)
+  static constexpr char16_t descriptor_utf16[] = u"android.aidl.tests.nested.INestedService";
+  static constexpr size_t descriptor_utf16_length = 40;
   class Result : public ::android::Parcelable {
   public:
     ::android::aidl::tests::nested::ParcelableWithNested::Status status = ::android::aidl::tests::nested::ParcelableWithNested::Status::OK;
@@ -68,6 +70,8 @@ public:
   public:
     typedef ICallbackDelegator DefaultDelegator;
     DECLARE_META_INTERFACE(Callback)
+    static constexpr char16_t descriptor_utf16[] = u"android.aidl.tests.nested.INestedService.ICallback";
+    static constexpr size_t descriptor_utf16_length = 50;
     virtual ::android::binder::Status done(::android::aidl::tests::nested::ParcelableWithNested::Status status) = 0;
   };  // class ICallback
 
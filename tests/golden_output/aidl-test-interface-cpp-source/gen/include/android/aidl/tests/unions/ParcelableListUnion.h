@@ -0,0 +1,350 @@
+#pragma once
+
+#include <android/aidl/tests/unions/ParcelableListUnion.h>
+#include <android/binder_to_string.h>
+#include <array>
+#include <binder/Enums.h>
+#include <binder/Parcel.h>
+#include <binder/Status.h>
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <utils/String16.h>
+#include <variant>
+#include <vector>
+
+#ifndef __BIONIC__
+#define __assert2(a,b,c,d) ((void)0)
+#endif
+
+namespace android {
+namespace aidl {
+namespace tests {
+namespace unions {
+class ParcelableListUnion : public ::android::Parcelable {
+public:
+  class Item : public ::android::Parcelable {
+  public:
+    int32_t a = 0;
+    int32_t b = 0;
+    inline bool operator!=(const Item& rhs) const {
+      return std::tie(a, b) != std::tie(rhs.a, rhs.b);
+    }
+    inline bool operator<(const Item& rhs) const {
+      return std::tie(a, b) < std::tie(rhs.a, rhs.b);
+    }
+    inline bool operator<=(const Item& rhs) const {
+      return std::tie(a, b) <= std::tie(rhs.a, rhs.b);
+    }
+    inline bool operator==(const Item& rhs) const {
+      return std::tie(a, b) == std::tie(rhs.a, rhs.b);
+    }
+    inline bool operator>(const Item& rhs) const {
+      return std::tie(a, b) > std::tie(rhs.a, rhs.b);
+    }
+    inline bool operator>=(const Item& rhs) const {
+      return std::tie(a, b) >= std::tie(rhs.a, rhs.b);
+    }
+
+    ::android::status_t readFromParcel(const ::android::Parcel* _aidl_parcel) final;
+    ::android::status_t writeToParcel(::android::Parcel* _aidl_parcel) const final;
+    static const ::android::String16& getParcelableDescriptor() {
+      static const ::android::StaticString16 DESCRIPTOR (u"android.aidl.tests.unions.ParcelableListUnion.Item");
+      return DESCRIPTOR;
+    }
+    inline std::string toString() const {
+      std::ostringstream os;
+      os << "Item{";
+      os << "a: " << ::android::internal::ToString(a);
+      os << ", b: " << ::android::internal::ToString(b);
+      os << "}";
+      return os.str();
+    }
+  };  // class Item
+  class OldItem : public ::android::Parcelable {
+  public:
+    int32_t a = 0;
+    inline bool operator!=(const OldItem& rhs) const {
+      return std::tie(a) != std::tie(rhs.a);
+    }
+    inline bool operator<(const OldItem& rhs) const {
+      return std::tie(a) < std::tie(rhs.a);
+    }
+    inline bool operator<=(const OldItem& rhs) const {
+      return std::tie(a) <= std::tie(rhs.a);
+    }
+    inline bool operator==(const OldItem& rhs) const {
+      return std::tie(a) == std::tie(rhs.a);
+    }
+    inline bool operator>(const OldItem& rhs) const {
+      return std::tie(a) > std::tie(rhs.a);
+    }
+    inline bool operator>=(const OldItem& rhs) const {
+      return std::tie(a) >= std::tie(rhs.a);
+    }
+
+    ::android::status_t readFromParcel(const ::android::Parcel* _aidl_parcel) final;
+    ::android::status_t writeToParcel(::android::Parcel* _aidl_parcel) const final;
+    static const ::android::String16& getParcelableDescriptor() {
+      static const ::android::StaticString16 DESCRIPTOR (u"android.aidl.tests.unions.ParcelableListUnion.OldItem");
+      return DESCRIPTOR;
+    }
+    inline std::string toString() const {
+      std::ostringstream os;
+      os << "OldItem{";
+      os << "a: " << ::android::internal::ToString(a);
+      os << "}";
+      return os.str();
+    }
+  };  // class OldItem
+  class Old : public ::android::Parcelable {
+  public:
+    enum class Tag : int32_t {
+      n = 0,
+      items = 1,
+    };
+    // Expose tag symbols for legacy code
+    static const inline Tag n = Tag::n;
+    static const inline Tag items = Tag::items;
+
+    template<typename _Tp>
+    static constexpr bool _not_self = !std::is_same_v<std::remove_cv_t<std::remove_reference_t<_Tp>>, Old>;
+
+    Old() : _value(std::in_place_index<static_cast<size_t>(n)>, int32_t(0)) { }
+
+    template <typename _Tp, typename = std::enable_if_t<_not_self<_Tp>>>
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    constexpr Old(_Tp&& _arg)
+        : _value(std::forward<_Tp>(_arg)) {}
+
+    template <size_t _Np, typename... _Tp>
+    constexpr explicit Old(std::in_place_index_t<_Np>, _Tp&&... _args)
+        : _value(std::in_place_index<_Np>, std::forward<_Tp>(_args)...) {}
+
+    template <Tag _tag, typename... _Tp>
+    static Old make(_Tp&&... _args) {
+      return Old(std::in_place_index<static_cast<size_t>(_tag)>, std::forward<_Tp>(_args)...);
+    }
+
+    template <Tag _tag, typename _Tp, typename... _Up>
+    static Old make(std::initializer_list<_Tp> _il, _Up&&... _args) {
+      return Old(std::in_place_index<static_cast<size_t>(_tag)>, std::move(_il), std::forward<_Up>(_args)...);
+    }
+
+    Tag getTag() const {
+      return static_cast<Tag>(_value.index());
+    }
+
+    template <Tag _tag>
+    const auto& get() const {
+      if (getTag() != _tag) { __assert2(__FILE__, __LINE__, __PRETTY_FUNCTION__, "bad access: a wrong tag"); }
+      return std::get<static_cast<size_t>(_tag)>(_value);
+    }
+
+    template <Tag _tag>
+    auto& get() {
+      if (getTag() != _tag) { __assert2(__FILE__, __LINE__, __PRETTY_FUNCTION__, "bad access: a wrong tag"); }
+      return std::get<static_cast<size_t>(_tag)>(_value);
+    }
+
+    template <Tag _tag, typename... _Tp>
+    void set(_Tp&&... _args) {
+      _value.emplace<static_cast<size_t>(_tag)>(std::forward<_Tp>(_args)...);
+    }
+
+    inline bool operator!=(const Old& rhs) const {
+      return _value != rhs._value;
+    }
+    inline bool operator<(const Old& rhs) const {
+      return _value < rhs._value;
+    }
+    inline bool operator<=(const Old& rhs) const {
+      return _value <= rhs._value;
+    }
+    inline bool operator==(const Old& rhs) const {
+      return _value == rhs._value;
+    }
+    inline bool operator>(const Old& rhs) const {
+      return _value > rhs._value;
+    }
+    inline bool operator>=(const Old& rhs) const {
+      return _value >= rhs._value;
+    }
+
+    ::android::status_t readFromParcel(const ::android::Parcel* _aidl_parcel) final;
+    ::android::status_t writeToParcel(::android::Parcel* _aidl_parcel) const final;
+    static const ::android::String16& getParcelableDescriptor() {
+      static const ::android::StaticString16 DESCRIPTOR (u"android.aidl.tests.unions.ParcelableListUnion.Old");
+      return DESCRIPTOR;
+    }
+    inline std::string toString() const {
+      std::ostringstream os;
+      os << "Old{";
+      switch (getTag()) {
+      case n: os << "n: " << ::android::internal::ToString(get<n>()); break;
+      case items: os << "items: " << ::android::internal::ToString(get<items>()); break;
+      }
+      os << "}";
+      return os.str();
+    }
+  private:
+    std::variant<int32_t, ::std::vector<::android::aidl::tests::unions::ParcelableListUnion::OldItem>> _value;
+  };  // class Old
+  enum class Tag : int32_t {
+    n = 0,
+    items = 1,
+  };
+  // Expose tag symbols for legacy code
+  static const inline Tag n = Tag::n;
+  static const inline Tag items = Tag::items;
+
+  template<typename _Tp>
+  static constexpr bool _not_self = !std::is_same_v<std::remove_cv_t<std::remove_reference_t<_Tp>>, ParcelableListUnion>;
+
+  ParcelableListUnion() : _value(std::in_place_index<static_cast<size_t>(n)>, int32_t(0)) { }
+
+  template <typename _Tp, typename = std::enable_if_t<_not_self<_Tp>>>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  constexpr ParcelableListUnion(_Tp&& _arg)
+      : _value(std::forward<_Tp>(_arg)) {}
+
+  template <size_t _Np, typename... _Tp>
+  constexpr explicit ParcelableListUnion(std::in_place_index_t<_Np>, _Tp&&... _args)
+      : _value(std::in_place_index<_Np>, std::forward<_Tp>(_args)...) {}
+
+  template <Tag _tag, typename... _Tp>
+  static ParcelableListUnion make(_Tp&&... _args) {
+    return ParcelableListUnion(std::in_place_index<static_cast<size_t>(_tag)>, std::forward<_Tp>(_args)...);
+  }
+
+  template <Tag _tag, typename _Tp, typename... _Up>
+  static ParcelableListUnion make(std::initializer_list<_Tp> _il, _Up&&... _args) {
+    return ParcelableListUnion(std::in_place_index<static_cast<size_t>(_tag)>, std::move(_il), std::forward<_Up>(_args)...);
+  }
+
+  Tag getTag() const {
+    return static_cast<Tag>(_value.index());
+  }
+
+  template <Tag _tag>
+  const auto& get() const {
+    if (getTag() != _tag) { __assert2(__FILE__, __LINE__, __PRETTY_FUNCTION__, "bad access: a wrong tag"); }
+    return std::get<static_cast<size_t>(_tag)>(_value);
+  }
+
+  template <Tag _tag>
+  auto& get() {
+    if (getTag() != _tag) { __assert2(__FILE__, __LINE__, __PRETTY_FUNCTION__, "bad access: a wrong tag"); }
+    return std::get<static_cast<size_t>(_tag)>(_value);
+  }
+
+  template <Tag _tag, typename... _Tp>
+  void set(_Tp&&... _args) {
+    _value.emplace<static_cast<size_t>(_tag)>(std::forward<_Tp>(_args)...);
+  }
+
+  inline bool operator!=(const ParcelableListUnion& rhs) const {
+    return _value != rhs._value;
+  }
+  inline bool operator<(const ParcelableListUnion& rhs) const {
+    return _value < rhs._value;
+  }
+  inline bool operator<=(const ParcelableListUnion& rhs) const {
+    return _value <= rhs._value;
+  }
+  inline bool operator==(const ParcelableListUnion& rhs) const {
+    return _value == rhs._value;
+  }
+  inline bool operator>(const ParcelableListUnion& rhs) const {
+    return _value > rhs._value;
+  }
+  inline bool operator>=(const ParcelableListUnion& rhs) const {
+    return _value >= rhs._value;
+  }
+
+  ::android::status_t readFromParcel(const ::android::Parcel* _aidl_parcel) final;
+  ::android::status_t writeToParcel(::android::Parcel* _aidl_parcel) const final;
+  static const ::android::String16& getParcelableDescriptor() {
+    static const ::android::StaticString16 DESCRIPTOR (u"android.aidl.tests.unions.ParcelableListUnion");
+    return DESCRIPTOR;
+  }
+  inline std::string toString() const {
+    std::ostringstream os;
+    os << "ParcelableListUnion{";
+    switch (getTag()) {
+    case n: os << "n: " << ::android::internal::ToString(get<n>()); break;
+    case items: os << "items: " << ::android::internal::ToString(get<items>()); break;
+    }
+    os << "}";
+    return os.str();
+  }
+private:
+  std::variant<int32_t, ::std::vector<::android::aidl::tests::unions::ParcelableListUnion::Item>> _value;
+};  // class ParcelableListUnion
+}  // namespace unions
+}  // namespace tests
+}  // namespace aidl
+}  // namespace android
+namespace android {
+namespace aidl {
+namespace tests {
+namespace unions {
+[[nodiscard]] static inline std::string toString(ParcelableListUnion::Old::Tag val) {
+  switch(val) {
+  case ParcelableListUnion::Old::Tag::n:
+    return "n";
+  case ParcelableListUnion::Old::Tag::items:
+    return "items";
+  default:
+    return std::to_string(static_cast<int32_t>(val));
+  }
+}
+}  // namespace unions
+}  // namespace tests
+}  // namespace aidl
+}  // namespace android
+namespace android {
+namespace internal {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wc++17-extensions"
+template <>
+constexpr inline std::array<::android::aidl::tests::unions::ParcelableListUnion::Old::Tag, 2> enum_values<::android::aidl::tests::unions::ParcelableListUnion::Old::Tag> = {
+  ::android::aidl::tests::unions::ParcelableListUnion::Old::Tag::n,
+  ::android::aidl::tests::unions::ParcelableListUnion::Old::Tag::items,
+};
+#pragma clang diagnostic pop
+}  // namespace internal
+}  // namespace android
+namespace android {
+namespace aidl {
+namespace tests {
+namespace unions {
+[[nodiscard]] static inline std::string toString(ParcelableListUnion::Tag val) {
+  switch(val) {
+  case ParcelableListUnion::Tag::n:
+    return "n";
+  case ParcelableListUnion::Tag::items:
+    return "items";
+  default:
+    return std::to_string(static_cast<int32_t>(val));
+  }
+}
+}  // namespace unions
+}  // namespace tests
+}  // namespace aidl
+}  // namespace android
+namespace android {
+namespace internal {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wc++17-extensions"
+template <>
+constexpr inline std::array<::android::aidl::tests::unions::ParcelableListUnion::Tag, 2> enum_values<::android::aidl::tests::unions::ParcelableListUnion::Tag> = {
+  ::android::aidl::tests::unions::ParcelableListUnion::Tag::n,
+  ::android::aidl::tests::unions::ParcelableListUnion::Tag::items,
+};
+#pragma clang diagnostic pop
+}  // namespace internal
+}  // namespace android
@@ -0,0 +1,488 @@
+/*
+ * This file is auto-generated.  DO NOT MODIFY.
+ */
+package android.aidl.tests.unions;
+public final class ParcelableListUnion implements android.os.Parcelable {
+  // tags for union fields
+  public final static int n = 0;  // int n;
+  public final static int items = 1;  // List<android.aidl.tests.unions.ParcelableListUnion.Item> items;
+
+  private int _tag;
+  private Object _value;
+
+  public ParcelableListUnion() {
+    int _value = 0;
+    this._tag = n;
+    this._value = _value;
+  }
+
+  private ParcelableListUnion(android.os.Parcel _aidl_parcel) {
+    readFromParcel(_aidl_parcel);
+  }
+
+  private ParcelableListUnion(int _tag, Object _value) {
+    this._tag = _tag;
+    this._value = _value;
+  }
+
+  public int getTag() {
+    return _tag;
+  }
+
+  // int n;
+
+  public static ParcelableListUnion n(int _value) {
+    return new ParcelableListUnion(n, _value);
+  }
+
+  public int getN() {
+    _assertTag(n);
+    return (int) _value;
+  }
+
+  public void setN(int _value) {
+    _set(n, _value);
+  }
+
+  // List<android.aidl.tests.unions.ParcelableListUnion.Item> items;
+
+  public static ParcelableListUnion items(java.util.List<android.aidl.tests.unions.ParcelableListUnion.Item> _value) {
+    return new ParcelableListUnion(items, _value);
+  }
+
+  @SuppressWarnings("unchecked")
+  public java.util.List<android.aidl.tests.unions.ParcelableListUnion.Item> getItems() {
+    _assertTag(items);
+    return (java.util.List<android.aidl.tests.unions.ParcelableListUnion.Item>) _value;
+  }
+
+  public void setItems(java.util.List<android.aidl.tests.unions.ParcelableListUnion.Item> _value) {
+    _set(items, _value);
+  }
+
+  public static final android.os.Parcelable.Creator<ParcelableListUnion> CREATOR = new android.os.Parcelable.Creator<ParcelableListUnion>() {
+    @Override
+    public ParcelableListUnion createFromParcel(android.os.Parcel _aidl_source) {
+      return new ParcelableListUnion(_aidl_source);
+    }
+    @Override
+    public ParcelableListUnion[] newArray(int _aidl_size) {
+      return new ParcelableListUnion[_aidl_size];
+    }
+  };
+
+  @Override
+  public final void writeToParcel(android.os.Parcel _aidl_parcel, int _aidl_flag) {
+    _aidl_parcel.writeInt(_tag);
+    switch (_tag) {
+    case n:
+      _aidl_parcel.writeInt(getN());
+      break;
+    case items:
+      _aidl_parcel.writeTypedList(getItems(), _aidl_flag);
+      break;
+    }
+  }
+
+  public void readFromParcel(android.os.Parcel _aidl_parcel) {
+    int _aidl_tag;
+    _aidl_tag = _aidl_parcel.readInt();
+    switch (_aidl_tag) {
+    case n: {
+      int _aidl_value;
+      _aidl_value = _aidl_parcel.readInt();
+      _set(_aidl_tag, _aidl_value);
+      return; }
+    case items: {
+      java.util.List<android.aidl.tests.unions.ParcelableListUnion.Item> _aidl_value;
+      _aidl_value = _aidl_parcel.createTypedArrayList(android.aidl.tests.unions.ParcelableListUnion.Item.CREATOR);
+      _set(_aidl_tag, _aidl_value);
+      return; }
+    }
+    throw new IllegalArgumentException("union: unknown tag: " + _aidl_tag);
+  }
+
+  @Override
+  public int describeContents() {
+    int _mask = 0;
+    switch (getTag()) {
+    case items:
+      _mask |= describeContents(getItems());
+      break;
+    }
+    return _mask;
+  }
+  private int describeContents(Object _v) {
+    if (_v == null) return 0;
+    if (_v instanceof java.util.Collection) {
+      int _mask = 0;
+      for (Object o : (java.util.Collection) _v) {
+        _mask |= describeContents(o);
+      }
+      return _mask;
+    }
+    if (_v instanceof android.os.Parcelable) {
+      return ((android.os.Parcelable) _v).describeContents();
+    }
+    return 0;
+  }
+
+  @Override
+  public String toString() {
+    switch (_tag) {
+    case n: return "android.aidl.tests.unions.ParcelableListUnion.n(" + (getN()) + ")";
+    case items: return "android.aidl.tests.unions.ParcelableListUnion.items(" + (java.util.Objects.toString(getItems())) + ")";
+    }
+    throw new IllegalStateException("unknown field: " + _tag);
+  }
+  @Override
+  public boolean equals(Object other) {
+    if (this == other) return true;
+    if (other == null) return false;
+    if (!(other instanceof ParcelableListUnion)) return false;
+    ParcelableListUnion that = (ParcelableListUnion)other;
+    if (_tag != that._tag) return false;
+    if (!java.util.Objects.deepEquals(_value, that._value)) return false;
+    return true;
+  }
+
+  @Override
+  public int hashCode() {
+    return java.util.Arrays.deepHashCode(java.util.Arrays.asList(_tag, _value).toArray());
+  }
+
+  private void _assertTag(int tag) {
+    if (getTag() != tag) {
+      throw new IllegalStateException("bad access: " + _tagString(tag) + ", " + _tagString(getTag()) + " is available.");
+    }
+  }
+
+  private String _tagString(int _tag) {
+    switch (_tag) {
+    case n: return "n";
+    case items: return "items";
+    }
+    throw new IllegalStateException("unknown field: " + _tag);
+  }
+
+  private void _set(int _tag, Object _value) {
+    this._tag = _tag;
+    this._value = _value;
+  }
+  public static class Item implements android.os.Parcelable
+  {
+    public int a = 0;
+    public int b = 0;
+    public static final android.os.Parcelable.Creator<Item> CREATOR = new android.os.Parcelable.Creator<Item>() {
+      @Override
+      public Item createFromParcel(android.os.Parcel _aidl_source) {
+        Item _aidl_out = new Item();
+        _aidl_out.readFromParcel(_aidl_source);
+        return _aidl_out;
+      }
+      @Override
+      public Item[] newArray(int _aidl_size) {
+        return new Item[_aidl_size];
+      }
+    };
+    @Override public final void writeToParcel(android.os.Parcel _aidl_parcel, int _aidl_flag)
+    {
+      int _aidl_start_pos = _aidl_parcel.dataPosition();
+      _aidl_parcel.writeInt(0);
+      _aidl_parcel.writeInt(a);
+      _aidl_parcel.writeInt(b);
+      int _aidl_end_pos = _aidl_parcel.dataPosition();
+      _aidl_parcel.setDataPosition(_aidl_start_pos);
+      _aidl_parcel.writeInt(_aidl_end_pos - _aidl_start_pos);
+      _aidl_parcel.setDataPosition(_aidl_end_pos);
+    }
+    public final void readFromParcel(android.os.Parcel _aidl_parcel)
+    {
+      int _aidl_start_pos = _aidl_parcel.dataPosition();
+      int _aidl_parcelable_size = _aidl_parcel.readInt();
+      try {
+        if (_aidl_parcelable_size < 4) throw new android.os.BadParcelableException("Parcelable too small");;
+        if (_aidl_parcel.dataPosition() - _aidl_start_pos >= _aidl_parcelable_size) return;
+        a = _aidl_parcel.readInt();
+        if (_aidl_parcel.dataPosition() - _aidl_start_pos >= _aidl_parcelable_size) return;
+        b = _aidl_parcel.readInt();
+      } finally {
+        if (_aidl_start_pos > (Integer.MAX_VALUE - _aidl_parcelable_size)) {
+          throw new android.os.BadParcelableException("Overflow in the size of parcelable");
+        }
+        _aidl_parcel.setDataPosition(_aidl_start_pos + _aidl_parcelable_size);
+      }
+    }
+    @Override
+    public String toString() {
+      java.util.StringJoiner _aidl_sj = new java.util.StringJoiner(", ", "{", "}");
+      _aidl_sj.add("a: " + (a));
+      _aidl_sj.add("b: " + (b));
+      return "android.aidl.tests.unions.ParcelableListUnion.Item" + _aidl_sj.toString()  ;
+    }
+    @Override
+    public boolean equals(Object other) {
+      if (this == other) return true;
+      if (other == null) return false;
+      if (!(other instanceof Item)) return false;
+      Item that = (Item)other;
+      if (!java.util.Objects.deepEquals(a, that.a)) return false;
+      if (!java.util.Objects.deepEquals(b, that.b)) return false;
+      return true;
+    }
+
+    @Override
+    public int hashCode() {
+      return java.util.Arrays.deepHashCode(java.util.Arrays.asList(a, b).toArray());
+    }
+    @Override
+    public int describeContents() {
+      int _mask = 0;
+      return _mask;
+    }
+  }
+  // Item of an older version, which doesn't have b.
+  public static class OldItem implements android.os.Parcelable
+  {
+    public int a = 0;
+    public static final android.os.Parcelable.Creator<OldItem> CREATOR = new android.os.Parcelable.Creator<OldItem>() {
+      @Override
+      public OldItem createFromParcel(android.os.Parcel _aidl_source) {
+        OldItem _aidl_out = new OldItem();
+        _aidl_out.readFromParcel(_aidl_source);
+        return _aidl_out;
+      }
+      @Override
+      public OldItem[] newArray(int _aidl_size) {
+        return new OldItem[_aidl_size];
+      }
+    };
+    @Override public final void writeToParcel(android.os.Parcel _aidl_parcel, int _aidl_flag)
+    {
+      int _aidl_start_pos = _aidl_parcel.dataPosition();
+      _aidl_parcel.writeInt(0);
+      _aidl_parcel.writeInt(a);
+      int _aidl_end_pos = _aidl_parcel.dataPosition();
+      _aidl_parcel.setDataPosition(_aidl_start_pos);
+      _aidl_parcel.writeInt(_aidl_end_pos - _aidl_start_pos);
+      _aidl_parcel.setDataPosition(_aidl_end_pos);
+    }
+    public final void readFromParcel(android.os.Parcel _aidl_parcel)
+    {
+      int _aidl_start_pos = _aidl_parcel.dataPosition();
+      int _aidl_parcelable_size = _aidl_parcel.readInt();
+      try {
+        if (_aidl_parcelable_size < 4) throw new android.os.BadParcelableException("Parcelable too small");;
+        if (_aidl_parcel.dataPosition() - _aidl_start_pos >= _aidl_parcelable_size) return;
+        a = _aidl_parcel.readInt();
+      } finally {
+        if (_aidl_start_pos > (Integer.MAX_VALUE - _aidl_parcelable_size)) {
+          throw new android.os.BadParcelableException("Overflow in the size of parcelable");
+        }
+        _aidl_parcel.setDataPosition(_aidl_start_pos + _aidl_parcelable_size);
+      }
+    }
+    @Override
+    public String toString() {
+      java.util.StringJoiner _aidl_sj = new java.util.StringJoiner(", ", "{", "}");
+      _aidl_sj.add("a: " + (a));
+      return "android.aidl.tests.unions.ParcelableListUnion.OldItem" + _aidl_sj.toString()  ;
+    }
+    @Override
+    public boolean equals(Object other) {
+      if (this == other) return true;
+      if (other == null) return false;
+      if (!(other instanceof OldItem)) return false;
+      OldItem that = (OldItem)other;
+      if (!java.util.Objects.deepEquals(a, that.a)) return false;
+      return true;
+    }
+
+    @Override
+    public int hashCode() {
+      return java.util.Arrays.deepHashCode(java.util.Arrays.asList(a).toArray());
+    }
+    @Override
+    public int describeContents() {
+      int _mask = 0;
+      return _mask;
+    }
+  }
+  // ParcelableListUnion of an older version.
+  public static final class Old implements android.os.Parcelable {
+    // tags for union fields
+    public final static int n = 0;  // int n;
+    public final static int items = 1;  // List<android.aidl.tests.unions.ParcelableListUnion.OldItem> items;
+
+    private int _tag;
+    private Object _value;
+
+    public Old() {
+      int _value = 0;
+      this._tag = n;
+      this._value = _value;
+    }
+
+    private Old(android.os.Parcel _aidl_parcel) {
+      readFromParcel(_aidl_parcel);
+    }
+
+    private Old(int _tag, Object _value) {
+      this._tag = _tag;
+      this._value = _value;
+    }
+
+    public int getTag() {
+      return _tag;
+    }
+
+    // int n;
+
+    public static Old n(int _value) {
+      return new Old(n, _value);
+    }
+
+    public int getN() {
+      _assertTag(n);
+      return (int) _value;
+    }
+
+    public void setN(int _value) {
+      _set(n, _value);
+    }
+
+    // List<android.aidl.tests.unions.ParcelableListUnion.OldItem> items;
+
+    public static Old items(java.util.List<android.aidl.tests.unions.ParcelableListUnion.OldItem> _value) {
+      return new Old(items, _value);
+    }
+
+    @SuppressWarnings("unchecked")
+    public java.util.List<android.aidl.tests.unions.ParcelableListUnion.OldItem> getItems() {
+      _assertTag(items);
+      return (java.util.List<android.aidl.tests.unions.ParcelableListUnion.OldItem>) _value;
+    }
+
+    public void setItems(java.util.List<android.aidl.tests.unions.ParcelableListUnion.OldItem> _value) {
+      _set(items, _value);
+    }
+
+    public static final android.os.Parcelable.Creator<Old> CREATOR = new android.os.Parcelable.Creator<Old>() {
+      @Override
+      public Old createFromParcel(android.os.Parcel _aidl_source) {
+        return new Old(_aidl_source);
+      }
+      @Override
+      public Old[] newArray(int _aidl_size) {
+        return new Old[_aidl_size];
+      }
+    };
+
+    @Override
+    public final void writeToParcel(android.os.Parcel _aidl_parcel, int _aidl_flag) {
+      _aidl_parcel.writeInt(_tag);
+      switch (_tag) {
+      case n:
+        _aidl_parcel.writeInt(getN());
+        break;
+      case items:
+        _aidl_parcel.writeTypedList(getItems(), _aidl_flag);
+        break;
+      }
+    }
+
+    public void readFromParcel(android.os.Parcel _aidl_parcel) {
+      int _aidl_tag;
+      _aidl_tag = _aidl_parcel.readInt();
+      switch (_aidl_tag) {
+      case n: {
+        int _aidl_value;
+        _aidl_value = _aidl_parcel.readInt();
+        _set(_aidl_tag, _aidl_value);
+        return; }
+      case items: {
+        java.util.List<android.aidl.tests.unions.ParcelableListUnion.OldItem> _aidl_value;
+        _aidl_value = _aidl_parcel.createTypedArrayList(android.aidl.tests.unions.ParcelableListUnion.OldItem.CREATOR);
+        _set(_aidl_tag, _aidl_value);
+        return; }
+      }
+      throw new IllegalArgumentException("union: unknown tag: " + _aidl_tag);
+    }
+
+    @Override
+    public int describeContents() {
+      int _mask = 0;
+      switch (getTag()) {
+      case items:
+        _mask |= describeContents(getItems());
+        break;
+      }
+      return _mask;
+    }
+    private int describeContents(Object _v) {
+      if (_v == null) return 0;
+      if (_v instanceof java.util.Collection) {
+        int _mask = 0;
+        for (Object o : (java.util.Collection) _v) {
+          _mask |= describeContents(o);
+        }
+        return _mask;
+      }
+      if (_v instanceof android.os.Parcelable) {
+        return ((android.os.Parcelable) _v).describeContents();
+      }
+      return 0;
+    }
+
+    @Override
+    public String toString() {
+      switch (_tag) {
+      case n: return "android.aidl.tests.unions.ParcelableListUnion.Old.n(" + (getN()) + ")";
+      case items: return "android.aidl.tests.unions.ParcelableListUnion.Old.items(" + (java.util.Objects.toString(getItems())) + ")";
+      }
+      throw new IllegalStateException("unknown field: " + _tag);
+    }
+    @Override
+    public boolean equals(Object other) {
+      if (this == other) return true;
+      if (other == null) return false;
+      if (!(other instanceof Old)) return false;
+      Old that = (Old)other;
+      if (_tag != that._tag) return false;
+      if (!java.util.Objects.deepEquals(_value, that._value)) return false;
+      return true;
+    }
+
+    @Override
+    public int hashCode() {
+      return java.util.Arrays.deepHashCode(java.util.Arrays.asList(_tag, _value).toArray());
+    }
+
+    private void _assertTag(int tag) {
+      if (getTag() != tag) {
+        throw new IllegalStateException("bad access: " + _tagString(tag) + ", " + _tagString(getTag()) + " is available.");
+      }
+    }
+
+    private String _tagString(int _tag) {
+      switch (_tag) {
+      case n: return "n";
+      case items: return "items";
+      }
+      throw new IllegalStateException("unknown field: " + _tag);
+    }
+
+    private void _set(int _tag, Object _value) {
+      this._tag = _tag;
+      this._value = _value;
+    }
+    public static @interface Tag {
+      public static final int n = 0;
+      public static final int items = 1;
+    }
+  }
+  public static @interface Tag {
+    public static final int n = 0;
+    public static final int items = 1;
+  }
+}
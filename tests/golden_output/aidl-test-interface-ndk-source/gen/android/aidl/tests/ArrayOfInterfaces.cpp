@@ -417,44 +417,20 @@ binder_status_t ArrayOfInterfaces::MyUnion::readFromParcel(const AParcel* _parce
   if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_tag)) != STATUS_OK) return _aidl_ret_status;
   switch (static_cast<Tag>(_aidl_tag)) {
   case iface: {
-    std::shared_ptr<::aidl::android::aidl::tests::ArrayOfInterfaces::IEmptyInterface> _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<std::shared_ptr<::aidl::android::aidl::tests::ArrayOfInterfaces::IEmptyInterface>>) {
-      set<iface>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<iface>(std::move(_aidl_value));
-    }
+    set<iface>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<iface>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   case nullable_iface: {
-    std::shared_ptr<::aidl::android::aidl::tests::ArrayOfInterfaces::IEmptyInterface> _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readNullableData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<std::shared_ptr<::aidl::android::aidl::tests::ArrayOfInterfaces::IEmptyInterface>>) {
-      set<nullable_iface>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<nullable_iface>(std::move(_aidl_value));
-    }
+    set<nullable_iface>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readNullableData(_parcel, &get<nullable_iface>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   case iface_array: {
-    std::vector<std::shared_ptr<::aidl::android::aidl::tests::ArrayOfInterfaces::IEmptyInterface>> _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<std::vector<std::shared_ptr<::aidl::android::aidl::tests::ArrayOfInterfaces::IEmptyInterface>>>) {
-      set<iface_array>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<iface_array>(std::move(_aidl_value));
-    }
+    set<iface_array>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<iface_array>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   case nullable_iface_array: {
-    std::optional<std::vector<std::shared_ptr<::aidl::android::aidl::tests::ArrayOfInterfaces::IEmptyInterface>>> _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readNullableData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<std::optional<std::vector<std::shared_ptr<::aidl::android::aidl::tests::ArrayOfInterfaces::IEmptyInterface>>>>) {
-      set<nullable_iface_array>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<nullable_iface_array>(std::move(_aidl_value));
-    }
+    set<nullable_iface_array>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readNullableData(_parcel, &get<nullable_iface_array>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   }
   return STATUS_BAD_VALUE;
@@ -4998,24 +4998,12 @@ binder_status_t ITestService::CompilerChecks::UsingHasDeprecated::readFromParcel
   if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_tag)) != STATUS_OK) return _aidl_ret_status;
   switch (static_cast<Tag>(_aidl_tag)) {
   case n: {
-    int32_t _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<int32_t>) {
-      set<n>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<n>(std::move(_aidl_value));
-    }
+    set<n>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<n>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   case m: {
-    ::aidl::android::aidl::tests::ITestService::CompilerChecks::HasDeprecated _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::aidl::android::aidl::tests::ITestService::CompilerChecks::HasDeprecated>) {
-      set<m>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<m>(std::move(_aidl_value));
-    }
+    set<m>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<m>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   }
   return STATUS_BAD_VALUE;
@@ -405,44 +405,20 @@ binder_status_t ListOfInterfaces::MyUnion::readFromParcel(const AParcel* _parcel
   if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_tag)) != STATUS_OK) return _aidl_ret_status;
   switch (static_cast<Tag>(_aidl_tag)) {
   case iface: {
-    std::shared_ptr<::aidl::android::aidl::tests::ListOfInterfaces::IEmptyInterface> _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<std::shared_ptr<::aidl::android::aidl::tests::ListOfInterfaces::IEmptyInterface>>) {
-      set<iface>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<iface>(std::move(_aidl_value));
-    }
+    set<iface>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<iface>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   case nullable_iface: {
-    std::shared_ptr<::aidl::android::aidl::tests::ListOfInterfaces::IEmptyInterface> _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readNullableData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<std::shared_ptr<::aidl::android::aidl::tests::ListOfInterfaces::IEmptyInterface>>) {
-      set<nullable_iface>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<nullable_iface>(std::move(_aidl_value));
-    }
+    set<nullable_iface>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readNullableData(_parcel, &get<nullable_iface>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   case iface_list: {
-    std::vector<std::shared_ptr<::aidl::android::aidl::tests::ListOfInterfaces::IEmptyInterface>> _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<std::vector<std::shared_ptr<::aidl::android::aidl::tests::ListOfInterfaces::IEmptyInterface>>>) {
-      set<iface_list>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<iface_list>(std::move(_aidl_value));
-    }
+    set<iface_list>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<iface_list>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   case nullable_iface_list: {
-    std::optional<std::vector<std::shared_ptr<::aidl::android::aidl::tests::ListOfInterfaces::IEmptyInterface>>> _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readNullableData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<std::optional<std::vector<std::shared_ptr<::aidl::android::aidl::tests::ListOfInterfaces::IEmptyInterface>>>>) {
-      set<nullable_iface_list>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<nullable_iface_list>(std::move(_aidl_value));
-    }
+    set<nullable_iface_list>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readNullableData(_parcel, &get<nullable_iface_list>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   }
   return STATUS_BAD_VALUE;
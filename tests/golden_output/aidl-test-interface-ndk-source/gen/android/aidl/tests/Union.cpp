@@ -15,74 +15,38 @@ binder_status_t Union::readFromParcel(const AParcel* _parcel) {
   if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_tag)) != STATUS_OK) return _aidl_ret_status;
   switch (static_cast<Tag>(_aidl_tag)) {
   case ns: {
-    std::vector<int32_t> _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<std::vector<int32_t>>) {
-      set<ns>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<ns>(std::move(_aidl_value));
+    if (getTag() != ns) {
+      set<ns>();
     }
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<ns>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   case n: {
-    int32_t _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<int32_t>) {
-      set<n>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<n>(std::move(_aidl_value));
-    }
+    set<n>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<n>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   case m: {
-    int32_t _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<int32_t>) {
-      set<m>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<m>(std::move(_aidl_value));
-    }
+    set<m>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<m>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   case s: {
-    std::string _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<std::string>) {
-      set<s>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<s>(std::move(_aidl_value));
+    if (getTag() != s) {
+      set<s>();
     }
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<s>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   case ibinder: {
-    ::ndk::SpAIBinder _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readNullableData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::ndk::SpAIBinder>) {
-      set<ibinder>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<ibinder>(std::move(_aidl_value));
-    }
+    set<ibinder>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readNullableData(_parcel, &get<ibinder>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   case ss: {
-    std::vector<std::string> _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<std::vector<std::string>>) {
-      set<ss>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<ss>(std::move(_aidl_value));
+    if (getTag() != ss) {
+      set<ss>();
     }
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<ss>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   case be: {
-    ::aidl::android::aidl::tests::ByteEnum _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::aidl::android::aidl::tests::ByteEnum>) {
-      set<be>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<be>(std::move(_aidl_value));
-    }
+    set<be>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<be>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   }
   return STATUS_BAD_VALUE;
@@ -17,34 +17,16 @@ binder_status_t EnumUnion::readFromParcel(const AParcel* _parcel) {
   if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_tag)) != STATUS_OK) return _aidl_ret_status;
   switch (static_cast<Tag>(_aidl_tag)) {
   case intEnum: {
-    ::aidl::android::aidl::tests::IntEnum _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::aidl::android::aidl::tests::IntEnum>) {
-      set<intEnum>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<intEnum>(std::move(_aidl_value));
-    }
+    set<intEnum>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<intEnum>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   case longEnum: {
-    ::aidl::android::aidl::tests::LongEnum _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::aidl::android::aidl::tests::LongEnum>) {
-      set<longEnum>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<longEnum>(std::move(_aidl_value));
-    }
+    set<longEnum>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<longEnum>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   case deprecatedField: {
-    int32_t _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<int32_t>) {
-      set<deprecatedField>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<deprecatedField>(std::move(_aidl_value));
-    }
+    set<deprecatedField>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<deprecatedField>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   }
   return STATUS_BAD_VALUE;
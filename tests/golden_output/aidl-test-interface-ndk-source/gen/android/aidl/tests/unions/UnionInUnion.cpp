@@ -15,24 +15,12 @@ binder_status_t UnionInUnion::readFromParcel(const AParcel* _parcel) {
   if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_tag)) != STATUS_OK) return _aidl_ret_status;
   switch (static_cast<Tag>(_aidl_tag)) {
   case first: {
-    ::aidl::android::aidl::tests::unions::EnumUnion _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::aidl::android::aidl::tests::unions::EnumUnion>) {
-      set<first>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<first>(std::move(_aidl_value));
-    }
+    set<first>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<first>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   case second: {
-    int32_t _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<int32_t>) {
-      set<second>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<second>(std::move(_aidl_value));
-    }
+    set<second>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<second>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   }
   return STATUS_BAD_VALUE;
@@ -0,0 +1,200 @@
+#![forbid(unsafe_code)]
+#![rustfmt::skip]
+#[derive(Debug, Clone, PartialEq)]
+pub enum r#ParcelableListUnion {
+  N(i32),
+  Items(Vec<crate::mangled::_7_android_4_aidl_5_tests_6_unions_19_ParcelableListUnion_4_Item>),
+}
+impl Default for r#ParcelableListUnion {
+  fn default() -> Self {
+    Self::N(0)
+  }
+}
+impl binder::Parcelable for r#ParcelableListUnion {
+  fn write_to_parcel(&self, parcel: &mut binder::binder_impl::BorrowedParcel) -> std::result::Result<(), binder::StatusCode> {
+    match self {
+      Self::N(v) => {
+        parcel.write(&0i32)?;
+        parcel.write(v)
+      }
+      Self::Items(v) => {
+        parcel.write(&1i32)?;
+        parcel.write(v)
+      }
+    }
+  }
+  fn read_from_parcel(&mut self, parcel: &binder::binder_impl::BorrowedParcel) -> std::result::Result<(), binder::StatusCode> {
+    let tag: i32 = parcel.read()?;
+    match tag {
+      0 => {
+        let value: i32 = parcel.read()?;
+        *self = Self::N(value);
+        Ok(())
+      }
+      1 => {
+        let value: Vec<crate::mangled::_7_android_4_aidl_5_tests_6_unions_19_ParcelableListUnion_4_Item> = parcel.read()?;
+        *self = Self::Items(value);
+        Ok(())
+      }
+      _ => {
+        Err(binder::StatusCode::BAD_VALUE)
+      }
+    }
+  }
+}
+binder::impl_serialize_for_parcelable!(r#ParcelableListUnion);
+binder::impl_deserialize_for_parcelable!(r#ParcelableListUnion);
+impl binder::binder_impl::ParcelableMetadata for r#ParcelableListUnion {
+  fn get_descriptor() -> &'static str { "android.aidl.tests.unions.ParcelableListUnion" }
+}
+pub mod r#Item {
+  #[derive(Debug, Clone, PartialEq)]
+  pub struct r#Item {
+    pub r#a: i32,
+    pub r#b: i32,
+  }
+  impl Default for r#Item {
+    fn default() -> Self {
+      Self {
+        r#a: 0,
+        r#b: 0,
+      }
+    }
+  }
+  impl binder::Parcelable for r#Item {
+    fn write_to_parcel(&self, parcel: &mut binder::binder_impl::BorrowedParcel) -> std::result::Result<(), binder::StatusCode> {
+      parcel.sized_write(|subparcel| {
+        subparcel.write(&self.r#a)?;
+        subparcel.write(&self.r#b)?;
+        Ok(())
+      })
+    }
+    fn read_from_parcel(&mut self, parcel: &binder::binder_impl::BorrowedParcel) -> std::result::Result<(), binder::StatusCode> {
+      parcel.sized_read(|subparcel| {
+        if subparcel.has_more_data() {
+          self.r#a = subparcel.read()?;
+        }
+        if subparcel.has_more_data() {
+          self.r#b = subparcel.read()?;
+        }
+        Ok(())
+      })
+    }
+  }
+  binder::impl_serialize_for_parcelable!(r#Item);
+  binder::impl_deserialize_for_parcelable!(r#Item);
+  impl binder::binder_impl::ParcelableMetadata for r#Item {
+    fn get_descriptor() -> &'static str { "android.aidl.tests.unions.ParcelableListUnion.Item" }
+  }
+}
+pub mod r#OldItem {
+  #[derive(Debug, Clone, PartialEq)]
+  pub struct r#OldItem {
+    pub r#a: i32,
+  }
+  impl Default for r#OldItem {
+    fn default() -> Self {
+      Self {
+        r#a: 0,
+      }
+    }
+  }
+  impl binder::Parcelable for r#OldItem {
+    fn write_to_parcel(&self, parcel: &mut binder::binder_impl::BorrowedParcel) -> std::result::Result<(), binder::StatusCode> {
+      parcel.sized_write(|subparcel| {
+        subparcel.write(&self.r#a)?;
+        Ok(())
+      })
+    }
+    fn read_from_parcel(&mut self, parcel: &binder::binder_impl::BorrowedParcel) -> std::result::Result<(), binder::StatusCode> {
+      parcel.sized_read(|subparcel| {
+        if subparcel.has_more_data() {
+          self.r#a = subparcel.read()?;
+        }
+        Ok(())
+      })
+    }
+  }
+  binder::impl_serialize_for_parcelable!(r#OldItem);
+  binder::impl_deserialize_for_parcelable!(r#OldItem);
+  impl binder::binder_impl::ParcelableMetadata for r#OldItem {
+    fn get_descriptor() -> &'static str { "android.aidl.tests.unions.ParcelableListUnion.OldItem" }
+  }
+}
+pub mod r#Old {
+  #[derive(Debug, Clone, PartialEq)]
+  pub enum r#Old {
+    N(i32),
+    Items(Vec<crate::mangled::_7_android_4_aidl_5_tests_6_unions_19_ParcelableListUnion_7_OldItem>),
+  }
+  impl Default for r#Old {
+    fn default() -> Self {
+      Self::N(0)
+    }
+  }
+  impl binder::Parcelable for r#Old {
+    fn write_to_parcel(&self, parcel: &mut binder::binder_impl::BorrowedParcel) -> std::result::Result<(), binder::StatusCode> {
+      match self {
+        Self::N(v) => {
+          parcel.write(&0i32)?;
+          parcel.write(v)
+        }
+        Self::Items(v) => {
+          parcel.write(&1i32)?;
+          parcel.write(v)
+        }
+      }
+    }
+    fn read_from_parcel(&mut self, parcel: &binder::binder_impl::BorrowedParcel) -> std::result::Result<(), binder::StatusCode> {
+      let tag: i32 = parcel.read()?;
+      match tag {
+        0 => {
+          let value: i32 = parcel.read()?;
+          *self = Self::N(value);
+          Ok(())
+        }
+        1 => {
+          let value: Vec<crate::mangled::_7_android_4_aidl_5_tests_6_unions_19_ParcelableListUnion_7_OldItem> = parcel.read()?;
+          *self = Self::Items(value);
+          Ok(())
+        }
+        _ => {
+          Err(binder::StatusCode::BAD_VALUE)
+        }
+      }
+    }
+  }
+  binder::impl_serialize_for_parcelable!(r#Old);
+  binder::impl_deserialize_for_parcelable!(r#Old);
+  impl binder::binder_impl::ParcelableMetadata for r#Old {
+    fn get_descriptor() -> &'static str { "android.aidl.tests.unions.ParcelableListUnion.Old" }
+  }
+  pub mod r#Tag {
+    #![allow(non_upper_case_globals)]
+    use binder::declare_binder_enum;
+    declare_binder_enum! {
+      r#Tag : [i32; 2] {
+        r#n = 0,
+        r#items = 1,
+      }
+    }
+  }
+}
+pub mod r#Tag {
+  #![allow(non_upper_case_globals)]
+  use binder::declare_binder_enum;
+  declare_binder_enum! {
+    r#Tag : [i32; 2] {
+      r#n = 0,
+      r#items = 1,
+    }
+  }
+}
+pub(crate) mod mangled {
+ pub use super::r#ParcelableListUnion as _7_android_4_aidl_5_tests_6_unions_19_ParcelableListUnion;
+ pub use super::r#Item::r#Item as _7_android_4_aidl_5_tests_6_unions_19_ParcelableListUnion_4_Item;
+ pub use super::r#OldItem::r#OldItem as _7_android_4_aidl_5_tests_6_unions_19_ParcelableListUnion_7_OldItem;
+ pub use super::r#Old::r#Old as _7_android_4_aidl_5_tests_6_unions_19_ParcelableListUnion_3_Old;
+ pub use super::r#Old::r#Tag::r#Tag as _7_android_4_aidl_5_tests_6_unions_19_ParcelableListUnion_3_Old_3_Tag;
+ pub use super::r#Tag::r#Tag as _7_android_4_aidl_5_tests_6_unions_19_ParcelableListUnion_3_Tag;
+}
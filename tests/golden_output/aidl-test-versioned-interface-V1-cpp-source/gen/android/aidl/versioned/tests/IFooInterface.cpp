@@ -30,11 +30,20 @@ BpFooInterface::BpFooInterface(const ::android::sp<::android::IBinder>& _aidl_im
   ::android::status_t _aidl_ret_status = ::android::OK;
   ::android::binder::Status _aidl_status;
   ::android::binder::ScopedTrace _aidl_trace(ATRACE_TAG_AIDL, "AIDL::cpp::IFooInterface::originalApi::cppClient");
-  _aidl_ret_status = _aidl_data.writeInterfaceToken(getInterfaceDescriptor());
+  if (UNLIKELY(unsupported_methods_[0].load(std::memory_order_relaxed) & (uint64_t{1} << 0))) {
+    if (IFooInterface::getDefaultImpl()) {
+      return IFooInterface::getDefaultImpl()->originalApi();
+    }
+    return ::android::binder::Status::fromStatusT(::android::UNKNOWN_TRANSACTION);
+  }
+  _aidl_ret_status = _aidl_data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
   if (((_aidl_ret_status) != (::android::OK))) {
     goto _aidl_error;
   }
   _aidl_ret_status = remote()->transact(BnFooInterface::TRANSACTION_originalApi, _aidl_data, &_aidl_reply, 0);
+  if (UNLIKELY(_aidl_ret_status == ::android::UNKNOWN_TRANSACTION)) {
+    unsupported_methods_[0].fetch_or(uint64_t{1} << 0, std::memory_order_relaxed);
+  }
   if (UNLIKELY(_aidl_ret_status == ::android::UNKNOWN_TRANSACTION && IFooInterface::getDefaultImpl())) {
      return IFooInterface::getDefaultImpl()->originalApi();
   }
@@ -60,7 +69,13 @@ BpFooInterface::BpFooInterface(const ::android::sp<::android::IBinder>& _aidl_im
   ::android::status_t _aidl_ret_status = ::android::OK;
   ::android::binder::Status _aidl_status;
   ::android::binder::ScopedTrace _aidl_trace(ATRACE_TAG_AIDL, "AIDL::cpp::IFooInterface::acceptUnionAndReturnString::cppClient");
-  _aidl_ret_status = _aidl_data.writeInterfaceToken(getInterfaceDescriptor());
+  if (UNLIKELY(unsupported_methods_[0].load(std::memory_order_relaxed) & (uint64_t{1} << 1))) {
+    if (IFooInterface::getDefaultImpl()) {
+      return IFooInterface::getDefaultImpl()->acceptUnionAndReturnString(u, _aidl_return);
+    }
+    return ::android::binder::Status::fromStatusT(::android::UNKNOWN_TRANSACTION);
+  }
+  _aidl_ret_status = _aidl_data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
   if (((_aidl_ret_status) != (::android::OK))) {
     goto _aidl_error;
   }
@@ -69,6 +84,9 @@ BpFooInterface::BpFooInterface(const ::android::sp<::android::IBinder>& _aidl_im
     goto _aidl_error;
   }
   _aidl_ret_status = remote()->transact(BnFooInterface::TRANSACTION_acceptUnionAndReturnString, _aidl_data, &_aidl_reply, 0);
+  if (UNLIKELY(_aidl_ret_status == ::android::UNKNOWN_TRANSACTION)) {
+    unsupported_methods_[0].fetch_or(uint64_t{1} << 1, std::memory_order_relaxed);
+  }
   if (UNLIKELY(_aidl_ret_status == ::android::UNKNOWN_TRANSACTION && IFooInterface::getDefaultImpl())) {
      return IFooInterface::getDefaultImpl()->acceptUnionAndReturnString(u, _aidl_return);
   }
@@ -98,7 +116,13 @@ BpFooInterface::BpFooInterface(const ::android::sp<::android::IBinder>& _aidl_im
   ::android::status_t _aidl_ret_status = ::android::OK;
   ::android::binder::Status _aidl_status;
   ::android::binder::ScopedTrace _aidl_trace(ATRACE_TAG_AIDL, "AIDL::cpp::IFooInterface::ignoreParcelablesAndRepeatInt::cppClient");
-  _aidl_ret_status = _aidl_data.writeInterfaceToken(getInterfaceDescriptor());
+  if (UNLIKELY(unsupported_methods_[0].load(std::memory_order_relaxed) & (uint64_t{1} << 2))) {
+    if (IFooInterface::getDefaultImpl()) {
+      return IFooInterface::getDefaultImpl()->ignoreParcelablesAndRepeatInt(inFoo, inoutFoo, outFoo, value, _aidl_return);
+    }
+    return ::android::binder::Status::fromStatusT(::android::UNKNOWN_TRANSACTION);
+  }
+  _aidl_ret_status = _aidl_data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
   if (((_aidl_ret_status) != (::android::OK))) {
     goto _aidl_error;
   }
@@ -115,6 +139,9 @@ BpFooInterface::BpFooInterface(const ::android::sp<::android::IBinder>& _aidl_im
     goto _aidl_error;
   }
   _aidl_ret_status = remote()->transact(BnFooInterface::TRANSACTION_ignoreParcelablesAndRepeatInt, _aidl_data, &_aidl_reply, 0);
+  if (UNLIKELY(_aidl_ret_status == ::android::UNKNOWN_TRANSACTION)) {
+    unsupported_methods_[0].fetch_or(uint64_t{1} << 2, std::memory_order_relaxed);
+  }
   if (UNLIKELY(_aidl_ret_status == ::android::UNKNOWN_TRANSACTION && IFooInterface::getDefaultImpl())) {
      return IFooInterface::getDefaultImpl()->ignoreParcelablesAndRepeatInt(inFoo, inoutFoo, outFoo, value, _aidl_return);
   }
@@ -152,7 +179,13 @@ BpFooInterface::BpFooInterface(const ::android::sp<::android::IBinder>& _aidl_im
   ::android::status_t _aidl_ret_status = ::android::OK;
   ::android::binder::Status _aidl_status;
   ::android::binder::ScopedTrace _aidl_trace(ATRACE_TAG_AIDL, "AIDL::cpp::IFooInterface::returnsLengthOfFooArray::cppClient");
-  _aidl_ret_status = _aidl_data.writeInterfaceToken(getInterfaceDescriptor());
+  if (UNLIKELY(unsupported_methods_[0].load(std::memory_order_relaxed) & (uint64_t{1} << 3))) {
+    if (IFooInterface::getDefaultImpl()) {
+      return IFooInterface::getDefaultImpl()->returnsLengthOfFooArray(foos, _aidl_return);
+    }
+    return ::android::binder::Status::fromStatusT(::android::UNKNOWN_TRANSACTION);
+  }
+  _aidl_ret_status = _aidl_data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
   if (((_aidl_ret_status) != (::android::OK))) {
     goto _aidl_error;
   }
@@ -161,6 +194,9 @@ BpFooInterface::BpFooInterface(const ::android::sp<::android::IBinder>& _aidl_im
     goto _aidl_error;
   }
   _aidl_ret_status = remote()->transact(BnFooInterface::TRANSACTION_returnsLengthOfFooArray, _aidl_data, &_aidl_reply, 0);
+  if (UNLIKELY(_aidl_ret_status == ::android::UNKNOWN_TRANSACTION)) {
+    unsupported_methods_[0].fetch_or(uint64_t{1} << 3, std::memory_order_relaxed);
+  }
   if (UNLIKELY(_aidl_ret_status == ::android::UNKNOWN_TRANSACTION && IFooInterface::getDefaultImpl())) {
      return IFooInterface::getDefaultImpl()->returnsLengthOfFooArray(foos, _aidl_return);
   }
@@ -187,7 +223,7 @@ int32_t BpFooInterface::getInterfaceVersion() {
   if (cached_version_ == -1) {
     ::android::Parcel data;
     ::android::Parcel reply;
-    data.writeInterfaceToken(getInterfaceDescriptor());
+    data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
     ::android::status_t err = remote()->transact(BnFooInterface::TRANSACTION_getInterfaceVersion, data, &reply);
     if (err == ::android::OK) {
       ::android::binder::Status _aidl_status;
@@ -206,7 +242,7 @@ std::string BpFooInterface::getInterfaceHash() {
   if (cached_hash_ == "-1") {
     ::android::Parcel data;
     ::android::Parcel reply;
-    data.writeInterfaceToken(getInterfaceDescriptor());
+    data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
     ::android::status_t err = remote()->transact(BnFooInterface::TRANSACTION_getInterfaceHash, data, &reply);
     if (err == ::android::OK) {
       ::android::binder::Status _aidl_status;
@@ -242,7 +278,7 @@ BnFooInterface::BnFooInterface()
   switch (_aidl_code) {
   case BnFooInterface::TRANSACTION_originalApi:
   {
-    if (!(_aidl_data.checkInterface(this))) {
+    if (!(_aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length))) {
       _aidl_ret_status = ::android::BAD_TYPE;
       break;
     }
@@ -261,7 +297,7 @@ BnFooInterface::BnFooInterface()
   {
     ::android::aidl::versioned::tests::BazUnion in_u;
     ::std::string _aidl_return;
-    if (!(_aidl_data.checkInterface(this))) {
+    if (!(_aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length))) {
       _aidl_ret_status = ::android::BAD_TYPE;
       break;
     }
@@ -295,7 +331,7 @@ BnFooInterface::BnFooInterface()
     ::android::aidl::versioned::tests::Foo out_outFoo;
     int32_t in_value;
     int32_t _aidl_return;
-    if (!(_aidl_data.checkInterface(this))) {
+    if (!(_aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length))) {
       _aidl_ret_status = ::android::BAD_TYPE;
       break;
     }
@@ -342,7 +378,7 @@ BnFooInterface::BnFooInterface()
   {
     ::std::vector<::android::aidl::versioned::tests::Foo> in_foos;
     int32_t _aidl_return;
-    if (!(_aidl_data.checkInterface(this))) {
+    if (!(_aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length))) {
       _aidl_ret_status = ::android::BAD_TYPE;
       break;
     }
@@ -371,14 +407,14 @@ BnFooInterface::BnFooInterface()
   break;
   case BnFooInterface::TRANSACTION_getInterfaceVersion:
   {
-    _aidl_data.checkInterface(this);
+    _aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length);
     _aidl_reply->writeNoException();
     _aidl_reply->writeInt32(IFooInterface::VERSION);
   }
   break;
   case BnFooInterface::TRANSACTION_getInterfaceHash:
   {
-    _aidl_data.checkInterface(this);
+    _aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length);
     _aidl_reply->writeNoException();
     _aidl_reply->writeUtf8AsUtf16(IFooInterface::HASH);
   }
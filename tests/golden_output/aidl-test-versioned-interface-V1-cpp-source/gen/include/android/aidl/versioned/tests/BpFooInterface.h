@@ -4,6 +4,7 @@
 #include <binder/IInterface.h>
 #include <utils/Errors.h>
 #include <android/aidl/versioned/tests/IFooInterface.h>
+#include <atomic>
 
 namespace android {
 namespace aidl {
@@ -21,6 +22,7 @@ public:
   std::string getInterfaceHash() override;
 private:
   int32_t cached_version_ = -1;
+  std::atomic<uint64_t> unsupported_methods_[1] = {};
   std::string cached_hash_ = "-1";
   std::mutex cached_hash_mutex_;
 };  // class BpFooInterface
@@ -25,6 +25,8 @@ class IFooInterface : public ::android::IInterface {
 public:
   typedef IFooInterfaceDelegator DefaultDelegator;
   DECLARE_META_INTERFACE(FooInterface)
+  static constexpr char16_t descriptor_utf16[] = u"android.aidl.versioned.tests.IFooInterface";
+  static constexpr size_t descriptor_utf16_length = 42;
   const int32_t VERSION = 1;
   const std::string HASH = "9e7be1859820c59d9d55dd133e71a3687b5d2e5b";
   virtual ::android::binder::Status originalApi() = 0;
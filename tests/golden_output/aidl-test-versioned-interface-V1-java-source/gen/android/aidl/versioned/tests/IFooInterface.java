@@ -157,6 +157,7 @@ public interface IFooInterface extends android.os.IInterface
         mRemote = remote;
       }
       private int mCachedVersion = -1;
+      private final long[] mUnsupportedMethods = new long[1];
       private String mCachedHash = "-1";
       @Override public android.os.IBinder asBinder()
       {
@@ -168,12 +169,16 @@ public interface IFooInterface extends android.os.IInterface
       }
       @Override public void originalApi() throws android.os.RemoteException
       {
+        if ((mUnsupportedMethods[0] & (1L << 0)) != 0) {
+          throw new android.os.RemoteException("Method originalApi is unimplemented.");
+        }
         android.os.Parcel _data = android.os.Parcel.obtain(asBinder());
         android.os.Parcel _reply = android.os.Parcel.obtain();
         try {
           _data.writeInterfaceToken(DESCRIPTOR);
           boolean _status = mRemote.transact(Stub.TRANSACTION_originalApi, _data, _reply, 0);
           if (!_status) {
+            mUnsupportedMethods[0] |= (1L << 0);
             throw new android.os.RemoteException("Method originalApi is unimplemented.");
           }
           _reply.readException();
@@ -185,6 +190,9 @@ public interface IFooInterface extends android.os.IInterface
       }
       @Override public java.lang.String acceptUnionAndReturnString(android.aidl.versioned.tests.BazUnion u) throws android.os.RemoteException
       {
+        if ((mUnsupportedMethods[0] & (1L << 1)) != 0) {
+          throw new android.os.RemoteException("Method acceptUnionAndReturnString is unimplemented.");
+        }
         android.os.Parcel _data = android.os.Parcel.obtain(asBinder());
         android.os.Parcel _reply = android.os.Parcel.obtain();
         java.lang.String _result;
@@ -193,6 +201,7 @@ public interface IFooInterface extends android.os.IInterface
           _data.writeTypedObject(u, 0);
           boolean _status = mRemote.transact(Stub.TRANSACTION_acceptUnionAndReturnString, _data, _reply, 0);
           if (!_status) {
+            mUnsupportedMethods[0] |= (1L << 1);
             throw new android.os.RemoteException("Method acceptUnionAndReturnString is unimplemented.");
           }
           _reply.readException();
@@ -206,6 +215,9 @@ public interface IFooInterface extends android.os.IInterface
       }
       @Override public int ignoreParcelablesAndRepeatInt(android.aidl.versioned.tests.Foo inFoo, android.aidl.versioned.tests.Foo inoutFoo, android.aidl.versioned.tests.Foo outFoo, int value) throws android.os.RemoteException
       {
+        if ((mUnsupportedMethods[0] & (1L << 2)) != 0) {
+          throw new android.os.RemoteException("Method ignoreParcelablesAndRepeatInt is unimplemented.");
+        }
         android.os.Parcel _data = android.os.Parcel.obtain(asBinder());
         android.os.Parcel _reply = android.os.Parcel.obtain();
         int _result;
@@ -216,6 +228,7 @@ public interface IFooInterface extends android.os.IInterface
           _data.writeInt(value);
           boolean _status = mRemote.transact(Stub.TRANSACTION_ignoreParcelablesAndRepeatInt, _data, _reply, 0);
           if (!_status) {
+            mUnsupportedMethods[0] |= (1L << 2);
             throw new android.os.RemoteException("Method ignoreParcelablesAndRepeatInt is unimplemented.");
           }
           _reply.readException();
@@ -235,6 +248,9 @@ public interface IFooInterface extends android.os.IInterface
       }
       @Override public int returnsLengthOfFooArray(android.aidl.versioned.tests.Foo[] foos) throws android.os.RemoteException
       {
+        if ((mUnsupportedMethods[0] & (1L << 3)) != 0) {
+          throw new android.os.RemoteException("Method returnsLengthOfFooArray is unimplemented.");
+        }
         android.os.Parcel _data = android.os.Parcel.obtain(asBinder());
         android.os.Parcel _reply = android.os.Parcel.obtain();
         int _result;
@@ -243,6 +259,7 @@ public interface IFooInterface extends android.os.IInterface
           _data.writeTypedArray(foos, 0);
           boolean _status = mRemote.transact(Stub.TRANSACTION_returnsLengthOfFooArray, _data, _reply, 0);
           if (!_status) {
+            mUnsupportedMethods[0] |= (1L << 3);
             throw new android.os.RemoteException("Method returnsLengthOfFooArray is unimplemented.");
           }
           _reply.readException();
@@ -134,6 +134,13 @@ BpFooInterface::~BpFooInterface() {}
 ::ndk::ScopedAStatus BpFooInterface::originalApi() {
   binder_status_t _aidl_ret_status = STATUS_OK;
   ::ndk::ScopedAStatus _aidl_status;
+  if (_aidl_unsupported_methods[0].load(std::memory_order_relaxed) & (uint64_t{1} << 0)) {
+    if (IFooInterface::getDefaultImpl()) {
+      return IFooInterface::getDefaultImpl()->originalApi();
+    }
+    _aidl_status.set(AStatus_fromStatus(STATUS_UNKNOWN_TRANSACTION));
+    return _aidl_status;
+  }
   ::ndk::ScopedAParcel _aidl_in;
   ::ndk::ScopedAParcel _aidl_out;
 
@@ -150,6 +157,9 @@ BpFooInterface::~BpFooInterface() {}
     | FLAG_PRIVATE_LOCAL
     #endif  // BINDER_STABILITY_SUPPORT
     );
+  if (_aidl_ret_status == STATUS_UNKNOWN_TRANSACTION) {
+    _aidl_unsupported_methods[0].fetch_or(uint64_t{1} << 0, std::memory_order_relaxed);
+  }
   if (_aidl_ret_status == STATUS_UNKNOWN_TRANSACTION && IFooInterface::getDefaultImpl()) {
     _aidl_status = IFooInterface::getDefaultImpl()->originalApi();
     goto _aidl_status_return;
@@ -168,6 +178,13 @@ BpFooInterface::~BpFooInterface() {}
 ::ndk::ScopedAStatus BpFooInterface::acceptUnionAndReturnString(const ::aidl::android::aidl::versioned::tests::BazUnion& in_u, std::string* _aidl_return) {
   binder_status_t _aidl_ret_status = STATUS_OK;
   ::ndk::ScopedAStatus _aidl_status;
+  if (_aidl_unsupported_methods[0].load(std::memory_order_relaxed) & (uint64_t{1} << 1)) {
+    if (IFooInterface::getDefaultImpl()) {
+      return IFooInterface::getDefaultImpl()->acceptUnionAndReturnString(in_u, _aidl_return);
+    }
+    _aidl_status.set(AStatus_fromStatus(STATUS_UNKNOWN_TRANSACTION));
+    return _aidl_status;
+  }
   ::ndk::ScopedAParcel _aidl_in;
   ::ndk::ScopedAParcel _aidl_out;
 
@@ -187,6 +204,9 @@ BpFooInterface::~BpFooInterface() {}
     | FLAG_PRIVATE_LOCAL
     #endif  // BINDER_STABILITY_SUPPORT
     );
+  if (_aidl_ret_status == STATUS_UNKNOWN_TRANSACTION) {
+    _aidl_unsupported_methods[0].fetch_or(uint64_t{1} << 1, std::memory_order_relaxed);
+  }
   if (_aidl_ret_status == STATUS_UNKNOWN_TRANSACTION && IFooInterface::getDefaultImpl()) {
     _aidl_status = IFooInterface::getDefaultImpl()->acceptUnionAndReturnString(in_u, _aidl_return);
     goto _aidl_status_return;
@@ -208,6 +228,13 @@ BpFooInterface::~BpFooInterface() {}
 ::ndk::ScopedAStatus BpFooInterface::ignoreParcelablesAndRepeatInt(const ::aidl::android::aidl::versioned::tests::Foo& in_inFoo, ::aidl::android::aidl::versioned::tests::Foo* in_inoutFoo, ::aidl::android::aidl::versioned::tests::Foo* out_outFoo, int32_t in_value, int32_t* _aidl_return) {
   binder_status_t _aidl_ret_status = STATUS_OK;
   ::ndk::ScopedAStatus _aidl_status;
+  if (_aidl_unsupported_methods[0].load(std::memory_order_relaxed) & (uint64_t{1} << 2)) {
+    if (IFooInterface::getDefaultImpl()) {
+      return IFooInterface::getDefaultImpl()->ignoreParcelablesAndRepeatInt(in_inFoo, in_inoutFoo, out_outFoo, in_value, _aidl_return);
+    }
+    _aidl_status.set(AStatus_fromStatus(STATUS_UNKNOWN_TRANSACTION));
+    return _aidl_status;
+  }
   ::ndk::ScopedAParcel _aidl_in;
   ::ndk::ScopedAParcel _aidl_out;
 
@@ -233,6 +260,9 @@ BpFooInterface::~BpFooInterface() {}
     | FLAG_PRIVATE_LOCAL
     #endif  // BINDER_STABILITY_SUPPORT
     );
+  if (_aidl_ret_status == STATUS_UNKNOWN_TRANSACTION) {
+    _aidl_unsupported_methods[0].fetch_or(uint64_t{1} << 2, std::memory_order_relaxed);
+  }
   if (_aidl_ret_status == STATUS_UNKNOWN_TRANSACTION && IFooInterface::getDefaultImpl()) {
     _aidl_status = IFooInterface::getDefaultImpl()->ignoreParcelablesAndRepeatInt(in_inFoo, in_inoutFoo, out_outFoo, in_value, _aidl_return);
     goto _aidl_status_return;
@@ -260,6 +290,13 @@ BpFooInterface::~BpFooInterface() {}
 ::ndk::ScopedAStatus BpFooInterface::returnsLengthOfFooArray(const std::vector<::aidl::android::aidl::versioned::tests::Foo>& in_foos, int32_t* _aidl_return) {
   binder_status_t _aidl_ret_status = STATUS_OK;
   ::ndk::ScopedAStatus _aidl_status;
+  if (_aidl_unsupported_methods[0].load(std::memory_order_relaxed) & (uint64_t{1} << 3)) {
+    if (IFooInterface::getDefaultImpl()) {
+      return IFooInterface::getDefaultImpl()->returnsLengthOfFooArray(in_foos, _aidl_return);
+    }
+    _aidl_status.set(AStatus_fromStatus(STATUS_UNKNOWN_TRANSACTION));
+    return _aidl_status;
+  }
   ::ndk::ScopedAParcel _aidl_in;
   ::ndk::ScopedAParcel _aidl_out;
 
@@ -279,6 +316,9 @@ BpFooInterface::~BpFooInterface() {}
     | FLAG_PRIVATE_LOCAL
     #endif  // BINDER_STABILITY_SUPPORT
     );
+  if (_aidl_ret_status == STATUS_UNKNOWN_TRANSACTION) {
+    _aidl_unsupported_methods[0].fetch_or(uint64_t{1} << 3, std::memory_order_relaxed);
+  }
   if (_aidl_ret_status == STATUS_UNKNOWN_TRANSACTION && IFooInterface::getDefaultImpl()) {
     _aidl_status = IFooInterface::getDefaultImpl()->returnsLengthOfFooArray(in_foos, _aidl_return);
     goto _aidl_status_return;
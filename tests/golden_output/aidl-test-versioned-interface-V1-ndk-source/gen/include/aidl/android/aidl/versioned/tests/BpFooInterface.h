@@ -3,6 +3,7 @@
 #include "aidl/android/aidl/versioned/tests/IFooInterface.h"
 
 #include <android/binder_ibinder.h>
+#include <atomic>
 
 namespace aidl {
 namespace android {
@@ -21,6 +22,7 @@ public:
   ::ndk::ScopedAStatus getInterfaceVersion(int32_t* _aidl_return) override;
   ::ndk::ScopedAStatus getInterfaceHash(std::string* _aidl_return) override;
   int32_t _aidl_cached_version = -1;
+  std::atomic<uint64_t> _aidl_unsupported_methods[1] = {};
   std::string _aidl_cached_hash = "-1";
   std::mutex _aidl_cached_hash_mutex;
 };
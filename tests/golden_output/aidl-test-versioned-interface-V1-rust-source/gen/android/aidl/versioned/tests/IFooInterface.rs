@@ -9,6 +9,7 @@ declare_binder_interface! {
     native: BnFooInterface(on_transact),
     proxy: BpFooInterface {
       cached_version: std::sync::atomic::AtomicI32 = std::sync::atomic::AtomicI32::new(-1),
+      unsupported_methods: [std::sync::atomic::AtomicU64; 1] = Default::default(),
       cached_hash: std::sync::Mutex<Option<String>> = std::sync::Mutex::new(None)
     },
     async: IFooInterfaceAsync,
@@ -127,6 +128,7 @@ impl BpFooInterface {
   }
   fn read_response_originalApi(&self, _aidl_reply: std::result::Result<binder::binder_impl::Parcel, binder::StatusCode>) -> binder::Result<()> {
     if let Err(binder::StatusCode::UNKNOWN_TRANSACTION) = _aidl_reply {
+      self.unsupported_methods[0].fetch_or(1 << 0, std::sync::atomic::Ordering::Relaxed);
       if let Some(_aidl_default_impl) = <Self as IFooInterface>::getDefaultImpl() {
         return _aidl_default_impl.r#originalApi();
       }
@@ -143,6 +145,7 @@ impl BpFooInterface {
   }
   fn read_response_acceptUnionAndReturnString(&self, _arg_u: &crate::mangled::_7_android_4_aidl_9_versioned_5_tests_8_BazUnion, _aidl_reply: std::result::Result<binder::binder_impl::Parcel, binder::StatusCode>) -> binder::Result<String> {
     if let Err(binder::StatusCode::UNKNOWN_TRANSACTION) = _aidl_reply {
+      self.unsupported_methods[0].fetch_or(1 << 1, std::sync::atomic::Ordering::Relaxed);
       if let Some(_aidl_default_impl) = <Self as IFooInterface>::getDefaultImpl() {
         return _aidl_default_impl.r#acceptUnionAndReturnString(_arg_u);
       }
@@ -162,6 +165,7 @@ impl BpFooInterface {
   }
   fn read_response_ignoreParcelablesAndRepeatInt(&self, _arg_inFoo: &crate::mangled::_7_android_4_aidl_9_versioned_5_tests_3_Foo, _arg_inoutFoo: &mut crate::mangled::_7_android_4_aidl_9_versioned_5_tests_3_Foo, _arg_outFoo: &mut crate::mangled::_7_android_4_aidl_9_versioned_5_tests_3_Foo, _arg_value: i32, _aidl_reply: std::result::Result<binder::binder_impl::Parcel, binder::StatusCode>) -> binder::Result<i32> {
     if let Err(binder::StatusCode::UNKNOWN_TRANSACTION) = _aidl_reply {
+      self.unsupported_methods[0].fetch_or(1 << 2, std::sync::atomic::Ordering::Relaxed);
       if let Some(_aidl_default_impl) = <Self as IFooInterface>::getDefaultImpl() {
         return _aidl_default_impl.r#ignoreParcelablesAndRepeatInt(_arg_inFoo, _arg_inoutFoo, _arg_outFoo, _arg_value);
       }
@@ -181,6 +185,7 @@ impl BpFooInterface {
   }
   fn read_response_returnsLengthOfFooArray(&self, _arg_foos: &[crate::mangled::_7_android_4_aidl_9_versioned_5_tests_3_Foo], _aidl_reply: std::result::Result<binder::binder_impl::Parcel, binder::StatusCode>) -> binder::Result<i32> {
     if let Err(binder::StatusCode::UNKNOWN_TRANSACTION) = _aidl_reply {
+      self.unsupported_methods[0].fetch_or(1 << 3, std::sync::atomic::Ordering::Relaxed);
       if let Some(_aidl_default_impl) = <Self as IFooInterface>::getDefaultImpl() {
         return _aidl_default_impl.r#returnsLengthOfFooArray(_arg_foos);
       }
@@ -218,21 +223,33 @@ impl BpFooInterface {
 }
 impl IFooInterface for BpFooInterface {
   fn r#originalApi(&self) -> binder::Result<()> {
+    if self.unsupported_methods[0].load(std::sync::atomic::Ordering::Relaxed) & (1 << 0) != 0 {
+      return self.read_response_originalApi(Err(binder::StatusCode::UNKNOWN_TRANSACTION));
+    }
     let _aidl_data = self.build_parcel_originalApi()?;
     let _aidl_reply = self.binder.submit_transact(transactions::r#originalApi, _aidl_data, binder::binder_impl::FLAG_PRIVATE_LOCAL);
     self.read_response_originalApi(_aidl_reply)
   }
   fn r#acceptUnionAndReturnString(&self, _arg_u: &crate::mangled::_7_android_4_aidl_9_versioned_5_tests_8_BazUnion) -> binder::Result<String> {
+    if self.unsupported_methods[0].load(std::sync::atomic::Ordering::Relaxed) & (1 << 1) != 0 {
+      return self.read_response_acceptUnionAndReturnString(_arg_u, Err(binder::StatusCode::UNKNOWN_TRANSACTION));
+    }
     let _aidl_data = self.build_parcel_acceptUnionAndReturnString(_arg_u)?;
     let _aidl_reply = self.binder.submit_transact(transactions::r#acceptUnionAndReturnString, _aidl_data, binder::binder_impl::FLAG_PRIVATE_LOCAL);
     self.read_response_acceptUnionAndReturnString(_arg_u, _aidl_reply)
   }
   fn r#ignoreParcelablesAndRepeatInt(&self, _arg_inFoo: &crate::mangled::_7_android_4_aidl_9_versioned_5_tests_3_Foo, _arg_inoutFoo: &mut crate::mangled::_7_android_4_aidl_9_versioned_5_tests_3_Foo, _arg_outFoo: &mut crate::mangled::_7_android_4_aidl_9_versioned_5_tests_3_Foo, _arg_value: i32) -> binder::Result<i32> {
+    if self.unsupported_methods[0].load(std::sync::atomic::Ordering::Relaxed) & (1 << 2) != 0 {
+      return self.read_response_ignoreParcelablesAndRepeatInt(_arg_inFoo, _arg_inoutFoo, _arg_outFoo, _arg_value, Err(binder::StatusCode::UNKNOWN_TRANSACTION));
+    }
     let _aidl_data = self.build_parcel_ignoreParcelablesAndRepeatInt(_arg_inFoo, _arg_inoutFoo, _arg_outFoo, _arg_value)?;
     let _aidl_reply = self.binder.submit_transact(transactions::r#ignoreParcelablesAndRepeatInt, _aidl_data, binder::binder_impl::FLAG_PRIVATE_LOCAL);
     self.read_response_ignoreParcelablesAndRepeatInt(_arg_inFoo, _arg_inoutFoo, _arg_outFoo, _arg_value, _aidl_reply)
   }
   fn r#returnsLengthOfFooArray(&self, _arg_foos: &[crate::mangled::_7_android_4_aidl_9_versioned_5_tests_3_Foo]) -> binder::Result<i32> {
+    if self.unsupported_methods[0].load(std::sync::atomic::Ordering::Relaxed) & (1 << 3) != 0 {
+      return self.read_response_returnsLengthOfFooArray(_arg_foos, Err(binder::StatusCode::UNKNOWN_TRANSACTION));
+    }
     let _aidl_data = self.build_parcel_returnsLengthOfFooArray(_arg_foos)?;
     let _aidl_reply = self.binder.submit_transact(transactions::r#returnsLengthOfFooArray, _aidl_data, binder::binder_impl::FLAG_PRIVATE_LOCAL);
     self.read_response_returnsLengthOfFooArray(_arg_foos, _aidl_reply)
@@ -258,6 +275,9 @@ impl IFooInterface for BpFooInterface {
 }
 impl<P: binder::BinderAsyncPool> IFooInterfaceAsync<P> for BpFooInterface {
   fn r#originalApi<'a>(&'a self) -> binder::BoxFuture<'a, binder::Result<()>> {
+    if self.unsupported_methods[0].load(std::sync::atomic::Ordering::Relaxed) & (1 << 0) != 0 {
+      return Box::pin(std::future::ready(self.read_response_originalApi(Err(binder::StatusCode::UNKNOWN_TRANSACTION))));
+    }
     let _aidl_data = match self.build_parcel_originalApi() {
       Ok(_aidl_data) => _aidl_data,
       Err(err) => return Box::pin(std::future::ready(Err(err))),
@@ -271,6 +291,9 @@ impl<P: binder::BinderAsyncPool> IFooInterfaceAsync<P> for BpFooInterface {
     )
   }
   fn r#acceptUnionAndReturnString<'a>(&'a self, _arg_u: &'a crate::mangled::_7_android_4_aidl_9_versioned_5_tests_8_BazUnion) -> binder::BoxFuture<'a, binder::Result<String>> {
+    if self.unsupported_methods[0].load(std::sync::atomic::Ordering::Relaxed) & (1 << 1) != 0 {
+      return Box::pin(std::future::ready(self.read_response_acceptUnionAndReturnString(_arg_u, Err(binder::StatusCode::UNKNOWN_TRANSACTION))));
+    }
     let _aidl_data = match self.build_parcel_acceptUnionAndReturnString(_arg_u) {
       Ok(_aidl_data) => _aidl_data,
       Err(err) => return Box::pin(std::future::ready(Err(err))),
@@ -284,6 +307,9 @@ impl<P: binder::BinderAsyncPool> IFooInterfaceAsync<P> for BpFooInterface {
     )
   }
   fn r#ignoreParcelablesAndRepeatInt<'a>(&'a self, _arg_inFoo: &'a crate::mangled::_7_android_4_aidl_9_versioned_5_tests_3_Foo, _arg_inoutFoo: &'a mut crate::mangled::_7_android_4_aidl_9_versioned_5_tests_3_Foo, _arg_outFoo: &'a mut crate::mangled::_7_android_4_aidl_9_versioned_5_tests_3_Foo, _arg_value: i32) -> binder::BoxFuture<'a, binder::Result<i32>> {
+    if self.unsupported_methods[0].load(std::sync::atomic::Ordering::Relaxed) & (1 << 2) != 0 {
+      return Box::pin(std::future::ready(self.read_response_ignoreParcelablesAndRepeatInt(_arg_inFoo, _arg_inoutFoo, _arg_outFoo, _arg_value, Err(binder::StatusCode::UNKNOWN_TRANSACTION))));
+    }
     let _aidl_data = match self.build_parcel_ignoreParcelablesAndRepeatInt(_arg_inFoo, _arg_inoutFoo, _arg_outFoo, _arg_value) {
       Ok(_aidl_data) => _aidl_data,
       Err(err) => return Box::pin(std::future::ready(Err(err))),
@@ -297,6 +323,9 @@ impl<P: binder::BinderAsyncPool> IFooInterfaceAsync<P> for BpFooInterface {
     )
   }
   fn r#returnsLengthOfFooArray<'a>(&'a self, _arg_foos: &'a [crate::mangled::_7_android_4_aidl_9_versioned_5_tests_3_Foo]) -> binder::BoxFuture<'a, binder::Result<i32>> {
+    if self.unsupported_methods[0].load(std::sync::atomic::Ordering::Relaxed) & (1 << 3) != 0 {
+      return Box::pin(std::future::ready(self.read_response_returnsLengthOfFooArray(_arg_foos, Err(binder::StatusCode::UNKNOWN_TRANSACTION))));
+    }
     let _aidl_data = match self.build_parcel_returnsLengthOfFooArray(_arg_foos) {
       Ok(_aidl_data) => _aidl_data,
       Err(err) => return Box::pin(std::future::ready(Err(err))),
@@ -56,7 +56,7 @@ std::function<void(const BpLoggableInterface::TransactionLog&)> BpLoggableInterf
     _transaction_log.input_args.emplace_back("pfdArray", ::android::internal::ToString(*pfdArray));
   }
   auto _log_start = std::chrono::steady_clock::now();
-  _aidl_ret_status = _aidl_data.writeInterfaceToken(getInterfaceDescriptor());
+  _aidl_ret_status = _aidl_data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
   if (((_aidl_ret_status) != (::android::OK))) {
     goto _aidl_error;
   }
@@ -281,7 +281,7 @@ BnLoggableInterface::BnLoggableInterface()
     ::std::optional<::android::os::ParcelFileDescriptor> in_pfdValue;
     ::std::vector<::android::os::ParcelFileDescriptor> in_pfdArray;
     ::std::vector<::android::String16> _aidl_return;
-    if (!(_aidl_data.checkInterface(this))) {
+    if (!(_aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length))) {
       _aidl_ret_status = ::android::BAD_TYPE;
       break;
     }
@@ -536,7 +536,7 @@ std::function<void(const ILoggableInterface::BpSub::TransactionLog&)> ILoggableI
     _transaction_log.input_args.emplace_back("value", ::android::internal::ToString(value));
   }
   auto _log_start = std::chrono::steady_clock::now();
-  _aidl_ret_status = _aidl_data.writeInterfaceToken(getInterfaceDescriptor());
+  _aidl_ret_status = _aidl_data.writeInterfaceToken(descriptor_utf16, descriptor_utf16_length);
   if (((_aidl_ret_status) != (::android::OK))) {
     goto _aidl_error;
   }
@@ -600,7 +600,7 @@ ILoggableInterface::BnSub::BnSub()
   case BnSub::TRANSACTION_Log:
   {
     int32_t in_value;
-    if (!(_aidl_data.checkInterface(this))) {
+    if (!(_aidl_data.enforceInterface(descriptor_utf16, descriptor_utf16_length))) {
       _aidl_ret_status = ::android::BAD_TYPE;
       break;
     }
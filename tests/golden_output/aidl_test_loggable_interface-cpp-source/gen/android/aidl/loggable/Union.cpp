@@ -9,24 +9,14 @@ namespace loggable {
   if ((_aidl_ret_status = _aidl_parcel->readInt32(&_aidl_tag)) != ::android::OK) return _aidl_ret_status;
   switch (static_cast<Tag>(_aidl_tag)) {
   case num: {
-    int32_t _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readInt32(&_aidl_value)) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<int32_t>) {
-      set<num>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<num>(std::move(_aidl_value));
-    }
+    set<num>();
+    if ((_aidl_ret_status = _aidl_parcel->readInt32(&get<num>())) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   case str: {
-    ::std::string _aidl_value;
-    if ((_aidl_ret_status = _aidl_parcel->readUtf8FromUtf16(&_aidl_value)) != ::android::OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<::std::string>) {
-      set<str>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<str>(std::move(_aidl_value));
+    if (getTag() != str) {
+      set<str>();
     }
+    if ((_aidl_ret_status = _aidl_parcel->readUtf8FromUtf16(&get<str>())) != ::android::OK) return _aidl_ret_status;
     return ::android::OK; }
   }
   return ::android::BAD_VALUE;
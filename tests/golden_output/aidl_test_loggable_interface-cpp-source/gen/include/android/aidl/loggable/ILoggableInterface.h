@@ -27,12 +27,16 @@ class ILoggableInterface : public ::android::IInterface {
 public:
   typedef ILoggableInterfaceDelegator DefaultDelegator;
   DECLARE_META_INTERFACE(LoggableInterface)
+  static constexpr char16_t descriptor_utf16[] = u"android.aidl.loggable.ILoggableInterface";
+  static constexpr size_t descriptor_utf16_length = 40;
   class ISubDelegator;
 
   class ISub : public ::android::IInterface {
   public:
     typedef ISubDelegator DefaultDelegator;
     DECLARE_META_INTERFACE(Sub)
+    static constexpr char16_t descriptor_utf16[] = u"android.aidl.loggable.ILoggableInterface.ISub";
+    static constexpr size_t descriptor_utf16_length = 45;
     virtual ::android::binder::Status Log(int32_t value) = 0;
   };  // class ISub
 
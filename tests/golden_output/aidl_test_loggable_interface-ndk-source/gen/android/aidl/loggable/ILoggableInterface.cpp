@@ -5,12 +5,15 @@
 #include <aidl/android/aidl/loggable/BnLoggableInterface.h>
 #include <aidl/android/aidl/loggable/BpLoggableInterface.h>
 
+#ifndef AIDL_NDK_SCOPED_TRACE
+#define AIDL_NDK_SCOPED_TRACE
 namespace {
 struct ScopedTrace {
   inline explicit ScopedTrace(const char* name) { ATrace_beginSection(name); }
   inline ~ScopedTrace() { ATrace_endSection(); }
 };
 }  // namespace
+#endif  // AIDL_NDK_SCOPED_TRACE
 
 namespace aidl {
 namespace android {
@@ -14,24 +14,14 @@ binder_status_t Union::readFromParcel(const AParcel* _parcel) {
   if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_tag)) != STATUS_OK) return _aidl_ret_status;
   switch (static_cast<Tag>(_aidl_tag)) {
   case num: {
-    int32_t _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<int32_t>) {
-      set<num>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<num>(std::move(_aidl_value));
-    }
+    set<num>();
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<num>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   case str: {
-    std::string _aidl_value;
-    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &_aidl_value)) != STATUS_OK) return _aidl_ret_status;
-    if constexpr (std::is_trivially_copyable_v<std::string>) {
-      set<str>(_aidl_value);
-    } else {
-      // NOLINTNEXTLINE(performance-move-const-arg)
-      set<str>(std::move(_aidl_value));
+    if (getTag() != str) {
+      set<str>();
     }
+    if ((_aidl_ret_status = ::ndk::AParcel_readData(_parcel, &get<str>())) != STATUS_OK) return _aidl_ret_status;
     return STATUS_OK; }
   }
   return STATUS_BAD_VALUE;